@@ -0,0 +1,91 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidAPI/IAlgorithm_fwd.h"
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/** AlgorithmGraph : Runs a set of algorithms concurrently, in an order that
+  respects the dependencies between them.
+
+  The nodes of the graph are algorithms. An algorithm depends on an algorithm
+  added before it if it reads a workspace the other one writes, or writes a
+  workspace the other one reads or writes. Workspaces are identified by their
+  names in the AnalysisDataService, taken from the workspace properties of the
+  algorithm or from the property values given when it is added. Further
+  dependencies can be added with addDependency().
+
+  execute() runs every algorithm whose dependencies have finished, as long as
+  the cores given to the running algorithms fit into the budget of the graph.
+  Each algorithm is limited to its number of cores for its own OpenMP loops.
+
+  If an algorithm fails, or the graph is cancelled, the algorithms depending on
+  it are not run. cancel() also cancels the algorithms that are running.
+*/
+class MANTID_API_DLL AlgorithmGraph {
+public:
+  /// Index of an algorithm in the graph
+  using Node = size_t;
+  /// Execution state of a node
+  enum class NodeState { Waiting, Running, Finished, Failed, Cancelled };
+
+  AlgorithmGraph() = default;
+  AlgorithmGraph(const AlgorithmGraph &) = delete;
+  AlgorithmGraph &operator=(const AlgorithmGraph &) = delete;
+
+  Node addAlgorithm(const IAlgorithm_sptr &algorithm, const std::map<std::string, std::string> &properties = {},
+                    int cores = 1);
+  void addDependency(Node before, Node after);
+
+  /// Number of algorithms in the graph
+  size_t size() const;
+  IAlgorithm_sptr algorithm(Node node) const;
+  std::vector<Node> dependencies(Node node) const;
+  NodeState state(Node node) const;
+
+  bool execute(int cores = 0);
+  void cancel();
+
+private:
+  class Scheduler;
+  class NodeTask;
+
+  struct NodeData {
+    IAlgorithm_sptr algorithm;
+    /// Property values set just before the algorithm is run
+    std::map<std::string, std::string> properties;
+    int cores;
+    std::set<Node> dependencies;
+    /// Names of the workspaces read and written by the algorithm
+    std::set<std::string> reads, writes;
+    NodeState state;
+    std::string error;
+  };
+
+  const NodeData &nodeData(Node node) const;
+  bool isReady(const NodeData &node) const;
+  void runNode(Node node, int cores);
+  void cancelDependents(Node node);
+
+  std::vector<NodeData> m_nodes;
+  /// Cores available to the running algorithms, and the cores they use
+  int m_coreBudget{0}, m_coresInUse{0};
+  bool m_executing{false};
+  mutable std::mutex m_mutex;
+};
+
+} // namespace API
+} // namespace Mantid
@@ -15,6 +15,7 @@
 #include <nexus/NeXusFile.hpp>
 
 #include <ctime>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -73,7 +74,7 @@ public:
   /// get the uuid
   const std::string &uuid() const { return m_uuid; }
   /// get parameter list of algorithm in history const
-  const Mantid::Kernel::PropertyHistories &getProperties() const { return m_properties; }
+  const Mantid::Kernel::PropertyHistories &getProperties() const;
   /// get the string representation of a specified property
   const std::string &getPropertyValue(const std::string &name) const;
   /// get the child histories of this history object
@@ -112,6 +113,8 @@ private:
   AlgorithmHistory();
   // Set properties of algorithm
   void setProperties(const Algorithm *const alg);
+  /// Copies of the property values whose histories are created on first use
+  struct PropertySnapshot;
   /// The name of the Algorithm
   std::string m_name;
   /// The version of the algorithm
@@ -122,6 +125,8 @@ private:
   double m_executionDuration{-1.0};
   /// The PropertyHistory's defined for the algorithm
   Mantid::Kernel::PropertyHistories m_properties;
+  /// Property values still to be turned into histories, shared between copies
+  std::shared_ptr<PropertySnapshot> m_snapshot;
   /// count keeps track of execution order of an algorithm
   std::size_t m_execCount{0};
   /// set of child algorithm histories for this history record
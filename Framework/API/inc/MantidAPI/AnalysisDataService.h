@@ -16,6 +16,9 @@
 
 #include <Poco/AutoPtr.h>
 
+#include <memory>
+#include <set>
+
 namespace Mantid {
 
 namespace API {
@@ -25,6 +28,7 @@ namespace API {
 //----------------------------------------------------------------------
 
 class WorkspaceGroup;
+class WorkspaceMemoryManager;
 
 /** The Analysis data service stores instances of the Workspace objects and
     anything that derives from template class
@@ -79,6 +83,25 @@ public:
     std::shared_ptr<const WorkspaceGroup> getWorkspaceGroup() const;
   };
 
+  /// Evicted notification is sent when a workspace is saved to a scratch file
+  /// to keep within the memory budget. The object is the placeholder standing
+  /// for the workspace until it is retrieved again.
+  class EvictedNotification : public DataServiceNotification {
+  public:
+    /// Constructor
+    EvictedNotification(const std::string &name, const std::shared_ptr<Workspace> &obj)
+        : DataServiceNotification(name, obj) {}
+  };
+
+  /// Restored notification is sent when a workspace saved to free memory has
+  /// been loaded back. The object is the workspace.
+  class RestoredNotification : public DataServiceNotification {
+  public:
+    /// Constructor
+    RestoredNotification(const std::string &name, const std::shared_ptr<Workspace> &obj)
+        : DataServiceNotification(name, obj) {}
+  };
+
   //@}
 
 public:
@@ -99,6 +122,8 @@ public:
   virtual void rename(const std::string &oldName, const std::string &newName);
   /// Overridden remove member to delete its name held by the workspace itself
   virtual Workspace_sptr remove(const std::string &name);
+  /// Overridden retrieve member to load back workspaces saved to free memory
+  Workspace_sptr retrieve(const std::string &name) const override;
   /// Random generated unique workspace name
   const std::string uniqueName(const int n = 5, const std::string &prefix = "", const std::string &suffix = "");
   /// Random generated unique hidden workspace name
@@ -115,7 +140,7 @@ public:
     // Get as a bare workspace
     try {
       // Cast to the desired type and return that.
-      return std::dynamic_pointer_cast<WSTYPE>(Kernel::DataService<API::Workspace>::retrieve(name));
+      return std::dynamic_pointer_cast<WSTYPE>(retrieve(name));
 
     } catch (Kernel::Exception::NotFoundError &) {
       throw;
@@ -133,14 +158,36 @@ public:
   void removeFromGroup(const std::string &groupName, const std::string &wsName);
   //@}
 
-  /// Return a lookup of the top level items
+  /// Return a lookup of the top level items, without loading back the
+  /// workspaces saved to free memory
   std::map<std::string, Workspace_sptr> topLevelItems() const;
+
+  /** @name Methods to keep the workspaces within a memory budget */
+  //@{
+  void setMemoryBudget(size_t bytes);
+  size_t memoryBudget() const;
+  size_t memoryUsage();
+  WorkspaceMemoryManager &memoryManager();
+  //@}
   void shutdown() override;
 
 private:
+  using Members = std::vector<std::pair<std::string, Workspace_sptr>>;
+  using NameSet = std::set<std::string, Kernel::CaseInsensitiveCmp>;
+
   /// Checks the name is valid, throwing if not
   void verifyName(const std::string &name, const std::shared_ptr<API::WorkspaceGroup> &workspace);
+  /// Find the members of a group that need adding with it
+  void collectMembersToAdd(const std::string &name, const std::shared_ptr<API::WorkspaceGroup> &group,
+                           NameSet &names, Members &members);
+  /// Attach the names to members about to be added
+  void attachMemberNames(const Members &members);
+  /// Find the members of a group that need removing with it
+  void collectMembersToRemove(const std::shared_ptr<API::WorkspaceGroup> &group,
+                              std::vector<Workspace_sptr> &workspaces);
   static char getRandomLowercaseLetter();
+  /// Save workspaces if needed to keep within the memory budget
+  void keepWithinMemoryBudget(const std::string &name);
 
   friend struct Mantid::Kernel::CreateUsingNew<AnalysisDataServiceImpl>;
   /// Constructor
@@ -150,10 +197,12 @@ private:
   /// Private, unimplemented copy assignment operator
   AnalysisDataServiceImpl &operator=(const AnalysisDataServiceImpl &) = delete;
   /// Private destructor
-  ~AnalysisDataServiceImpl() override = default;
+  ~AnalysisDataServiceImpl() override;
 
   /// The string of illegal characters
   std::string m_illegalChars;
+  /// Keeps the workspaces within the memory budget
+  std::unique_ptr<WorkspaceMemoryManager> m_memoryManager;
 };
 
 using AnalysisDataService = Mantid::Kernel::SingletonHolder<AnalysisDataServiceImpl>;
@@ -197,6 +246,12 @@ using WorkspaceUnGroupingNotification_ptr =
 using GroupUpdatedNotification = AnalysisDataServiceImpl::GroupUpdatedNotification;
 using GroupUpdatedNotification_ptr = const Poco::AutoPtr<AnalysisDataServiceImpl::GroupUpdatedNotification> &;
 
+using WorkspaceEvictedNotification = AnalysisDataServiceImpl::EvictedNotification;
+using WorkspaceEvictedNotification_ptr = const Poco::AutoPtr<AnalysisDataServiceImpl::EvictedNotification> &;
+
+using WorkspaceRestoredNotification = AnalysisDataServiceImpl::RestoredNotification;
+using WorkspaceRestoredNotification_ptr = const Poco::AutoPtr<AnalysisDataServiceImpl::RestoredNotification> &;
+
 } // Namespace API
 } // Namespace Mantid
 
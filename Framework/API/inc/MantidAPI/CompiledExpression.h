@@ -0,0 +1,143 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/DllConfig.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class Jacobian;
+
+/** CompiledExpression : a formula compiled for evaluation over whole arrays.
+
+  The formula is parsed, with the operator precedence of muParser, into a
+  graph of operations in which common subexpressions are shared and constant
+  subexpressions are folded. The graph is compiled into a short program that is executed block
+  by block: every instruction is a tight loop over a block of values, and
+  subexpressions that depend only on the scalar variables are evaluated once
+  per call rather than once per point.
+
+  The formula depends on one array variable (e.g. "x") and any number of
+  scalar variables (e.g. fit parameters). Derivatives with respect to the
+  scalar variables are obtained by symbolic differentiation and compiled into
+  a second program.
+
+  Supported are the operators + - * / ^, unary minus, the constants _pi and _e
+  and the functions sin, cos, tan, asin, acos, atan, sinh, cosh, tanh, exp,
+  log, ln, log10, log2, sqrt, abs, sign, erf and erfc. Any other construct
+  throws std::invalid_argument so that the caller can fall back to muParser.
+*/
+class MANTID_API_DLL CompiledExpression {
+public:
+  CompiledExpression(const std::string &formula, const std::string &arrayVariable,
+                     const std::vector<std::string> &scalarVariables);
+
+  /// Number of scalar variables
+  size_t nScalars() const { return m_nScalars; }
+  /// Number of instructions executed per block of values
+  size_t nInstructions() const { return m_value.instructions.size(); }
+
+  void evaluate(double *out, const double *values, const size_t nValues, const double *scalars) const;
+  void evaluateDerivatives(Jacobian &jacobian, const double *values, const size_t nValues,
+                           const double *scalars) const;
+
+private:
+  enum class Op : uint8_t {
+    Constant,
+    Array,
+    Scalar,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    /// a * b, or 0 where a is 0: a term of the chain rule, a being the
+    /// derivative of the argument, vanishes even where b is not finite
+    Chain,
+    Power,
+    Negate,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Sinh,
+    Cosh,
+    Tanh,
+    Exp,
+    Ln,
+    Log10,
+    Log2,
+    Sqrt,
+    Abs,
+    Sign,
+    Erf,
+    Erfc
+  };
+
+  /// A node of the expression graph
+  struct Node {
+    Op op;
+    /// Operands, or the variable index of a Scalar node
+    size_t a;
+    size_t b;
+    double value;
+    /// True if the node depends on the array variable
+    bool varying;
+  };
+
+  /// Where an instruction finds an operand
+  struct Source {
+    enum class Kind : uint8_t { Array, Register, Uniform };
+    Kind kind;
+    /// Register index or node index of a uniform value
+    size_t index;
+  };
+
+  struct Instruction {
+    Op op;
+    Source a;
+    Source b;
+    size_t result;
+  };
+
+  struct Program {
+    /// Nodes that do not depend on the array variable, in evaluation order
+    std::vector<size_t> uniforms;
+    std::vector<Instruction> instructions;
+    size_t nRegisters = 0;
+    std::vector<Source> outputs;
+  };
+
+  using UnaryFunction = double (*)(double);
+  static UnaryFunction unaryFunction(Op op);
+  class Parser;
+  size_t node(Op op, size_t a = 0, size_t b = 0, double value = 0.0);
+  size_t constant(double value) { return node(Op::Constant, 0, 0, value); }
+  bool isConstant(size_t i, double value) const;
+  size_t derivative(size_t i, size_t scalar, std::map<size_t, size_t> &cache);
+  Program compile(const std::vector<size_t> &outputs) const;
+  template <typename Store>
+  void run(const Program &program, const double *values, const size_t nValues, const double *scalars,
+           Store &&store) const;
+
+  size_t m_nScalars;
+  std::vector<Node> m_nodes;
+  /// Index of existing nodes, used to share common subexpressions
+  std::map<std::tuple<Op, size_t, size_t, uint64_t>, size_t> m_index;
+  Program m_value;
+  Program m_derivatives;
+};
+
+} // namespace API
+} // namespace Mantid
@@ -228,6 +228,8 @@ protected:
   std::string writeToString(const std::string &parentLocalAttributesStr = "") const override;
 
   size_t paramOffset(size_t i) const { return m_paramOffsets[i]; }
+  /// Numerical derivatives evaluating only the members a parameter affects
+  void calNumericalDerivByMember(const FunctionDomain &domain, Jacobian &jacobian);
 
 private:
   // get attribute offset from attribute index
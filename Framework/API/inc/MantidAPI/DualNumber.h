@@ -0,0 +1,155 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Jacobian.h"
+
+#include <array>
+#include <cmath>
+
+namespace Mantid {
+namespace API {
+
+/** DualNumber : a value together with its gradient with respect to N
+  variables, for forward-mode automatic differentiation.
+
+  Arithmetic on dual numbers propagates the gradient by the chain rule, so a
+  function written as a template over its scalar type returns its exact
+  derivatives with respect to all N variables in a single evaluation. This is
+  how simple fit functions provide analytical derivatives without writing them
+  by hand:
+
+  @code
+  template <typename T> T model(double x, const T &height, const T &rate) { return height * exp(-rate * x); }
+
+  void MyFunction::functionDeriv1D(Jacobian *out, const double *xValues, const size_t nData) {
+    const auto height = DualNumber<2>::variable(getParameter(0), 0);
+    const auto rate = DualNumber<2>::variable(getParameter(1), 1);
+    for (size_t i = 0; i < nData; ++i)
+      setJacobianRow(out, i, model(xValues[i], height, rate));
+  }
+  @endcode
+*/
+template <size_t N> class DualNumber {
+public:
+  DualNumber(double value = 0.0) : m_value(value), m_gradient{} {}
+
+  /// The i-th of N independent variables
+  static DualNumber variable(double value, size_t i) {
+    DualNumber result(value);
+    result.m_gradient[i] = 1.0;
+    return result;
+  }
+
+  double value() const { return m_value; }
+  double derivative(size_t i) const { return m_gradient[i]; }
+
+  DualNumber &operator+=(const DualNumber &rhs) {
+    m_value += rhs.m_value;
+    for (size_t i = 0; i < N; ++i)
+      m_gradient[i] += rhs.m_gradient[i];
+    return *this;
+  }
+  DualNumber &operator-=(const DualNumber &rhs) {
+    m_value -= rhs.m_value;
+    for (size_t i = 0; i < N; ++i)
+      m_gradient[i] -= rhs.m_gradient[i];
+    return *this;
+  }
+  DualNumber &operator*=(const DualNumber &rhs) {
+    for (size_t i = 0; i < N; ++i)
+      m_gradient[i] = m_gradient[i] * rhs.m_value + m_value * rhs.m_gradient[i];
+    m_value *= rhs.m_value;
+    return *this;
+  }
+  DualNumber &operator/=(const DualNumber &rhs) {
+    const double inverse = 1.0 / rhs.m_value;
+    m_value *= inverse;
+    for (size_t i = 0; i < N; ++i)
+      m_gradient[i] = (m_gradient[i] - m_value * rhs.m_gradient[i]) * inverse;
+    return *this;
+  }
+  DualNumber operator-() const {
+    DualNumber result(-m_value);
+    for (size_t i = 0; i < N; ++i)
+      result.m_gradient[i] = -m_gradient[i];
+    return result;
+  }
+
+  /// Apply a function with value f and derivative df at value()
+  DualNumber chain(double f, double df) const {
+    DualNumber result(f);
+    for (size_t i = 0; i < N; ++i)
+      // Skip zero components so that an infinite df at a point where the
+      // argument is constant does not produce NaN
+      result.m_gradient[i] = m_gradient[i] == 0.0 ? 0.0 : df * m_gradient[i];
+    return result;
+  }
+
+private:
+  double m_value;
+  std::array<double, N> m_gradient;
+};
+
+template <size_t N> DualNumber<N> operator+(DualNumber<N> lhs, const DualNumber<N> &rhs) { return lhs += rhs; }
+template <size_t N> DualNumber<N> operator-(DualNumber<N> lhs, const DualNumber<N> &rhs) { return lhs -= rhs; }
+template <size_t N> DualNumber<N> operator*(DualNumber<N> lhs, const DualNumber<N> &rhs) { return lhs *= rhs; }
+template <size_t N> DualNumber<N> operator/(DualNumber<N> lhs, const DualNumber<N> &rhs) { return lhs /= rhs; }
+template <size_t N> DualNumber<N> operator+(DualNumber<N> lhs, double rhs) { return lhs += DualNumber<N>(rhs); }
+template <size_t N> DualNumber<N> operator-(DualNumber<N> lhs, double rhs) { return lhs -= DualNumber<N>(rhs); }
+template <size_t N> DualNumber<N> operator*(const DualNumber<N> &lhs, double rhs) {
+  return lhs.chain(lhs.value() * rhs, rhs);
+}
+template <size_t N> DualNumber<N> operator/(const DualNumber<N> &lhs, double rhs) { return lhs * (1.0 / rhs); }
+template <size_t N> DualNumber<N> operator+(double lhs, const DualNumber<N> &rhs) { return rhs + lhs; }
+template <size_t N> DualNumber<N> operator-(double lhs, const DualNumber<N> &rhs) { return -rhs + lhs; }
+template <size_t N> DualNumber<N> operator*(double lhs, const DualNumber<N> &rhs) { return rhs * lhs; }
+template <size_t N> DualNumber<N> operator/(double lhs, const DualNumber<N> &rhs) { return DualNumber<N>(lhs) / rhs; }
+
+template <size_t N> DualNumber<N> exp(const DualNumber<N> &x) {
+  const double f = std::exp(x.value());
+  return x.chain(f, f);
+}
+template <size_t N> DualNumber<N> log(const DualNumber<N> &x) { return x.chain(std::log(x.value()), 1.0 / x.value()); }
+template <size_t N> DualNumber<N> sqrt(const DualNumber<N> &x) {
+  const double f = std::sqrt(x.value());
+  return x.chain(f, 0.5 / f);
+}
+template <size_t N> DualNumber<N> sin(const DualNumber<N> &x) {
+  return x.chain(std::sin(x.value()), std::cos(x.value()));
+}
+template <size_t N> DualNumber<N> cos(const DualNumber<N> &x) {
+  return x.chain(std::cos(x.value()), -std::sin(x.value()));
+}
+template <size_t N> DualNumber<N> atan(const DualNumber<N> &x) {
+  return x.chain(std::atan(x.value()), 1.0 / (1.0 + x.value() * x.value()));
+}
+template <size_t N> DualNumber<N> erf(const DualNumber<N> &x) {
+  constexpr double twoOverSqrtPi = 1.1283791670955126;
+  return x.chain(std::erf(x.value()), twoOverSqrtPi * std::exp(-x.value() * x.value()));
+}
+template <size_t N> DualNumber<N> pow(const DualNumber<N> &x, double p) {
+  return x.chain(std::pow(x.value(), p), p * std::pow(x.value(), p - 1.0));
+}
+template <size_t N> DualNumber<N> pow(const DualNumber<N> &x, const DualNumber<N> &p) {
+  const double f = std::pow(x.value(), p.value());
+  auto result = pow(x, p.value());
+  // d(x^p)/dp = x^p * log(x), which vanishes with x^p at x = 0
+  if (f != 0.0)
+    result += p.chain(0.0, f * std::log(x.value()));
+  return result;
+}
+
+/// Set row i of a Jacobian to the gradient of value with respect to the
+/// function parameters, the i-th variable being the i-th parameter
+template <size_t N> void setJacobianRow(Jacobian *jacobian, size_t i, const DualNumber<N> &value) {
+  for (size_t iP = 0; iP < N; ++iP)
+    jacobian->set(i, iP, value.derivative(iP));
+}
+
+} // namespace API
+} // namespace Mantid
@@ -41,6 +41,11 @@ public:
   /// Does this listener buffer events (true) or histogram data (false)
   virtual bool buffersEvents() const = 0;
 
+  /// Name of the run property marking a chunk that only holds the spectra
+  /// that changed since the last extraction. Instead of replacing the
+  /// accumulation workspace these spectra are copied into it.
+  static constexpr const char *DELTA_UPDATE_PROPERTY = "live_delta_update";
+
   //----------------------------------------------------------------------
   // Actions
   //----------------------------------------------------------------------
@@ -71,7 +76,7 @@ public:
    *  (or since start() was called).
    *  This method should never return an empty shared pointer, and a given
    *  instance of a listener should return a workspace of the same dimension
-   * every time.
+   * every time, unless the workspace is marked with DELTA_UPDATE_PROPERTY.
    *  The implementation should reset its internal buffer when this method is
    * called
    *    - the returned workspace is for the caller to do with as they wish.
@@ -104,6 +109,13 @@ public:
    */
   virtual bool dataReset() = 0;
 
+  /** Asks the listener to return all of its data, rather than only what
+   *  changed, on the next call to extractData(). The client calls this when
+   *  a chunk marked with DELTA_UPDATE_PROPERTY could not be accumulated.
+   *  Listeners that never mark their chunks can ignore it.
+   */
+  virtual void requestFullUpdate() {}
+
   /** The possible run statuses (initial list taken from SNS SMS protocol)
    *  None    : No current run
    *  Begin   : A new run has begun since the last call to extractData
@@ -0,0 +1,122 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Run.h"
+#include "MantidAPI/WorkspaceFactory.h"
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/** LiveListenerBuffer : Double buffering of the workspaces a live listener
+  fills from its background thread.
+
+  Creating an empty copy of a buffer, with the instrument and spectrum
+  definitions of a large instrument, is slow. Instead of doing this while
+  holding the lock that blocks the background thread, the listener calls
+  prepare() with the data it has just extracted once the lock is released.
+  The next call to swap() then only has to exchange the pointers and carry the
+  run over to the new buffer.
+
+  If the listener replaces its buffers, e.g. at the start of a new run, the
+  prepared buffers no longer match and swap() creates new ones from the
+  current buffers instead.
+
+  The class itself is not thread safe, it is only used by the thread extracting
+  the data.
+*/
+template <typename WorkspaceType> class LiveListenerBuffer {
+public:
+  using WorkspaceType_sptr = std::shared_ptr<WorkspaceType>;
+  /// Additional initialization of an empty buffer created from a filled one
+  using Initializer = std::function<void(WorkspaceType &empty, const WorkspaceType &filled)>;
+
+  /// What is kept of the time series logs of a filled buffer
+  enum class Logs { KeepLatestValue, ClearValues };
+
+  explicit LiveListenerBuffer(Logs logs = Logs::KeepLatestValue, Initializer initializer = Initializer())
+      : m_logs(logs), m_initializer(std::move(initializer)) {}
+
+  /**
+   * Swap the filled buffers with empty ones. Call this holding the lock that
+   * protects the buffers.
+   * @param buffers :: The buffers being filled, replaced by empty buffers.
+   * @return :: The filled buffers.
+   */
+  std::vector<WorkspaceType_sptr> swap(std::vector<WorkspaceType_sptr> &buffers) {
+    const bool prepared = m_empty.size() == buffers.size() && m_swappedIn.size() == buffers.size();
+    m_swappedIn.resize(buffers.size());
+    std::vector<WorkspaceType_sptr> filled(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      auto empty = (prepared && m_swappedIn[i].lock() == buffers[i]) ? std::move(m_empty[i]) : createEmpty(*buffers[i]);
+      // The run may have changed since the empty buffer was created
+      empty->mutableRun() = buffers[i]->run();
+      clearLogs(empty->mutableRun());
+      filled[i] = std::exchange(buffers[i], std::move(empty));
+      m_swappedIn[i] = buffers[i];
+    }
+    m_empty.clear();
+    return filled;
+  }
+
+  /// Swap a single filled buffer with an empty one, see swap() above.
+  WorkspaceType_sptr swap(WorkspaceType_sptr &buffer) {
+    std::vector<WorkspaceType_sptr> buffers{std::move(buffer)};
+    auto filled = swap(buffers);
+    buffer = std::move(buffers.front());
+    return filled.front();
+  }
+
+  /**
+   * Create the empty buffers for the next swap. Call this without holding the
+   * lock, before the extracted data are handed out.
+   * @param filled :: The buffers returned by the last swap.
+   */
+  void prepare(const std::vector<WorkspaceType_sptr> &filled) {
+    m_empty.clear();
+    m_empty.reserve(filled.size());
+    for (const auto &buffer : filled)
+      m_empty.emplace_back(createEmpty(*buffer));
+  }
+
+  /// Create the empty buffer for the next swap, see prepare() above.
+  void prepare(const WorkspaceType_sptr &filled) { prepare(std::vector<WorkspaceType_sptr>{filled}); }
+
+private:
+  WorkspaceType_sptr createEmpty(const WorkspaceType &filled) const {
+    auto empty = std::static_pointer_cast<WorkspaceType>(
+        WorkspaceFactory::Instance().create(filled.id(), filled.getNumberHistograms(), 2, 1));
+    // Copy geometry over.
+    WorkspaceFactory::Instance().initializeFromParent(filled, *empty, false);
+    clearLogs(empty->mutableRun());
+    if (m_initializer)
+      m_initializer(*empty, filled);
+    return empty;
+  }
+
+  void clearLogs(Run &run) const {
+    if (m_logs == Logs::KeepLatestValue)
+      run.clearOutdatedTimeSeriesLogValues();
+    else
+      run.clearTimeSeriesLogs();
+  }
+
+  const Logs m_logs;
+  const Initializer m_initializer;
+  /// Empty buffers created by prepare()
+  std::vector<WorkspaceType_sptr> m_empty;
+  /// The buffers installed by the last swap, to tell if the listener replaced them
+  std::vector<std::weak_ptr<WorkspaceType>> m_swappedIn;
+};
+
+} // namespace API
+} // namespace Mantid
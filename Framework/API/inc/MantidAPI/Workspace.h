@@ -105,6 +105,7 @@ private:
   virtual Workspace *doCloneEmpty() const = 0;
 
   friend class AnalysisDataServiceImpl;
+  friend class WorkspaceMemoryManager;
 };
 
 } // namespace API
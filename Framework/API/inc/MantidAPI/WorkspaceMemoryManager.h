@@ -0,0 +1,91 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidAPI/Workspace_fwd.h"
+#include "MantidKernel/DataService.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace Mantid {
+namespace API {
+class AnalysisDataServiceImpl;
+
+/** WorkspaceMemoryManager : Keeps the memory used by the workspaces in the
+  analysis data service within a budget.
+
+  The memory of each workspace is given by Workspace::getMemorySize(). When
+  the total goes over the budget, the least recently used workspaces are saved
+  to files in a scratch directory and replaced in the service by placeholders
+  using almost no memory. Retrieving a placeholder from the service loads the
+  workspace back. Only workspaces held by nothing but the service are saved,
+  so workspaces used by algorithms or held in groups stay in memory. Python
+  handles do not own their workspaces, so the workspaces retrieved from
+  Python are marked with keepInMemory() instead.
+
+  Matrix, table and peaks workspaces are saved with SaveNexusProcessed and MD
+  workspaces with SaveMD. Other workspaces stay in memory.
+*/
+class MANTID_API_DLL WorkspaceMemoryManager {
+public:
+  explicit WorkspaceMemoryManager(AnalysisDataServiceImpl &ads);
+  WorkspaceMemoryManager(const WorkspaceMemoryManager &) = delete;
+  WorkspaceMemoryManager &operator=(const WorkspaceMemoryManager &) = delete;
+
+  /// The memory the workspaces may use in bytes, 0 if there is no limit
+  size_t budget() const { return m_budget; }
+  void setBudget(size_t bytes);
+  std::string scratchDirectory() const;
+  void setScratchDirectory(const std::string &directory);
+
+  /// Is there anything to do when a workspace is retrieved?
+  bool active() const { return m_budget > 0 || numberSaved() > 0; }
+  static size_t numberSaved();
+  static bool isSaved(const Workspace &workspace);
+
+  size_t memoryUsage();
+  void added(const std::string &name);
+  void keepInMemory(const std::string &name);
+  Workspace_sptr accessed(const std::string &name, Workspace_sptr workspace);
+  size_t enforceBudget(const std::string &keep = "");
+  bool save(const std::string &name);
+
+private:
+  /// What is known about a workspace in the service
+  struct Usage {
+    /// The workspace the size was found for
+    const Workspace *workspace{nullptr};
+    size_t bytes{0};
+    /// When the workspace was last used
+    uint64_t lastUsed{0};
+    /// Never save the workspace
+    bool keepInMemory{false};
+  };
+
+  Workspace_sptr restore(const std::string &name);
+  bool isKeptInMemory(const std::string &name) const;
+  void touch(const std::string &name);
+
+  AnalysisDataServiceImpl &m_ads;
+  std::atomic<size_t> m_budget{0};
+  std::string m_scratchDirectory;
+  /// Held while workspaces are saved or restored
+  std::recursive_mutex m_mutex;
+  /// Guards the usage, which is updated whenever a workspace is retrieved
+  mutable std::mutex m_usageMutex;
+  std::map<std::string, Usage, Kernel::CaseInsensitiveCmp> m_usage;
+  uint64_t m_clock{0};
+  bool m_enforcing{false};
+};
+
+} // namespace API
+} // namespace Mantid
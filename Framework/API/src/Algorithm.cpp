@@ -681,11 +681,13 @@ bool Algorithm::executeInternal() {
       // method
       algIsExecuted = true;
 
-      // Log that execution has completed.
-      getLogger().debug("Time to validate properties: " + std::to_string(timingPropertyValidation) + " seconds\n" +
-                        "Time for other input validation: " + std::to_string(timingInputValidation) + " seconds\n" +
-                        "Time for other initialization: " + std::to_string(timingInit) + " seconds\n" +
-                        "Time to run exec: " + std::to_string(timingExec) + " seconds\n");
+      // Log that execution has completed. Only build the message if it will be
+      // shown, child algorithms are run many times.
+      if (getLogger().isDebug())
+        getLogger().debug("Time to validate properties: " + std::to_string(timingPropertyValidation) + " seconds\n" +
+                          "Time for other input validation: " + std::to_string(timingInputValidation) + " seconds\n" +
+                          "Time for other initialization: " + std::to_string(timingInit) + " seconds\n" +
+                          "Time to run exec: " + std::to_string(timingExec) + " seconds\n");
       reportCompleted(duration);
     } catch (std::runtime_error &ex) {
       m_gcTime = Mantid::Types::Core::DateAndTime::getCurrentTime() +=
@@ -891,8 +893,16 @@ void Algorithm::setupAsChildAlgorithm(const Algorithm_sptr &alg, const double st
   // It will be used this to pass on cancellation requests
   // It must be protected by a critical block so that Child Algorithms can run
   // in parallel safely.
+  // Children that no longer exist are dropped before the vector would grow, so
+  // that a parent running many short-lived children does not keep a growing list.
   std::weak_ptr<IAlgorithm> weakPtr(alg);
-  PARALLEL_CRITICAL(Algorithm_StoreWeakPtr) { m_ChildAlgorithms.emplace_back(weakPtr); }
+  PARALLEL_CRITICAL(Algorithm_StoreWeakPtr) {
+    if (m_ChildAlgorithms.size() == m_ChildAlgorithms.capacity())
+      m_ChildAlgorithms.erase(std::remove_if(m_ChildAlgorithms.begin(), m_ChildAlgorithms.end(),
+                                             [](const auto &child) { return child.expired(); }),
+                              m_ChildAlgorithms.end());
+    m_ChildAlgorithms.emplace_back(weakPtr);
+  }
 }
 
 //=============================================================================================
@@ -1719,7 +1729,7 @@ void Algorithm::reportCompleted(const double &duration, const bool groupProcessi
     }
   }
 
-  else {
+  else if (getLogger().isDebug()) {
     getLogger().debug() << name() << " finished with isChild = " << isChild() << '\n';
   }
   setExecutionState(ExecutionState::Finished);
@@ -0,0 +1,317 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/AlgorithmGraph.h"
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Task.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace Mantid::API {
+
+namespace {
+/// static logger
+Kernel::Logger g_log("AlgorithmGraph");
+
+bool intersects(const std::set<std::string> &a, const std::set<std::string> &b) {
+  return std::any_of(a.cbegin(), a.cend(), [&b](const auto &name) { return b.count(name) > 0; });
+}
+} // namespace
+
+/// Runs one algorithm of the graph on a thread of the pool
+class AlgorithmGraph::NodeTask final : public Kernel::Task {
+public:
+  NodeTask(AlgorithmGraph &graph, Node node, int cores)
+      : Kernel::Task(static_cast<double>(cores)), m_graph(graph), m_node(node), m_cores(cores) {}
+
+  void run() override { m_graph.runNode(m_node, m_cores); }
+
+private:
+  AlgorithmGraph &m_graph;
+  const Node m_node;
+  const int m_cores;
+};
+
+/**
+ * Hands out the algorithms of the graph that are ready to run. The queue is
+ * only empty once no algorithm is waiting any more. Until then, threads that
+ * find no algorithm they can run wait for the running ones to finish.
+ */
+class AlgorithmGraph::Scheduler final : public Kernel::ThreadScheduler {
+public:
+  explicit Scheduler(AlgorithmGraph &graph) : m_graph(graph) {}
+
+  void push(std::shared_ptr<Kernel::Task> newTask) override {
+    UNUSED_ARG(newTask);
+    throw std::logic_error("AlgorithmGraph::Scheduler - tasks are created from the nodes of the graph");
+  }
+
+  std::shared_ptr<Kernel::Task> pop(size_t threadnum) override {
+    UNUSED_ARG(threadnum);
+    std::lock_guard<std::mutex> lock(m_graph.m_mutex);
+    for (Node i = 0; i < m_graph.m_nodes.size(); ++i) {
+      auto &node = m_graph.m_nodes[i];
+      if (node.state != NodeState::Waiting || !m_graph.isReady(node))
+        continue;
+      // An algorithm asking for more cores than the budget runs on its own
+      const int cores = std::min(node.cores, m_graph.m_coreBudget);
+      if (m_graph.m_coresInUse + cores > m_graph.m_coreBudget)
+        continue;
+      node.state = NodeState::Running;
+      m_graph.m_coresInUse += cores;
+      return std::make_shared<NodeTask>(m_graph, i, cores);
+    }
+    return nullptr;
+  }
+
+  size_t size() override {
+    std::lock_guard<std::mutex> lock(m_graph.m_mutex);
+    return std::count_if(m_graph.m_nodes.cbegin(), m_graph.m_nodes.cend(),
+                         [](const auto &node) { return node.state == NodeState::Waiting; });
+  }
+
+  bool empty() override { return size() == 0; }
+
+  void clear() override { m_graph.cancel(); }
+
+private:
+  AlgorithmGraph &m_graph;
+};
+
+/**
+ * Add an algorithm to the graph. It depends on the algorithms added before it
+ * that write a workspace it reads, or read or write a workspace it writes.
+ * @param algorithm :: The algorithm, initialized if it is not already.
+ * @param properties :: Property values set just before the algorithm is run.
+ * Input workspaces that do not exist yet can only be given here.
+ * @param cores :: The number of cores the algorithm may use.
+ * @return :: The node of the algorithm.
+ * @throw std::invalid_argument if the algorithm has no property of one of the
+ * given names.
+ */
+AlgorithmGraph::Node AlgorithmGraph::addAlgorithm(const IAlgorithm_sptr &algorithm,
+                                                  const std::map<std::string, std::string> &properties, int cores) {
+  if (!algorithm)
+    throw std::invalid_argument("AlgorithmGraph::addAlgorithm() - the algorithm is null");
+  if (cores < 1)
+    throw std::invalid_argument("AlgorithmGraph::addAlgorithm() - an algorithm needs at least one core");
+  if (!algorithm->isInitialized())
+    algorithm->initialize();
+  for (const auto &property : properties) {
+    if (!algorithm->existsProperty(property.first))
+      throw std::invalid_argument("AlgorithmGraph::addAlgorithm() - " + algorithm->name() + " has no property " +
+                                  property.first);
+  }
+
+  NodeData node{algorithm, properties, cores, {}, {}, {}, NodeState::Waiting, {}};
+  for (const auto *property : algorithm->getProperties()) {
+    if (!dynamic_cast<const IWorkspaceProperty *>(property))
+      continue;
+    // Property names are not case sensitive
+    const auto value = std::find_if(properties.cbegin(), properties.cend(), [property](const auto &given) {
+      return boost::iequals(given.first, property->name());
+    });
+    const auto name = value != properties.cend() ? value->second : property->value();
+    if (name.empty())
+      continue;
+    if (property->direction() != Kernel::Direction::Output)
+      node.reads.insert(name);
+    if (property->direction() != Kernel::Direction::Input)
+      node.writes.insert(name);
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_executing)
+    throw std::runtime_error("AlgorithmGraph::addAlgorithm() - the graph is executing");
+  for (Node other = 0; other < m_nodes.size(); ++other) {
+    const auto &earlier = m_nodes[other];
+    if (intersects(node.reads, earlier.writes) || intersects(node.writes, earlier.reads) ||
+        intersects(node.writes, earlier.writes))
+      node.dependencies.insert(other);
+  }
+  m_nodes.emplace_back(std::move(node));
+  return m_nodes.size() - 1;
+}
+
+/**
+ * Make an algorithm wait for another one, e.g. if it uses a file the other one
+ * writes. Only algorithms added earlier can be waited for, so that the graph
+ * has no cycles.
+ * @param before :: The algorithm to wait for.
+ * @param after :: The algorithm that waits.
+ */
+void AlgorithmGraph::addDependency(Node before, Node after) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (after >= m_nodes.size())
+    throw std::out_of_range("AlgorithmGraph::addDependency() - node index out of range");
+  if (before >= after)
+    throw std::invalid_argument("AlgorithmGraph::addDependency() - an algorithm can only depend on the algorithms "
+                                "added before it");
+  if (m_executing)
+    throw std::runtime_error("AlgorithmGraph::addDependency() - the graph is executing");
+  m_nodes[after].dependencies.insert(before);
+}
+
+size_t AlgorithmGraph::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_nodes.size();
+}
+
+/// The algorithm of a node
+IAlgorithm_sptr AlgorithmGraph::algorithm(Node node) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return nodeData(node).algorithm;
+}
+
+/// The nodes a node waits for
+std::vector<AlgorithmGraph::Node> AlgorithmGraph::dependencies(Node node) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto &dependencies = nodeData(node).dependencies;
+  return std::vector<Node>(dependencies.cbegin(), dependencies.cend());
+}
+
+/// The execution state of a node
+AlgorithmGraph::NodeState AlgorithmGraph::state(Node node) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return nodeData(node).state;
+}
+
+/**
+ * Run the algorithms of the graph, and wait for them to finish.
+ * @param cores :: The number of cores shared by the running algorithms, by
+ * default the number of cores of the machine.
+ * @return :: True if all algorithms finished, false if the graph was cancelled.
+ * @throw std::runtime_error listing the algorithms that failed, if any.
+ */
+bool AlgorithmGraph::execute(int cores) {
+  size_t numThreads(0);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_executing)
+      throw std::runtime_error("AlgorithmGraph::execute() - the graph is already executing");
+    m_executing = true;
+    m_coreBudget = cores > 0 ? cores : static_cast<int>(Kernel::ThreadPool::getNumPhysicalCores());
+    m_coresInUse = 0;
+    for (auto &node : m_nodes) {
+      node.state = NodeState::Waiting;
+      node.error.clear();
+    }
+    // Every algorithm uses at least one core
+    numThreads = std::min(m_nodes.size(), static_cast<size_t>(m_coreBudget));
+  }
+
+  if (numThreads > 0) {
+    // The algorithms catch their own exceptions, so the pool does not throw
+    Kernel::ThreadPool pool(new Scheduler(*this), numThreads);
+    pool.joinAll();
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_executing = false;
+  std::ostringstream failures;
+  for (const auto &node : m_nodes) {
+    if (node.state == NodeState::Failed)
+      failures << "\n  " << node.algorithm->name() << ": " << node.error;
+  }
+  if (!failures.str().empty())
+    throw std::runtime_error("AlgorithmGraph::execute() - algorithms failed:" + failures.str());
+  return std::all_of(m_nodes.cbegin(), m_nodes.cend(),
+                     [](const auto &node) { return node.state == NodeState::Finished; });
+}
+
+/**
+ * Cancel the running algorithms. Those that have not started are not run.
+ */
+void AlgorithmGraph::cancel() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto &node : m_nodes) {
+    if (node.state == NodeState::Waiting)
+      node.state = NodeState::Cancelled;
+    else if (node.state == NodeState::Running)
+      node.algorithm->cancel();
+  }
+}
+
+const AlgorithmGraph::NodeData &AlgorithmGraph::nodeData(Node node) const {
+  if (node >= m_nodes.size())
+    throw std::out_of_range("AlgorithmGraph - node index out of range");
+  return m_nodes[node];
+}
+
+/// True if all the dependencies of the node have finished
+bool AlgorithmGraph::isReady(const NodeData &node) const {
+  return std::all_of(node.dependencies.cbegin(), node.dependencies.cend(),
+                     [this](const auto dependency) { return m_nodes[dependency].state == NodeState::Finished; });
+}
+
+/**
+ * Run the algorithm of a node on the calling thread.
+ * @param node :: The node, set to running by the scheduler.
+ * @param cores :: The cores the algorithm may use.
+ */
+void AlgorithmGraph::runNode(Node node, int cores) {
+  // Nodes are neither added nor removed while the graph is executing
+  const auto &algorithm = m_nodes[node].algorithm;
+  PARALLEL_SET_NUM_THREADS(cores)
+
+  auto state = NodeState::Finished;
+  std::string error;
+  try {
+    for (const auto &property : m_nodes[node].properties)
+      algorithm->setPropertyValue(property.first, property.second);
+    algorithm->setRethrows(true);
+    if (!algorithm->execute()) {
+      state = NodeState::Failed;
+      error = "the algorithm did not execute";
+    }
+  } catch (Algorithm::CancelException &) {
+    state = NodeState::Cancelled;
+  } catch (std::exception &ex) {
+    state = NodeState::Failed;
+    error = ex.what();
+  } catch (...) {
+    state = NodeState::Failed;
+    error = "unknown exception";
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_coresInUse -= cores;
+  auto &data = m_nodes[node];
+  data.state = state;
+  data.error = error;
+  if (state != NodeState::Finished)
+    cancelDependents(node);
+}
+
+/// Cancel the algorithms that wait for a node that failed or was cancelled.
+/// Call this holding the lock.
+void AlgorithmGraph::cancelDependents(Node node) {
+  // Algorithms only depend on those added before them
+  for (Node i = node + 1; i < m_nodes.size(); ++i) {
+    auto &dependent = m_nodes[i];
+    if (dependent.state != NodeState::Waiting)
+      continue;
+    if (std::any_of(dependent.dependencies.cbegin(), dependent.dependencies.cend(), [this](const auto dependency) {
+          const auto state = m_nodes[dependency].state;
+          return state == NodeState::Failed || state == NodeState::Cancelled;
+        })) {
+      dependent.state = NodeState::Cancelled;
+      g_log.information() << dependent.algorithm->name() << " will not be run, an algorithm it depends on did not "
+                          << "finish\n";
+    }
+  }
+}
+
+} // namespace Mantid::API
@@ -9,6 +9,7 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/AlgorithmHistory.h"
 #include "MantidAPI/Algorithm.h"
+#include "MantidKernel/ArrayProperty.h"
 
 #if BOOST_VERSION == 106900
 #ifndef BOOST_PENDING_INTEGER_LOG2_HPP
@@ -23,6 +24,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <mutex>
 #include <sstream>
 #include <utility>
 
@@ -38,8 +40,43 @@ using Types::Core::DateAndTime;
 namespace {
 /// The generator for algorithm history UUIDs
 static boost::uuids::random_generator uuidGen;
+
+/// True if the property is an ArrayProperty of one of the given types
+template <typename... T> bool isArrayPropertyOf(const Property *property) {
+  return (... || (dynamic_cast<const Kernel::ArrayProperty<T> *>(property) != nullptr));
+}
+
+/**
+ * Formatting the value of a long array for the history is far more expensive
+ * than copying it, and most histories are never looked at. These properties
+ * own their values, so a copy is an immutable snapshot. Other properties, e.g.
+ * workspace properties, would keep the objects they point to alive.
+ */
+bool deferHistory(const Property *property) {
+  return isArrayPropertyOf<int32_t, uint32_t, int64_t, uint64_t, float, double, std::string>(property);
+}
 } // namespace
 
+/// The property values of an executed algorithm, of which the histories are
+/// created by the first call to materialize()
+struct AlgorithmHistory::PropertySnapshot {
+  /// Copies of the deferred properties, null for those already in histories
+  std::vector<std::unique_ptr<Property>> copies;
+  PropertyHistories histories;
+  std::once_flag materialized;
+
+  const PropertyHistories &materialize() {
+    std::call_once(materialized, [this]() {
+      for (size_t i = 0; i < copies.size(); ++i) {
+        if (copies[i])
+          histories[i] = std::make_shared<PropertyHistory>(copies[i]->createHistory());
+      }
+      copies.clear();
+    });
+    return histories;
+  }
+};
+
 /** Constructor
  *  @param alg ::      A pointer to the algorithm for which the history should
  * be constructed
@@ -86,11 +123,31 @@ AlgorithmHistory::AlgorithmHistory(std::string name, int vers, std::string uuid,
 void AlgorithmHistory::setProperties(const Algorithm *const alg) {
   // overwrite any existing properties
   m_properties.clear();
+  m_snapshot.reset();
   // Now go through the algorithm's properties and create the PropertyHistory
-  // objects.
+  // objects, or copy the property if that can be left until it is needed.
   const std::vector<Property *> &properties = alg->getProperties();
-  std::transform(properties.cbegin(), properties.cend(), std::back_inserter(m_properties),
-                 [](const auto &property) { return std::make_shared<PropertyHistory>(property->createHistory()); });
+  auto snapshot = std::make_shared<PropertySnapshot>();
+  snapshot->copies.resize(properties.size());
+  snapshot->histories.resize(properties.size());
+  bool deferred(false);
+  for (size_t i = 0; i < properties.size(); ++i) {
+    if (deferHistory(properties[i])) {
+      snapshot->copies[i].reset(properties[i]->clone());
+      deferred = true;
+    } else {
+      snapshot->histories[i] = std::make_shared<PropertyHistory>(properties[i]->createHistory());
+    }
+  }
+  if (deferred)
+    m_snapshot = std::move(snapshot);
+  else
+    m_properties = std::move(snapshot->histories);
+}
+
+/// Get the parameter list of the algorithm, creating any deferred histories
+const PropertyHistories &AlgorithmHistory::getProperties() const {
+  return m_snapshot ? m_snapshot->materialize() : m_properties;
 }
 
 /**
@@ -129,6 +186,10 @@ void AlgorithmHistory::addExecutionInfo(const DateAndTime &start, const double &
  */
 void AlgorithmHistory::addProperty(const std::string &name, const std::string &value, bool isdefault,
                                    const unsigned int &direction) {
+  if (m_snapshot) {
+    m_properties = m_snapshot->materialize();
+    m_snapshot.reset();
+  }
   m_properties.emplace_back(std::make_shared<PropertyHistory>(name, value, "", isdefault, direction));
 }
 
@@ -177,9 +238,10 @@ AlgorithmHistory_sptr AlgorithmHistory::operator[](const size_t index) const { r
  * @throw Exception::NotFoundError if the named property is unknown
  */
 const std::string &AlgorithmHistory::getPropertyValue(const std::string &name) const {
-  const auto found = std::find_if(m_properties.cbegin(), m_properties.cend(),
+  const auto &properties = getProperties();
+  const auto found = std::find_if(properties.cbegin(), properties.cend(),
                                   [&name](const auto &history) { return history->name() == name; });
-  if (found == m_properties.cend()) {
+  if (found == properties.cend()) {
     throw Kernel::Exception::NotFoundError("Could not find the specified property", name);
   }
   return (*found)->value();
@@ -212,7 +274,7 @@ void AlgorithmHistory::printSelf(std::ostream &os, const int indent, const size_
   os << std::string(indent, ' ') << "UUID: " << m_uuid << '\n';
   os << std::string(indent, ' ') << "Parameters:\n";
 
-  for (const auto &property : m_properties) {
+  for (const auto &property : getProperties()) {
     property->printSelf(os, indent + 2, maxPropertyLength);
   }
 }
@@ -234,6 +296,7 @@ AlgorithmHistory &AlgorithmHistory::operator=(const AlgorithmHistory &A) {
     m_executionDate = A.m_executionDate;
     m_executionDuration = A.m_executionDuration;
     m_properties = A.m_properties;
+    m_snapshot = A.m_snapshot;
     // required to prevent destruction of descendant if assigning a descendant
     // to an ancestor
     auto temp = A.m_childHistories;
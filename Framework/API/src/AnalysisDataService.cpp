@@ -6,6 +6,8 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/WorkspaceGroup.h"
+#include "MantidAPI/WorkspaceMemoryManager.h"
+#include <algorithm>
 #include <iterator>
 #include <random>
 #include <sstream>
@@ -71,27 +73,34 @@ void AnalysisDataServiceImpl::add(const std::string &name, const std::shared_ptr
   // Attach the name to the workspace
   if (workspace)
     workspace->setName(name);
-  Kernel::DataService<API::Workspace>::add(name, workspace);
-
-  // if a group is added add its members as well
-  if (!group)
+  if (!group) {
+    Kernel::DataService<API::Workspace>::add(name, workspace);
+    keepWithinMemoryBudget(name);
     return;
+  }
+
+  Kernel::DataService<API::Workspace>::add(name, workspace);
 
+  // if a group is added add its members as well, in one go
   group->observeADSNotifications(true);
-  for (size_t i = 0; i < group->size(); ++i) {
-    auto ws = group->getItem(i);
-    std::string wsName = ws->getName();
-    // if anonymous make up a name and add
-    if (wsName.empty()) {
-      wsName = name + "_" + std::to_string(i + 1);
-    } else if (doesExist(wsName)) { // if ws is already there do nothing
-      wsName.clear();
-    }
-    // add member workspace if needed
-    if (!wsName.empty()) {
-      add(wsName, ws);
-    }
+  Members members;
+  NameSet names{name};
+  collectMembersToAdd(name, group, names, members);
+  // the members before a name made up for an anonymous member that is taken
+  // are added, as if they were added one by one
+  const auto taken = std::find_if(members.begin(), members.end(),
+                                  [this](const auto &member) { return doesExist(member.first); });
+  if (taken != members.end()) {
+    taken->second->setName(taken->first);
+    const std::string error = " add : Unable to insert Data Object : '" + taken->first + "'";
+    members.erase(taken, members.end());
+    attachMemberNames(members);
+    addOrReplaceMany(members);
+    throw std::runtime_error(error);
   }
+  attachMemberNames(members);
+  addOrReplaceMany(members);
+  keepWithinMemoryBudget(name);
 }
 
 /**
@@ -109,25 +118,20 @@ void AnalysisDataServiceImpl::addOrReplace(const std::string &name, const std::s
   // Attach the name to the workspace
   if (workspace)
     workspace->setName(name);
-  Kernel::DataService<API::Workspace>::addOrReplace(name, workspace);
-
-  if (!group)
+  if (!group) {
+    Kernel::DataService<API::Workspace>::addOrReplace(name, workspace);
+    keepWithinMemoryBudget(name);
     return;
-  group->observeADSNotifications(true);
-  for (size_t i = 0; i < group->size(); ++i) {
-    auto ws = group->getItem(i);
-    std::string wsName = ws->getName();
-    // make up a name for an anonymous workspace
-    if (wsName.empty()) {
-      wsName = name + "_" + std::to_string(i + 1);
-    } else if (doesExist(wsName)) { // if ws is already there do nothing
-      wsName.clear();
-    }
-    // add member workspace if needed
-    if (!wsName.empty()) {
-      addOrReplace(wsName, ws);
-    }
   }
+
+  // the group and its members are added or replaced in one go
+  Members members{{name, workspace}};
+  NameSet names{name};
+  collectMembersToAdd(name, group, names, members);
+  group->observeADSNotifications(true);
+  attachMemberNames(members);
+  addOrReplaceMany(members);
+  keepWithinMemoryBudget(name);
 }
 
 /**
@@ -159,7 +163,8 @@ void AnalysisDataServiceImpl::rename(const std::string &oldName, const std::stri
 Workspace_sptr AnalysisDataServiceImpl::remove(const std::string &name) {
   Workspace_sptr ws;
   try {
-    ws = retrieve(name);
+    // a workspace saved to free memory is not loaded back to be removed
+    ws = Kernel::DataService<API::Workspace>::retrieve(name);
   } catch (const Kernel::Exception::NotFoundError &) {
     // do nothing - remove will do what's needed
   }
@@ -170,6 +175,20 @@ Workspace_sptr AnalysisDataServiceImpl::remove(const std::string &name) {
   return ws;
 }
 
+/**
+ * Overridden retrieve member to load back a workspace that was saved to a
+ * scratch file to keep within the memory budget.
+ * @param name The name of the workspace
+ * @return The workspace
+ * @throw Kernel::Exception::NotFoundError if the name cannot be found
+ */
+Workspace_sptr AnalysisDataServiceImpl::retrieve(const std::string &name) const {
+  auto workspace = Kernel::DataService<API::Workspace>::retrieve(name);
+  if (!m_memoryManager->active())
+    return workspace;
+  return m_memoryManager->accessed(name, std::move(workspace));
+}
+
 /**
  * @brief random lowercase letter used for generating workspace name in
  * unique_name and unique_hidden_name
@@ -224,6 +243,8 @@ const std::string AnalysisDataServiceImpl::uniqueHiddenName() { return AnalysisD
  * @param names A list of names of workspaces, if any does not exist then
  * a Kernel::Exception::NotFoundError is thrown.
  * @param unrollGroups If true flatten groups into the list of members.
+ * Workspaces saved to free memory are loaded back, use topLevelItems() or
+ * getObjects() to list the workspaces without loading them.
  * @return A vector of pointers to Workspaces
  * @throws std::invalid_argument if no names are provided
  * @throws Mantid::Kernel::Exception::NotFoundError if a workspace does not
@@ -273,7 +294,7 @@ void AnalysisDataServiceImpl::sortGroupByName(const std::string &groupName) {
     throw std::runtime_error("Workspace " + groupName + " is not a workspace group.");
   }
   group->sortMembersByName();
-  notificationCenter.postNotification(new GroupUpdatedNotification(groupName));
+  postNotification(new GroupUpdatedNotification(groupName));
 }
 
 /**
@@ -293,7 +314,7 @@ void AnalysisDataServiceImpl::addToGroup(const std::string &groupName, const std
 
   auto ws = retrieve(wsName);
   group->addWorkspace(ws);
-  notificationCenter.postNotification(new GroupUpdatedNotification(groupName));
+  postNotification(new GroupUpdatedNotification(groupName));
 }
 
 /**
@@ -305,18 +326,18 @@ void AnalysisDataServiceImpl::deepRemoveGroup(const std::string &name) {
   if (!group) {
     throw std::runtime_error("Workspace " + name + " is not a workspace group.");
   }
-  group->observeADSNotifications(false);
-  for (size_t i = 0; i < group->size(); ++i) {
-    auto ws = group->getItem(i);
-    WorkspaceGroup_sptr gws = std::dynamic_pointer_cast<WorkspaceGroup>(ws);
-    if (gws) {
-      // if a member is a group remove its items as well
-      deepRemoveGroup(gws->getName());
-    } else {
-      remove(ws->getName());
-    }
+  // the group and its members are removed in one go
+  std::vector<Workspace_sptr> workspaces;
+  collectMembersToRemove(group, workspaces);
+  workspaces.emplace_back(group);
+  std::vector<std::string> names;
+  names.reserve(workspaces.size());
+  std::transform(workspaces.cbegin(), workspaces.cend(), std::back_inserter(names),
+                 [](const auto &ws) { return ws->getName(); });
+  removeMany(names);
+  for (const auto &ws : workspaces) {
+    ws->setName("");
   }
-  remove(name);
 }
 
 /**
@@ -334,12 +355,14 @@ void AnalysisDataServiceImpl::removeFromGroup(const std::string &groupName, cons
     throw std::runtime_error("WorkspaceGroup " + groupName + " does not containt workspace " + wsName);
   }
   group->removeByADS(wsName);
-  notificationCenter.postNotification(new GroupUpdatedNotification(groupName));
+  postNotification(new GroupUpdatedNotification(groupName));
 }
 
 /**
  * Produces a map of names to Workspaces that doesn't include
- * items that are part of a WorkspaceGroup already in the list
+ * items that are part of a WorkspaceGroup already in the list. Workspaces
+ * saved to free memory are listed by their placeholders, with the id
+ * "SavedWorkspace", and are not loaded back.
  * @return A lookup of name to Workspace pointer
  */
 std::map<std::string, Workspace_sptr> AnalysisDataServiceImpl::topLevelItems() const {
@@ -350,7 +373,7 @@ std::map<std::string, Workspace_sptr> AnalysisDataServiceImpl::topLevelItems() c
   for (const auto &topLevelName : topLevelNames) {
     try {
       const std::string &name = topLevelName;
-      auto ws = this->retrieve(topLevelName);
+      auto ws = Kernel::DataService<API::Workspace>::retrieve(topLevelName);
       topLevel.emplace(name, ws);
       if (auto group = std::dynamic_pointer_cast<WorkspaceGroup>(ws)) {
         group->reportMembers(groupMembers);
@@ -374,6 +397,39 @@ std::map<std::string, Workspace_sptr> AnalysisDataServiceImpl::topLevelItems() c
 
 void AnalysisDataServiceImpl::shutdown() { clear(); }
 
+/**
+ * Set the memory the workspaces may use. Beyond it the least recently used
+ * workspaces held only by the ADS are saved to scratch files, and loaded back
+ * when they are retrieved.
+ * @param bytes :: The budget in bytes, 0 for no limit
+ */
+void AnalysisDataServiceImpl::setMemoryBudget(size_t bytes) {
+  m_memoryManager->setBudget(bytes);
+  m_memoryManager->enforceBudget();
+}
+
+/// @return The memory the workspaces may use in bytes, 0 if there is no limit
+size_t AnalysisDataServiceImpl::memoryBudget() const { return m_memoryManager->budget(); }
+
+/// @return The memory used by the workspaces in bytes, as given by
+/// Workspace::getMemorySize()
+size_t AnalysisDataServiceImpl::memoryUsage() { return m_memoryManager->memoryUsage(); }
+
+/// @return The object keeping the workspaces within the memory budget
+WorkspaceMemoryManager &AnalysisDataServiceImpl::memoryManager() { return *m_memoryManager; }
+
+/**
+ * Save the least recently used workspaces if a workspace added or replaced
+ * takes the memory over the budget.
+ * @param name :: The name of the workspace added or replaced, which is kept
+ */
+void AnalysisDataServiceImpl::keepWithinMemoryBudget(const std::string &name) {
+  if (!m_memoryManager->active())
+    return;
+  m_memoryManager->added(name);
+  m_memoryManager->enforceBudget(name);
+}
+
 //-------------------------------------------------------------------------
 // Private methods
 //-------------------------------------------------------------------------
@@ -382,7 +438,10 @@ void AnalysisDataServiceImpl::shutdown() { clear(); }
  * Constructor
  */
 AnalysisDataServiceImpl::AnalysisDataServiceImpl()
-    : Mantid::Kernel::DataService<Mantid::API::Workspace>("AnalysisDataService"), m_illegalChars() {}
+    : Mantid::Kernel::DataService<Mantid::API::Workspace>("AnalysisDataService"), m_illegalChars(),
+      m_memoryManager(std::make_unique<WorkspaceMemoryManager>(*this)) {}
+
+AnalysisDataServiceImpl::~AnalysisDataServiceImpl() = default;
 
 // The following is commented using /// rather than /** to stop the compiler
 // complaining
@@ -403,6 +462,68 @@ void AnalysisDataServiceImpl::setIllegalCharacterList(const std::string &illegal
   m_illegalChars = illegalChars;
 }
 
+/**
+ * Find the members of a group, and of the groups in it, that are not in the
+ * ADS yet. Anonymous members are named after the group.
+ * @param name The name the group is added with
+ * @param group The group
+ * @param names The names found so far, which are not added twice
+ * @param members Appended with the names and members to add
+ */
+void AnalysisDataServiceImpl::collectMembersToAdd(const std::string &name, const WorkspaceGroup_sptr &group,
+                                                  NameSet &names, Members &members) {
+  for (size_t i = 0; i < group->size(); ++i) {
+    auto ws = group->getItem(i);
+    std::string wsName = ws->getName();
+    // if anonymous make up a name and add
+    if (wsName.empty()) {
+      wsName = name + "_" + std::to_string(i + 1);
+    } else if (doesExist(wsName) || names.count(wsName) > 0) { // if ws is already there do nothing
+      continue;
+    }
+    auto memberGroup = std::dynamic_pointer_cast<WorkspaceGroup>(ws);
+    verifyName(wsName, memberGroup);
+    names.emplace(wsName);
+    members.emplace_back(wsName, ws);
+    if (memberGroup) {
+      collectMembersToAdd(wsName, memberGroup, names, members);
+    }
+  }
+}
+
+/**
+ * Attach the names to the workspaces about to be added, and make the groups
+ * among them observe the ADS.
+ * @param members The names and workspaces
+ */
+void AnalysisDataServiceImpl::attachMemberNames(const Members &members) {
+  for (const auto &member : members) {
+    member.second->setName(member.first);
+    if (auto memberGroup = std::dynamic_pointer_cast<WorkspaceGroup>(member.second)) {
+      memberGroup->observeADSNotifications(true);
+    }
+  }
+}
+
+/**
+ * Find the members of a group, and of the groups in it, and stop the groups
+ * observing the ADS. Members of a nested group come before the group.
+ * @param group The group
+ * @param workspaces Appended with the members
+ */
+void AnalysisDataServiceImpl::collectMembersToRemove(const WorkspaceGroup_sptr &group,
+                                                     std::vector<Workspace_sptr> &workspaces) {
+  group->observeADSNotifications(false);
+  for (size_t i = 0; i < group->size(); ++i) {
+    auto ws = group->getItem(i);
+    if (auto gws = std::dynamic_pointer_cast<WorkspaceGroup>(ws)) {
+      // if a member is a group remove its items as well
+      collectMembersToRemove(gws, workspaces);
+    }
+    workspaces.emplace_back(std::move(ws));
+  }
+}
+
 /**
  * Checks the name is valid
  * @param name A string containing the name to check. If the name is invalid a
@@ -0,0 +1,699 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/CompiledExpression.h"
+#include "MantidAPI/Jacobian.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Mantid::API {
+
+namespace {
+/// Number of values processed by each instruction at a time
+constexpr size_t BLOCK_SIZE = 256;
+constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+/// A run-time operand: either a block of values or a single value
+struct Operand {
+  const double *data;
+  double value;
+};
+
+template <typename F> void binary(F f, const Operand &a, const Operand &b, double *out, const size_t n) {
+  if (a.data && b.data) {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = f(a.data[i], b.data[i]);
+  } else if (a.data) {
+    const double bValue = b.value;
+    for (size_t i = 0; i < n; ++i)
+      out[i] = f(a.data[i], bValue);
+  } else {
+    const double aValue = a.value;
+    for (size_t i = 0; i < n; ++i)
+      out[i] = f(aValue, b.data[i]);
+  }
+}
+
+template <typename F> void unary(F f, const double *a, double *out, const size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = f(a[i]);
+}
+
+uint64_t bits(double value) {
+  uint64_t result;
+  std::memcpy(&result, &value, sizeof(result));
+  return result;
+}
+} // namespace
+
+/** Recursive descent parser creating the graph of a formula:
+ *   sum     := product (('+' | '-') product)*
+ *   product := unary (('*' | '/') unary)*
+ *   unary   := ('-' | '+') unary | power
+ *   power   := primary ('^' unary)?
+ *   primary := number | name | name '(' sum ')' | '(' sum ')'
+ * As in muParser, unary minus binds more weakly than '^': -x^2 == -(x^2).
+ */
+class CompiledExpression::Parser {
+public:
+  Parser(CompiledExpression &graph, const std::string &formula, const std::string &arrayVariable,
+         const std::vector<std::string> &scalarVariables)
+      : m_graph(graph), m_formula(formula), m_arrayVariable(arrayVariable), m_scalarVariables(scalarVariables) {}
+
+  size_t parse() {
+    const auto result = sum();
+    if (peek() != '\0')
+      fail("unexpected character");
+    return result;
+  }
+
+private:
+  char peek() {
+    while (m_position < m_formula.size() && std::isspace(static_cast<unsigned char>(m_formula[m_position])))
+      ++m_position;
+    return m_position < m_formula.size() ? m_formula[m_position] : '\0';
+  }
+  bool accept(char c) {
+    if (peek() != c)
+      return false;
+    ++m_position;
+    return true;
+  }
+  [[noreturn]] void fail(const std::string &message) const {
+    throw std::invalid_argument("CompiledExpression: " + message + " at position " + std::to_string(m_position) +
+                                " in " + m_formula);
+  }
+
+  size_t sum() {
+    auto result = product();
+    for (;;) {
+      if (accept('+'))
+        result = m_graph.node(Op::Add, result, product());
+      else if (accept('-'))
+        result = m_graph.node(Op::Subtract, result, product());
+      else
+        return result;
+    }
+  }
+  size_t product() {
+    auto result = unary();
+    for (;;) {
+      if (accept('*'))
+        result = m_graph.node(Op::Multiply, result, unary());
+      else if (accept('/'))
+        result = m_graph.node(Op::Divide, result, unary());
+      else
+        return result;
+    }
+  }
+  size_t unary() {
+    if (accept('-'))
+      return m_graph.node(Op::Negate, unary());
+    if (accept('+'))
+      return unary();
+    return power();
+  }
+  size_t power() {
+    const auto base = primary();
+    if (!accept('^'))
+      return base;
+    return m_graph.node(Op::Power, base, unary());
+  }
+  size_t primary() {
+    if (accept('(')) {
+      const auto result = sum();
+      if (!accept(')'))
+        fail("expected )");
+      return result;
+    }
+    const char c = peek();
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+      return number();
+    if (!std::isalpha(static_cast<unsigned char>(c)) && c != '_')
+      fail("unexpected character");
+    const auto start = m_position;
+    while (m_position < m_formula.size() &&
+           (std::isalnum(static_cast<unsigned char>(m_formula[m_position])) || m_formula[m_position] == '_'))
+      ++m_position;
+    const auto name = m_formula.substr(start, m_position - start);
+    if (accept('('))
+      return function(name);
+    return variable(name);
+  }
+  size_t number() {
+    const char *start = m_formula.c_str() + m_position;
+    char *end = nullptr;
+    const double value = std::strtod(start, &end);
+    if (end == start)
+      fail("invalid number");
+    m_position += static_cast<size_t>(end - start);
+    return m_graph.constant(value);
+  }
+  size_t function(const std::string &name) {
+    static const std::map<std::string, Op> functions{
+        {"sin", Op::Sin},   {"cos", Op::Cos},   {"tan", Op::Tan},     {"asin", Op::Asin}, {"acos", Op::Acos},
+        {"atan", Op::Atan}, {"sinh", Op::Sinh}, {"cosh", Op::Cosh},   {"tanh", Op::Tanh}, {"exp", Op::Exp},
+        {"log", Op::Ln},    {"ln", Op::Ln},     {"log10", Op::Log10}, {"log2", Op::Log2}, {"sqrt", Op::Sqrt},
+        {"abs", Op::Abs},   {"sign", Op::Sign}, {"erf", Op::Erf},     {"erfc", Op::Erfc}};
+    const auto op = functions.find(name);
+    if (op == functions.end())
+      fail("unsupported function " + name);
+    const auto argument = sum();
+    if (!accept(')'))
+      fail("expected )");
+    return m_graph.node(op->second, argument);
+  }
+  size_t variable(const std::string &name) {
+    if (name == m_arrayVariable)
+      return m_graph.node(Op::Array);
+    const auto scalar = std::find(m_scalarVariables.cbegin(), m_scalarVariables.cend(), name);
+    if (scalar != m_scalarVariables.cend())
+      return m_graph.node(Op::Scalar, static_cast<size_t>(std::distance(m_scalarVariables.cbegin(), scalar)));
+    if (name == "_pi")
+      return m_graph.constant(M_PI);
+    if (name == "_e")
+      return m_graph.constant(M_E);
+    fail("unknown name " + name);
+  }
+
+  CompiledExpression &m_graph;
+  const std::string &m_formula;
+  const std::string &m_arrayVariable;
+  const std::vector<std::string> &m_scalarVariables;
+  size_t m_position = 0;
+};
+
+/** Parse and compile a formula.
+ * @param formula :: The formula, e.g. "h*exp(-(x-c)^2/w)"
+ * @param arrayVariable :: Name of the variable the formula is evaluated over, e.g. "x"
+ * @param scalarVariables :: Names of the other variables, e.g. fit parameters
+ * @throw std::invalid_argument if the formula uses unsupported operations or unknown names
+ */
+CompiledExpression::CompiledExpression(const std::string &formula, const std::string &arrayVariable,
+                                       const std::vector<std::string> &scalarVariables)
+    : m_nScalars(scalarVariables.size()) {
+  const auto value = Parser(*this, formula, arrayVariable, scalarVariables).parse();
+  std::map<size_t, size_t> cache;
+  std::vector<size_t> derivatives(m_nScalars);
+  for (size_t i = 0; i < m_nScalars; ++i) {
+    cache.clear();
+    derivatives[i] = derivative(value, i, cache);
+  }
+  m_value = compile({value});
+  m_derivatives = compile(derivatives);
+}
+
+/** Evaluate the formula.
+ * @param out :: Buffer for nValues results
+ * @param values :: Values of the array variable
+ * @param nValues :: Number of values
+ * @param scalars :: Values of the scalar variables
+ */
+void CompiledExpression::evaluate(double *out, const double *values, const size_t nValues,
+                                  const double *scalars) const {
+  run(m_value, values, nValues, scalars, [out](size_t, size_t start, size_t count, const Operand &result) {
+    if (result.data)
+      std::copy_n(result.data, count, out + start);
+    else
+      std::fill_n(out + start, count, result.value);
+  });
+}
+
+/** Evaluate the derivatives of the formula with respect to the scalar
+ * variables. Column i of the Jacobian receives the derivative with respect
+ * to the i-th scalar variable.
+ * @param jacobian :: The Jacobian to fill
+ * @param values :: Values of the array variable
+ * @param nValues :: Number of values
+ * @param scalars :: Values of the scalar variables
+ */
+void CompiledExpression::evaluateDerivatives(Jacobian &jacobian, const double *values, const size_t nValues,
+                                             const double *scalars) const {
+  run(m_derivatives, values, nValues, scalars,
+      [&jacobian](size_t iScalar, size_t start, size_t count, const Operand &result) {
+        for (size_t i = 0; i < count; ++i)
+          jacobian.set(start + i, iScalar, result.data ? result.data[i] : result.value);
+      });
+}
+
+bool CompiledExpression::isConstant(size_t i, double value) const {
+  return m_nodes[i].op == Op::Constant && m_nodes[i].value == value;
+}
+
+/// Returns the function evaluating a unary operation
+CompiledExpression::UnaryFunction CompiledExpression::unaryFunction(Op op) {
+  switch (op) {
+  case Op::Negate:
+    return [](double x) { return -x; };
+  case Op::Sin:
+    return [](double x) { return std::sin(x); };
+  case Op::Cos:
+    return [](double x) { return std::cos(x); };
+  case Op::Tan:
+    return [](double x) { return std::tan(x); };
+  case Op::Asin:
+    return [](double x) { return std::asin(x); };
+  case Op::Acos:
+    return [](double x) { return std::acos(x); };
+  case Op::Atan:
+    return [](double x) { return std::atan(x); };
+  case Op::Sinh:
+    return [](double x) { return std::sinh(x); };
+  case Op::Cosh:
+    return [](double x) { return std::cosh(x); };
+  case Op::Tanh:
+    return [](double x) { return std::tanh(x); };
+  case Op::Exp:
+    return [](double x) { return std::exp(x); };
+  case Op::Ln:
+    return [](double x) { return std::log(x); };
+  case Op::Log10:
+    return [](double x) { return std::log10(x); };
+  case Op::Log2:
+    return [](double x) { return std::log2(x); };
+  case Op::Sqrt:
+    return [](double x) { return std::sqrt(x); };
+  case Op::Abs:
+    return [](double x) { return std::fabs(x); };
+  case Op::Sign:
+    return [](double x) { return x > 0.0 ? 1.0 : (x < 0.0 ? -1.0 : 0.0); };
+  case Op::Erf:
+    return [](double x) { return std::erf(x); };
+  case Op::Erfc:
+    return [](double x) { return std::erfc(x); };
+  default:
+    throw std::logic_error("CompiledExpression: not a unary operation");
+  }
+}
+
+/** Returns the index of a node, creating it if it doesn't exist yet.
+ * Constant operands are folded and trivial operations are simplified away.
+ */
+size_t CompiledExpression::node(Op op, size_t a, size_t b, double value) {
+  const bool isUnary = op > Op::Power;
+  const bool isBinary = op >= Op::Add && op <= Op::Power;
+  if (isBinary || isUnary) {
+    if (isBinary && m_nodes[a].op == Op::Constant && m_nodes[b].op == Op::Constant) {
+      const double x = m_nodes[a].value, y = m_nodes[b].value;
+      switch (op) {
+      case Op::Add:
+        return constant(x + y);
+      case Op::Subtract:
+        return constant(x - y);
+      case Op::Multiply:
+        return constant(x * y);
+      case Op::Divide:
+        return constant(x / y);
+      case Op::Chain:
+        return constant(x == 0.0 ? 0.0 : x * y);
+      default:
+        return constant(std::pow(x, y));
+      }
+    }
+    if (isUnary && m_nodes[a].op == Op::Constant)
+      return constant(unaryFunction(op)(m_nodes[a].value));
+    switch (op) {
+    case Op::Add:
+      if (isConstant(a, 0.0))
+        return b;
+      if (isConstant(b, 0.0))
+        return a;
+      if (a > b)
+        std::swap(a, b);
+      break;
+    case Op::Subtract:
+      if (isConstant(b, 0.0))
+        return a;
+      if (isConstant(a, 0.0))
+        return node(Op::Negate, b);
+      break;
+    case Op::Multiply:
+      if (isConstant(a, 0.0) || isConstant(b, 0.0))
+        return constant(0.0);
+      if (isConstant(a, 1.0))
+        return b;
+      if (isConstant(b, 1.0))
+        return a;
+      if (a > b)
+        std::swap(a, b);
+      break;
+    case Op::Divide:
+      if (isConstant(a, 0.0))
+        return constant(0.0);
+      if (isConstant(b, 1.0))
+        return a;
+      break;
+    case Op::Chain:
+      if (isConstant(a, 0.0))
+        return constant(0.0);
+      if (isConstant(a, 1.0))
+        return b;
+      if (m_nodes[b].op == Op::Constant && std::isfinite(m_nodes[b].value))
+        return node(Op::Multiply, a, b);
+      break;
+    case Op::Power:
+      if (isConstant(b, 0.0))
+        return constant(1.0);
+      if (isConstant(b, 1.0))
+        return a;
+      if (isConstant(b, 2.0))
+        return node(Op::Multiply, a, a);
+      if (isConstant(b, -1.0))
+        return node(Op::Divide, constant(1.0), a);
+      break;
+    case Op::Negate:
+      if (m_nodes[a].op == Op::Negate)
+        return m_nodes[a].a;
+      break;
+    default:
+      break;
+    }
+  }
+  if (!isBinary)
+    b = 0;
+  if (op != Op::Constant)
+    value = 0.0;
+  const auto key = std::make_tuple(op, a, b, bits(value));
+  const auto existing = m_index.find(key);
+  if (existing != m_index.end())
+    return existing->second;
+  bool varying = op == Op::Array;
+  if (isBinary || isUnary)
+    varying = m_nodes[a].varying || (isBinary && m_nodes[b].varying);
+  m_nodes.emplace_back(Node{op, a, b, value, varying});
+  m_index.emplace(key, m_nodes.size() - 1);
+  return m_nodes.size() - 1;
+}
+
+/** Returns the derivative of a node with respect to a scalar variable.
+ * @param i :: Index of the node
+ * @param scalar :: Index of the scalar variable
+ * @param cache :: Derivatives of nodes already differentiated
+ */
+size_t CompiledExpression::derivative(size_t i, size_t scalar, std::map<size_t, size_t> &cache) {
+  const auto cached = cache.find(i);
+  if (cached != cache.end())
+    return cached->second;
+
+  // Copy: creating nodes invalidates references into m_nodes
+  const Node n = m_nodes[i];
+  size_t result;
+  if (n.op == Op::Constant || n.op == Op::Array) {
+    result = constant(0.0);
+  } else if (n.op == Op::Scalar) {
+    result = constant(n.a == scalar ? 1.0 : 0.0);
+  } else {
+    const auto da = derivative(n.a, scalar, cache);
+    const bool isBinary = n.op >= Op::Add && n.op <= Op::Power;
+    const auto db = isBinary ? derivative(n.b, scalar, cache) : NONE;
+    const auto a = n.a, b = n.b;
+    auto mul = [this](size_t x, size_t y) { return node(Op::Multiply, x, y); };
+    auto div = [this](size_t x, size_t y) { return node(Op::Divide, x, y); };
+    auto add = [this](size_t x, size_t y) { return node(Op::Add, x, y); };
+    auto sub = [this](size_t x, size_t y) { return node(Op::Subtract, x, y); };
+    auto fun = [this](Op op, size_t x) { return node(op, x); };
+    // As DualNumber::chain, terms whose argument does not vary are skipped
+    // so that e.g. sqrt(x) does not give 0/0 where x = 0
+    auto chain = [this](size_t d, size_t df) { return node(Op::Chain, d, df); };
+    auto inverse = [this](size_t x) { return node(Op::Divide, constant(1.0), x); };
+    switch (n.op) {
+    case Op::Add:
+      result = add(da, db);
+      break;
+    case Op::Subtract:
+      result = sub(da, db);
+      break;
+    case Op::Multiply:
+      result = add(mul(da, b), mul(a, db));
+      break;
+    case Op::Divide:
+      result = div(sub(mul(da, b), mul(a, db)), mul(b, b));
+      break;
+    case Op::Chain:
+      result = add(chain(da, b), chain(a, db));
+      break;
+    case Op::Power:
+      if (m_nodes[b].op == Op::Constant) {
+        const double p = m_nodes[b].value;
+        result = chain(da, mul(constant(p), node(Op::Power, a, constant(p - 1.0))));
+      } else {
+        // d(a^b)/db = a^b * ln(a) vanishes with a^b where a = 0
+        result = add(chain(da, mul(b, node(Op::Power, a, sub(b, constant(1.0))))),
+                     chain(db, chain(i, fun(Op::Ln, a))));
+      }
+      break;
+    case Op::Negate:
+      result = fun(Op::Negate, da);
+      break;
+    case Op::Sin:
+      result = chain(da, fun(Op::Cos, a));
+      break;
+    case Op::Cos:
+      result = chain(da, fun(Op::Negate, fun(Op::Sin, a)));
+      break;
+    case Op::Tan: {
+      const auto c = fun(Op::Cos, a);
+      result = chain(da, inverse(mul(c, c)));
+      break;
+    }
+    case Op::Asin:
+      result = chain(da, inverse(fun(Op::Sqrt, sub(constant(1.0), mul(a, a)))));
+      break;
+    case Op::Acos:
+      result = chain(da, fun(Op::Negate, inverse(fun(Op::Sqrt, sub(constant(1.0), mul(a, a))))));
+      break;
+    case Op::Atan:
+      result = chain(da, inverse(add(constant(1.0), mul(a, a))));
+      break;
+    case Op::Sinh:
+      result = chain(da, fun(Op::Cosh, a));
+      break;
+    case Op::Cosh:
+      result = chain(da, fun(Op::Sinh, a));
+      break;
+    case Op::Tanh:
+      result = chain(da, sub(constant(1.0), mul(i, i)));
+      break;
+    case Op::Exp:
+      result = chain(da, i);
+      break;
+    case Op::Ln:
+      result = chain(da, inverse(a));
+      break;
+    case Op::Log10:
+      result = chain(da, inverse(mul(a, constant(M_LN10))));
+      break;
+    case Op::Log2:
+      result = chain(da, inverse(mul(a, constant(M_LN2))));
+      break;
+    case Op::Sqrt:
+      result = chain(da, div(constant(0.5), i));
+      break;
+    case Op::Abs:
+      result = chain(da, fun(Op::Sign, a));
+      break;
+    case Op::Sign:
+      result = constant(0.0);
+      break;
+    case Op::Erf:
+    case Op::Erfc: {
+      // d/du erf(u) = 2/sqrt(pi) * exp(-u^2)
+      const auto d = mul(constant(M_2_SQRTPI), fun(Op::Exp, fun(Op::Negate, mul(a, a))));
+      result = chain(da, n.op == Op::Erf ? d : fun(Op::Negate, d));
+      break;
+    }
+    default:
+      throw std::logic_error("CompiledExpression: cannot differentiate node");
+    }
+  }
+  cache.emplace(i, result);
+  return result;
+}
+
+/** Compile the evaluation of a set of nodes into a program.
+ * Uniform nodes are evaluated once per call; varying nodes become block
+ * instructions whose results are held in registers. Registers are reused
+ * once their value is no longer needed.
+ */
+CompiledExpression::Program CompiledExpression::compile(const std::vector<size_t> &outputs) const {
+  Program program;
+  std::vector<size_t> order;
+  std::vector<bool> visited(m_nodes.size(), false);
+  // Post-order depth first traversal, so operands precede their users
+  std::vector<std::pair<size_t, bool>> stack;
+  for (auto output = outputs.rbegin(); output != outputs.rend(); ++output)
+    stack.emplace_back(*output, false);
+  while (!stack.empty()) {
+    const auto [i, expanded] = stack.back();
+    stack.pop_back();
+    if (expanded) {
+      order.emplace_back(i);
+      continue;
+    }
+    if (visited[i])
+      continue;
+    visited[i] = true;
+    stack.emplace_back(i, true);
+    const auto &n = m_nodes[i];
+    if (n.op >= Op::Add) {
+      if (n.op <= Op::Power)
+        stack.emplace_back(n.b, false);
+      stack.emplace_back(n.a, false);
+    }
+  }
+
+  std::vector<size_t> varying;
+  for (const auto i : order) {
+    if (!m_nodes[i].varying)
+      program.uniforms.emplace_back(i);
+    else if (m_nodes[i].op != Op::Array)
+      varying.emplace_back(i);
+  }
+
+  // Index of the last instruction that reads each node
+  std::unordered_map<size_t, size_t> lastUse;
+  for (size_t k = 0; k < varying.size(); ++k) {
+    const auto &n = m_nodes[varying[k]];
+    lastUse[n.a] = k;
+    if (n.op <= Op::Power)
+      lastUse[n.b] = k;
+  }
+  for (const auto output : outputs)
+    lastUse[output] = NONE;
+
+  std::unordered_map<size_t, size_t> registers;
+  std::vector<size_t> free;
+  auto source = [this, &registers](size_t i) {
+    if (!m_nodes[i].varying)
+      return Source{Source::Kind::Uniform, i};
+    if (m_nodes[i].op == Op::Array)
+      return Source{Source::Kind::Array, 0};
+    return Source{Source::Kind::Register, registers.at(i)};
+  };
+  for (size_t k = 0; k < varying.size(); ++k) {
+    const auto &n = m_nodes[varying[k]];
+    const bool isBinary = n.op <= Op::Power;
+    Instruction instruction{n.op, source(n.a), isBinary ? source(n.b) : source(n.a), 0};
+    // Operand registers that are not needed any more can hold the result:
+    // instructions work element by element
+    for (const auto operand : {n.a, isBinary ? n.b : n.a}) {
+      const auto reg = registers.find(operand);
+      if (reg != registers.end() && lastUse[operand] == k) {
+        free.emplace_back(reg->second);
+        registers.erase(reg);
+      }
+    }
+    if (free.empty()) {
+      instruction.result = program.nRegisters++;
+    } else {
+      instruction.result = free.back();
+      free.pop_back();
+    }
+    registers[varying[k]] = instruction.result;
+    program.instructions.emplace_back(instruction);
+  }
+  for (const auto output : outputs)
+    program.outputs.emplace_back(source(output));
+  return program;
+}
+
+/** Execute a program over blocks of values.
+ * @param program :: The program
+ * @param values :: Values of the array variable
+ * @param nValues :: Number of values
+ * @param scalars :: Values of the scalar variables
+ * @param store :: Called as store(iOutput, start, count, operand) with the
+ * results of each output for values [start, start + count)
+ */
+template <typename Store>
+void CompiledExpression::run(const Program &program, const double *values, const size_t nValues,
+                             const double *scalars, Store &&store) const {
+  std::vector<double> uniform(program.uniforms.empty() ? 0 : m_nodes.size());
+  for (const auto i : program.uniforms) {
+    const auto &n = m_nodes[i];
+    switch (n.op) {
+    case Op::Constant:
+      uniform[i] = n.value;
+      break;
+    case Op::Scalar:
+      uniform[i] = scalars[n.a];
+      break;
+    case Op::Add:
+      uniform[i] = uniform[n.a] + uniform[n.b];
+      break;
+    case Op::Subtract:
+      uniform[i] = uniform[n.a] - uniform[n.b];
+      break;
+    case Op::Multiply:
+      uniform[i] = uniform[n.a] * uniform[n.b];
+      break;
+    case Op::Divide:
+      uniform[i] = uniform[n.a] / uniform[n.b];
+      break;
+    case Op::Chain:
+      uniform[i] = uniform[n.a] == 0.0 ? 0.0 : uniform[n.a] * uniform[n.b];
+      break;
+    case Op::Power:
+      uniform[i] = std::pow(uniform[n.a], uniform[n.b]);
+      break;
+    default:
+      uniform[i] = unaryFunction(n.op)(uniform[n.a]);
+    }
+  }
+
+  std::vector<double> registers(program.nRegisters * BLOCK_SIZE);
+  for (size_t start = 0; start < nValues; start += BLOCK_SIZE) {
+    const size_t count = std::min(BLOCK_SIZE, nValues - start);
+    auto operand = [&](const Source &source) {
+      switch (source.kind) {
+      case Source::Kind::Array:
+        return Operand{values + start, 0.0};
+      case Source::Kind::Register:
+        return Operand{&registers[source.index * BLOCK_SIZE], 0.0};
+      default:
+        return Operand{nullptr, uniform[source.index]};
+      }
+    };
+    for (const auto &instruction : program.instructions) {
+      const auto a = operand(instruction.a);
+      const auto b = operand(instruction.b);
+      double *out = &registers[instruction.result * BLOCK_SIZE];
+      switch (instruction.op) {
+      case Op::Add:
+        binary([](double x, double y) { return x + y; }, a, b, out, count);
+        break;
+      case Op::Subtract:
+        binary([](double x, double y) { return x - y; }, a, b, out, count);
+        break;
+      case Op::Multiply:
+        binary([](double x, double y) { return x * y; }, a, b, out, count);
+        break;
+      case Op::Divide:
+        binary([](double x, double y) { return x / y; }, a, b, out, count);
+        break;
+      case Op::Chain:
+        binary([](double x, double y) { return x == 0.0 ? 0.0 : x * y; }, a, b, out, count);
+        break;
+      case Op::Power:
+        binary([](double x, double y) { return std::pow(x, y); }, a, b, out, count);
+        break;
+      default:
+        unary(unaryFunction(instruction.op), a.data, out, count);
+      }
+    }
+    for (size_t i = 0; i < program.outputs.size(); ++i)
+      store(i, start, count, operand(program.outputs[i]));
+  }
+}
+
+} // namespace Mantid::API
@@ -9,6 +9,8 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/CompositeFunction.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/Jacobian.h"
 #include "MantidAPI/IConstraint.h"
 #include "MantidAPI/ParameterTie.h"
 #include "MantidKernel/Exception.h"
@@ -204,7 +206,7 @@ void CompositeFunction::function(const FunctionDomain &domain, FunctionValues &v
  */
 void CompositeFunction::functionDeriv(const FunctionDomain &domain, Jacobian &jacobian) {
   if (getAttribute(ATTNUMDERIV).asBool()) {
-    calNumericalDeriv(domain, jacobian);
+    calNumericalDerivByMember(domain, jacobian);
   } else {
     for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
       PartialJacobian J(&jacobian, paramOffset(iFun));
@@ -213,6 +215,73 @@ void CompositeFunction::functionDeriv(const FunctionDomain &domain, Jacobian &ja
   }
 }
 
+/**
+ * Calculate numerical derivatives of the sum of the member functions. Unlike
+ * IFunction::calNumericalDeriv, which evaluates the whole composite for every
+ * parameter step, only the members whose parameters change when a parameter
+ * is stepped are re-evaluated. These are the member owning the parameter and
+ * any member with a parameter tied to it.
+ * @param domain :: Function domain to get the arguments from.
+ * @param jacobian :: A Jacobian to store the derivatives.
+ */
+void CompositeFunction::calNumericalDerivByMember(const FunctionDomain &domain, Jacobian &jacobian) {
+  const size_t nParam = nParams();
+  applyTies(); // just in case
+
+  std::vector<FunctionValues> memberValues;
+  memberValues.reserve(nFunctions());
+  for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
+    memberValues.emplace_back(domain);
+    m_functions[iFun]->function(domain, memberValues.back());
+  }
+  const size_t nData = domain.size();
+
+  std::vector<double> parameters(nParam);
+  for (size_t i = 0; i < nParam; ++i) {
+    parameters[i] = getParameter(i);
+  }
+
+  FunctionValues plusStep(domain);
+  std::vector<double> derivative(nData);
+  std::vector<bool> affected(nFunctions());
+  for (size_t iP = 0; iP < nParam; ++iP) {
+    if (!isActive(iP))
+      continue;
+    const double val = activeParameter(iP);
+    double step = calculateStepSize(val);
+    const double paramPstep = val + step;
+    setActiveParameter(iP, paramPstep);
+    applyTies();
+
+    // Find the members depending on this parameter from the parameters that
+    // changed, directly or through ties
+    std::fill(affected.begin(), affected.end(), false);
+    for (size_t i = 0; i < nParam; ++i) {
+      if (getParameter(i) != parameters[i])
+        affected[m_IFunction[i]] = true;
+    }
+    affected[m_IFunction[iP]] = true;
+
+    step = paramPstep - val;
+    std::fill(derivative.begin(), derivative.end(), 0.0);
+    for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
+      if (!affected[iFun])
+        continue;
+      m_functions[iFun]->function(domain, plusStep);
+      const auto &minusStep = memberValues[iFun];
+      for (size_t i = 0; i < nData; ++i) {
+        derivative[i] += plusStep.getCalculated(i) - minusStep.getCalculated(i);
+      }
+    }
+
+    setActiveParameter(iP, val);
+    applyTies();
+    for (size_t i = 0; i < nData; ++i) {
+      jacobian.set(i, iP, derivative[i] / step);
+    }
+  }
+}
+
 /** Sets a new value to the i-th parameter.
  *  @param i :: The parameter index
  *  @param value :: The new value
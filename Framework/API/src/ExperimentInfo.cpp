@@ -23,6 +23,7 @@
 #include "MantidGeometry/Instrument/ParComponentFactory.h"
 #include "MantidGeometry/Instrument/ParameterFactory.h"
 #include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidGeometry/Instrument/ParameterMapSnapshot.h"
 #include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
 
 #include "MantidBeamline/ComponentInfo.h"
@@ -642,8 +643,32 @@ double ExperimentInfo::getEFixed(const std::shared_ptr<const Geometry::IDetector
 
 double ExperimentInfo::getEFixedForIndirect(const std::shared_ptr<const Geometry::IDetector> &detector,
                                             const std::vector<std::string> &parameterNames) const {
+  // Single detectors of this instrument are resolved from the dense columns of
+  // the parameter map snapshot rather than searching up the tree every call,
+  // once enough lookups have been made since the map last changed to pay for
+  // building the snapshot
+  const auto &pmap = constInstrumentParameters();
+  std::shared_ptr<const Geometry::ParameterMapSnapshot> snapshot;
+  size_t detectorIndex = 0;
+  const auto *singleDetector = dynamic_cast<const Geometry::Detector *>(detector.get());
+  if (singleDetector && singleDetector->isParametrized() && &singleDetector->parameterMap() == &pmap &&
+      pmap.hasDetectorInfo(sptr_instrument.get())) {
+    snapshot = pmap.snapshotForRepeatedLookups();
+    detectorIndex = singleDetector->index();
+  }
+
   double efixed = 0.;
   for (auto &parameterName : parameterNames) {
+    if (snapshot) {
+      const auto nameIndex = snapshot->nameIndex(parameterName);
+      if (nameIndex != Geometry::ParameterMapSnapshot::npos) {
+        const auto &column = snapshot->doubleColumn(nameIndex);
+        if (column.has(detectorIndex)) {
+          efixed = column.value(detectorIndex);
+          continue;
+        }
+      }
+    }
     Parameter_sptr par = constInstrumentParameters().getRecursive(detector.get(), parameterName);
     if (par) {
       efixed = par->value<double>();
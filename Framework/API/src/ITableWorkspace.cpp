@@ -76,7 +76,7 @@ void ITableWorkspace::modified() {
   ITableWorkspace_sptr tws = std::dynamic_pointer_cast<ITableWorkspace>(ws);
   if (!tws)
     return;
-  AnalysisDataService::Instance().notificationCenter.postNotification(
+  AnalysisDataService::Instance().postNotification(
       new Kernel::DataService<API::Workspace>::AfterReplaceNotification(this->getName(), tws));
 }
 
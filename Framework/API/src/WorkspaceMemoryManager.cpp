@@ -0,0 +1,375 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/WorkspaceMemoryManager.h"
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/IMDEventWorkspace.h"
+#include "MantidAPI/IMDHistoWorkspace.h"
+#include "MantidAPI/ITableWorkspace.h"
+#include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/WorkspaceGroup.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Logger.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+namespace Mantid::API {
+
+namespace {
+/// static logger
+Kernel::Logger g_log("WorkspaceMemoryManager");
+
+/// The number of workspaces saved to scratch files
+std::atomic<size_t> g_numberSaved{0};
+/// Makes the names of the scratch files unique
+std::atomic<uint64_t> g_fileNumber{0};
+
+/// Stands in the service for a workspace saved to a scratch file, which is
+/// deleted with the placeholder
+class SavedWorkspace final : public Workspace {
+public:
+  SavedWorkspace(std::string fileName, std::string savedId, std::string loader)
+      : m_fileName(std::move(fileName)), m_savedId(std::move(savedId)), m_loader(std::move(loader)) {
+    ++g_numberSaved;
+  }
+  ~SavedWorkspace() override {
+    std::error_code error;
+    std::filesystem::remove(m_fileName, error);
+    --g_numberSaved;
+  }
+  const std::string id() const override { return "SavedWorkspace"; }
+  const std::string toString() const override {
+    return m_savedId + " saved to " + m_fileName + " to free memory, retrieve it to load it back\n";
+  }
+  size_t getMemorySize() const override { return sizeof(SavedWorkspace); }
+
+  const std::string &fileName() const { return m_fileName; }
+  const std::string &loader() const { return m_loader; }
+
+private:
+  SavedWorkspace *doClone() const override { throw std::runtime_error("Cannot clone a saved workspace."); }
+  SavedWorkspace *doCloneEmpty() const override { throw std::runtime_error("Cannot clone a saved workspace."); }
+
+  const std::string m_fileName, m_savedId, m_loader;
+};
+
+/**
+ * @param workspace :: A workspace
+ * @return The names of the algorithms saving and loading the workspace,
+ * empty if it cannot be saved
+ */
+std::pair<std::string, std::string> saverAndLoader(const Workspace &workspace) {
+  if (dynamic_cast<const IMDEventWorkspace *>(&workspace) || dynamic_cast<const IMDHistoWorkspace *>(&workspace))
+    return {"SaveMD", "LoadMD"};
+  if (dynamic_cast<const MatrixWorkspace *>(&workspace) || dynamic_cast<const ITableWorkspace *>(&workspace))
+    return {"SaveNexusProcessed", "LoadNexusProcessed"};
+  return {};
+}
+
+/// Do the names refer to the same workspace in the service?
+bool sameName(const std::string &lhs, const std::string &rhs) {
+  const Kernel::CaseInsensitiveCmp less;
+  return !less(lhs, rhs) && !less(rhs, lhs);
+}
+
+/// The memory of a workspace, 0 for groups as their members are counted
+size_t memoryOf(const Workspace &workspace) {
+  if (dynamic_cast<const WorkspaceGroup *>(&workspace))
+    return 0;
+  try {
+    return workspace.getMemorySize();
+  } catch (std::exception &) {
+    return 0;
+  }
+}
+} // namespace
+
+/**
+ * Read the budget and scratch directory from the configuration
+ * @param ads :: The service whose workspaces are managed
+ */
+WorkspaceMemoryManager::WorkspaceMemoryManager(AnalysisDataServiceImpl &ads) : m_ads(ads) {
+  auto &config = Kernel::ConfigService::Instance();
+  setBudget(config.getValue<size_t>("workspace.memoryBudget").value_or(0));
+  setScratchDirectory(config.getString("workspace.scratchDirectory"));
+}
+
+/**
+ * @param bytes :: The memory the workspaces may use in bytes, 0 for no limit.
+ * Lowering the budget does not save workspaces until one is added.
+ */
+void WorkspaceMemoryManager::setBudget(size_t bytes) { m_budget = bytes; }
+
+/// @return The directory the workspaces are saved to
+std::string WorkspaceMemoryManager::scratchDirectory() const {
+  std::lock_guard<std::mutex> lock(m_usageMutex);
+  return m_scratchDirectory;
+}
+
+/**
+ * @param directory :: The directory to save workspaces to. If empty, the
+ * temporary directory of the system is used.
+ */
+void WorkspaceMemoryManager::setScratchDirectory(const std::string &directory) {
+  std::lock_guard<std::mutex> lock(m_usageMutex);
+  m_scratchDirectory = directory.empty() ? Kernel::ConfigService::Instance().getTempDir() : directory;
+}
+
+/// @return The number of workspaces saved to scratch files
+size_t WorkspaceMemoryManager::numberSaved() { return g_numberSaved; }
+
+/// @return True if the workspace stands for one saved to a scratch file
+bool WorkspaceMemoryManager::isSaved(const Workspace &workspace) {
+  return dynamic_cast<const SavedWorkspace *>(&workspace) != nullptr;
+}
+
+/**
+ * The memory used by the workspaces in the service. The size of a workspace
+ * is only found again if it has been added or replaced since.
+ * @return The memory in bytes
+ */
+size_t WorkspaceMemoryManager::memoryUsage() {
+  const auto names = m_ads.getObjectNames(Kernel::DataServiceSort::Unsorted, Kernel::DataServiceHidden::Include);
+  std::vector<std::pair<std::string, Workspace_sptr>> workspaces;
+  workspaces.reserve(names.size());
+  for (const auto &name : names) {
+    try {
+      workspaces.emplace_back(name, m_ads.Kernel::DataService<Workspace>::retrieve(name));
+    } catch (Kernel::Exception::NotFoundError &) {
+      // removed since the names were taken
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_usageMutex);
+  decltype(m_usage) usage;
+  size_t total = 0;
+  for (const auto &[name, workspace] : workspaces) {
+    auto it = m_usage.find(name);
+    Usage entry = it != m_usage.end() ? it->second : Usage{nullptr, 0, ++m_clock, false};
+    if (entry.workspace != workspace.get()) {
+      entry.workspace = workspace.get();
+      entry.bytes = memoryOf(*workspace);
+    }
+    total += entry.bytes;
+    usage.emplace(name, entry);
+  }
+  // Forget the workspaces no longer in the service
+  m_usage.swap(usage);
+  return total;
+}
+
+/**
+ * Call when a workspace has been added or replaced. Its size is found again
+ * and it becomes the most recently used.
+ * @param name :: The name of the workspace
+ */
+void WorkspaceMemoryManager::added(const std::string &name) {
+  std::lock_guard<std::mutex> lock(m_usageMutex);
+  auto &entry = m_usage[name];
+  entry.workspace = nullptr;
+  entry.lastUsed = ++m_clock;
+  entry.keepInMemory = false;
+}
+
+/**
+ * Keep a workspace in memory until it is replaced or removed. Use this for
+ * workspaces handed to holders that do not own them, such as the handles
+ * of Python scripts, which would be left empty if the workspace was saved.
+ * @param name :: The name of the workspace
+ */
+void WorkspaceMemoryManager::keepInMemory(const std::string &name) {
+  std::lock_guard<std::mutex> lock(m_usageMutex);
+  m_usage[name].keepInMemory = true;
+}
+
+/// @return True if the workspace must not be saved
+bool WorkspaceMemoryManager::isKeptInMemory(const std::string &name) const {
+  std::lock_guard<std::mutex> lock(m_usageMutex);
+  auto it = m_usage.find(name);
+  return it != m_usage.end() && it->second.keepInMemory;
+}
+
+/**
+ * Call when a workspace is retrieved from the service. It becomes the most
+ * recently used, and is loaded back if it had been saved.
+ * @param name :: The name of the workspace
+ * @param workspace :: The workspace in the service
+ * @return The workspace to return to the caller
+ */
+Workspace_sptr WorkspaceMemoryManager::accessed(const std::string &name, Workspace_sptr workspace) {
+  touch(name);
+  if (!isSaved(*workspace))
+    return workspace;
+  workspace.reset();
+  return restore(name);
+}
+
+/// Make a workspace the most recently used
+void WorkspaceMemoryManager::touch(const std::string &name) {
+  std::lock_guard<std::mutex> lock(m_usageMutex);
+  auto it = m_usage.find(name);
+  if (it != m_usage.end())
+    it->second.lastUsed = ++m_clock;
+}
+
+/**
+ * Save the least recently used workspaces until the memory used is within
+ * the budget.
+ * @param keep :: The name of a workspace never to save, for example the one
+ * just added
+ * @return The number of workspaces saved
+ */
+size_t WorkspaceMemoryManager::enforceBudget(const std::string &keep) {
+  const size_t budget = m_budget;
+  if (budget == 0)
+    return 0;
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  // Saving runs algorithms, which must not start saving again
+  if (m_enforcing)
+    return 0;
+  m_enforcing = true;
+
+  size_t usage = memoryUsage();
+  size_t numberSaved = 0;
+  if (usage > budget) {
+    std::vector<std::pair<uint64_t, std::string>> candidates;
+    {
+      std::lock_guard<std::mutex> usageLock(m_usageMutex);
+      for (const auto &[name, entry] : m_usage) {
+        if (entry.bytes > 0 && !entry.keepInMemory && !sameName(name, keep))
+          candidates.emplace_back(entry.lastUsed, name);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto &candidate : candidates) {
+      if (usage <= budget)
+        break;
+      size_t bytes = 0;
+      {
+        std::lock_guard<std::mutex> usageLock(m_usageMutex);
+        bytes = m_usage[candidate.second].bytes;
+      }
+      if (save(candidate.second)) {
+        usage -= std::min(usage, bytes);
+        ++numberSaved;
+      }
+    }
+    if (usage > budget) {
+      g_log.warning() << "The workspaces use " << usage << " bytes, more than the budget of " << budget
+                      << " bytes, and no more of them can be saved to free memory.\n";
+    }
+  }
+  m_enforcing = false;
+  return numberSaved;
+}
+
+/**
+ * Save a workspace to a scratch file and replace it in the service by a
+ * placeholder, unless something other than the service holds it or it is
+ * kept in memory. Observers of the service receive an EvictedNotification.
+ * @param name :: The name of the workspace
+ * @return True if the workspace was saved
+ */
+bool WorkspaceMemoryManager::save(const std::string &name) {
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  Workspace_sptr workspace;
+  try {
+    workspace = m_ads.Kernel::DataService<Workspace>::retrieve(name);
+  } catch (Kernel::Exception::NotFoundError &) {
+    return false;
+  }
+  // Held by the service and here only
+  const auto heldByServiceOnly = [&workspace]() { return workspace.use_count() <= 2; };
+  const auto algorithms = saverAndLoader(*workspace);
+  if (algorithms.first.empty() || !heldByServiceOnly() || isKeptInMemory(name))
+    return false;
+
+  const auto fileName =
+      (std::filesystem::path(scratchDirectory()) / ("mantid_workspace_" + std::to_string(++g_fileNumber) + ".nxs"))
+          .string();
+  try {
+    auto saver = AlgorithmManager::Instance().createUnmanaged(algorithms.first);
+    saver->initialize();
+    saver->setChild(true);
+    saver->setLogging(false);
+    saver->setProperty("InputWorkspace", workspace);
+    saver->setPropertyValue("Filename", fileName);
+    saver->execute();
+  } catch (std::exception &ex) {
+    g_log.warning() << "Unable to save " << name << " to free memory: " << ex.what() << '\n';
+    std::error_code error;
+    std::filesystem::remove(fileName, error);
+    return false;
+  }
+
+  auto saved = std::make_shared<SavedWorkspace>(fileName, workspace->id(), algorithms.second);
+  saved->setName(name);
+  const size_t bytes = memoryOf(*workspace);
+  // Something may have taken or replaced the workspace while it was saved
+  if (!heldByServiceOnly() || !m_ads.exchange(name, workspace, saved))
+    return false;
+  // Readers that looked the workspace up just before the exchange can still
+  // take it from the map they found it in, which holds a reference too. Once
+  // those maps are gone nothing else can reach the workspace, so only the
+  // reference here must be left; otherwise put the workspace back.
+  if (workspace.use_count() > 1) {
+    m_ads.exchange(name, saved, workspace);
+    return false;
+  }
+  workspace.reset();
+  g_log.information() << "Saved " << name << " to " << fileName << " to free " << bytes << " bytes\n";
+  m_ads.postNotification(new AnalysisDataServiceImpl::EvictedNotification(name, saved));
+  return true;
+}
+
+/**
+ * Load a saved workspace back into the service
+ * @param name :: The name of the workspace
+ * @return The workspace
+ */
+Workspace_sptr WorkspaceMemoryManager::restore(const std::string &name) {
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  // Another thread may have loaded it already
+  auto workspace = m_ads.Kernel::DataService<Workspace>::retrieve(name);
+  auto saved = std::dynamic_pointer_cast<SavedWorkspace>(workspace);
+  if (!saved)
+    return workspace;
+
+  try {
+    auto loader = AlgorithmManager::Instance().createUnmanaged(saved->loader());
+    loader->initialize();
+    loader->setChild(true);
+    loader->setLogging(false);
+    loader->setPropertyValue("Filename", saved->fileName());
+    loader->setPropertyValue("OutputWorkspace", "dummy-output-name");
+    loader->execute();
+    // The output of LoadMD is not a PropertyWithValue<Workspace_sptr>
+    const auto *output = dynamic_cast<IWorkspaceProperty *>(loader->getPointerToProperty("OutputWorkspace"));
+    workspace = output ? output->getWorkspace() : nullptr;
+    if (!workspace)
+      throw std::runtime_error(saved->loader() + " did not produce a workspace");
+  } catch (std::exception &ex) {
+    throw std::runtime_error("Unable to load " + name + " back from " + saved->fileName() + ": " + ex.what());
+  }
+  workspace->setName(name);
+  if (!m_ads.exchange(name, saved, workspace)) {
+    // Replaced or removed meanwhile
+    return m_ads.Kernel::DataService<Workspace>::retrieve(name);
+  }
+  g_log.information() << "Loaded " << name << " back from " << saved->fileName() << '\n';
+  saved.reset();
+  m_ads.postNotification(new AnalysisDataServiceImpl::RestoredNotification(name, workspace));
+  added(name);
+  enforceBudget(name);
+  return workspace;
+}
+
+} // namespace Mantid::API
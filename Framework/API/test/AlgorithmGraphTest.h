@@ -0,0 +1,213 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmGraph.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidFrameworkTestHelpers/FakeObjects.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+using namespace Mantid::API;
+using Mantid::Kernel::Direction;
+using NodeState = AlgorithmGraph::NodeState;
+
+namespace {
+/// Shared by the algorithms of a test, to see how they were run
+struct GraphTestRecord {
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::vector<std::string> finished;
+  int running{0}, maxRunning{0}, arrived{0};
+  bool released{false};
+};
+GraphTestRecord *g_record = nullptr;
+
+class GraphTestAlgorithm : public Algorithm {
+public:
+  const std::string name() const override { return "GraphTestAlgorithm"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "Cat"; }
+  const std::string summary() const override { return "Test summary"; }
+
+  void init() override {
+    declareProperty(
+        std::make_unique<WorkspaceProperty<>>("InputWorkspace", "", Direction::Input, PropertyMode::Optional));
+    declareProperty(std::make_unique<WorkspaceProperty<>>("OutputWorkspace", "", Direction::Output));
+    declareProperty("Fail", false);
+    declareProperty("Barrier", 0);
+    declareProperty("Hold", false);
+  }
+
+  void exec() override {
+    std::unique_lock<std::mutex> lock(g_record->mutex);
+    g_record->maxRunning = std::max(g_record->maxRunning, ++g_record->running);
+    const int barrier = getProperty("Barrier");
+    if (barrier > 0) {
+      // Wait for the given number of algorithms to run at the same time
+      ++g_record->arrived;
+      g_record->changed.notify_all();
+      if (!g_record->changed.wait_for(lock, std::chrono::seconds(10),
+                                      [barrier]() { return g_record->arrived >= barrier; })) {
+        --g_record->running;
+        throw std::runtime_error("timed out waiting at the barrier");
+      }
+    }
+    const bool hold = getProperty("Hold");
+    if (hold) {
+      // Wait for the test to release the algorithm
+      ++g_record->arrived;
+      g_record->changed.notify_all();
+      g_record->changed.wait(lock, []() { return g_record->released; });
+    }
+    --g_record->running;
+    g_record->finished.emplace_back(getPropertyValue("OutputWorkspace"));
+    lock.unlock();
+
+    const bool fail = getProperty("Fail");
+    if (fail)
+      throw std::runtime_error("failed on purpose");
+    auto output = std::make_shared<WorkspaceTester>();
+    output->initialize(1, 1, 1);
+    setProperty("OutputWorkspace", std::static_pointer_cast<MatrixWorkspace>(output));
+  }
+};
+} // namespace
+
+class AlgorithmGraphTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlgorithmGraphTest *createSuite() { return new AlgorithmGraphTest(); }
+  static void destroySuite(AlgorithmGraphTest *suite) { delete suite; }
+
+  void setUp() override {
+    m_record = std::make_unique<GraphTestRecord>();
+    g_record = m_record.get();
+  }
+
+  void tearDown() override {
+    AnalysisDataService::Instance().clear();
+    g_record = nullptr;
+  }
+
+  void test_dependencies_follow_workspace_names() {
+    AlgorithmGraph graph;
+    const auto a = graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "a"}});
+    const auto b = graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "b"}});
+    const auto c = graph.addAlgorithm(createAlgorithm(), {{"InputWorkspace", "a"}, {"OutputWorkspace", "c"}});
+    // Writing a workspace waits for the algorithms reading it
+    const auto d = graph.addAlgorithm(createAlgorithm(), {{"inputworkspace", "b"}, {"OutputWorkspace", "a"}});
+
+    TS_ASSERT_EQUALS(graph.size(), 4);
+    TS_ASSERT(graph.dependencies(a).empty());
+    TS_ASSERT(graph.dependencies(b).empty());
+    TS_ASSERT_EQUALS(graph.dependencies(c), std::vector<AlgorithmGraph::Node>{a});
+    TS_ASSERT_EQUALS(graph.dependencies(d), (std::vector<AlgorithmGraph::Node>{a, b, c}));
+  }
+
+  void test_addDependency() {
+    AlgorithmGraph graph;
+    const auto a = graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "a"}});
+    const auto b = graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "b"}});
+    graph.addDependency(a, b);
+    TS_ASSERT_EQUALS(graph.dependencies(b), std::vector<AlgorithmGraph::Node>{a});
+    TS_ASSERT_THROWS(graph.addDependency(b, a), const std::invalid_argument &);
+    TS_ASSERT_THROWS(graph.addDependency(a, 2), const std::out_of_range &);
+  }
+
+  void test_addAlgorithm_throws_for_unknown_property() {
+    AlgorithmGraph graph;
+    TS_ASSERT_THROWS(graph.addAlgorithm(createAlgorithm(), {{"NotAProperty", "a"}}), const std::invalid_argument &);
+    TS_ASSERT_THROWS(graph.addAlgorithm(createAlgorithm(), {}, 0), const std::invalid_argument &);
+    TS_ASSERT_EQUALS(graph.size(), 0);
+  }
+
+  void test_execute_runs_algorithms_after_their_dependencies() {
+    AlgorithmGraph graph;
+    graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "a"}});
+    graph.addAlgorithm(createAlgorithm(), {{"InputWorkspace", "a"}, {"OutputWorkspace", "b"}});
+    graph.addAlgorithm(createAlgorithm(), {{"InputWorkspace", "b"}, {"OutputWorkspace", "c"}});
+
+    TS_ASSERT(graph.execute(4));
+    TS_ASSERT_EQUALS(m_record->finished, (std::vector<std::string>{"a", "b", "c"}));
+    TS_ASSERT(AnalysisDataService::Instance().doesExist("c"));
+    for (AlgorithmGraph::Node node = 0; node < graph.size(); ++node)
+      TS_ASSERT_EQUALS(graph.state(node), NodeState::Finished);
+  }
+
+  void test_independent_algorithms_run_concurrently() {
+    AlgorithmGraph graph;
+    graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "a"}, {"Barrier", "2"}});
+    graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "b"}, {"Barrier", "2"}});
+
+    TS_ASSERT(graph.execute(2));
+    TS_ASSERT_EQUALS(m_record->maxRunning, 2);
+  }
+
+  void test_core_budget_limits_running_algorithms() {
+    AlgorithmGraph graph;
+    graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "a"}}, 2);
+    graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "b"}}, 2);
+    graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "c"}}, 2);
+
+    TS_ASSERT(graph.execute(3));
+    TS_ASSERT_EQUALS(m_record->maxRunning, 1);
+    TS_ASSERT_EQUALS(m_record->finished.size(), 3);
+  }
+
+  void test_failure_cancels_dependent_algorithms() {
+    AlgorithmGraph graph;
+    const auto a = graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "a"}, {"Fail", "1"}});
+    const auto b = graph.addAlgorithm(createAlgorithm(), {{"InputWorkspace", "a"}, {"OutputWorkspace", "b"}});
+    const auto c = graph.addAlgorithm(createAlgorithm(), {{"InputWorkspace", "b"}, {"OutputWorkspace", "c"}});
+    const auto d = graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "d"}});
+
+    TS_ASSERT_THROWS(graph.execute(2), const std::runtime_error &);
+    TS_ASSERT_EQUALS(graph.state(a), NodeState::Failed);
+    TS_ASSERT_EQUALS(graph.state(b), NodeState::Cancelled);
+    TS_ASSERT_EQUALS(graph.state(c), NodeState::Cancelled);
+    TS_ASSERT_EQUALS(graph.state(d), NodeState::Finished);
+    TS_ASSERT(!AnalysisDataService::Instance().doesExist("b"));
+  }
+
+  void test_cancelled_graph_does_not_run_waiting_algorithms() {
+    AlgorithmGraph graph;
+    const auto a = graph.addAlgorithm(createAlgorithm(), {{"OutputWorkspace", "a"}, {"Hold", "1"}});
+    const auto b = graph.addAlgorithm(createAlgorithm(), {{"InputWorkspace", "a"}, {"OutputWorkspace", "b"}});
+
+    auto result = std::async(std::launch::async, [&graph]() { return graph.execute(1); });
+    {
+      // Cancel while the first algorithm is running
+      std::unique_lock<std::mutex> lock(m_record->mutex);
+      m_record->changed.wait(lock, [this]() { return m_record->arrived == 1; });
+      graph.cancel();
+      m_record->released = true;
+      m_record->changed.notify_all();
+    }
+
+    TS_ASSERT(!result.get());
+    TS_ASSERT_EQUALS(graph.state(a), NodeState::Cancelled);
+    TS_ASSERT_EQUALS(graph.state(b), NodeState::Cancelled);
+    TS_ASSERT(!AnalysisDataService::Instance().doesExist("b"));
+  }
+
+private:
+  IAlgorithm_sptr createAlgorithm() { return std::make_shared<GraphTestAlgorithm>(); }
+
+  std::unique_ptr<GraphTestRecord> m_record;
+};
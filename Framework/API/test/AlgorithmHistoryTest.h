@@ -9,7 +9,9 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/AlgorithmHistory.h"
 #include "MantidAPI/WorkspaceProperty.h"
+#include "MantidKernel/ArrayProperty.h"
 #include <cxxtest/TestSuite.h>
+#include <numeric>
 #include <sstream>
 
 using namespace Mantid::API;
@@ -32,6 +34,22 @@ public:
   void exec() override {}
 };
 
+// Algorithm with array properties, of which the histories are deferred
+class testarrayalg : public Algorithm {
+public:
+  const std::string name() const override { return "testarrayalg"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "Cat"; }
+  const std::string summary() const override { return "Test summary"; }
+
+  void init() override {
+    declareProperty(std::make_unique<ArrayProperty<double>>("values"));
+    declareProperty(std::make_unique<ArrayProperty<int>>("indices", "1,2,3"));
+    declareProperty("label", "x");
+  }
+  void exec() override {}
+};
+
 class AlgorithmHistoryTest : public CxxTest::TestSuite {
 public:
   AlgorithmHistoryTest() : m_correctOutput(), m_execCount(0) {}
@@ -179,6 +197,49 @@ public:
     TS_ASSERT_EQUALS(alg->getPropertyValue("arg1_param"), "child1");
   }
 
+  void test_array_property_histories_keep_values_at_creation() {
+    testarrayalg alg;
+    alg.initialize();
+    alg.setPropertyValue("values", "1.5,2.5");
+    AlgorithmHistory history(&alg);
+    alg.setPropertyValue("values", "3.5");
+    alg.setPropertyValue("indices", "4");
+
+    TS_ASSERT_EQUALS(history.getPropertyValue("values"), "1.5,2.5");
+    TS_ASSERT_EQUALS(history.getPropertyValue("indices"), "1-3");
+    TS_ASSERT_EQUALS(history.getPropertyValue("label"), "x");
+    const auto &properties = history.getProperties();
+    TS_ASSERT_EQUALS(properties.size(), 3);
+    TS_ASSERT_EQUALS(properties[0]->name(), "values");
+    TS_ASSERT(!properties[0]->isDefault());
+    TS_ASSERT(properties[1]->isDefault());
+    TS_ASSERT_EQUALS(properties[1]->type(), "int list");
+  }
+
+  void test_copies_share_array_property_histories() {
+    testarrayalg alg;
+    alg.initialize();
+    AlgorithmHistory history(&alg);
+    const AlgorithmHistory copy(history);
+    AlgorithmHistory assigned = createTestHistory();
+    assigned = history;
+
+    TS_ASSERT_EQUALS(copy.getProperties()[0], history.getProperties()[0]);
+    TS_ASSERT_EQUALS(assigned.getProperties()[1], history.getProperties()[1]);
+  }
+
+  void test_addProperty_after_array_properties() {
+    testarrayalg alg;
+    alg.initialize();
+    AlgorithmHistory history(&alg);
+    history.addProperty("extra", "value", false);
+
+    const auto &properties = history.getProperties();
+    TS_ASSERT_EQUALS(properties.size(), 4);
+    TS_ASSERT_EQUALS(properties[1]->value(), "1-3");
+    TS_ASSERT_EQUALS(history.getPropertyValue("extra"), "value");
+  }
+
 private:
   AlgorithmHistory createTestHistory() {
     m_correctOutput = "Algorithm: testalg ";
@@ -240,3 +301,57 @@ private:
   std::string m_correctOutput;
   size_t m_execCount;
 };
+
+class AlgorithmHistoryTestPerformance : public CxxTest::TestSuite {
+public:
+  static AlgorithmHistoryTestPerformance *createSuite() { return new AlgorithmHistoryTestPerformance(); }
+  static void destroySuite(AlgorithmHistoryTestPerformance *suite) { delete suite; }
+
+  AlgorithmHistoryTestPerformance() : m_values(100000) {
+    AlgorithmFactory::Instance().subscribe<testarrayalg>();
+    std::iota(m_values.begin(), m_values.end(), 0.5);
+    m_parent.initialize();
+  }
+
+  ~AlgorithmHistoryTestPerformance() override { AlgorithmFactory::Instance().unsubscribe("testarrayalg", 1); }
+
+  void test_child_algorithm_dispatch() { runChildAlgorithms(false); }
+
+  void test_child_algorithm_dispatch_with_history() { runChildAlgorithms(true); }
+
+  void test_create_history_of_large_array() {
+    testarrayalg alg;
+    alg.initialize();
+    alg.setProperty("values", m_values);
+    // The property histories are not built, so this times the deferred path
+    for (size_t i = 0; i < 200; ++i) {
+      AlgorithmHistory history(&alg);
+      AlgorithmHistory copy(history);
+      TS_ASSERT_EQUALS(copy.name(), "testarrayalg");
+    }
+  }
+
+  void test_get_properties_of_history_of_large_array() {
+    testarrayalg alg;
+    alg.initialize();
+    alg.setProperty("values", m_values);
+    for (size_t i = 0; i < 200; ++i) {
+      AlgorithmHistory history(&alg);
+      TS_ASSERT_EQUALS(history.getProperties().size(), 3);
+    }
+  }
+
+private:
+  void runChildAlgorithms(bool recordHistory) {
+    const std::vector<double> values{1., 2., 3., 4., 5.};
+    for (size_t i = 0; i < 10000; ++i) {
+      auto child = m_parent.createChildAlgorithm("testarrayalg");
+      child->enableHistoryRecordingForChild(recordHistory);
+      child->setProperty("values", values);
+      child->execute();
+    }
+  }
+
+  testalg m_parent;
+  std::vector<double> m_values;
+};
@@ -10,6 +10,7 @@
 
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/WorkspaceGroup.h"
+#include <Poco/NObserver.h>
 #include <memory>
 
 using namespace Mantid::Kernel;
@@ -33,6 +34,7 @@ using MockWorkspace_sptr = std::shared_ptr<MockWorkspace>;
 class AnalysisDataServiceTest : public CxxTest::TestSuite {
 private:
   AnalysisDataServiceImpl &ads;
+  std::vector<bool> m_membersPresent;
 
 public:
   static AnalysisDataServiceTest *createSuite() { return new AnalysisDataServiceTest(); }
@@ -401,6 +403,33 @@ public:
     ads.clear();
   }
 
+  void test_addOrReplace_group_makes_members_visible_with_the_group() {
+    Poco::NObserver<AnalysisDataServiceTest, WorkspaceAddNotification> observer(
+        *this, &AnalysisDataServiceTest::handleAddNotification);
+    ads.notificationCenter.addObserver(observer);
+    m_membersPresent.clear();
+
+    addOrReplaceGroupToADS("group");
+    ads.notificationCenter.removeObserver(observer);
+    TS_ASSERT_EQUALS(m_membersPresent, (std::vector<bool>{true, true, true}));
+  }
+
+  void handleAddNotification(const Poco::AutoPtr<WorkspaceAddNotification> &) {
+    m_membersPresent.emplace_back(ads.doesExist("group") && ads.doesExist("group_1") && ads.doesExist("group_2"));
+  }
+
+  void test_deepRemoveGroup_clears_member_names() {
+    auto group = addGroupWithGroupToADS("group");
+    auto nested = std::dynamic_pointer_cast<WorkspaceGroup>(group->getItem(1));
+    TS_ASSERT_THROWS_NOTHING(ads.deepRemoveGroup("group"));
+    TS_ASSERT_EQUALS(ads.size(), 0);
+    TS_ASSERT(group->getName().empty());
+    TS_ASSERT(nested->getName().empty());
+    TS_ASSERT(nested->getItem(0)->getName().empty());
+    // The groups no longer observe the ADS
+    TS_ASSERT_EQUALS(nested->size(), 2);
+  }
+
   void test_removeFromGroup() {
     auto group = addGroupToADS("group");
     TS_ASSERT_EQUALS(ads.size(), 3);
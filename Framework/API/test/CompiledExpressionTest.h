@@ -0,0 +1,139 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/CompiledExpression.h"
+#include "MantidAPI/Jacobian.h"
+
+#include <cmath>
+#include <functional>
+
+using Mantid::API::CompiledExpression;
+
+class CompiledExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompiledExpressionTest *createSuite() { return new CompiledExpressionTest(); }
+  static void destroySuite(CompiledExpressionTest *suite) { delete suite; }
+
+  class TestJacobian : public Mantid::API::Jacobian {
+  public:
+    TestJacobian(size_t nData, size_t nParams) : m_nParams(nParams), m_data(nData * nParams, -1.0) {}
+    void set(size_t iY, size_t iP, double value) override { m_data[iY * m_nParams + iP] = value; }
+    double get(size_t iY, size_t iP) override { return m_data[iY * m_nParams + iP]; }
+    void zero() override { m_data.assign(m_data.size(), 0.0); }
+
+  private:
+    size_t m_nParams;
+    std::vector<double> m_data;
+  };
+
+  void test_values_match_direct_evaluation() {
+    // More values than fit in one block
+    const auto x = values(1000);
+    const std::vector<double> p{1.3, -0.4, 0.7};
+    checkValues("a*x+b", x, p, [&](double v) { return p[0] * v + p[1]; });
+    checkValues("a-b-c*x", x, p, [&](double v) { return p[0] - p[1] - p[2] * v; });
+    checkValues("a/b/x", x, p, [&](double v) { return p[0] / p[1] / v; });
+    checkValues("a*exp(-(x-b)^2/(2*c^2))", x, p,
+                [&](double v) { return p[0] * std::exp(-std::pow(v - p[1], 2) / (2 * p[2] * p[2])); });
+    checkValues("sin(x)*cos(a)+sqrt(abs(x))-_pi*atan(x^c)+erf(b*x)", x, p, [&](double v) {
+      return std::sin(v) * std::cos(p[0]) + std::sqrt(std::fabs(v)) - M_PI * std::atan(std::pow(v, p[2])) +
+             std::erf(p[1] * v);
+    });
+    checkValues("1.5e-1*x^3-log10(x)+ln(x)", x, p,
+                [&](double v) { return 0.15 * v * v * v - std::log10(v) + std::log(v); });
+    // Unary minus binds more weakly than ^, as in muParser
+    checkValues("-x^2+(-a)^2", x, p, [&](double v) { return -v * v + p[0] * p[0]; });
+    checkValues("x^-c", x, p, [&](double v) { return std::pow(v, -p[2]); });
+    checkValues("x", x, p, [](double v) { return v; });
+    checkValues("a*2", x, p, [&](double) { return p[0] * 2; });
+  }
+
+  void test_derivatives_match_analytic_derivatives() {
+    const auto x = values(300);
+    const std::vector<double> p{1.3, -0.4, 0.7};
+    CompiledExpression expression("a*exp(-(x-b)^2/(2*c^2))+b*sin(c*x)", "x", {"a", "b", "c"});
+    TestJacobian jacobian(x.size(), 3);
+    expression.evaluateDerivatives(jacobian, x.data(), x.size(), p.data());
+    const double a = p[0], b = p[1], c = p[2];
+    for (size_t i = 0; i < x.size(); ++i) {
+      const double g = std::exp(-(x[i] - b) * (x[i] - b) / (2 * c * c));
+      TS_ASSERT_DELTA(jacobian.get(i, 0), g, 1e-12);
+      TS_ASSERT_DELTA(jacobian.get(i, 1), a * g * (x[i] - b) / (c * c) + std::sin(c * x[i]), 1e-12);
+      TS_ASSERT_DELTA(jacobian.get(i, 2),
+                      a * g * (x[i] - b) * (x[i] - b) / (c * c * c) + b * x[i] * std::cos(c * x[i]), 1e-12);
+    }
+  }
+
+  void test_derivatives_are_finite_where_the_base_is_zero() {
+    const std::vector<double> x{0.0, 0.5, 1.2};
+    const std::vector<double> p{2.0, 0.8, 1.5, 3.0};
+    CompiledExpression expression("a*exp(-(l*x)^b)+sqrt(c*x)", "x", {"a", "l", "b", "c"});
+    TestJacobian jacobian(x.size(), 4);
+    expression.evaluateDerivatives(jacobian, x.data(), x.size(), p.data());
+    const double a = p[0], l = p[1], b = p[2], c = p[3];
+    for (size_t i = 0; i < x.size(); ++i) {
+      const double u = l * x[i];
+      const double g = std::exp(-std::pow(u, b));
+      TS_ASSERT_DELTA(jacobian.get(i, 0), g, 1e-12);
+      TS_ASSERT_DELTA(jacobian.get(i, 1), -a * g * b * std::pow(u, b - 1) * x[i], 1e-12);
+      TS_ASSERT_DELTA(jacobian.get(i, 2), (u == 0.0 ? 0.0 : -a * g * std::pow(u, b) * std::log(u)), 1e-12);
+      TS_ASSERT_DELTA(jacobian.get(i, 3), (x[i] == 0.0 ? 0.0 : x[i] / (2 * std::sqrt(c * x[i]))), 1e-12);
+    }
+  }
+
+  void test_derivative_of_unused_variable_is_zero() {
+    const auto x = values(10);
+    const std::vector<double> p{2.0, 3.0};
+    CompiledExpression expression("a*x^2", "x", {"a", "unused"});
+    TestJacobian jacobian(x.size(), 2);
+    expression.evaluateDerivatives(jacobian, x.data(), x.size(), p.data());
+    for (size_t i = 0; i < x.size(); ++i) {
+      TS_ASSERT_DELTA(jacobian.get(i, 0), x[i] * x[i], 1e-14);
+      TS_ASSERT_EQUALS(jacobian.get(i, 1), 0.0);
+    }
+  }
+
+  void test_common_subexpressions_are_evaluated_once() {
+    CompiledExpression shared("exp(a*x)+exp(a*x)", "x", {"a"});
+    CompiledExpression single("exp(a*x)", "x", {"a"});
+    // One extra instruction for the addition
+    TS_ASSERT_EQUALS(shared.nInstructions(), single.nInstructions() + 1);
+    // Subexpressions of the scalars alone are not evaluated per value
+    CompiledExpression uniform("sin(a)*cos(a)*x", "x", {"a"});
+    TS_ASSERT_EQUALS(uniform.nInstructions(), 1);
+  }
+
+  void test_unsupported_expressions_throw() {
+    TS_ASSERT_THROWS(CompiledExpression("a*x+b", "x", {"a"}), const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledExpression("max(x,a)", "x", {"a"}), const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledExpression("x>a", "x", {"a"}), const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledExpression("x?a:1", "x", {"a"}), const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledExpression("a*(x", "x", {"a"}), const std::invalid_argument &);
+  }
+
+private:
+  std::vector<double> values(size_t n) {
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i)
+      x[i] = 0.1 + 0.01 * static_cast<double>(i);
+    return x;
+  }
+
+  void checkValues(const std::string &formula, const std::vector<double> &x, const std::vector<double> &p,
+                   const std::function<double(double)> &expected) {
+    CompiledExpression expression(formula, "x", {"a", "b", "c"});
+    std::vector<double> out(x.size());
+    expression.evaluate(out.data(), x.data(), x.size(), p.data());
+    for (size_t i = 0; i < x.size(); ++i)
+      TSM_ASSERT_DELTA(formula, out[i], expected(x[i]), 1e-12 * std::max(1.0, std::fabs(out[i])));
+  }
+};
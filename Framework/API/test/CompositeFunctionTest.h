@@ -10,7 +10,9 @@
 
 #include "MantidAPI/CompositeFunction.h"
 #include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/Jacobian.h"
 #include "MantidAPI/IFunction1D.h"
 #include "MantidAPI/IPeakFunction.h"
 #include "MantidAPI/MatrixWorkspace.h"
@@ -226,6 +228,28 @@ public:
   }
 };
 
+/// Linear function counting its evaluations
+class CountingLinear : public Linear<> {
+public:
+  void function1D(double *out, const double *xValues, const size_t nData) const override {
+    ++evaluations;
+    Linear<>::function1D(out, xValues, nData);
+  }
+  mutable size_t evaluations = 0;
+};
+
+class CompositeFunctionTest_Jacobian : public Jacobian {
+public:
+  CompositeFunctionTest_Jacobian(size_t nY, size_t nP) : m_nP(nP), m_values(nY * nP) {}
+  void set(size_t iY, size_t iP, double value) override { m_values[iY * m_nP + iP] = value; }
+  double get(size_t iY, size_t iP) override { return m_values[iY * m_nP + iP]; }
+  void zero() override { std::fill(m_values.begin(), m_values.end(), 0.0); }
+
+private:
+  size_t m_nP;
+  std::vector<double> m_values;
+};
+
 class CompositeFunctionTest : public CxxTest::TestSuite {
 public:
   static CompositeFunctionTest *createSuite() { return new CompositeFunctionTest(); }
@@ -1555,6 +1579,46 @@ public:
                             "CompositeFunction has members with inconsistent domain numbers.");
   }
 
+  void test_numerical_derivatives_only_evaluate_affected_members() {
+    CompositeFunction fun;
+    std::vector<std::shared_ptr<CountingLinear>> members;
+    for (size_t i = 0; i < 4; ++i) {
+      members.emplace_back(std::make_shared<CountingLinear>());
+      members.back()->setParameter("a", static_cast<double>(i));
+      members.back()->setParameter("b", 0.5 * static_cast<double>(i + 1));
+      fun.addFunction(members.back());
+    }
+    fun.setAttributeValue("NumDeriv", true);
+    // f3.a follows f0.b, so stepping f0.b must re-evaluate f3 as well
+    fun.tie("f3.a", "2*f0.b");
+    fun.fix(fun.parameterIndex("f2.b"));
+
+    FunctionDomain1DVector domain(0.0, 1.0, 5);
+    CompositeFunctionTest_Jacobian jacobian(domain.size(), fun.nParams());
+    fun.functionDeriv(domain, jacobian);
+
+    // One evaluation for the values plus one per active parameter of the
+    // member, plus one for f3 when f0.b steps
+    TS_ASSERT_EQUALS(members[0]->evaluations, 3);
+    TS_ASSERT_EQUALS(members[1]->evaluations, 3);
+    TS_ASSERT_EQUALS(members[2]->evaluations, 2);
+    TS_ASSERT_EQUALS(members[3]->evaluations, 3);
+
+    const auto f0b = fun.parameterIndex("f0.b");
+    const auto f1a = fun.parameterIndex("f1.a");
+    const auto f1b = fun.parameterIndex("f1.b");
+    for (size_t i = 0; i < domain.size(); ++i) {
+      const double x = domain[i];
+      TS_ASSERT_DELTA(jacobian.get(i, fun.parameterIndex("f0.a")), 1.0, 1e-6);
+      TS_ASSERT_DELTA(jacobian.get(i, f0b), x + 2.0, 1e-6);
+      TS_ASSERT_DELTA(jacobian.get(i, f1a), 1.0, 1e-6);
+      TS_ASSERT_DELTA(jacobian.get(i, f1b), x, 1e-6);
+    }
+    // Parameters are restored
+    TS_ASSERT_EQUALS(fun.getParameter("f0.b"), 0.5);
+    TS_ASSERT_EQUALS(fun.getParameter("f3.a"), 1.0);
+  }
+
 private:
   CompositeFunction_sptr createComposite() {
     auto composite = std::make_unique<CompositeFunction>();
@@ -290,6 +290,26 @@ public:
     detectorInfo.setRotation(0, oldRot);
   }
 
+  void test_rotateDetectors() {
+    auto &detectorInfo = m_workspace.mutableDetectorInfo();
+    const auto oldPos = detectorInfo.position(1);
+    const auto oldRot = detectorInfo.rotation(1);
+    const auto otherPos = detectorInfo.position(2);
+    const V3D centre(0.0, 0.0, 1.0);
+    const Quat rotation(90.0, V3D(0, 1, 0));
+    detectorInfo.rotateDetectors({1}, centre, {rotation});
+    auto expected = oldPos - centre;
+    rotation.rotate(expected);
+    expected += centre;
+    TS_ASSERT_EQUALS(detectorInfo.position(1), expected);
+    TS_ASSERT_EQUALS(detectorInfo.rotation(1), rotation * oldRot);
+    TS_ASSERT_EQUALS(detectorInfo.position(2), otherPos);
+    detectorInfo.rotateDetectors({1}, centre, {Quat(-90.0, V3D(0, 1, 0))});
+    TS_ASSERT_EQUALS(detectorInfo.position(1), oldPos);
+    TS_ASSERT_EQUALS(detectorInfo.rotation(1), oldRot);
+    TS_ASSERT_THROWS(detectorInfo.rotateDetectors({1}, centre, {rotation, rotation}), const std::invalid_argument &);
+  }
+
   void test_setPosition_component() {
     auto &detInfo = m_workspace.mutableDetectorInfo();
     const auto &instrument = m_workspace.getInstrument();
@@ -0,0 +1,85 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/DualNumber.h"
+
+#include <functional>
+
+using Mantid::API::DualNumber;
+
+namespace {
+using Dual = DualNumber<2>;
+
+/// Central difference of f with respect to the i-th of (x, y)
+double centralDifference(const std::function<double(double, double)> &f, double x, double y, size_t i) {
+  constexpr double h = 1e-6;
+  if (i == 0)
+    return (f(x + h, y) - f(x - h, y)) / (2 * h);
+  return (f(x, y + h) - f(x, y - h)) / (2 * h);
+}
+
+template <typename T> T model(const T &x, const T &y) {
+  using std::atan;
+  using std::cos;
+  using std::erf;
+  using std::exp;
+  using std::log;
+  using std::pow;
+  using std::sin;
+  using std::sqrt;
+  return (x * y + 2.0 * sin(x) - cos(y) / 3.0) * exp(-x / y) + sqrt(x) * log(y) - atan(x - y) + erf(y) +
+         pow(x, 2.5) / (1.0 + pow(x, y));
+}
+} // namespace
+
+class DualNumberTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static DualNumberTest *createSuite() { return new DualNumberTest(); }
+  static void destroySuite(DualNumberTest *suite) { delete suite; }
+
+  void test_constant_has_zero_gradient() {
+    const Dual c(3.0);
+    TS_ASSERT_EQUALS(c.value(), 3.0);
+    TS_ASSERT_EQUALS(c.derivative(0), 0.0);
+    TS_ASSERT_EQUALS(c.derivative(1), 0.0);
+  }
+
+  void test_arithmetic() {
+    const auto x = Dual::variable(2.0, 0);
+    const auto y = Dual::variable(5.0, 1);
+    const auto f = (x * y - 1.0) / (x + y);
+    TS_ASSERT_DELTA(f.value(), 9.0 / 7.0, 1e-15);
+    // d/dx = (y(x+y) - (xy-1)) / (x+y)^2
+    TS_ASSERT_DELTA(f.derivative(0), (5.0 * 7.0 - 9.0) / 49.0, 1e-15);
+    TS_ASSERT_DELTA(f.derivative(1), (2.0 * 7.0 - 9.0) / 49.0, 1e-15);
+  }
+
+  void test_gradient_matches_finite_differences() {
+    const double x0 = 0.7;
+    const double y0 = 1.3;
+    const auto f = model(Dual::variable(x0, 0), Dual::variable(y0, 1));
+    const auto reference = [](double x, double y) { return model(x, y); };
+    TS_ASSERT_DELTA(f.value(), model(x0, y0), 1e-14);
+    TS_ASSERT_DELTA(f.derivative(0), centralDifference(reference, x0, y0, 0), 1e-7);
+    TS_ASSERT_DELTA(f.derivative(1), centralDifference(reference, x0, y0, 1), 1e-7);
+  }
+
+  void test_pow_of_zero_has_finite_gradient() {
+    // (a * x)^b at x = 0 does not depend on a or b
+    const auto a = Dual::variable(2.0, 0);
+    const auto b = Dual::variable(0.5, 1);
+    const auto f = pow(a * 0.0, b);
+    TS_ASSERT_EQUALS(f.value(), 0.0);
+    TS_ASSERT_EQUALS(f.derivative(0), 0.0);
+    TS_ASSERT_EQUALS(f.derivative(1), 0.0);
+  }
+};
@@ -338,6 +338,24 @@ public:
     TS_ASSERT_EQUALS(exptInfo->getEFixed(test_id), test_ef);
   }
 
+  void test_getEfixed_in_indirect_mode_follows_changes_to_the_parameters() {
+    ExperimentInfo_sptr exptInfo(new ExperimentInfo);
+    Instrument_sptr inst = addInstrumentWithIndirectEmodeParameter(exptInfo);
+    ParameterMap &pmap = exptInfo->instrumentParameters();
+    pmap.addDouble(inst.get(), "Efixed", 32.7);
+    const Mantid::detid_t test_id = 3;
+    IDetector_const_sptr det = exptInfo->getInstrument()->getDetector(test_id);
+    TS_ASSERT_EQUALS(exptInfo->getEFixed(det), 32.7);
+
+    pmap.addDouble(det.get(), "Efixed", 12.1);
+    TS_ASSERT_EQUALS(exptInfo->getEFixed(det), 12.1);
+    // EFixed-val takes precedence over Efixed
+    pmap.addDouble(inst.get(), "EFixed-val", 4.2);
+    TS_ASSERT_EQUALS(exptInfo->getEFixed(test_id), 4.2);
+    pmap.clearParametersByName("EFixed-val");
+    TS_ASSERT_EQUALS(exptInfo->getEFixed(test_id), 12.1);
+  }
+
   void test_accessing_SpectrumInfo_creates_default_grouping() {
     using namespace Mantid;
     ExperimentInfo_sptr exptInfo(new ExperimentInfo);
@@ -761,4 +779,25 @@ public:
     BoundingBox box;
     m_provisionedInstrument->getBoundingBox(box);
   }
+
+  void test_getEFixed_indirect_for_every_detector() {
+    ExperimentInfo expInfo;
+    expInfo.setInstrument(m_bareInstrument);
+    auto &pmap = expInfo.instrumentParameters();
+    pmap.addString(m_bareInstrument.get(), "deltaE-mode", "indirect");
+    pmap.addDouble(m_bareInstrument.get(), "Efixed", 1.845);
+    const auto instrument = expInfo.getInstrument();
+    const auto detectorIDs = instrument->getDetectorIDs(true);
+    std::vector<Mantid::Geometry::IDetector_const_sptr> detectors;
+    detectors.reserve(detectorIDs.size());
+    for (const auto id : detectorIDs)
+      detectors.emplace_back(instrument->getDetector(id));
+
+    size_t mismatches = 0;
+    for (const auto &detector : detectors) {
+      if (expInfo.getEFixedGivenEMode(detector, Mantid::Kernel::DeltaEMode::Indirect) != 1.845)
+        ++mismatches;
+    }
+    TS_ASSERT_EQUALS(mismatches, 0);
+  }
 };
@@ -0,0 +1,113 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/LiveListenerBuffer.h"
+#include "MantidFrameworkTestHelpers/FakeObjects.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+
+using namespace Mantid::API;
+using Mantid::Kernel::TimeSeriesProperty;
+
+using Buffer = LiveListenerBuffer<WorkspaceTester>;
+
+class LiveListenerBufferTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LiveListenerBufferTest *createSuite() { return new LiveListenerBufferTest(); }
+  static void destroySuite(LiveListenerBufferTest *suite) { delete suite; }
+
+  LiveListenerBufferTest() {
+    if (!WorkspaceFactory::Instance().exists("WorkspaceTester"))
+      WorkspaceFactory::Instance().subscribe<WorkspaceTester>("WorkspaceTester");
+  }
+
+  void test_swap_returns_filled_buffer() {
+    Buffer bufferSwap;
+    auto buffer = createBuffer(3);
+    const auto filled = buffer;
+
+    TS_ASSERT_EQUALS(bufferSwap.swap(buffer), filled);
+    TS_ASSERT_DIFFERS(buffer, filled);
+    TS_ASSERT_EQUALS(buffer->getNumberHistograms(), 3);
+    TS_ASSERT_EQUALS(buffer->getSpectrum(2).getSpectrumNo(), 12);
+  }
+
+  void test_swap_keeps_latest_log_value() {
+    Buffer bufferSwap(Buffer::Logs::KeepLatestValue);
+    auto buffer = createBuffer(2);
+    const auto filled = bufferSwap.swap(buffer);
+
+    TS_ASSERT_EQUALS(filled->run().getTimeSeriesProperty<double>("temperature")->size(), 2);
+    const auto *log = buffer->run().getTimeSeriesProperty<double>("temperature");
+    TS_ASSERT_EQUALS(log->size(), 1);
+    TS_ASSERT_EQUALS(log->lastValue(), 2.0);
+  }
+
+  void test_swap_clears_log_values() {
+    Buffer bufferSwap(Buffer::Logs::ClearValues);
+    auto buffer = createBuffer(2);
+    bufferSwap.swap(buffer);
+
+    TS_ASSERT(buffer->run().hasProperty("temperature"));
+    TS_ASSERT_EQUALS(buffer->run().getTimeSeriesProperty<double>("temperature")->size(), 0);
+  }
+
+  void test_prepared_buffer_gets_logs_added_after_prepare() {
+    Buffer bufferSwap;
+    auto buffer = createBuffer(2);
+    bufferSwap.prepare(bufferSwap.swap(buffer));
+    buffer->mutableRun().getTimeSeriesProperty<double>("temperature")->addValue("2024-01-01T00:00:10", 3.0);
+
+    const auto filled = buffer;
+    TS_ASSERT_EQUALS(bufferSwap.swap(buffer), filled);
+    TS_ASSERT_EQUALS(buffer->getNumberHistograms(), 2);
+    TS_ASSERT_EQUALS(buffer->run().getTimeSeriesProperty<double>("temperature")->lastValue(), 3.0);
+  }
+
+  void test_prepared_buffers_are_not_used_for_replaced_buffers() {
+    Buffer bufferSwap;
+    std::vector<std::shared_ptr<WorkspaceTester>> buffers{createBuffer(2), createBuffer(2)};
+    bufferSwap.prepare(bufferSwap.swap(buffers));
+
+    // e.g. a new run with a different instrument
+    buffers[1] = createBuffer(5);
+    const auto filled = bufferSwap.swap(buffers);
+    TS_ASSERT_EQUALS(filled.size(), 2);
+    TS_ASSERT_EQUALS(buffers[0]->getNumberHistograms(), 2);
+    TS_ASSERT_EQUALS(buffers[1]->getNumberHistograms(), 5);
+  }
+
+  void test_initializer_is_applied_to_empty_buffers() {
+    int calls = 0;
+    Buffer bufferSwap(Buffer::Logs::KeepLatestValue, [&calls](WorkspaceTester &empty, const WorkspaceTester &filled) {
+      TS_ASSERT_EQUALS(empty.getNumberHistograms(), filled.getNumberHistograms());
+      ++calls;
+    });
+    auto buffer = createBuffer(2);
+    bufferSwap.prepare(bufferSwap.swap(buffer));
+    TS_ASSERT_EQUALS(calls, 2);
+    bufferSwap.swap(buffer);
+    TS_ASSERT_EQUALS(calls, 2);
+  }
+
+private:
+  std::shared_ptr<WorkspaceTester> createBuffer(size_t numberOfSpectra) {
+    auto buffer = std::make_shared<WorkspaceTester>();
+    buffer->initialize(numberOfSpectra, 2, 1);
+    for (size_t i = 0; i < numberOfSpectra; ++i)
+      buffer->getSpectrum(i).setSpectrumNo(static_cast<Mantid::specnum_t>(10 + i));
+    auto log = std::make_unique<TimeSeriesProperty<double>>("temperature");
+    log->addValue("2024-01-01T00:00:00", 1.0);
+    log->addValue("2024-01-01T00:00:01", 2.0);
+    buffer->mutableRun().addProperty(std::move(log));
+    return buffer;
+  }
+};
@@ -0,0 +1,260 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmFactory.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/WorkspaceGroup.h"
+#include "MantidAPI/WorkspaceMemoryManager.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidFrameworkTestHelpers/FakeObjects.h"
+
+#include <Poco/NObserver.h>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace Mantid::API;
+using Mantid::Kernel::Direction;
+
+namespace {
+/// Stands in for SaveNexusProcessed, which is not available to these tests
+class FakeSaveNexusProcessed : public Algorithm {
+public:
+  const std::string name() const override { return "SaveNexusProcessed"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "Cat"; }
+  const std::string summary() const override { return "Test summary"; }
+
+  void init() override {
+    declareProperty(std::make_unique<WorkspaceProperty<MatrixWorkspace>>("InputWorkspace", "", Direction::Input));
+    declareProperty("Filename", "");
+  }
+
+  void exec() override {
+    MatrixWorkspace_const_sptr ws = getProperty("InputWorkspace");
+    std::ofstream file(getPropertyValue("Filename"));
+    file << ws->getNumberHistograms() << ' ' << ws->blocksize() << ' ' << ws->y(0)[0];
+  }
+};
+
+/// Stands in for LoadNexusProcessed
+class FakeLoadNexusProcessed : public Algorithm {
+public:
+  const std::string name() const override { return "LoadNexusProcessed"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "Cat"; }
+  const std::string summary() const override { return "Test summary"; }
+
+  void init() override {
+    declareProperty("Filename", "");
+    declareProperty(std::make_unique<WorkspaceProperty<Workspace>>("OutputWorkspace", "", Direction::Output));
+  }
+
+  void exec() override {
+    std::ifstream file(getPropertyValue("Filename"));
+    size_t numberHistograms = 0, blocksize = 0;
+    double y = 0;
+    file >> numberHistograms >> blocksize >> y;
+    auto ws = std::make_shared<WorkspaceTester>();
+    ws->initialize(numberHistograms, blocksize + 1, blocksize);
+    ws->mutableY(0)[0] = y;
+    setProperty("OutputWorkspace", std::static_pointer_cast<Workspace>(ws));
+  }
+};
+} // namespace
+
+class WorkspaceMemoryManagerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static WorkspaceMemoryManagerTest *createSuite() { return new WorkspaceMemoryManagerTest(); }
+  static void destroySuite(WorkspaceMemoryManagerTest *suite) { delete suite; }
+
+  WorkspaceMemoryManagerTest() : ads(AnalysisDataService::Instance()) {
+    AlgorithmFactory::Instance().subscribe<FakeSaveNexusProcessed>();
+    AlgorithmFactory::Instance().subscribe<FakeLoadNexusProcessed>();
+  }
+
+  ~WorkspaceMemoryManagerTest() override {
+    AlgorithmFactory::Instance().unsubscribe("SaveNexusProcessed", 1);
+    AlgorithmFactory::Instance().unsubscribe("LoadNexusProcessed", 1);
+  }
+
+  void setUp() override {
+    ads.clear();
+    m_evicted.clear();
+    m_restored.clear();
+    m_replaced = 0;
+  }
+
+  void tearDown() override {
+    ads.setMemoryBudget(0);
+    ads.clear();
+  }
+
+  void test_memoryUsage_sums_the_workspaces() {
+    auto a = createWorkspace(1);
+    auto b = createWorkspace(2);
+    ads.add("a", a);
+    ads.add("b", b);
+    TS_ASSERT_EQUALS(ads.memoryUsage(), a->getMemorySize() + b->getMemorySize());
+
+    // Groups are not counted twice
+    auto group = std::make_shared<WorkspaceGroup>();
+    group->addWorkspace(createWorkspace(3));
+    ads.add("group", group);
+    TS_ASSERT_EQUALS(ads.memoryUsage(), a->getMemorySize() + b->getMemorySize() + group->getMemorySize());
+    a.reset();
+    ads.remove("a");
+    TS_ASSERT_EQUALS(ads.memoryUsage(), b->getMemorySize() + group->getMemorySize());
+  }
+
+  void test_least_recently_used_workspace_is_saved_over_the_budget() {
+    Poco::NObserver<WorkspaceMemoryManagerTest, WorkspaceEvictedNotification> observer(
+        *this, &WorkspaceMemoryManagerTest::handleEvicted);
+    ads.notificationCenter.addObserver(observer);
+    const size_t size = createWorkspace(0)->getMemorySize();
+    ads.setMemoryBudget(2 * size + size / 2);
+
+    ads.add("a", createWorkspace(1));
+    ads.add("b", createWorkspace(2));
+    ads.retrieve("a");
+    ads.add("c", createWorkspace(3));
+    ads.notificationCenter.removeObserver(observer);
+
+    // b was used last longest ago
+    TS_ASSERT_EQUALS(m_evicted, std::vector<std::string>{"b"});
+    TS_ASSERT_LESS_THAN_EQUALS(ads.memoryUsage(), ads.memoryBudget());
+    TS_ASSERT_EQUALS(WorkspaceMemoryManager::numberSaved(), 1);
+    TS_ASSERT(ads.doesExist("b"));
+    TS_ASSERT_EQUALS(ads.getObjects().size(), 3);
+  }
+
+  void test_saved_workspace_is_loaded_back_when_retrieved() {
+    const size_t size = createWorkspace(0)->getMemorySize();
+    ads.setMemoryBudget(size + size / 2);
+    ads.add("a", createWorkspace(1));
+    ads.add("b", createWorkspace(2));
+    TS_ASSERT_EQUALS(WorkspaceMemoryManager::numberSaved(), 1);
+
+    auto a = ads.retrieveWS<MatrixWorkspace>("a");
+    TS_ASSERT(a);
+    TS_ASSERT_EQUALS(a->getName(), "a");
+    TS_ASSERT_EQUALS(a->y(0)[0], 1);
+    // b is saved in turn, a is held here
+    TS_ASSERT_EQUALS(WorkspaceMemoryManager::numberSaved(), 1);
+    TS_ASSERT_EQUALS(ads.retrieveWS<MatrixWorkspace>("b")->y(0)[0], 2);
+    TS_ASSERT_EQUALS(ads.retrieve("a"), a);
+  }
+
+  void test_workspaces_held_elsewhere_are_not_saved() {
+    const size_t size = createWorkspace(0)->getMemorySize();
+    ads.setMemoryBudget(size);
+    auto a = createWorkspace(1);
+    ads.add("a", a);
+    ads.add("b", createWorkspace(2));
+    TS_ASSERT_EQUALS(WorkspaceMemoryManager::numberSaved(), 0);
+    TS_ASSERT_EQUALS(ads.retrieve("a"), a);
+  }
+
+  void test_workspaces_kept_in_memory_are_not_saved() {
+    const size_t size = createWorkspace(0)->getMemorySize();
+    ads.setMemoryBudget(size);
+    ads.add("a", createWorkspace(1));
+    ads.memoryManager().keepInMemory("a");
+    ads.add("b", createWorkspace(2));
+    TS_ASSERT_EQUALS(WorkspaceMemoryManager::numberSaved(), 0);
+
+    // Until it is replaced
+    ads.addOrReplace("a", createWorkspace(3));
+    ads.add("c", createWorkspace(4));
+    TS_ASSERT_EQUALS(WorkspaceMemoryManager::numberSaved(), 2);
+  }
+
+  void test_topLevelItems_does_not_load_saved_workspaces_back() {
+    const size_t size = createWorkspace(0)->getMemorySize();
+    ads.setMemoryBudget(size + size / 2);
+    ads.add("a", createWorkspace(1));
+    ads.add("b", createWorkspace(2));
+    TS_ASSERT_EQUALS(WorkspaceMemoryManager::numberSaved(), 1);
+
+    const auto items = ads.topLevelItems();
+    TS_ASSERT_EQUALS(WorkspaceMemoryManager::numberSaved(), 1);
+    TS_ASSERT_EQUALS(items.size(), 2);
+    TS_ASSERT_EQUALS(items.at("a")->id(), "SavedWorkspace");
+    TS_ASSERT(WorkspaceMemoryManager::isSaved(*items.at("a")));
+  }
+
+  void test_saving_and_loading_back_does_not_send_replace_notifications() {
+    Poco::NObserver<WorkspaceMemoryManagerTest, WorkspaceAfterReplaceNotification> replaceObserver(
+        *this, &WorkspaceMemoryManagerTest::handleReplaced);
+    Poco::NObserver<WorkspaceMemoryManagerTest, WorkspaceRestoredNotification> restoreObserver(
+        *this, &WorkspaceMemoryManagerTest::handleRestored);
+    ads.notificationCenter.addObserver(replaceObserver);
+    ads.notificationCenter.addObserver(restoreObserver);
+    const size_t size = createWorkspace(0)->getMemorySize();
+    ads.setMemoryBudget(size + size / 2);
+    ads.add("a", createWorkspace(1));
+    ads.add("b", createWorkspace(2));
+    ads.retrieve("a");
+    ads.notificationCenter.removeObserver(replaceObserver);
+    ads.notificationCenter.removeObserver(restoreObserver);
+
+    TS_ASSERT_EQUALS(m_replaced, 0);
+    TS_ASSERT_EQUALS(m_restored, std::vector<std::string>{"a"});
+  }
+
+  void test_removing_a_saved_workspace_deletes_its_file() {
+    const size_t size = createWorkspace(0)->getMemorySize();
+    ads.setMemoryBudget(size);
+    ads.add("a", createWorkspace(1));
+    ads.add("b", createWorkspace(2));
+    TS_ASSERT_EQUALS(WorkspaceMemoryManager::numberSaved(), 1);
+    const auto numberOfFiles = countScratchFiles();
+    TS_ASSERT_LESS_THAN(0, numberOfFiles);
+
+    ads.remove("a");
+    TS_ASSERT_EQUALS(WorkspaceMemoryManager::numberSaved(), 0);
+    TS_ASSERT_EQUALS(countScratchFiles(), numberOfFiles - 1);
+  }
+
+  void handleEvicted(const Poco::AutoPtr<WorkspaceEvictedNotification> &notification) {
+    m_evicted.emplace_back(notification->objectName());
+  }
+
+  void handleReplaced(const Poco::AutoPtr<WorkspaceAfterReplaceNotification> &) { ++m_replaced; }
+
+  void handleRestored(const Poco::AutoPtr<WorkspaceRestoredNotification> &notification) {
+    m_restored.emplace_back(notification->objectName());
+  }
+
+private:
+  MatrixWorkspace_sptr createWorkspace(double y) {
+    auto ws = std::make_shared<WorkspaceTester>();
+    ws->initialize(10, 101, 100);
+    ws->mutableY(0)[0] = y;
+    return ws;
+  }
+
+  size_t countScratchFiles() const {
+    size_t count = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(ads.memoryManager().scratchDirectory())) {
+      if (entry.path().filename().string().rfind("mantid_workspace_", 0) == 0)
+        ++count;
+    }
+    return count;
+  }
+
+  AnalysisDataServiceImpl &ads;
+  std::vector<std::string> m_evicted;
+  std::vector<std::string> m_restored;
+  int m_replaced{0};
+};
@@ -8,7 +8,6 @@
 #include "MantidAPI/InstrumentValidator.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
-#include "MantidAPI/WorkspaceNearestNeighbourInfo.h"
 #include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/OffsetsWorkspace.h"
@@ -16,11 +15,17 @@
 #include "MantidGeometry/ICompAssembly.h"
 #include "MantidGeometry/IComponent.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/DetectorSpatialIndex.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Objects/BoundingBox.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/ListValidator.h"
 
+#include <algorithm>
+#include <limits>
+#include <optional>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
@@ -56,6 +61,140 @@ struct CallOnExit {
 private:
   Callable m_callable;
 };
+
+/**
+ * Finds the nearest spectra of the spectra that take part in the neighbour
+ * search: no monitors and, if requested, no masked detectors. As in
+ * NearestNeighbours distances are divided by the size of the first detector,
+ * so that neighbours are counted in pixels along every axis.
+ *
+ * If every spectrum has a single detector of its own the search runs on the
+ * cached DetectorInfo::spatialIndex(), mapping detectors to spectra and
+ * skipping excluded detectors at query time. Grouped workspaces index the
+ * spectrum positions themselves.
+ */
+class SpectrumNeighbourSearch {
+public:
+  SpectrumNeighbourSearch(const MatrixWorkspace &ws, const bool ignoreMaskedDetectors, const int nNeighbours)
+      : m_spectrumInfo(ws.spectrumInfo()) {
+    const auto &detectorInfo = ws.detectorInfo();
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < ws.getNumberHistograms(); ++i) {
+      if (m_spectrumInfo.hasDetectors(i) && !m_spectrumInfo.isMonitor(i) &&
+          !(ignoreMaskedDetectors && m_spectrumInfo.isMasked(i)))
+        indices.emplace_back(i);
+    }
+    if (indices.empty())
+      throw std::runtime_error("SmoothNeighbours - Cannot find any spectra");
+    if (static_cast<size_t>(nNeighbours) >= indices.size())
+      throw std::invalid_argument("SmoothNeighbours - Invalid number of neighbours");
+
+    BoundingBox bbox;
+    m_spectrumInfo.detector(indices.front()).getBoundingBox(bbox);
+    m_scale = bbox.width();
+    // A detector without a shape has no size to count in
+    for (size_t axis = 0; axis < 3; ++axis)
+      if (!(m_scale[axis] > 0.0))
+        m_scale[axis] = 1.0;
+
+    bool oneDetectorPerSpectrum = !detectorInfo.isScanning();
+    if (oneDetectorPerSpectrum) {
+      m_spectrumOfDetector.assign(detectorInfo.size(), NO_SPECTRUM);
+      for (const auto i : indices) {
+        if (!m_spectrumInfo.hasUniqueDetector(i)) {
+          oneDetectorPerSpectrum = false;
+          break;
+        }
+        auto &spectrum = m_spectrumOfDetector[m_spectrumInfo.spectrumDefinition(i)[0].first];
+        if (spectrum != NO_SPECTRUM) {
+          oneDetectorPerSpectrum = false;
+          break;
+        }
+        spectrum = i;
+      }
+    }
+    if (oneDetectorPerSpectrum) {
+      m_detectorIndex = detectorInfo.spatialIndex();
+      return;
+    }
+    m_spectrumOfDetector.clear();
+    std::vector<V3D> positions;
+    positions.reserve(indices.size());
+    for (const auto i : indices)
+      positions.emplace_back(m_spectrumInfo.position(i) / m_scale);
+    m_spectrumIndex.emplace(std::move(positions), std::move(indices));
+  }
+
+  /**
+   * @param centre :: The position to search around
+   * @param k :: The number of spectra to find
+   * @return The workspace indices of the k spectra closest to centre, closest
+   * first
+   */
+  std::vector<size_t> findNearest(const V3D &centre, const size_t k) const {
+    std::vector<size_t> result;
+    if (k == 0)
+      return result;
+    if (m_spectrumIndex) {
+      for (const auto &neighbour : m_spectrumIndex->findNearest(centre / m_scale, k))
+        result.emplace_back(neighbour.detectorIndex);
+      return result;
+    }
+
+    // The k closest spectra in real space bound the distance, in detector
+    // sizes, of the k-th closest spectrum
+    double bound = 0.0;
+    for (size_t candidates = k;; candidates *= 2) {
+      const auto found = m_detectorIndex->findNearest(centre, candidates);
+      size_t included = 0;
+      bound = 0.0;
+      for (const auto &neighbour : found) {
+        const auto spectrum = m_spectrumOfDetector[neighbour.detectorIndex];
+        if (spectrum == NO_SPECTRUM)
+          continue;
+        bound = std::max(bound, scaledDistance(centre, spectrum));
+        if (++included == k)
+          break;
+      }
+      if (included == k || found.size() < candidates)
+        break;
+    }
+
+    // Every spectrum within that bound is no further than the bound times
+    // the largest detector size in real space. Allow a little for rounding.
+    const auto largestSize = std::max({m_scale.X(), m_scale.Y(), m_scale.Z()});
+    std::vector<std::pair<double, size_t>> inRange;
+    for (const auto &neighbour : m_detectorIndex->findInRadius(centre, bound * largestSize * (1.0 + 1e-9))) {
+      const auto spectrum = m_spectrumOfDetector[neighbour.detectorIndex];
+      if (spectrum != NO_SPECTRUM)
+        inRange.emplace_back(scaledDistance(centre, spectrum), spectrum);
+    }
+    std::sort(inRange.begin(), inRange.end());
+    inRange.resize(std::min(inRange.size(), k));
+    result.reserve(inRange.size());
+    for (const auto &neighbour : inRange)
+      result.emplace_back(neighbour.second);
+    return result;
+  }
+
+private:
+  static constexpr size_t NO_SPECTRUM = std::numeric_limits<size_t>::max();
+
+  /// Distance of a spectrum from centre in detector sizes
+  double scaledDistance(const V3D &centre, const size_t spectrum) const {
+    return ((m_spectrumInfo.position(spectrum) - centre) / m_scale).norm();
+  }
+
+  const SpectrumInfo &m_spectrumInfo;
+  /// Size of the first detector, the unit distances are counted in
+  V3D m_scale;
+  /// Workspace index of each detector index, NO_SPECTRUM if excluded
+  std::vector<size_t> m_spectrumOfDetector;
+  /// Cached index of the detector positions
+  std::shared_ptr<const DetectorSpatialIndex> m_detectorIndex;
+  /// Index of the scaled spectrum positions of a grouped workspace
+  std::optional<DetectorSpatialIndex> m_spectrumIndex;
+};
 } // namespace
 
 SmoothNeighbours::SmoothNeighbours() : API::Algorithm(), m_weightedSum(std::make_unique<NullWeighting>()) {}
@@ -306,7 +445,8 @@ void SmoothNeighbours::findNeighboursRectangular() {
 }
 
 //--------------------------------------------------------------------------------------------
-/** Use NearestNeighbours to find the neighbours for any instrument
+/** Use a spatial index of the spectrum positions to find the neighbours for
+ * any instrument
  */
 void SmoothNeighbours::findNeighboursUbiquitous() {
   g_log.debug("SmoothNeighbours processing NOT assuming rectangular detectors.");
@@ -321,7 +461,8 @@ void SmoothNeighbours::findNeighboursUbiquitous() {
   m_neighbours.resize(m_inWS->getNumberHistograms());
 
   bool ignoreMaskedDetectors = getProperty("IgnoreMaskedDetectors");
-  WorkspaceNearestNeighbourInfo neighbourInfo(*m_inWS, ignoreMaskedDetectors, m_nNeighbours);
+  const SpectrumNeighbourSearch neighbourSearch(*m_inWS, ignoreMaskedDetectors, m_nNeighbours);
+  const auto &spectrumInfo = m_inWS->spectrumInfo();
 
   // Cull by radius
   RadiusFilter radiusFilter(m_radius);
@@ -363,14 +504,17 @@ void SmoothNeighbours::findNeighboursUbiquitous() {
     specnum_t inSpec = m_inWS->getSpectrum(wi).getSpectrumNo();
 
     // Step one - Get the number of specified neighbours
-    SpectraDistanceMap insideGrid = neighbourInfo.getNeighboursExact(inSpec);
+    SpectraDistanceMap insideGrid;
+    const V3D position = spectrumInfo.position(wi);
+    for (const auto neighbourWI : neighbourSearch.findNearest(position, static_cast<size_t>(m_nNeighbours))) {
+      insideGrid[m_inWS->getSpectrum(neighbourWI).getSpectrumNo()] = spectrumInfo.position(neighbourWI) - position;
+    }
 
     // Step two - Filter the results by the radius cut off.
     SpectraDistanceMap neighbSpectra = radiusFilter.apply(insideGrid);
 
-    // Force the central pixel to always be there
-    // There seems to be a bug in nearestNeighbours, returns distance != 0.0 for
-    // the central pixel. So we force distance = 0
+    // Force the central pixel to always be there, also when detectors share
+    // its position
     neighbSpectra[inSpec] = V3D(0.0, 0.0, 0.0);
 
     // Neighbours and weights list
@@ -55,7 +55,7 @@ void UnGroupWorkspace::exec() {
   // add algorithm history to the workspaces being released from the group
   fillHistory(wsGrpSptr->getAllItems());
   // Notify observers that a WorkspaceGroup is about to be unrolled
-  data_store.notificationCenter.postNotification(new Mantid::API::WorkspaceUnGroupingNotification(inputws, wsSptr));
+  data_store.postNotification(new Mantid::API::WorkspaceUnGroupingNotification(inputws, wsSptr));
   // Now remove the WorkspaceGroup from the ADS
   data_store.remove(inputws);
 }
@@ -7,10 +7,12 @@
 #pragma once
 
 #include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/WorkspaceNearestNeighbourInfo.h"
 #include "MantidAlgorithms/SmoothNeighbours.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidFrameworkTestHelpers/FakeObjects.h"
 #include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
 
 #include <cxxtest/TestSuite.h>
 
@@ -71,6 +73,46 @@ public:
     AnalysisDataService::Instance().remove("testMW");
   }
 
+  void doTestNeighboursMatchNearestNeighbours(const bool maskEveryFifth) {
+    MatrixWorkspace_sptr inWS = WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(60, 3);
+    // Scatter the pixels so that no two neighbours are equally far away
+    auto &detectorInfo = inWS->mutableDetectorInfo();
+    for (size_t i = 0; i < detectorInfo.size(); ++i) {
+      const auto x = static_cast<double>(i);
+      detectorInfo.setPosition(i, V3D(0.3 * std::sin(1.7 * x), 0.05 * x, 5.0 + 0.2 * std::cos(2.3 * x)));
+      inWS->mutableY(i) = x + 1.0;
+      if (maskEveryFifth && i % 5 == 0)
+        detectorInfo.setMasked(i, true);
+    }
+
+    SmoothNeighbours alg;
+    alg.setChild(true);
+    alg.initialize();
+    alg.setProperty("InputWorkspace", inWS);
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    alg.setProperty("PreserveEvents", false);
+    alg.setProperty("WeightedSum", "Flat");
+    alg.setProperty("NumberOfNeighbours", 8);
+    alg.setProperty("Radius", 10.0);
+    alg.setProperty("RadiusUnits", "Meters");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    MatrixWorkspace_sptr outWS = alg.getProperty("OutputWorkspace");
+
+    // With flat weights every output spectrum is the mean of its neighbours
+    WorkspaceNearestNeighbourInfo neighbourInfo(*inWS, true, 8);
+    for (size_t wi = 0; wi < inWS->getNumberHistograms(); ++wi) {
+      if (detectorInfo.isMasked(wi))
+        continue;
+      auto neighbours = neighbourInfo.getNeighboursExact(inWS->getSpectrum(wi).getSpectrumNo());
+      neighbours[inWS->getSpectrum(wi).getSpectrumNo()] = V3D();
+      double expected = 0.0;
+      for (const auto &neighbour : neighbours)
+        expected += inWS->y(inWS->getIndexFromSpectrumNumber(neighbour.first))[0];
+      expected /= static_cast<double>(neighbours.size());
+      TS_ASSERT_DELTA(outWS->y(wi)[0], expected, 1e-10);
+    }
+  }
+
   void do_test_non_uniform(EventType type, double *expectedY, const std::string &WeightedSum = "Parabolic",
                            bool PreserveEvents = true, double Radius = 0.001, bool ConvertTo2D = false,
                            int numberOfNeighbours = 8) {
@@ -277,6 +319,10 @@ public:
 
   void testWithNumberOfNeighboursAndGaussianWeighting() { doTestWithNumberOfNeighbours("Gaussian"); }
 
+  void test_neighbours_are_the_same_as_from_NearestNeighbours() { doTestNeighboursMatchNearestNeighbours(false); }
+
+  void test_masked_detectors_are_not_neighbours() { doTestNeighboursMatchNearestNeighbours(true); }
+
   void test_event_WEIGHTED() {
     double expectedY[9] = {2, 2, 2, 2.3636, 2.5454, 2.3636, 2, 2, 2};
     do_test_rectangular(WEIGHTED, expectedY);
@@ -96,7 +96,7 @@ public:
   }
 
   const Eigen::Vector3d &position(const size_t componentIndex) const;
-  const Eigen::Vector3d &position(const std::pair<size_t, size_t> &index) const;
+  Eigen::Vector3d position(const std::pair<size_t, size_t> &index) const;
   Eigen::Quaterniond rotation(const size_t componentIndex) const;
   Eigen::Quaterniond rotation(const std::pair<size_t, size_t> &index) const;
   Eigen::Vector3d relativePosition(const size_t componentIndex) const;
@@ -7,11 +7,15 @@
 #pragma once
 
 #include "MantidBeamline/DllConfig.h"
+#include "MantidBeamline/ScanTransforms.h"
 #include "MantidKernel/cow_ptr.h"
 
 #include "Eigen/Geometry"
 #include "Eigen/StdVector"
 
+#include <atomic>
+#include <cstdint>
+
 namespace Mantid {
 namespace Beamline {
 
@@ -50,6 +54,10 @@ public:
   DetectorInfo(std::vector<Eigen::Vector3d> positions,
                std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond>> rotations,
                const std::vector<size_t> &monitorIndices);
+  DetectorInfo(const DetectorInfo &other);
+  DetectorInfo(DetectorInfo &&other) noexcept;
+  DetectorInfo &operator=(const DetectorInfo &other);
+  DetectorInfo &operator=(DetectorInfo &&other) noexcept;
 
   bool isEquivalent(const DetectorInfo &other) const;
 
@@ -64,13 +72,18 @@ public:
   void setMasked(const std::pair<size_t, size_t> &index, bool masked);
   bool hasMaskedDetectors() const;
   const Eigen::Vector3d &position(const size_t index) const;
-  const Eigen::Vector3d &position(const std::pair<size_t, size_t> &index) const;
+  Eigen::Vector3d position(const std::pair<size_t, size_t> &index) const;
   const Eigen::Quaterniond &rotation(const size_t index) const;
-  const Eigen::Quaterniond &rotation(const std::pair<size_t, size_t> &index) const;
+  Eigen::Quaterniond rotation(const std::pair<size_t, size_t> &index) const;
   void setPosition(const size_t index, const Eigen::Vector3d &position);
   void setPosition(const std::pair<size_t, size_t> &index, const Eigen::Vector3d &position);
   void setRotation(const size_t index, const Eigen::Quaterniond &rotation);
   void setRotation(const std::pair<size_t, size_t> &index, const Eigen::Quaterniond &rotation);
+  void transformDetectors(ScanTransforms::IndexIterator begin, ScanTransforms::IndexIterator end,
+                          const size_t timeIndex, const ScanTransforms::Transform &transform);
+  void transformDetectors(const std::vector<size_t> &detectorIndices, const ScanTransforms::Transforms &transforms);
+  bool hasCompactScan() const;
+  uint64_t positionVersion() const;
 
   size_t scanCount() const;
   const std::vector<std::pair<int64_t, int64_t>> scanIntervals() const;
@@ -95,11 +108,19 @@ private:
   void checkNoTimeDependence() const;
   void checkSizes(const DetectorInfo &other) const;
   void merge(const DetectorInfo &other, const std::vector<bool> &merge);
+  size_t timeIndexCount() const;
+  bool isReferenceStep(const DetectorInfo &other, const size_t timeIndex) const;
+  void expandScanTransforms();
 
   Kernel::cow_ptr<std::vector<bool>> m_isMonitor{nullptr};
   Kernel::cow_ptr<std::vector<bool>> m_isMasked{nullptr};
   Kernel::cow_ptr<std::vector<Eigen::Vector3d>> m_positions{nullptr};
   Kernel::cow_ptr<std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond>>> m_rotations{nullptr};
+  /// Time dependence of positions and rotations for compact scans. If set,
+  /// m_positions and m_rotations hold one reference value per detector.
+  Kernel::cow_ptr<ScanTransforms> m_scanTransforms{nullptr};
+  /// Identifier of the current positions, 0 if not yet assigned after a change
+  mutable std::atomic<uint64_t> m_positionVersion{0};
 
   ComponentInfo *m_componentInfo = nullptr; // Geometry::ComponentInfo owner
 };
@@ -116,9 +137,9 @@ inline size_t DetectorInfo::size() const {
 
 /// Returns true if the beamline has scanning detectors.
 inline bool DetectorInfo::isScanning() const {
-  if (!m_positions)
+  if (!m_isMasked)
     return false;
-  return size() != m_positions->size();
+  return size() != m_isMasked->size();
 }
 
 /** Returns the position of the detector with given detector index.
@@ -131,7 +152,9 @@ inline const Eigen::Vector3d &DetectorInfo::position(const size_t index) const {
 }
 
 /// Returns the position of the detector with given index.
-inline const Eigen::Vector3d &DetectorInfo::position(const std::pair<size_t, size_t> &index) const {
+inline Eigen::Vector3d DetectorInfo::position(const std::pair<size_t, size_t> &index) const {
+  if (m_scanTransforms)
+    return m_scanTransforms->position(index.first, index.second, (*m_positions)[index.first]);
   return (*m_positions)[linearIndex(index)];
 }
 
@@ -145,7 +168,9 @@ inline const Eigen::Quaterniond &DetectorInfo::rotation(const size_t index) cons
 }
 
 /// Returns the rotation of the detector with given index.
-inline const Eigen::Quaterniond &DetectorInfo::rotation(const std::pair<size_t, size_t> &index) const {
+inline Eigen::Quaterniond DetectorInfo::rotation(const std::pair<size_t, size_t> &index) const {
+  if (m_scanTransforms)
+    return m_scanTransforms->rotation(index.first, index.second, (*m_rotations)[index.first]);
   return (*m_rotations)[linearIndex(index)];
 }
 
@@ -156,11 +181,16 @@ inline const Eigen::Quaterniond &DetectorInfo::rotation(const std::pair<size_t,
 inline void DetectorInfo::setPosition(const size_t index, const Eigen::Vector3d &position) {
   checkNoTimeDependence();
   m_positions.access()[index] = position;
+  m_positionVersion.store(0, std::memory_order_relaxed);
 }
 
 /// Set the position of the detector with given index.
 inline void DetectorInfo::setPosition(const std::pair<size_t, size_t> &index, const Eigen::Vector3d &position) {
+  // Individual detectors cannot be represented by a compact scan
+  if (m_scanTransforms)
+    expandScanTransforms();
   m_positions.access()[linearIndex(index)] = position;
+  m_positionVersion.store(0, std::memory_order_relaxed);
 }
 
 /** Set the rotation of the detector with given detector index.
@@ -174,6 +204,8 @@ inline void DetectorInfo::setRotation(const size_t index, const Eigen::Quaternio
 
 /// Set the rotation of the detector with given index.
 inline void DetectorInfo::setRotation(const std::pair<size_t, size_t> &index, const Eigen::Quaterniond &rotation) {
+  if (m_scanTransforms)
+    expandScanTransforms();
   m_rotations.access()[linearIndex(index)] = rotation.normalized();
 }
 
@@ -0,0 +1,83 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidBeamline/DllConfig.h"
+
+#include "Eigen/Geometry"
+#include "Eigen/StdVector"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Beamline {
+
+/** ScanTransforms : compact storage of time-dependent detector positions and
+  rotations.
+
+  Detectors are partitioned into groups that move rigidly together, e.g. the
+  detectors of a tube or bank. For every group and time index a rigid
+  transformation is stored. Position and rotation of a detector at a given
+  time index are obtained by applying the transformation of its group to the
+  reference position and rotation of the detector, which are stored by the
+  owner (DetectorInfo).
+
+  Memory therefore scales as (number of detectors + number of groups * number
+  of time indices) instead of (number of detectors * number of time indices).
+  Groups are split automatically when only part of a group is transformed.
+*/
+class MANTID_BEAMLINE_DLL ScanTransforms {
+public:
+  /// Rigid transformation x -> rotation * x + translation
+  struct Transform {
+    Eigen::Quaterniond rotation{Eigen::Quaterniond::Identity()};
+    Eigen::Vector3d translation{Eigen::Vector3d::Zero()};
+  };
+  using Transforms = std::vector<Transform, Eigen::aligned_allocator<Transform>>;
+  using IndexIterator = std::vector<size_t>::const_iterator;
+
+  ScanTransforms(const size_t numberOfDetectors, const size_t scanCount);
+
+  size_t scanCount() const { return m_scanCount; }
+  size_t numberOfGroups() const { return m_transforms.size(); }
+  size_t group(const size_t detectorIndex) const { return m_groups[detectorIndex]; }
+
+  /// Transformation of a detector at a time index
+  const Transform &transform(const size_t detectorIndex, const size_t timeIndex) const {
+    return m_transforms[m_groups[detectorIndex]][timeIndex];
+  }
+  /// Position of a detector with given reference position at a time index
+  Eigen::Vector3d position(const size_t detectorIndex, const size_t timeIndex,
+                           const Eigen::Vector3d &reference) const {
+    const auto &t = transform(detectorIndex, timeIndex);
+    return t.rotation * reference + t.translation;
+  }
+  /// Rotation of a detector with given reference rotation at a time index
+  Eigen::Quaterniond rotation(const size_t detectorIndex, const size_t timeIndex,
+                              const Eigen::Quaterniond &reference) const {
+    return transform(detectorIndex, timeIndex).rotation * reference;
+  }
+
+  void appendIdentity();
+  void transform(IndexIterator begin, IndexIterator end, const size_t timeIndex, const Transform &delta);
+  void transform(IndexIterator begin, IndexIterator end, const Transforms &deltas);
+
+private:
+  std::vector<size_t> groupsCovering(IndexIterator begin, IndexIterator end);
+
+  size_t m_scanCount;
+  /// Group of each detector
+  std::vector<uint32_t> m_groups;
+  /// Number of detectors in each group
+  std::vector<size_t> m_groupSizes;
+  /// Transformation of each group at each time index
+  std::vector<Transforms> m_transforms;
+};
+
+} // namespace Beamline
+} // namespace Mantid
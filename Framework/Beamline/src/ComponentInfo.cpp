@@ -177,7 +177,7 @@ const Eigen::Vector3d &ComponentInfo::position(const size_t componentIndex) cons
   return (*m_positions)[rangesIndex];
 }
 
-const Eigen::Vector3d &ComponentInfo::position(const std::pair<size_t, size_t> &index) const {
+Eigen::Vector3d ComponentInfo::position(const std::pair<size_t, size_t> &index) const {
 
   const auto componentIndex = index.first;
   if (isDetector(componentIndex)) {
@@ -260,8 +260,14 @@ void ComponentInfo::doSetPosition(const std::pair<size_t, size_t> &index, const
   const auto componentIndex = index.first;
   const auto timeIndex = index.second;
   const Eigen::Vector3d offset = newPosition - position(componentIndex);
-  for (const auto &subIndex : detectorRange) {
-    m_detectorInfo->setPosition({subIndex, timeIndex}, m_detectorInfo->position({subIndex, timeIndex}) + offset);
+  if (m_detectorInfo->hasCompactScan()) {
+    ScanTransforms::Transform translation;
+    translation.translation = offset;
+    m_detectorInfo->transformDetectors(detectorRange.begin(), detectorRange.end(), timeIndex, translation);
+  } else {
+    for (const auto &subIndex : detectorRange) {
+      m_detectorInfo->setPosition({subIndex, timeIndex}, m_detectorInfo->position({subIndex, timeIndex}) + offset);
+    }
   }
 
   for (const auto &subIndex : componentRangeInSubtree(componentIndex)) {
@@ -280,12 +286,20 @@ void ComponentInfo::doSetRotation(const std::pair<size_t, size_t> &index, const
   const Eigen::Quaterniond rotDelta = (newRotation * currentRotInv).normalized();
   auto transform = Eigen::Matrix3d(rotDelta);
 
-  for (const auto &subDetIndex : detectorRange) {
-    auto oldPos = m_detectorInfo->position({subDetIndex, timeIndex});
-    auto newPos = transform * (oldPos - compPos) + compPos;
-    auto newRot = rotDelta * m_detectorInfo->rotation({subDetIndex, timeIndex});
-    m_detectorInfo->setPosition({subDetIndex, timeIndex}, newPos);
-    m_detectorInfo->setRotation({subDetIndex, timeIndex}, newRot);
+  if (m_detectorInfo->hasCompactScan()) {
+    // Rotation around compPos, stored as one transformation per detector group
+    ScanTransforms::Transform rotation;
+    rotation.rotation = rotDelta;
+    rotation.translation = compPos - transform * compPos;
+    m_detectorInfo->transformDetectors(detectorRange.begin(), detectorRange.end(), timeIndex, rotation);
+  } else {
+    for (const auto &subDetIndex : detectorRange) {
+      auto oldPos = m_detectorInfo->position({subDetIndex, timeIndex});
+      auto newPos = transform * (oldPos - compPos) + compPos;
+      auto newRot = rotDelta * m_detectorInfo->rotation({subDetIndex, timeIndex});
+      m_detectorInfo->setPosition({subDetIndex, timeIndex}, newPos);
+      m_detectorInfo->setRotation({subDetIndex, timeIndex}, newRot);
+    }
   }
 
   for (const auto &subCompIndex : componentRangeInSubtree(componentIndex)) {
@@ -483,18 +497,18 @@ const Eigen::Vector3d &ComponentInfo::sourcePosition() const {
   if (!hasSource()) {
     throw std::runtime_error("Source component has not been specified");
   }
-  // Getting position with time index to bypass scanning check. Sources are not
+  // Accessing time index 0 directly to bypass scanning check. Sources are not
   // scanned.
-  return position({static_cast<size_t>(m_sourceIndex), 0});
+  return (*m_positions)[compOffsetIndex(static_cast<size_t>(m_sourceIndex))];
 }
 
 const Eigen::Vector3d &ComponentInfo::samplePosition() const {
   if (!hasSample()) {
     throw std::runtime_error("Sample component has not been specified");
   }
-  // Getting position with time index to bypass scanning check. Samples are not
+  // Accessing time index 0 directly to bypass scanning check. Samples are not
   // scanned.
-  return position({static_cast<size_t>(m_sampleIndex), 0});
+  return (*m_positions)[compOffsetIndex(static_cast<size_t>(m_sampleIndex))];
 }
 
 size_t ComponentInfo::source() const {
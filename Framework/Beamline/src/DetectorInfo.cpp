@@ -13,6 +13,12 @@
 
 namespace Mantid::Beamline {
 
+namespace {
+/// Source of position versions. Shared by all instances so that a version
+/// identifies a set of positions across copies.
+std::atomic<uint64_t> g_nextPositionVersion{1};
+} // namespace
+
 DetectorInfo::DetectorInfo(std::vector<Eigen::Vector3d> positions,
                            std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond>> rotations)
     : m_isMonitor(Kernel::make_cow<std::vector<bool>>(positions.size())),
@@ -33,6 +39,57 @@ DetectorInfo::DetectorInfo(std::vector<Eigen::Vector3d> positions,
     m_isMonitor.access().at(i) = true;
 }
 
+DetectorInfo::DetectorInfo(const DetectorInfo &other)
+    : m_isMonitor(other.m_isMonitor), m_isMasked(other.m_isMasked), m_positions(other.m_positions),
+      m_rotations(other.m_rotations), m_scanTransforms(other.m_scanTransforms),
+      m_positionVersion(other.m_positionVersion.load()),
+      m_componentInfo(other.m_componentInfo) {}
+
+DetectorInfo::DetectorInfo(DetectorInfo &&other) noexcept
+    : m_isMonitor(std::move(other.m_isMonitor)), m_isMasked(std::move(other.m_isMasked)),
+      m_positions(std::move(other.m_positions)), m_rotations(std::move(other.m_rotations)),
+      m_scanTransforms(std::move(other.m_scanTransforms)), m_positionVersion(other.m_positionVersion.load()),
+      m_componentInfo(other.m_componentInfo) {}
+
+DetectorInfo &DetectorInfo::operator=(const DetectorInfo &other) {
+  m_isMonitor = other.m_isMonitor;
+  m_isMasked = other.m_isMasked;
+  m_positions = other.m_positions;
+  m_rotations = other.m_rotations;
+  m_scanTransforms = other.m_scanTransforms;
+  m_positionVersion = other.m_positionVersion.load();
+  m_componentInfo = other.m_componentInfo;
+  return *this;
+}
+
+DetectorInfo &DetectorInfo::operator=(DetectorInfo &&other) noexcept {
+  m_isMonitor = std::move(other.m_isMonitor);
+  m_isMasked = std::move(other.m_isMasked);
+  m_positions = std::move(other.m_positions);
+  m_rotations = std::move(other.m_rotations);
+  m_scanTransforms = std::move(other.m_scanTransforms);
+  m_positionVersion = other.m_positionVersion.load();
+  m_componentInfo = other.m_componentInfo;
+  return *this;
+}
+
+/** Returns an identifier of the current detector positions.
+ *
+ * Two calls return the same value if and only if no position has been changed
+ * in between. Copies share the version of their source until either is
+ * modified, so caches derived from positions (such as a spatial index) can be
+ * validated by comparing versions. */
+uint64_t DetectorInfo::positionVersion() const {
+  auto version = m_positionVersion.load();
+  if (version == 0) {
+    const auto next = g_nextPositionVersion.fetch_add(1);
+    // Another thread may have assigned a version concurrently, use theirs
+    if (m_positionVersion.compare_exchange_strong(version, next))
+      version = next;
+  }
+  return version;
+}
+
 /** Returns true if the content of this is equivalent to the content of other.
  *
  * Here "equivalent" implies equality of all member, except for positions and
@@ -62,10 +119,7 @@ bool DetectorInfo::isEquivalent(const DetectorInfo &other) const {
 
   // Positions: Absolute difference matter, so comparison is not relative.
   // Changes below 1 nm = 1e-9 m are allowed.
-  if (!(m_positions == other.m_positions) &&
-      !std::equal(m_positions->begin(), m_positions->end(), other.m_positions->begin(),
-                  [](const Eigen::Vector3d &a, const Eigen::Vector3d &b) { return (a - b).norm() < 1e-9; }))
-    return false;
+  const auto equalPositions = [](const Eigen::Vector3d &a, const Eigen::Vector3d &b) { return (a - b).norm() < 1e-9; };
   // At a distance of L = 1000 m (a reasonable upper limit for instrument sizes)
   // from the rotation center we want a difference of less than d = 1 nm = 1e-9
   // m). We have, using small angle approximation,
@@ -76,12 +130,30 @@ bool DetectorInfo::isEquivalent(const DetectorInfo &other) const {
   constexpr double L = 1000.0;
   constexpr double safety_factor = 2.0;
   const double imag_norm_max = sin(d_max / (2.0 * L * safety_factor));
-  if (!(m_rotations == other.m_rotations) &&
-      !std::equal(m_rotations->begin(), m_rotations->end(), other.m_rotations->begin(),
-                  [imag_norm_max](const Eigen::Quaterniond &a, const Eigen::Quaterniond &b) {
-                    return (a * b.conjugate()).vec().norm() < imag_norm_max;
-                  }))
+  const auto equalRotations = [imag_norm_max](const Eigen::Quaterniond &a, const Eigen::Quaterniond &b) {
+    return (a * b.conjugate()).vec().norm() < imag_norm_max;
+  };
+
+  if (!m_scanTransforms && !other.m_scanTransforms) {
+    if (!(m_positions == other.m_positions) &&
+        !std::equal(m_positions->begin(), m_positions->end(), other.m_positions->begin(), equalPositions))
+      return false;
+    if (!(m_rotations == other.m_rotations) &&
+        !std::equal(m_rotations->begin(), m_rotations->end(), other.m_rotations->begin(), equalRotations))
+      return false;
+    return true;
+  }
+  // Compact and dense scans may describe the same positions
+  const auto count = timeIndexCount();
+  if (count != other.timeIndexCount())
     return false;
+  for (size_t timeIndex = 0; timeIndex < count; ++timeIndex) {
+    for (size_t i = 0; i < size(); ++i) {
+      if (!equalPositions(position({i, timeIndex}), other.position({i, timeIndex})) ||
+          !equalRotations(rotation({i, timeIndex}), other.rotation({i, timeIndex})))
+        return false;
+    }
+  }
   return true;
 }
 
@@ -177,17 +249,132 @@ void DetectorInfo::merge(const DetectorInfo &other, const std::vector<bool> &mer
   for (size_t timeIndex = 0; timeIndex < other.scanCount(); ++timeIndex) {
     if (!merge[timeIndex])
       continue;
+    // Steps that leave all detectors at their reference positions, as produced
+    // when building a scan before moving detectors, are stored compactly.
+    if ((m_scanTransforms || !isScanning()) && isReferenceStep(other, timeIndex)) {
+      if (!m_scanTransforms)
+        m_scanTransforms = Kernel::make_cow<ScanTransforms>(size(), 1);
+      m_scanTransforms.access().appendIdentity();
+    } else {
+      if (m_scanTransforms)
+        expandScanTransforms();
+      auto &positions = m_positions.access();
+      auto &rotations = m_rotations.access();
+      if (other.m_scanTransforms) {
+        for (size_t i = 0; i < size(); ++i) {
+          positions.emplace_back(other.position({i, timeIndex}));
+          rotations.emplace_back(other.rotation({i, timeIndex}));
+        }
+      } else {
+        const size_t indexStart = other.linearIndex({0, timeIndex});
+        const size_t indexEnd = indexStart + size();
+        positions.insert(positions.end(), other.m_positions->begin() + indexStart,
+                         other.m_positions->begin() + indexEnd);
+        rotations.insert(rotations.end(), other.m_rotations->begin() + indexStart,
+                         other.m_rotations->begin() + indexEnd);
+      }
+    }
     auto &isMaskedVec = m_isMasked.access();
-    auto &positions = m_positions.access();
-    auto &rotations = m_rotations.access();
     const size_t indexStart = other.linearIndex({0, timeIndex});
-    size_t indexEnd = indexStart + size();
-    isMaskedVec.insert(isMaskedVec.end(), other.m_isMasked->begin() + indexStart, other.m_isMasked->begin() + indexEnd);
-    positions.insert(positions.end(), other.m_positions->begin() + indexStart, other.m_positions->begin() + indexEnd);
-    rotations.insert(rotations.end(), other.m_rotations->begin() + indexStart, other.m_rotations->begin() + indexEnd);
+    isMaskedVec.insert(isMaskedVec.end(), other.m_isMasked->begin() + indexStart,
+                       other.m_isMasked->begin() + indexStart + size());
+  }
+  m_positionVersion = 0;
+}
+
+/// Returns the number of time indices for which positions are stored.
+size_t DetectorInfo::timeIndexCount() const {
+  if (m_scanTransforms)
+    return m_scanTransforms->scanCount();
+  if (size() == 0)
+    return 1;
+  return m_positions->size() / size();
+}
+
+/** Returns true if all detectors of other at the given time index are at the
+ * reference positions and rotations of this, i.e., at time index 0 unless this
+ * is a compact scan. */
+bool DetectorInfo::isReferenceStep(const DetectorInfo &other, const size_t timeIndex) const {
+  // Detectors of workspaces created from the same instrument share their data
+  if (!other.isScanning() && m_positions == other.m_positions && m_rotations == other.m_rotations)
+    return true;
+  for (size_t i = 0; i < size(); ++i) {
+    if (other.position({i, timeIndex}) != (*m_positions)[i] ||
+        other.rotation({i, timeIndex}).coeffs() != (*m_rotations)[i].coeffs())
+      return false;
+  }
+  return true;
+}
+
+/// Replace the compact representation of a scan by explicit positions and
+/// rotations for every detector and time index.
+void DetectorInfo::expandScanTransforms() {
+  const auto &transforms = *m_scanTransforms;
+  const auto count = transforms.scanCount();
+  std::vector<Eigen::Vector3d> positions;
+  std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond>> rotations;
+  positions.reserve(size() * count);
+  rotations.reserve(size() * count);
+  for (size_t timeIndex = 0; timeIndex < count; ++timeIndex) {
+    for (size_t i = 0; i < size(); ++i) {
+      positions.emplace_back(transforms.position(i, timeIndex, (*m_positions)[i]));
+      rotations.emplace_back(transforms.rotation(i, timeIndex, (*m_rotations)[i]));
+    }
+  }
+  m_positions = Kernel::make_cow<std::vector<Eigen::Vector3d>>(std::move(positions));
+  m_rotations = Kernel::make_cow<std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond>>>(
+      std::move(rotations));
+  m_scanTransforms = Kernel::cow_ptr<ScanTransforms>(nullptr);
+}
+
+/** Apply a rigid transformation to the detectors in [begin, end) at the given
+ * time index, i.e., transform their positions and rotations. Detector indices
+ * must be unique.
+ *
+ * For compact scans this is a cheap operation that does not depend on the
+ * number of time indices. Not thread safe. */
+void DetectorInfo::transformDetectors(ScanTransforms::IndexIterator begin, ScanTransforms::IndexIterator end,
+                                      const size_t timeIndex, const ScanTransforms::Transform &transform) {
+  m_positionVersion = 0;
+  if (m_scanTransforms) {
+    m_scanTransforms.access().transform(begin, end, timeIndex, transform);
+    return;
+  }
+  auto &positions = m_positions.access();
+  auto &rotations = m_rotations.access();
+  for (auto it = begin; it != end; ++it) {
+    const auto index = linearIndex({*it, timeIndex});
+    positions[index] = transform.rotation * positions[index] + transform.translation;
+    rotations[index] = (transform.rotation * rotations[index]).normalized();
+  }
+}
+
+/** Apply a rigid transformation to the given detectors at each time index.
+ *
+ * This is the efficient way of describing scans in which groups of detectors
+ * move together, such as instruments rotating around the sample, since no
+ * positions are stored per detector and time index for compact scans.
+ *
+ * @param detectorIndices :: Unique indices of the detectors to transform
+ * @param transforms :: Transformation for each time index */
+void DetectorInfo::transformDetectors(const std::vector<size_t> &detectorIndices,
+                                      const ScanTransforms::Transforms &transforms) {
+  if (transforms.size() != timeIndexCount())
+    throw std::invalid_argument("DetectorInfo::transformDetectors: number of transformations does not match the "
+                                "number of time indices");
+  m_positionVersion = 0;
+  if (m_scanTransforms) {
+    m_scanTransforms.access().transform(detectorIndices.cbegin(), detectorIndices.cend(), transforms);
+    return;
   }
+  for (size_t timeIndex = 0; timeIndex < transforms.size(); ++timeIndex)
+    transformDetectors(detectorIndices.cbegin(), detectorIndices.cend(), timeIndex, transforms[timeIndex]);
 }
 
+/// Returns true if positions and rotations of a scan are stored compactly as
+/// transformations of groups of detectors.
+bool DetectorInfo::hasCompactScan() const { return static_cast<bool>(m_scanTransforms); }
+
 void DetectorInfo::setComponentInfo(ComponentInfo *componentInfo) { m_componentInfo = componentInfo; }
 
 bool DetectorInfo::hasComponentInfo() const { return m_componentInfo != nullptr; }
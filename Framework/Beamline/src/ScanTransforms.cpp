@@ -0,0 +1,120 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidBeamline/ScanTransforms.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace Mantid::Beamline {
+
+namespace {
+/// Apply delta after transform
+void compose(ScanTransforms::Transform &transform, const ScanTransforms::Transform &delta) {
+  transform.rotation = (delta.rotation * transform.rotation).normalized();
+  transform.translation = delta.rotation * transform.translation + delta.translation;
+}
+} // namespace
+
+/** Create transforms for the given number of detectors, all in a single group
+ * with identity transformations for every time index.
+ *
+ * @param numberOfDetectors :: Number of detectors
+ * @param scanCount :: Number of time indices
+ */
+ScanTransforms::ScanTransforms(const size_t numberOfDetectors, const size_t scanCount)
+    : m_scanCount(scanCount), m_groups(numberOfDetectors, 0), m_groupSizes(1, numberOfDetectors),
+      m_transforms(1, Transforms(scanCount)) {}
+
+/// Append a time index at which all detectors are at their reference positions
+void ScanTransforms::appendIdentity() {
+  for (auto &transforms : m_transforms)
+    transforms.emplace_back();
+  ++m_scanCount;
+}
+
+/** Apply a rigid transformation to a set of detectors at one time index.
+ *
+ * The transformation is applied after the current transformation of the
+ * detectors, i.e. it acts on their current positions. Detector indices must be
+ * unique.
+ *
+ * @param begin :: Iterator to the first detector index to transform
+ * @param end :: Iterator past the last detector index to transform
+ * @param timeIndex :: Time index to transform at
+ * @param delta :: Transformation to apply
+ */
+void ScanTransforms::transform(IndexIterator begin, IndexIterator end, const size_t timeIndex,
+                               const Transform &delta) {
+  if (timeIndex >= m_scanCount)
+    throw std::out_of_range("ScanTransforms::transform: time index out of range");
+  for (const auto group : groupsCovering(begin, end))
+    compose(m_transforms[group][timeIndex], delta);
+}
+
+/** Apply a rigid transformation to a set of detectors at every time index.
+ *
+ * @param begin :: Iterator to the first detector index to transform
+ * @param end :: Iterator past the last detector index to transform
+ * @param deltas :: Transformation to apply for each time index
+ */
+void ScanTransforms::transform(IndexIterator begin, IndexIterator end, const Transforms &deltas) {
+  if (deltas.size() != m_scanCount)
+    throw std::invalid_argument("ScanTransforms::transform: number of transformations does not match scan count");
+  for (const auto group : groupsCovering(begin, end)) {
+    auto &transforms = m_transforms[group];
+    for (size_t timeIndex = 0; timeIndex < m_scanCount; ++timeIndex)
+      compose(transforms[timeIndex], deltas[timeIndex]);
+  }
+}
+
+/** Returns groups that contain exactly the given detectors.
+ *
+ * Groups that contain only part of the given detectors are split. The new
+ * group starts with a copy of the transformations of the group it was split
+ * from, so positions are unchanged by this operation.
+ */
+std::vector<size_t> ScanTransforms::groupsCovering(IndexIterator begin, IndexIterator end) {
+  const auto numberOfGroups = m_transforms.size();
+  std::vector<size_t> hits(numberOfGroups, 0);
+  std::vector<size_t> touched;
+  for (auto it = begin; it != end; ++it) {
+    const auto group = m_groups.at(*it);
+    if (hits[group]++ == 0)
+      touched.emplace_back(group);
+  }
+
+  constexpr auto unchanged = std::numeric_limits<size_t>::max();
+  std::vector<size_t> replacement(numberOfGroups, unchanged);
+  std::vector<size_t> covering;
+  covering.reserve(touched.size());
+  bool split = false;
+  for (const auto group : touched) {
+    if (hits[group] == m_groupSizes[group]) {
+      covering.emplace_back(group);
+      continue;
+    }
+    if (m_transforms.size() >= std::numeric_limits<uint32_t>::max())
+      throw std::overflow_error("ScanTransforms: too many detector groups");
+    replacement[group] = m_transforms.size();
+    covering.emplace_back(m_transforms.size());
+    auto transforms = m_transforms[group];
+    m_transforms.emplace_back(std::move(transforms));
+    m_groupSizes.emplace_back(hits[group]);
+    m_groupSizes[group] -= hits[group];
+    split = true;
+  }
+  if (split) {
+    for (auto it = begin; it != end; ++it) {
+      auto &group = m_groups[*it];
+      if (replacement[group] != unchanged)
+        group = static_cast<uint32_t>(replacement[group]);
+    }
+  }
+  return covering;
+}
+
+} // namespace Mantid::Beamline
@@ -1149,6 +1149,111 @@ public:
     TS_ASSERT_EQUALS(mergeDetectorInfo.scanIntervals()[2], interval3);
   }
 
+  void test_merge_steps_at_reference_positions_is_compact() {
+    PosVec pos{Eigen::Vector3d{1, 0, 0}, Eigen::Vector3d{2, 0, 0}};
+    auto infos1 = makeFlatTree(pos, RotVec(2, Eigen::Quaterniond::Identity()));
+    auto infos2 = makeFlatTree(pos, RotVec(2, Eigen::Quaterniond::Identity()));
+    ComponentInfo &a = *std::get<0>(infos1);
+    ComponentInfo &b = *std::get<0>(infos2);
+    const DetectorInfo &detectorInfo = *std::get<1>(infos1);
+    a.setScanInterval({0, 1});
+    b.setScanInterval({1, 2});
+    a.merge(b);
+    TS_ASSERT(detectorInfo.isScanning());
+    TS_ASSERT(detectorInfo.hasCompactScan());
+    for (size_t timeIndex = 0; timeIndex < 2; ++timeIndex) {
+      TS_ASSERT_EQUALS(detectorInfo.position({0, timeIndex}), pos[0]);
+      TS_ASSERT_EQUALS(detectorInfo.position({1, timeIndex}), pos[1]);
+    }
+  }
+
+  void test_merge_steps_at_other_positions_is_not_compact() {
+    auto infos1 = makeFlatTree(PosVec(1, Eigen::Vector3d{1, 0, 0}), RotVec(1, Eigen::Quaterniond::Identity()));
+    auto infos2 = makeFlatTree(PosVec(1, Eigen::Vector3d{2, 0, 0}), RotVec(1, Eigen::Quaterniond::Identity()));
+    ComponentInfo &a = *std::get<0>(infos1);
+    ComponentInfo &b = *std::get<0>(infos2);
+    a.setScanInterval({0, 1});
+    b.setScanInterval({1, 2});
+    a.merge(b);
+    TS_ASSERT(!std::get<1>(infos1)->hasCompactScan());
+    TS_ASSERT_EQUALS(std::get<1>(infos1)->position({0, 1}), Eigen::Vector3d(2, 0, 0));
+  }
+
+  void test_compact_scan_expands_when_merging_other_positions() {
+    auto infos1 = makeFlatTree(PosVec(1, Eigen::Vector3d{1, 0, 0}), RotVec(1, Eigen::Quaterniond::Identity()));
+    auto infos2 = makeFlatTree(PosVec(1, Eigen::Vector3d{1, 0, 0}), RotVec(1, Eigen::Quaterniond::Identity()));
+    auto infos3 = makeFlatTree(PosVec(1, Eigen::Vector3d{3, 0, 0}), RotVec(1, Eigen::Quaterniond::Identity()));
+    ComponentInfo &a = *std::get<0>(infos1);
+    ComponentInfo &b = *std::get<0>(infos2);
+    ComponentInfo &c = *std::get<0>(infos3);
+    const DetectorInfo &detectorInfo = *std::get<1>(infos1);
+    a.setScanInterval({0, 1});
+    b.setScanInterval({1, 2});
+    c.setScanInterval({2, 3});
+    a.merge(b);
+    TS_ASSERT(detectorInfo.hasCompactScan());
+    a.merge(c);
+    TS_ASSERT(!detectorInfo.hasCompactScan());
+    TS_ASSERT_EQUALS(detectorInfo.scanCount(), 3);
+    TS_ASSERT_EQUALS(detectorInfo.position({0, 0}), Eigen::Vector3d(1, 0, 0));
+    TS_ASSERT_EQUALS(detectorInfo.position({0, 1}), Eigen::Vector3d(1, 0, 0));
+    TS_ASSERT_EQUALS(detectorInfo.position({0, 2}), Eigen::Vector3d(3, 0, 0));
+  }
+
+  void test_compact_scan_setRotation_matches_dense_scan() {
+    PosVec pos{Eigen::Vector3d{1, 0, 0}, Eigen::Vector3d{0, 1, 2}};
+    RotVec rot{Eigen::Quaterniond::Identity(), Eigen::Quaterniond(Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitX()))};
+    auto compact = makeFlatTree(pos, rot);
+    auto compactStep = makeFlatTree(pos, rot);
+    auto dense = makeFlatTree(pos, rot);
+    auto denseStep = makeFlatTree(pos, rot);
+    std::get<0>(compact)->setScanInterval({0, 1});
+    std::get<0>(compactStep)->setScanInterval({1, 2});
+    std::get<0>(dense)->setScanInterval({0, 1});
+    std::get<0>(denseStep)->setScanInterval({1, 2});
+    std::get<0>(compact)->merge(*std::get<0>(compactStep));
+    std::get<0>(dense)->merge(*std::get<0>(denseStep));
+    // Setting a single detector forces explicit storage of all positions
+    std::get<1>(dense)->setPosition({0, 0}, pos[0]);
+    TS_ASSERT(std::get<1>(compact)->hasCompactScan());
+    TS_ASSERT(!std::get<1>(dense)->hasCompactScan());
+
+    const Eigen::Quaterniond rotation(Eigen::AngleAxisd(M_PI / 3, Eigen::Vector3d{1, 2, 3}.normalized()));
+    for (auto *info : {std::get<0>(compact).get(), std::get<0>(dense).get()}) {
+      info->setRotation({info->root(), 1}, rotation);
+      info->setRotation({info->root(), 1}, rotation.inverse());
+      info->setRotation({info->root(), 1}, rotation);
+    }
+    const auto &compactInfo = *std::get<1>(compact);
+    const auto &denseInfo = *std::get<1>(dense);
+    TS_ASSERT(compactInfo.hasCompactScan());
+    TS_ASSERT(compactInfo.isEquivalent(denseInfo));
+    for (size_t timeIndex = 0; timeIndex < 2; ++timeIndex) {
+      for (size_t i = 0; i < 2; ++i) {
+        TS_ASSERT(compactInfo.position({i, timeIndex}).isApprox(denseInfo.position({i, timeIndex}), 1e-14));
+        TS_ASSERT(compactInfo.rotation({i, timeIndex}).isApprox(denseInfo.rotation({i, timeIndex}), 1e-14));
+      }
+    }
+    TS_ASSERT_EQUALS(compactInfo.position({0, 0}), pos[0]);
+    TS_ASSERT(compactInfo.position({0, 1}).isApprox(rotation * pos[0]));
+  }
+
+  void test_compact_scan_setPosition_of_detector_expands() {
+    auto infos1 = makeFlatTree(PosVec(2, Eigen::Vector3d::Zero()), RotVec(2, Eigen::Quaterniond::Identity()));
+    auto infos2 = makeFlatTree(PosVec(2, Eigen::Vector3d::Zero()), RotVec(2, Eigen::Quaterniond::Identity()));
+    std::get<0>(infos1)->setScanInterval({0, 1});
+    std::get<0>(infos2)->setScanInterval({1, 2});
+    std::get<0>(infos1)->merge(*std::get<0>(infos2));
+    auto &detectorInfo = *std::get<1>(infos1);
+    TS_ASSERT(detectorInfo.hasCompactScan());
+    const Eigen::Vector3d pos{1, 2, 3};
+    detectorInfo.setPosition({1, 1}, pos);
+    TS_ASSERT(!detectorInfo.hasCompactScan());
+    TS_ASSERT_EQUALS(detectorInfo.position({1, 1}), pos);
+    TS_ASSERT_EQUALS(detectorInfo.position({1, 0}), Eigen::Vector3d::Zero());
+    TS_ASSERT_EQUALS(detectorInfo.position({0, 1}), Eigen::Vector3d::Zero());
+  }
+
   void test_merge_idempotent() {
     // Test that A + B + B = A + B
     PosVec pos = {Eigen::Vector3d{0, 0, 0}, Eigen::Vector3d{1, 1, 1}};
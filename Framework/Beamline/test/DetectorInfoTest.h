@@ -257,6 +257,48 @@ public:
     TS_ASSERT_EQUALS(info.position(0), pos);
   }
 
+  void test_positionVersion() {
+    DetectorInfo info(PosVec(2), RotVec(2));
+    const auto version = info.positionVersion();
+    TS_ASSERT_DIFFERS(version, 0);
+    TS_ASSERT_EQUALS(info.positionVersion(), version);
+    info.setRotation(0, Eigen::Quaterniond{1, 2, 3, 4});
+    TS_ASSERT_EQUALS(info.positionVersion(), version);
+    info.setMasked(0, true);
+    TS_ASSERT_EQUALS(info.positionVersion(), version);
+    info.setPosition(1, Eigen::Vector3d{1, 2, 3});
+    const auto moved = info.positionVersion();
+    TS_ASSERT_DIFFERS(moved, version);
+    TS_ASSERT_DIFFERS(moved, 0);
+  }
+
+  void test_positionVersion_copy() {
+    DetectorInfo info(PosVec(2), RotVec(2));
+    const auto version = info.positionVersion();
+    DetectorInfo copy(info);
+    TS_ASSERT_EQUALS(copy.positionVersion(), version);
+    copy.setPosition(0, Eigen::Vector3d{1, 2, 3});
+    TS_ASSERT_DIFFERS(copy.positionVersion(), version);
+    TS_ASSERT_EQUALS(info.positionVersion(), version);
+    info = copy;
+    TS_ASSERT_EQUALS(info.positionVersion(), copy.positionVersion());
+  }
+
+  void test_transformDetectors_without_scan() {
+    DetectorInfo info(PosVec(2, Eigen::Vector3d{1, 0, 0}), RotVec(2, Eigen::Quaterniond::Identity()));
+    const auto version = info.positionVersion();
+    Mantid::Beamline::ScanTransforms::Transform transform;
+    transform.rotation = Eigen::Quaterniond(Eigen::AngleAxisd(M_PI / 2, Eigen::Vector3d::UnitZ()));
+    transform.translation = Eigen::Vector3d{0, 0, 1};
+    info.transformDetectors({1}, {transform});
+    TS_ASSERT(!info.hasCompactScan());
+    TS_ASSERT_EQUALS(info.position(0), Eigen::Vector3d(1, 0, 0));
+    TS_ASSERT(info.position(1).isApprox(Eigen::Vector3d(0, 1, 1)));
+    TS_ASSERT(info.rotation(1).isApprox(transform.rotation));
+    TS_ASSERT_DIFFERS(info.positionVersion(), version);
+    TS_ASSERT_THROWS(info.transformDetectors({1}, {transform, transform}), const std::invalid_argument &);
+  }
+
   void test_setRotattion() {
     DetectorInfo info(PosVec(1), RotVec(1));
     Eigen::Quaterniond rot{1, 2, 3, 4};
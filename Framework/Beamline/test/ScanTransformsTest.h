@@ -0,0 +1,127 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidBeamline/ScanTransforms.h"
+
+using Mantid::Beamline::ScanTransforms;
+
+namespace {
+ScanTransforms::Transform translation(const Eigen::Vector3d &offset) {
+  ScanTransforms::Transform transform;
+  transform.translation = offset;
+  return transform;
+}
+} // namespace
+
+class ScanTransformsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ScanTransformsTest *createSuite() { return new ScanTransformsTest(); }
+  static void destroySuite(ScanTransformsTest *suite) { delete suite; }
+
+  void test_constructor() {
+    ScanTransforms transforms(4, 3);
+    TS_ASSERT_EQUALS(transforms.scanCount(), 3);
+    TS_ASSERT_EQUALS(transforms.numberOfGroups(), 1);
+    const Eigen::Vector3d reference{1, 2, 3};
+    for (size_t timeIndex = 0; timeIndex < 3; ++timeIndex)
+      TS_ASSERT_EQUALS(transforms.position(2, timeIndex, reference), reference);
+  }
+
+  void test_appendIdentity() {
+    ScanTransforms transforms(2, 1);
+    const std::vector<size_t> all{0, 1};
+    transforms.transform(all.cbegin(), all.cend(), 0, translation({1, 0, 0}));
+    transforms.appendIdentity();
+    TS_ASSERT_EQUALS(transforms.scanCount(), 2);
+    TS_ASSERT_EQUALS(transforms.position(0, 0, Eigen::Vector3d::Zero()), Eigen::Vector3d(1, 0, 0));
+    TS_ASSERT_EQUALS(transforms.position(0, 1, Eigen::Vector3d::Zero()), Eigen::Vector3d::Zero());
+  }
+
+  void test_transform_whole_group_does_not_split() {
+    ScanTransforms transforms(3, 2);
+    const std::vector<size_t> all{2, 0, 1};
+    transforms.transform(all.cbegin(), all.cend(), 1, translation({0, 1, 0}));
+    TS_ASSERT_EQUALS(transforms.numberOfGroups(), 1);
+    TS_ASSERT_EQUALS(transforms.position(1, 0, Eigen::Vector3d::Zero()), Eigen::Vector3d::Zero());
+    TS_ASSERT_EQUALS(transforms.position(1, 1, Eigen::Vector3d::Zero()), Eigen::Vector3d(0, 1, 0));
+  }
+
+  void test_transform_part_of_group_splits() {
+    ScanTransforms transforms(4, 2);
+    const std::vector<size_t> all{0, 1, 2, 3};
+    const std::vector<size_t> tube{2, 3};
+    transforms.transform(all.cbegin(), all.cend(), 1, translation({1, 0, 0}));
+    transforms.transform(tube.cbegin(), tube.cend(), 1, translation({0, 1, 0}));
+    TS_ASSERT_EQUALS(transforms.numberOfGroups(), 2);
+    TS_ASSERT_EQUALS(transforms.group(0), transforms.group(1));
+    TS_ASSERT_EQUALS(transforms.group(2), transforms.group(3));
+    TS_ASSERT_DIFFERS(transforms.group(0), transforms.group(2));
+    const Eigen::Vector3d zero = Eigen::Vector3d::Zero();
+    TS_ASSERT_EQUALS(transforms.position(0, 1, zero), Eigen::Vector3d(1, 0, 0));
+    TS_ASSERT_EQUALS(transforms.position(3, 1, zero), Eigen::Vector3d(1, 1, 0));
+    // The split group keeps the history of the group it was split from
+    TS_ASSERT_EQUALS(transforms.position(3, 0, zero), zero);
+
+    // Transforming the same subset again reuses its group
+    transforms.transform(tube.cbegin(), tube.cend(), 0, translation({0, 0, 1}));
+    TS_ASSERT_EQUALS(transforms.numberOfGroups(), 2);
+    TS_ASSERT_EQUALS(transforms.position(2, 0, zero), Eigen::Vector3d(0, 0, 1));
+    TS_ASSERT_EQUALS(transforms.position(0, 0, zero), zero);
+  }
+
+  void test_transform_across_groups() {
+    ScanTransforms transforms(4, 1);
+    const std::vector<size_t> first{0, 1};
+    const std::vector<size_t> middle{1, 2};
+    transforms.transform(first.cbegin(), first.cend(), 0, translation({1, 0, 0}));
+    transforms.transform(middle.cbegin(), middle.cend(), 0, translation({0, 1, 0}));
+    TS_ASSERT_EQUALS(transforms.numberOfGroups(), 4);
+    const Eigen::Vector3d zero = Eigen::Vector3d::Zero();
+    TS_ASSERT_EQUALS(transforms.position(0, 0, zero), Eigen::Vector3d(1, 0, 0));
+    TS_ASSERT_EQUALS(transforms.position(1, 0, zero), Eigen::Vector3d(1, 1, 0));
+    TS_ASSERT_EQUALS(transforms.position(2, 0, zero), Eigen::Vector3d(0, 1, 0));
+    TS_ASSERT_EQUALS(transforms.position(3, 0, zero), zero);
+  }
+
+  void test_rotation_is_applied_after_current_transform() {
+    ScanTransforms transforms(1, 1);
+    const std::vector<size_t> all{0};
+    transforms.transform(all.cbegin(), all.cend(), 0, translation({1, 0, 0}));
+    ScanTransforms::Transform rotation;
+    rotation.rotation = Eigen::Quaterniond(Eigen::AngleAxisd(M_PI / 2, Eigen::Vector3d::UnitZ()));
+    transforms.transform(all.cbegin(), all.cend(), 0, rotation);
+    TS_ASSERT(transforms.position(0, 0, Eigen::Vector3d(1, 0, 0)).isApprox(Eigen::Vector3d(0, 2, 0)));
+    TS_ASSERT(transforms.rotation(0, 0, Eigen::Quaterniond::Identity()).isApprox(rotation.rotation));
+  }
+
+  void test_transform_all_time_indices() {
+    ScanTransforms transforms(3, 3);
+    const std::vector<size_t> moving{0, 2};
+    ScanTransforms::Transforms deltas{translation({1, 0, 0}), translation({2, 0, 0}), translation({3, 0, 0})};
+    transforms.transform(moving.cbegin(), moving.cend(), deltas);
+    const Eigen::Vector3d zero = Eigen::Vector3d::Zero();
+    for (size_t timeIndex = 0; timeIndex < 3; ++timeIndex) {
+      TS_ASSERT_EQUALS(transforms.position(0, timeIndex, zero), deltas[timeIndex].translation);
+      TS_ASSERT_EQUALS(transforms.position(1, timeIndex, zero), zero);
+      TS_ASSERT_EQUALS(transforms.position(2, timeIndex, zero), deltas[timeIndex].translation);
+    }
+  }
+
+  void test_transform_failures() {
+    ScanTransforms transforms(2, 2);
+    const std::vector<size_t> all{0, 1};
+    TS_ASSERT_THROWS(transforms.transform(all.cbegin(), all.cend(), 2, translation({1, 0, 0})),
+                     const std::out_of_range &);
+    TS_ASSERT_THROWS(transforms.transform(all.cbegin(), all.cend(), ScanTransforms::Transforms(1)),
+                     const std::invalid_argument &);
+  }
+};
@@ -11,6 +11,7 @@
 #include "MantidAPI/MatrixWorkspace_fwd.h"
 #include "MantidCurveFitting/DllConfig.h"
 #include "MantidCurveFitting/Functions/BackgroundFunction.h"
+#include "MantidCurveFitting/PeakProfileCache.h"
 #include "MantidKernel/System.h"
 
 namespace Mantid {
@@ -160,6 +161,9 @@ private:
   /// Has new peak values
   mutable bool m_hasNewPeakValue;
 
+  /// Calculated values of the peaks
+  mutable PeakProfileCache m_peakCache;
+
   /// Has first value set up
   bool m_isInputValue;
 
@@ -66,10 +66,27 @@ private:
   /// Set any WorkspaceIndex attributes in the fitting function
   void setWorkspaceIndexAttribute(const API::IFunction_sptr &fun, int wsIndex) const;
 
+  /// Outcome of fitting a single spectrum
+  struct SpectrumFitResult {
+    API::IFunction_sptr function;
+    double chi2 = 0.0;
+    std::string status;
+    API::MatrixWorkspace_sptr fitWorkspace;
+    API::ITableWorkspace_sptr parameterWorkspace;
+    API::ITableWorkspace_sptr covarianceWorkspace;
+  };
+
+  SpectrumFitResult fitSpectrum(bool createFitOutput, bool outputCompositeMembers, bool outputConvolvedMembers,
+                                const API::IFunction_sptr &ifun, const InputSpectraToFit &data, double startX,
+                                double endX, const std::string &exclude, const std::string &minimizer);
+
   std::shared_ptr<Algorithm> runSingleFit(bool createFitOutput, bool outputCompositeMembers,
                                           bool outputConvolvedMembers, const API::IFunction_sptr &ifun,
                                           const InputSpectraToFit &data, double startX, double endX,
-                                          const std::string &exclude);
+                                          const std::string &exclude, const std::string &minimizer);
+
+  bool canFitInParallel(bool individual, bool isMultiDomainFunction,
+                        const std::vector<InputSpectraToFit> &spectra) const;
 
   double calculateLogValue(const std::string &logName, const InputSpectraToFit &data);
 
@@ -98,6 +115,10 @@ private:
 
   /// Record of workspaces output by the minimizer
   std::map<std::string, std::vector<std::string>> m_minimizerWorkspaces;
+
+  /// Workspace properties (name, value) of each minimizer string already
+  /// created, so that the minimizer is only created once per distinct string
+  std::map<std::string, std::vector<std::pair<std::string, std::string>>> m_minimizerWorkspaceProperties;
 };
 
 } // namespace Algorithms
@@ -79,6 +79,8 @@ public:
   void applyTies();
   /// Reset the fitting function (neccessary if parameters get fixed/unfixed)
   void reset() const;
+  /// Check if the constraints' penalty is added to the cost function
+  bool includePenalty() const { return m_includePenalty; }
 
 protected:
   /// Calculates covariance matrix for fitting function's active parameters.
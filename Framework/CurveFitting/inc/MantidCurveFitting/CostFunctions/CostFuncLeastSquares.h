@@ -32,6 +32,9 @@ public:
   /// Get short name of minimizer - useful for say labels in guis
   std::string shortName() const override { return "Chi-sq"; };
 
+  /// Get mapped weights from FunctionValues
+  virtual std::vector<double> getFitWeights(API::FunctionValues_sptr values) const;
+
 protected:
   void calActiveCovarianceMatrix(EigenMatrix &covar, double epsrel = 1e-8) override;
 
@@ -40,9 +43,6 @@ protected:
                           API::FunctionValues_sptr values, bool evalDeriv = true,
                           bool evalHessian = true) const override;
 
-  /// Get mapped weights from FunctionValues
-  virtual std::vector<double> getFitWeights(API::FunctionValues_sptr values) const;
-
   double m_factor;
 };
 
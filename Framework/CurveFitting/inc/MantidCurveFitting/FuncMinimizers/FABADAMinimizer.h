@@ -12,6 +12,9 @@
 #include "MantidCurveFitting/EigenVector.h"
 #include "MantidKernel/System.h"
 
+#include <memory>
+#include <random>
+
 namespace Mantid {
 namespace CurveFitting {
 namespace CostFunctions {
@@ -28,6 +31,12 @@ namespace FuncMinimisers {
 /** FABADA : Implements the FABADA Algorithm, based on a Adaptive Metropolis
   Algorithm extended with Gibbs Sampling. Designed to obtain the Bayesian
   posterior PDFs
+
+  With NumberOfChains > 1 several independent chains, each on its own copy of
+  the fitting function, are advanced concurrently. Their converged parts are
+  pooled so that each chain contributes ChainLength / NumberOfChains points,
+  and the Gelman-Rubin statistic across the chains ends the burn-in of all of
+  them as soon as they agree.
 */
 class MANTID_CURVEFITTING_DLL FABADAMinimizer : public API::IFuncMinimizer {
 public:
@@ -49,8 +58,23 @@ public:
   /// If the new point is out of its bounds, it is changed to fit in the bound
   /// limits
   void boundApplication(const size_t &parameterIndex, double &newValue, double &step);
+  /// Gelman-Rubin potential scale reduction of each parameter over the
+  /// converged parts of the chains
+  std::vector<double> gelmanRubin() const;
 
 private:
+  /// Initialize the state of a single chain
+  void initializeChain(size_t maxIterations);
+  /// Create the additional chains run alongside this one
+  void createChains(size_t nChains, size_t maxIterations);
+  /// Do one iteration of a single chain
+  bool advanceChain();
+  /// Mark the chain as converged and start collecting the posterior chain
+  void setConverged();
+  /// End the burn-in of all chains if the Gelman-Rubin statistic allows it
+  void gelmanRubinConvergenceCheck();
+  /// The converged parts of all chains, one after another
+  std::vector<std::vector<double>> pooledConvergedChain() const;
   /// Returns the step from a Gaussian given sigma = Jump
   double gaussianStep(const double &jump);
   /// Applied to the other parameters first and sequentially, finally to the
@@ -71,7 +95,7 @@ private:
   /// Output Markov chains
   void outputChains();
   /// Output converged chains
-  void outputConvergedChains(size_t convLength, int nSteps);
+  void outputConvergedChains(const std::vector<std::vector<double>> &convergedChain, size_t convLength, int nSteps);
   /// Output cost function
   void outputCostFunctionTable(size_t convLength, double mostProbableChi2);
   /// Output PDF
@@ -90,8 +114,8 @@ private:
   void outputParameterTable(const std::vector<double> &bestParameters, const std::vector<double> &errorsLeft,
                             const std::vector<double> &errorsRight);
   /// Calculated converged chain and parameters
-  void calculateConvChainAndBestParameters(size_t convLength, int nSteps,
-                                           std::vector<std::vector<double>> &reducedChain,
+  void calculateConvChainAndBestParameters(const std::vector<std::vector<double>> &convergedChain, size_t convLength,
+                                           int nSteps, std::vector<std::vector<double>> &reducedChain,
                                            std::vector<double> &bestParameters, std::vector<double> &errorLeft,
                                            std::vector<double> &errorRight);
   /// Initialize member variables related to fitting parameters
@@ -151,6 +175,16 @@ private:
   std::vector<size_t> m_numInactiveRegenerations;
   /// To track convergence through immobility
   std::vector<int> m_changesOld;
+  /// Random number generator of this chain
+  std::mt19937 m_rng;
+  /// Number of points of the converged part of this chain
+  size_t m_chainLength;
+  /// True when this chain has completed its converged part
+  bool m_finished;
+  /// The chains run alongside this one
+  std::vector<std::unique_ptr<FABADAMinimizer>> m_chains;
+  /// The number of iterations while any of the chains runs
+  size_t m_iterationOfChains;
 };
 
 /// Used to access the setDirty() protected member
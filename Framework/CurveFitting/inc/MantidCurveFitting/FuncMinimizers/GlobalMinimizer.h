@@ -0,0 +1,89 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IFuncMinimizer.h"
+#include "MantidCurveFitting/DllConfig.h"
+#include "MantidKernel/MersenneTwister.h"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace CurveFitting {
+namespace FuncMinimisers {
+/** A global minimizer searching a box in parameter space for the lowest
+    minimum of the cost function.
+
+    Method=MultiStart runs a local minimizer from NumberOfStarts points: the
+    initial parameters and points of a Sobol sequence filling the box.
+    Method=DifferentialEvolution evolves a population of NumberOfStarts points,
+    one generation per iteration, and refines the best member with the local
+    minimizer when the population has converged.
+
+    The box is given by the boundary constraints of the parameters. Where a
+    bound is missing the parameter may vary by SearchRange times its initial
+    value (or by SearchRange if it is zero).
+
+    The points are evaluated in parallel if the cost function fits a function
+    on a simple domain; each thread then works on its own copy of the cost
+    function.
+*/
+class MANTID_CURVEFITTING_DLL GlobalMinimizer : public API::IFuncMinimizer {
+public:
+  GlobalMinimizer();
+  /// Name of the minimizer.
+  std::string name() const override { return "Global"; }
+  /// Initialize minimizer, i.e. pass a function to minimize.
+  void initialize(API::ICostFunction_sptr function, size_t maxIterations = 1000) override;
+  /// Do one iteration.
+  bool iterate(size_t iteration) override;
+  /// Return current value of the cost function
+  double costFunctionVal() override;
+
+private:
+  /// A point in parameter space and the value of the cost function there
+  struct Candidate {
+    std::vector<double> parameters;
+    double cost = std::numeric_limits<double>::infinity();
+  };
+
+  void setSearchBox();
+  std::vector<std::vector<double>> startingPoints(size_t n) const;
+  std::vector<API::ICostFunction_sptr> costFunctionCopies(size_t n) const;
+  void setParameters(API::ICostFunction &costFunction, const std::vector<double> &parameters) const;
+  double cost(API::ICostFunction &costFunction, const std::vector<double> &parameters) const;
+  Candidate localMinimum(API::IFuncMinimizer &minimizer, const API::ICostFunction_sptr &costFunction,
+                         const std::vector<double> &start) const;
+  void evaluate(std::vector<Candidate> &candidates) const;
+  bool multiStart();
+  bool evolve(size_t iteration);
+  void accept(const Candidate &candidate);
+
+  /// The cost function to minimize
+  API::ICostFunction_sptr m_costFunction;
+  /// Maximum number of iterations of the local minimizer
+  size_t m_maxIterations;
+  /// Lower bounds of the search box
+  std::vector<double> m_lower;
+  /// Upper bounds of the search box
+  std::vector<double> m_upper;
+  /// Copies of the cost function for parallel evaluation, empty if the
+  /// cost function cannot be copied
+  std::vector<API::ICostFunction_sptr> m_copies;
+  /// Differential evolution population
+  std::vector<Candidate> m_population;
+  /// Best point found so far
+  Candidate m_best;
+  /// Random numbers for differential evolution
+  std::unique_ptr<Kernel::MersenneTwister> m_random;
+};
+
+} // namespace FuncMinimisers
+} // namespace CurveFitting
+} // namespace Mantid
@@ -0,0 +1,142 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IFuncMinimizer.h"
+#include "MantidAPI/IFunction.h"
+#include "MantidCurveFitting/DllConfig.h"
+
+#include <Eigen/Core>
+
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class FunctionDomain;
+} // namespace API
+namespace CurveFitting {
+namespace CostFunctions {
+class CostFuncLeastSquares;
+} // namespace CostFunctions
+
+namespace FuncMinimisers {
+/** Levenberg-Marquardt minimizer for global fits of a MultiDomainFunction.
+
+    The parameters of a member function that applies to a single domain are
+    local to that domain; all other parameters are shared, as are those that
+    ties of other members refer to. The Hessian of a
+    least squares cost function then has a block-arrow structure: a block for
+    the local parameters of each domain, a block for the shared parameters and
+    the blocks coupling the two. The Jacobian is calculated domain by domain
+    and never stored in full, and the damped normal equations are solved by
+    eliminating the local parameters (the Schur complement on the shared
+    parameters). The cost of an iteration is therefore linear in the number of
+    domains.
+
+    If the function has the NumDeriv attribute set, which is the default of
+    MultiDomainFunction, or has ties to other parameters, the derivatives are
+    calculated numerically with the ties applied after each step.
+
+    The damping strategy and the stopping criteria are those of
+    LevenbergMarquardtMDMinimizer. Any other function is fitted as a single
+    block of parameters, which is the same as the dense algorithm.
+*/
+class MANTID_CURVEFITTING_DLL SparseLevenbergMarquardtMinimizer : public API::IFuncMinimizer {
+public:
+  SparseLevenbergMarquardtMinimizer();
+  /// Name of the minimizer.
+  std::string name() const override { return "Levenberg-MarquardtSparse"; }
+  /// Initialize minimizer, i.e. pass a function to minimize.
+  void initialize(API::ICostFunction_sptr function, size_t maxIterations = 0) override;
+  /// Do one iteration.
+  bool iterate(size_t iteration) override;
+  /// Return current value of the cost function
+  double costFunctionVal() override;
+
+private:
+  /// A member function applied to a domain
+  struct Member {
+    API::IFunction_sptr function;
+    /// Index of the member's first parameter in the fitting function
+    size_t parameterOffset;
+  };
+
+  /// One part of the domain with the parameters local to it
+  struct Block {
+    const API::FunctionDomain *domain = nullptr;
+    /// Index of the first value of the part in the cost function's values
+    size_t valueOffset = 0;
+    /// Members with parameters local to this part
+    std::vector<Member> localMembers;
+    /// Members with shared parameters
+    std::vector<Member> sharedMembers;
+    /// Active indices of the local parameters
+    std::vector<size_t> local;
+    /// Calculated values
+    Eigen::VectorXd calculated;
+    /// Derivatives by the local and the shared parameters
+    Eigen::MatrixXd localJacobian;
+    Eigen::MatrixXd sharedJacobian;
+    /// Hessian blocks: local-local, local-shared and shared-shared
+    Eigen::MatrixXd A;
+    Eigen::MatrixXd B;
+    Eigen::MatrixXd C;
+    /// Gradients by the local and the shared parameters
+    Eigen::VectorXd localGradient;
+    Eigen::VectorXd sharedGradient;
+    /// A^-1 * B and A^-1 * (local gradient) of the damped, scaled system
+    Eigen::MatrixXd AinvB;
+    Eigen::VectorXd AinvG;
+    /// The block's contributions to the Schur complement and its right-hand side
+    Eigen::MatrixXd schur;
+    Eigen::VectorXd schurRhs;
+  };
+
+  void setBlocks();
+  void addDerivatives(const Member &member, Block &block) const;
+  Eigen::VectorXd evaluate(const Block &block) const;
+  void calculateNumericalDerivatives();
+  void calculateDerivatives();
+  void addPenalty();
+  bool solve(Eigen::VectorXd &dx);
+  double hessianDiagonal(size_t i) const;
+  double predictedReduction(const Eigen::VectorXd &dx) const;
+
+  /// Pointer to the cost function.
+  std::shared_ptr<CostFunctions::CostFuncLeastSquares> m_costFunction;
+  /// Parts of the domain
+  std::vector<Block> m_blocks;
+  /// Active indices of the shared parameters
+  std::vector<size_t> m_shared;
+  /// Active index of each parameter of the fitting function or npos if fixed
+  std::vector<size_t> m_activeIndex;
+  /// Block of each active parameter or npos if it is shared
+  std::vector<size_t> m_owner;
+  /// Position of each active parameter in its block or in m_shared
+  std::vector<size_t> m_position;
+  /// Hessian block of the shared parameters summed over the blocks
+  Eigen::MatrixXd m_sharedHessian;
+  /// Gradient by all active parameters
+  Eigen::VectorXd m_gradient;
+  /// Calculate the derivatives numerically
+  bool m_numericalDerivatives = false;
+  /// The tau parameter in the Levenberg-Marquardt method.
+  double m_tau;
+  /// The damping mu parameter in the Levenberg-Marquardt method.
+  double m_mu;
+  /// The nu parameter in the Levenberg-Marquardt method.
+  double m_nu;
+  /// The rho parameter in the Levenberg-Marquardt method.
+  double m_rho;
+  /// To keep function value
+  double m_F;
+  std::vector<double> m_D;
+};
+
+} // namespace FuncMinimisers
+} // namespace CurveFitting
+} // namespace Mantid
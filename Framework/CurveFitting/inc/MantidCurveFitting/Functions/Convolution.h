@@ -119,7 +119,7 @@ public:
   void setUpForFit() override;
 
   /// Deletes and zeroes pointer m_resolution forsing function(...) to
-  /// recalculate the resolution function
+  /// recalculate the resolution function if its parameters have changed
   void refreshResolution() const;
 
 protected:
@@ -131,6 +131,14 @@ private:
   /// step in xValues) when in FFT mode, and the inverted resolution if in
   /// Direct mode
   mutable std::vector<double> m_resolution;
+  /// The x-values m_resolution was calculated for
+  mutable std::vector<double> m_resolutionX;
+  /// The resolution parameters m_resolution was calculated with
+  mutable std::vector<double> m_resolutionParameters;
+  /// True if m_resolution holds the transform used in FFT mode
+  mutable bool m_resolutionFFTMode = true;
+  bool isResolutionCached(bool fftMode, const double *xValues, size_t nData) const;
+  void cacheResolution(bool fftMode, const double *xValues, size_t nData) const;
   void innerFunctionsAre1D() const;
 };
 
@@ -12,6 +12,7 @@
 #include "MantidAPI/MatrixWorkspace_fwd.h"
 #include "MantidAPI/ParamFunction.h"
 #include "MantidCurveFitting/DllConfig.h"
+#include "MantidCurveFitting/PeakProfileCache.h"
 #include "MantidKernel/System.h"
 
 #include "MantidGeometry/Crystal/PointGroup.h"
@@ -140,6 +141,9 @@ protected:
   Kernel::Unit_sptr m_wsUnit;
 
   int m_peakRadius;
+
+  /// Calculated values of the peaks
+  mutable PeakProfileCache m_peakCache;
 };
 
 using PawleyFunction_sptr = std::shared_ptr<PawleyFunction>;
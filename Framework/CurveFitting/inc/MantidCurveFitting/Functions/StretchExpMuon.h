@@ -29,6 +29,7 @@ public:
 
 protected:
   void function1D(double *out, const double *xValues, const size_t nData) const override;
+  void functionDeriv1D(API::Jacobian *out, const double *xValues, const size_t nData) override;
   void init() override;
 };
 
@@ -19,11 +19,18 @@ class Parser;
 }
 
 namespace Mantid {
+namespace API {
+class CompiledExpression;
+}
 namespace CurveFitting {
 namespace Functions {
 /**
 A user defined function.
 
+Formulas built from arithmetic and elementary functions are compiled to
+evaluate whole arrays at once and to provide analytical derivatives. Other
+formulas are evaluated point by point with muParser.
+
 @author Roman Tolchenov, Tessella plc
 @date 15/01/2010
 */
@@ -66,6 +73,8 @@ private:
   mutable double m_x;
   /// True indicates that input formula contains 'x' variable
   bool m_x_set;
+  /// Compiled formula, if it can be compiled
+  std::unique_ptr<API::CompiledExpression> m_compiled;
   /// Temporary data storage used in functionDeriv
   mutable std::vector<double> m_tmp;
   /// Temporary data storage used in functionDeriv
@@ -73,6 +82,10 @@ private:
 
   /// mu::Parser callback function for setting variables.
   static double *AddVariable(const char *varName, void *pufun);
+  /// Compile the formula if it is supported and agrees with muParser
+  void compileFormula();
+  /// Current values of the parameters
+  std::vector<double> parameterValues() const;
 };
 
 } // namespace Functions
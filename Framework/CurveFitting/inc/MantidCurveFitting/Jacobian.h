@@ -70,6 +70,8 @@ public:
   }
   /// overwrite base method
   void zero() override { m_data.assign(m_data.size(), 0.0); }
+  /// Get the derivatives, stored row by row with one row per data point
+  const std::vector<double> &data() const { return m_data; }
 };
 
 } // namespace CurveFitting
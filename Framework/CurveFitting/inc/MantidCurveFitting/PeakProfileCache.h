@@ -0,0 +1,64 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IFunction.h"
+#include "MantidCurveFitting/DllConfig.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Mantid {
+namespace CurveFitting {
+
+/** PeakProfileCache : Helper class that keeps the calculated profile of each
+peak of a powder pattern together with the parameter values it was calculated
+with. A profile is only recalculated when a parameter of its peak changes, so
+when a fit changes the parameters of one peak (e.g. when calculating a
+numerical derivative) the other peaks are not evaluated again.
+
+A profile covers a window of the domain: it holds the values starting at an
+offset into the domain. All profiles are discarded when the domain changes.
+Changes of a peak's attributes are not detected, the owner must call clear()
+after changing them.
+*/
+class MANTID_CURVEFITTING_DLL PeakProfileCache {
+public:
+  /// Values of a peak in a window of the domain
+  struct Profile {
+    /// Index of the first value in the domain
+    std::size_t offset = 0;
+    std::vector<double> values;
+  };
+
+  /// Set the domain the profiles are calculated on
+  void setDomain(const double *x, std::size_t n);
+  /// Get the stored profile of the i-th peak if it is up to date
+  const Profile *find(std::size_t i, const API::IFunction_sptr &peak) const;
+  /// Store the profile of the i-th peak
+  const Profile &store(std::size_t i, const API::IFunction_sptr &peak, std::size_t offset, const double *values,
+                       std::size_t n);
+  /// Discard all profiles
+  void clear();
+
+private:
+  struct Entry {
+    /// The peak the profile was calculated for
+    API::IFunction_sptr peak;
+    /// Parameter values of the peak at the time of the calculation
+    std::vector<double> parameters;
+    Profile profile;
+  };
+
+  /// Copy of the domain
+  std::vector<double> m_domain;
+  /// Profiles by peak index
+  std::vector<Entry> m_entries;
+};
+
+} // namespace CurveFitting
+} // namespace Mantid
@@ -13,6 +13,7 @@
 #include "MantidHistogramData/HistogramY.h"
 #include "MantidKernel/System.h"
 
+#include <algorithm>
 #include <sstream>
 #include <utility>
 
@@ -110,12 +111,24 @@ HistogramY LeBailFunction::function(const Mantid::HistogramData::HistogramX &xva
 
   // Peaks
   if (calpeaks) {
+    // Peaks whose parameters are unchanged since the last call are not calculated again
+    m_peakCache.setDomain(xvals.data(), xvals.size());
+    // A peak only writes the values within its range, which are reset after use
+    vector<double> temp(xvalues.size(), 0);
+    auto isNonZero = [](double y) { return y != 0.; };
     for (size_t ipk = 0; ipk < m_numPeaks; ++ipk) {
-      // Reset temporary vector for output
-      vector<double> temp(xvalues.size(), 0);
       IPowderDiffPeakFunction_sptr peak = m_vecPeaks[ipk];
-      peak->function(temp, xvals);
-      transform(out.begin(), out.end(), temp.begin(), out.begin(), ::plus<double>());
+      const PeakProfileCache::Profile *profile = m_peakCache.find(ipk, peak);
+      if (!profile) {
+        peak->function(temp, xvals);
+        auto first = find_if(temp.begin(), temp.end(), isNonZero);
+        auto last = find_if(temp.rbegin(), vector<double>::reverse_iterator(first), isNonZero).base();
+        auto offset = static_cast<size_t>(distance(temp.begin(), first));
+        profile = &m_peakCache.store(ipk, peak, offset, temp.data() + offset, static_cast<size_t>(distance(first, last)));
+        fill(first, last, 0.);
+      }
+      auto start = out.begin() + profile->offset;
+      transform(profile->values.begin(), profile->values.end(), start, start, ::plus<double>());
     }
   }
 
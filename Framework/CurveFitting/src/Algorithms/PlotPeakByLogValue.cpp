@@ -33,6 +33,7 @@
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 
 namespace {
@@ -90,7 +91,8 @@ void PlotPeakByLogValue::init() {
                   "If set to 'Sequential' every next fit starts with "
                   "parameters returned by the previous fit. \n"
                   "If set to 'Individual' each fit starts with the same "
-                  "initial values defined in the Function property.");
+                  "initial values defined in the Function property and the "
+                  "spectra are fitted in parallel.");
 
   declareProperty("PassWSIndexToFunction", false,
                   "For each spectrum in Input pass its workspace index to all "
@@ -231,62 +233,96 @@ void PlotPeakByLogValue::exec() {
     fitChiSquared.reserve(wsNames.size());
   }
 
-  double dProg = 1. / static_cast<double>(wsNames.size());
-  double Prog = 0.;
+  // Select the spectra to fit and create the minimizer strings up front: both
+  // log warnings and record minimizer output workspaces, which must happen in
+  // input order
+  std::vector<int> toFit;
+  std::vector<std::string> minimizers;
+  toFit.reserve(wsNames.size());
+  minimizers.reserve(wsNames.size());
   for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
-    InputSpectraToFit data = wsNames[i];
-
+    const auto &data = wsNames[i];
     if (!data.ws) {
       g_log.warning() << "Cannot access workspace " << data.name << '\n';
       continue;
     }
-
     if (data.i < 0) {
-      g_log.warning() << "Zero spectra selected for fitting in workspace " << wsNames[i].name << '\n';
+      g_log.warning() << "Zero spectra selected for fitting in workspace " << data.name << '\n';
       continue;
     }
+    toFit.emplace_back(i);
+    minimizers.emplace_back(getMinimizerString(data.name, std::to_string(data.i)));
+  }
 
-    IFunction_sptr ifun =
-        setupFunction(individual, passWSIndexToFunction, inputFunction, initialParams, isMultiDomainFunction, i, data);
-    std::shared_ptr<Algorithm> fit;
-    if (startX.size() == 0) {
-      fit = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data, EMPTY_DBL(),
-                         EMPTY_DBL(), exclude[i]);
-    } else if (startX.size() == 1) {
-      fit = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data, startX[0],
-                         endX[0], exclude[i]);
-    } else {
-      fit = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data, startX[i],
-                         endX[i], exclude[i]);
+  const auto fitRange = [&startX, &endX](const int i) {
+    if (startX.empty())
+      return std::make_pair(EMPTY_DBL(), EMPTY_DBL());
+    if (startX.size() == 1)
+      return std::make_pair(startX[0], endX[0]);
+    return std::make_pair(startX[i], endX[i]);
+  };
+
+  const auto nFits = static_cast<int>(toFit.size());
+  std::vector<SpectrumFitResult> fitResults(toFit.size());
+  Progress prog(this, 0.0, 1.0, toFit.size());
+  if (canFitInParallel(individual, isMultiDomainFunction, wsNames)) {
+    // Individual fits are independent: fit a copy of the input function for
+    // each spectrum concurrently
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int j = 0; j < nFits; ++j) {
+      PARALLEL_START_INTERRUPT_REGION
+      const int i = toFit[j];
+      const auto &data = wsNames[i];
+      auto ifun = inputFunction->clone();
+      if (passWSIndexToFunction)
+        setWorkspaceIndexAttribute(ifun, data.i);
+      const auto range = fitRange(i);
+      fitResults[j] = fitSpectrum(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data,
+                                  range.first, range.second, exclude[i], minimizers[j]);
+      prog.report("Fitting Workspace: (" + std::to_string(i) + ") - ");
+      PARALLEL_END_INTERRUPT_REGION
     }
+    PARALLEL_CHECK_INTERRUPT_REGION
+    // Leave the input function holding the result of the last fit, as a serial
+    // run does
+    if (!fitResults.empty()) {
+      const auto &last = fitResults.back().function;
+      for (size_t k = 0; k < inputFunction->nParams(); ++k) {
+        inputFunction->setParameter(k, last->getParameter(k));
+        inputFunction->setError(k, last->getError(k));
+      }
+    }
+  } else {
+    for (int j = 0; j < nFits; ++j) {
+      const int i = toFit[j];
+      const auto &data = wsNames[i];
+      IFunction_sptr ifun = setupFunction(individual, passWSIndexToFunction, inputFunction, initialParams,
+                                          isMultiDomainFunction, i, data);
+      const auto range = fitRange(i);
+      fitResults[j] = fitSpectrum(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data,
+                                  range.first, range.second, exclude[i], minimizers[j]);
+      prog.report("Fitting Workspace: (" + std::to_string(i) + ") - ");
+      interruption_point();
+    }
+  }
 
-    ifun = fit->getProperty("Function");
-    double chi2 = fit->getProperty("OutputChi2overDoF");
-
+  // Collect the results in input order
+  for (int j = 0; j < nFits; ++j) {
+    const auto &data = wsNames[toFit[j]];
+    const auto &fitResult = fitResults[j];
     if (createFitOutput) {
-      MatrixWorkspace_sptr outputFitWorkspace = fit->getProperty("OutputWorkspace");
-      ITableWorkspace_sptr outputParamWorkspace = fit->getProperty("OutputParameters");
-      ITableWorkspace_sptr outputCovarianceWorkspace = fit->getProperty("OutputNormalisedCovarianceMatrix");
-      fitWorkspaces.emplace_back(outputFitWorkspace);
-      parameterWorkspaces.emplace_back(outputParamWorkspace);
-      covarianceWorkspaces.emplace_back(outputCovarianceWorkspace);
+      fitWorkspaces.emplace_back(fitResult.fitWorkspace);
+      parameterWorkspaces.emplace_back(fitResult.parameterWorkspace);
+      covarianceWorkspaces.emplace_back(fitResult.covarianceWorkspace);
     }
     if (outputFitStatus) {
-      fitStatus.push_back(fit->getProperty("OutputStatus"));
-      fitChiSquared.push_back(chi2);
+      fitStatus.emplace_back(fitResult.status);
+      fitChiSquared.emplace_back(fitResult.chi2);
     }
-
-    g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus") << ' ' << chi2 << '\n';
-
     // Find the log value: it is either a log-file value or
     // simply the workspace number
     double logValue = calculateLogValue(logName, data);
-    appendTableRow(isDataName, result, ifun, data, logValue, chi2);
-
-    Prog += dProg;
-    std::string current = std::to_string(i);
-    progress(Prog, ("Fitting Workspace: (" + current + ") - "));
-    interruption_point();
+    appendTableRow(isDataName, result, fitResult.function, data, logValue, fitResult.chi2);
   }
 
   if (outputFitStatus) {
@@ -449,12 +485,55 @@ ITableWorkspace_sptr PlotPeakByLogValue::createResultsTable(const std::string &l
   return result;
 }
 
+/**
+ * Decide whether the spectra can be fitted concurrently. This requires that
+ * every fit starts from the same initial values, i.e. no warm start from a
+ * previous result, and that the minimizer does not create output workspaces,
+ * which are named and grouped in input order.
+ * @param individual :: True if each fit starts from the input function
+ * @param isMultiDomainFunction :: True if the input function is a
+ * MultiDomainFunction holding a function per spectrum
+ * @param spectra :: The spectra to fit
+ * @return True if the fits can run in parallel
+ */
+bool PlotPeakByLogValue::canFitInParallel(bool individual, bool isMultiDomainFunction,
+                                          const std::vector<InputSpectraToFit> &spectra) const {
+  if (!individual || isMultiDomainFunction || !m_minimizerWorkspaces.empty() || spectra.size() < 2)
+    return false;
+  return std::all_of(spectra.cbegin(), spectra.cend(),
+                     [](const auto &data) { return !data.ws || data.ws->threadSafe(); });
+}
+
+/**
+ * Fit a single spectrum and extract the results from the Fit algorithm.
+ */
+PlotPeakByLogValue::SpectrumFitResult
+PlotPeakByLogValue::fitSpectrum(bool createFitOutput, bool outputCompositeMembers, bool outputConvolvedMembers,
+                                const IFunction_sptr &ifun, const InputSpectraToFit &data, double startX, double endX,
+                                const std::string &exclude, const std::string &minimizer) {
+  auto fit = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data, startX, endX,
+                          exclude, minimizer);
+  SpectrumFitResult fitResult;
+  fitResult.function = fit->getProperty("Function");
+  fitResult.chi2 = fit->getProperty("OutputChi2overDoF");
+  fitResult.status = fit->getPropertyValue("OutputStatus");
+  if (createFitOutput) {
+    fitResult.fitWorkspace = fit->getProperty("OutputWorkspace");
+    fitResult.parameterWorkspace = fit->getProperty("OutputParameters");
+    fitResult.covarianceWorkspace = fit->getProperty("OutputNormalisedCovarianceMatrix");
+  }
+  g_log.debug() << "Fit result " << fitResult.status << ' ' << fitResult.chi2 << '\n';
+  return fitResult;
+}
+
 std::shared_ptr<Algorithm> PlotPeakByLogValue::runSingleFit(bool createFitOutput, bool outputCompositeMembers,
                                                             bool outputConvolvedMembers, const IFunction_sptr &ifun,
                                                             const InputSpectraToFit &data, double startX, double endX,
-                                                            const std::string &exclude) {
-  g_log.debug() << "Fitting " << data.ws->getName() << " index " << data.i << " with \n";
-  g_log.debug() << ifun->asString() << '\n';
+                                                            const std::string &exclude, const std::string &minimizer) {
+  if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
+    g_log.debug() << "Fitting " << data.ws->getName() << " index " << data.i << " with \n";
+    g_log.debug() << ifun->asString() << '\n';
+  }
 
   const std::string spectrum_index = std::to_string(data.i);
   std::string wsBaseName;
@@ -474,7 +553,7 @@ std::shared_ptr<Algorithm> PlotPeakByLogValue::runSingleFit(bool createFitOutput
   fit->setProperty("StartX", startX);
   fit->setProperty("EndX", endX);
   fit->setProperty("IgnoreInvalidData", ignoreInvalidData);
-  fit->setPropertyValue("Minimizer", this->getMinimizerString(data.name, spectrum_index));
+  fit->setPropertyValue("Minimizer", minimizer);
   fit->setPropertyValue("CostFunction", this->getPropertyValue("CostFunction"));
   fit->setPropertyValue("MaxIterations", this->getPropertyValue("MaxIterations"));
   fit->setPropertyValue("PeakRadius", this->getPropertyValue("PeakRadius"));
@@ -537,18 +616,24 @@ std::string PlotPeakByLogValue::getMinimizerString(const std::string &wsName, co
   boost::replace_all(format, "$basename", wsBaseName);
   boost::replace_all(format, "$outputname", m_baseName);
 
-  auto minimizer = FuncMinimizerFactory::Instance().createMinimizer(format);
-  auto minimizerProps = minimizer->getProperties();
-  for (auto &minimizerProp : minimizerProps) {
-    auto *wsProp = dynamic_cast<Mantid::API::WorkspaceProperty<> *>(minimizerProp);
-    if (wsProp) {
-      const std::string &wsPropValue = minimizerProp->value();
-      if (!wsPropValue.empty()) {
-        const std::string &wsPropName = minimizerProp->name();
-        m_minimizerWorkspaces[wsPropName].emplace_back(wsPropValue);
+  auto cached = m_minimizerWorkspaceProperties.find(format);
+  if (cached == m_minimizerWorkspaceProperties.end()) {
+    std::vector<std::pair<std::string, std::string>> wsProps;
+    auto minimizer = FuncMinimizerFactory::Instance().createMinimizer(format);
+    auto minimizerProps = minimizer->getProperties();
+    for (auto &minimizerProp : minimizerProps) {
+      auto *wsProp = dynamic_cast<Mantid::API::WorkspaceProperty<> *>(minimizerProp);
+      if (wsProp) {
+        const std::string &wsPropValue = minimizerProp->value();
+        if (!wsPropValue.empty()) {
+          wsProps.emplace_back(minimizerProp->name(), wsPropValue);
+        }
       }
     }
+    cached = m_minimizerWorkspaceProperties.emplace(format, std::move(wsProps)).first;
   }
+  for (const auto &wsProp : cached->second)
+    m_minimizerWorkspaces[wsProp.first].emplace_back(wsProp.second);
 
   return format;
 }
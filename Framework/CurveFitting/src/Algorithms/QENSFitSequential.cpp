@@ -426,7 +426,8 @@ void QENSFitSequential::init() {
                   "Defines the way of setting initial values. If set to Sequential every "
                   "next fit starts with parameters returned by the previous fit. If set to "
                   "Individual each fit starts with the same initial values defined in "
-                  "the Function property. Allowed values: [Sequential, Individual]",
+                  "the Function property and the spectra are fitted in parallel. "
+                  "Allowed values: [Sequential, Individual]",
                   Kernel::Direction::Input);
 
   declareProperty(std::make_unique<ArrayProperty<double>>("Exclude", ""),
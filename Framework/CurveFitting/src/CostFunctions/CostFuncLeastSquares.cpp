@@ -16,12 +16,59 @@
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MultiThreaded.h"
 
+#include <algorithm>
 #include <sstream>
 
 namespace Mantid::CurveFitting::CostFunctions {
 namespace {
 /// static logger
 Kernel::Logger g_log("CostFuncLeastSquares");
+
+/**
+ * Calculate the residuals (calculated - observed) multiplied by the fit
+ * weights.
+ * @param values :: The fit function values
+ * @param weights :: The fit weights
+ */
+Eigen::VectorXd weightedResiduals(const API::FunctionValues &values, const std::vector<double> &weights) {
+  Eigen::VectorXd residuals(values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    residuals(i) = (values.getCalculated(i) - values.getFitData(i)) * weights[i];
+  }
+  return residuals;
+}
+
+/**
+ * Split data points into chunks for a deterministic parallel reduction.
+ * @param nData :: The number of data points
+ * @return Boundaries of the chunks: chunk i covers [result[i], result[i + 1])
+ */
+std::vector<size_t> reductionChunks(const size_t nData) {
+  // Enough chunks to share between threads but few enough to keep the memory
+  // for one Hessian per chunk small. Neither depends on the thread count.
+  constexpr size_t minChunkSize = 1024;
+  constexpr size_t maxChunks = 64;
+  const auto nChunks = std::clamp<size_t>(nData / minChunkSize, 1, maxChunks);
+  std::vector<size_t> boundaries(nChunks + 1);
+  for (size_t i = 0; i <= nChunks; ++i) {
+    boundaries[i] = i * nData / nChunks;
+  }
+  return boundaries;
+}
+
+/**
+ * Sum partial results pairwise in an order that depends only on their number.
+ * @param partials :: The partial results. Overwritten.
+ * @return The sum
+ */
+template <typename T> T treeReduce(std::vector<T> &partials) {
+  for (size_t stride = 1; stride < partials.size(); stride *= 2) {
+    for (size_t i = 0; i + stride < partials.size(); i += 2 * stride) {
+      partials[i] += partials[i + stride];
+    }
+  }
+  return partials.front();
+}
 } // namespace
 
 DECLARE_COSTFUNCTION(CostFuncLeastSquares, Least squares)
@@ -38,16 +85,16 @@ CostFuncLeastSquares::CostFuncLeastSquares() : CostFuncFitting(), m_factor(0.5)
  */
 void CostFuncLeastSquares::addVal(API::FunctionDomain_sptr domain, API::FunctionValues_sptr values) const {
   m_function->function(*domain, *values);
-  size_t ny = values->size();
-
-  double retVal = 0.0;
-
-  std::vector<double> weights = getFitWeights(values);
-
-  for (size_t i = 0; i < ny; i++) {
-    double val = (values->getCalculated(i) - values->getFitData(i)) * weights[i];
-    retVal += val * val;
+  const auto residuals = weightedResiduals(*values, getFitWeights(values));
+  const auto chunks = reductionChunks(residuals.size());
+  std::vector<double> partialSums(chunks.size() - 1);
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int chunk = 0; chunk < static_cast<int>(partialSums.size()); ++chunk) {
+    const auto begin = chunks[chunk];
+    partialSums[chunk] = residuals.segment(begin, chunks[chunk + 1] - begin).squaredNorm();
   }
+  const double retVal = treeReduce(partialSums);
 
   PARALLEL_ATOMIC
   m_value += m_factor * retVal;
@@ -56,6 +103,12 @@ void CostFuncLeastSquares::addVal(API::FunctionDomain_sptr domain, API::Function
 /**
  * Update the cost function, derivatives and hessian by adding values calculated
  * on a domain.
+ *
+ * The data points are split into a number of chunks that depends only on the
+ * number of points. Each chunk's contribution is calculated independently,
+ * with the Hessian contribution as a single rank-k update J^T W J, and the
+ * contributions are summed in a fixed pairwise order. The result is therefore
+ * the same for any number of threads.
  * @param function :: Function to use to calculate the value and the derivatives
  * @param domain :: The domain.
  * @param values :: The fit function values
@@ -71,73 +124,63 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function, API:
   Jacobian jacobian(ny, np);
   function->functionDeriv(*domain, jacobian);
 
-  size_t iActiveP = 0;
-  double fVal = 0.0;
-  std::vector<double> weights = getFitWeights(values);
-
-  for (size_t ip = 0; ip < np; ++ip) {
-    if (!function->isActive(ip))
-      continue;
-
-    double d = 0.0;
+  std::vector<size_t> activeParameters;
+  for (size_t ip = 0; ip < np && activeParameters.size() < m_der.size(); ++ip) {
+    if (function->isActive(ip))
+      activeParameters.emplace_back(ip);
+  }
+  const auto nActive = activeParameters.size();
+
+  const std::vector<double> weights = getFitWeights(values);
+  const auto residuals = weightedResiduals(*values, weights);
+  // Jacobian of the active parameters with each row multiplied by its weight
+  Eigen::MatrixXd weightedJacobian(ny, nActive);
+  const auto &derivatives = jacobian.data();
+  for (size_t a = 0; a < nActive; ++a) {
+    const auto ip = activeParameters[a];
     for (size_t i = 0; i < ny; ++i) {
-      double calc = values->getCalculated(i);
-      double obs = values->getFitData(i);
-      double w = weights[i];
-      double y = (calc - obs) * w;
-      d += y * jacobian.get(i, ip) * w;
-      if (iActiveP == 0) {
-        fVal += y * y;
-      }
-    }
-    PARALLEL_CRITICAL(der_set) {
-      double der = m_der.get(iActiveP);
-      m_der.set(iActiveP, der + d);
+      weightedJacobian(i, a) = derivatives[i * np + ip] * weights[i];
     }
-    ++iActiveP;
+  }
 
-    if (iActiveP >= m_der.size())
-      break;
+  const auto chunks = reductionChunks(ny);
+  const auto nChunks = chunks.size() - 1;
+  std::vector<double> values2(nChunks);
+  std::vector<Eigen::VectorXd> gradients(nChunks);
+  std::vector<Eigen::MatrixXd> hessians(evalHessian ? nChunks : 0);
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int chunk = 0; chunk < static_cast<int>(nChunks); ++chunk) {
+    const auto begin = chunks[chunk];
+    const auto size = chunks[chunk + 1] - begin;
+    const auto r = residuals.segment(begin, size);
+    const auto J = weightedJacobian.middleRows(begin, size);
+    values2[chunk] = r.squaredNorm();
+    gradients[chunk].noalias() = J.transpose() * r;
+    if (evalHessian) {
+      hessians[chunk] = Eigen::MatrixXd::Zero(nActive, nActive);
+      hessians[chunk].selfadjointView<Eigen::Lower>().rankUpdate(J.transpose());
+    }
   }
 
-  PARALLEL_ATOMIC
-  m_value += 0.5 * fVal;
-
-  if (!evalHessian)
-    return;
-
-  size_t i1 = 0;                  // active parameter index
-  for (size_t i = 0; i < np; ++i) // over parameters
-  {
-    if (!function->isActive(i))
-      continue;
-    size_t i2 = 0;                  // active parameter index
-    for (size_t j = 0; j <= i; ++j) // over ~ half of parameters
-    {
-      if (!function->isActive(j))
-        continue;
-      double d = 0.0;
-      for (size_t k = 0; k < ny; ++k) // over fitting data
-      {
-        double w = weights[k];
-        d += jacobian.get(k, i) * jacobian.get(k, j) * w * w;
-      }
-      PARALLEL_CRITICAL(hessian_set) {
-        double h = m_hessian.get(i1, i2);
-        m_hessian.set(i1, i2, h + d);
-        if (i1 != i2) {
-          m_hessian.set(i2, i1, h + d);
-        }
-      }
-      ++i2;
+  const double fVal = treeReduce(values2);
+  const Eigen::VectorXd gradient = treeReduce(gradients);
+  Eigen::MatrixXd hessian;
+  if (evalHessian) {
+    hessian = treeReduce(hessians).selfadjointView<Eigen::Lower>();
+  }
 
-      if (i2 >= m_hessian.size2())
-        break;
+  // Domains of a ParDomain are evaluated concurrently
+  PARALLEL_CRITICAL(CostFuncLeastSquares_accumulate) {
+    m_value += 0.5 * fVal;
+    for (size_t a = 0; a < nActive; ++a) {
+      m_der.set(a, m_der.get(a) + gradient(a));
+    }
+    if (evalHessian) {
+      const auto nRows = std::min(nActive, m_hessian.size1());
+      const auto nCols = std::min(nActive, m_hessian.size2());
+      m_hessian.mutator().topLeftCorner(nRows, nCols) += hessian.topLeftCorner(nRows, nCols);
     }
-    ++i1;
-
-    if (i1 >= m_hessian.size1())
-      break;
   }
 }
 
@@ -8,6 +8,7 @@
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/CostFunctionFactory.h"
 #include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidAPI/IFunction.h"
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidAPI/MatrixWorkspace.h"
@@ -20,20 +21,27 @@
 #include "MantidCurveFitting/Constraints/BoundaryConstraint.h"
 #include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
 #include "MantidCurveFitting/FuncMinimizers/FABADAMinimizer.h"
+#include "MantidCurveFitting/SeqDomain.h"
 
 #include "MantidHistogramData/LinearGenerator.h"
 
+#include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
 #include "MantidKernel/normal_distribution.h"
 
 #include <boost/math/special_functions/fpclassify.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <exception>
+#include <limits>
+#include <numeric>
 #include <random>
 
 namespace Mantid::CurveFitting::FuncMinimisers {
@@ -51,8 +59,36 @@ const size_t LOWER_CONVERGENCE_LIMIT = 350;
 const size_t JUMP_CHECKING_RATE = 200;
 // low jump limit
 const double LOW_JUMP_LIMIT = 1e-25;
-// random number generator
-std::mt19937 rng;
+
+/** Gelman-Rubin potential scale reduction factor of a parameter.
+ * @param chains :: the first of n samples of the parameter in each chain
+ * @param n :: the number of samples of each chain
+ * @return :: the factor, 1 if the parameter does not vary
+ */
+double potentialScaleReduction(const std::vector<const double *> &chains, size_t n) {
+  const auto m = static_cast<double>(chains.size());
+  const auto nd = static_cast<double>(n);
+  std::vector<double> means;
+  double withinVariance = 0.0;
+  for (const auto *chain : chains) {
+    const double mean = std::accumulate(chain, chain + n, 0.0) / nd;
+    double variance = 0.0;
+    for (size_t k = 0; k < n; ++k)
+      variance += (chain[k] - mean) * (chain[k] - mean);
+    withinVariance += variance / (nd - 1.0);
+    means.emplace_back(mean);
+  }
+  withinVariance /= m;
+  if (withinVariance <= 0.0)
+    return 1.0;
+  const double grandMean = std::accumulate(means.begin(), means.end(), 0.0) / m;
+  double betweenVariance = 0.0;
+  for (const double mean : means)
+    betweenVariance += (mean - grandMean) * (mean - grandMean);
+  betweenVariance *= nd / (m - 1.0);
+  const double pooledVariance = (nd - 1.0) / nd * withinVariance + betweenVariance / nd;
+  return std::sqrt(pooledVariance / withinVariance);
+}
 
 API::MatrixWorkspace_sptr createWorkspace(std::vector<double> const &xValues, std::vector<double> const &yValues,
                                           int const numberOfSpectra,
@@ -80,7 +116,8 @@ FABADAMinimizer::FABADAMinimizer()
     : m_counter(0), m_chainIterations(0), m_changes(), m_jump(), m_parameters(), m_chain(), m_chi2(0.),
       m_converged(false), m_convPoint(0), m_parConverged(), m_criteria(), m_maxIter(0), m_parChanged(),
       m_temperature(0.), m_counterGlobal(0), m_simAnnealingItStep(0), m_leftRefrPoints(0), m_tempStep(0.),
-      m_overexploration(false), m_nParams(0), m_numInactiveRegenerations(), m_changesOld() {
+      m_overexploration(false), m_nParams(0), m_numInactiveRegenerations(), m_changesOld(), m_rng(), m_chainLength(0),
+      m_finished(false), m_iterationOfChains(0) {
   declareProperty("ChainLength", static_cast<size_t>(10000), "Length of the converged chain.");
   declareProperty("StepsBetweenValues", 10,
                   "Steps done between chain points to avoid correlation"
@@ -90,6 +127,17 @@ FABADAMinimizer::FABADAMinimizer()
                   "Number of Innactive Regenerations to consider"
                   " a certain parameter to be converged");
   declareProperty("JumpAcceptanceRate", 0.6666666, "Desired jumping acceptance rate");
+  auto atLeastOne = std::make_shared<Kernel::BoundedValidator<int>>();
+  atLeastOne->setLower(1);
+  declareProperty("NumberOfChains", 1, atLeastOne,
+                  "Number of independent chains run in parallel. Their"
+                  " converged parts are pooled.");
+  auto nonNegative = std::make_shared<Kernel::BoundedValidator<double>>();
+  nonNegative->setLower(0.0);
+  declareProperty("GelmanRubinCriterion", 1.1, nonNegative,
+                  "With several chains, the burn-in ends for all of them when"
+                  " the Gelman-Rubin statistic of every parameter is below"
+                  " this value. 0 disables the check.");
   // Simulated Annealing properties
   declareProperty("SimAnnealingApplied", false,
                   "If minimization should be run with Simulated"
@@ -141,10 +189,31 @@ void FABADAMinimizer::initialize(API::ICostFunction_sptr function, size_t maxIte
                                 " Different function was given.");
   }
 
+  const int numberOfChains = getProperty("NumberOfChains");
+  auto nChains = static_cast<size_t>(numberOfChains);
+  if (nChains > 1 && std::dynamic_pointer_cast<SeqDomain>(m_leastSquares->getDomain())) {
+    g_log.warning() << "Several chains cannot share a sequential domain. A single chain is run.\n";
+    nChains = 1;
+  }
+  const size_t chainLength = getProperty("ChainLength");
+  m_chainLength = (chainLength + nChains - 1) / nChains;
+
+  initializeChain(maxIterations);
+  createChains(nChains, maxIterations);
+  m_iterationOfChains = 0;
+}
+
+/** Initialize the state of a single chain from the parameters of the fitting
+ * function.
+ *
+ * @param maxIterations :: maximum number of iterations
+ */
+void FABADAMinimizer::initializeChain(size_t maxIterations) {
   m_fitFunction = m_leastSquares->getFittingFunction();
   m_counter = 0;
   m_counterGlobal = 0;
   m_converged = false;
+  m_finished = false;
   m_maxIter = maxIterations;
 
   // Initialize member variables related to fitting parameters, such as
@@ -171,7 +240,48 @@ void FABADAMinimizer::initialize(API::ICostFunction_sptr function, size_t maxIte
   }
 }
 
-/** Do one iteration.
+/** Create the chains run alongside this one. Each works on its own copy of the
+ * fitting function and data, starts from a point drawn around the initial
+ * parameters and uses its own random numbers.
+ *
+ * @param nChains :: the total number of chains, including this one
+ * @param maxIterations :: maximum number of iterations
+ */
+void FABADAMinimizer::createChains(size_t nChains, size_t maxIterations) {
+  m_chains.clear();
+  for (size_t i = 1; i < nChains; ++i) {
+    auto chain = std::make_unique<FABADAMinimizer>();
+    for (const auto &name : {"StepsBetweenValues", "ConvergenceCriteria", "InnactiveConvergenceCriterion",
+                             "JumpAcceptanceRate", "SimAnnealingApplied", "MaximumTemperature", "NumRefrigerationSteps",
+                             "SimAnnealingIterations", "Overexploration"}) {
+      chain->setPropertyValue(name, getPropertyValue(name));
+    }
+    chain->m_leastSquares = std::dynamic_pointer_cast<CostFunctions::CostFuncLeastSquares>(
+        API::CostFunctionFactory::Instance().create(m_leastSquares->name()));
+    auto function = m_fitFunction->clone();
+    chain->m_leastSquares->setFittingFunction(function, m_leastSquares->getDomain(),
+                                              std::make_shared<API::FunctionValues>(*m_leastSquares->getValues()));
+    chain->m_rng.seed(static_cast<std::mt19937::result_type>(m_rng()));
+    // Overdispersed starting points make the Gelman-Rubin statistic meaningful
+    for (size_t j = 0; j < m_nParams; ++j) {
+      if (function->isFixed(j))
+        continue;
+      double value = m_parameters.get(j) + chain->gaussianStep(m_jump[j]);
+      auto *bcon = dynamic_cast<Constraints::BoundaryConstraint *>(function->getConstraint(j));
+      if (bcon && bcon->hasLower())
+        value = std::max(value, bcon->lower());
+      if (bcon && bcon->hasUpper())
+        value = std::min(value, bcon->upper());
+      function->setParameter(j, value);
+    }
+    function->applyTies();
+    chain->m_chainLength = m_chainLength;
+    chain->initializeChain(maxIterations);
+    m_chains.emplace_back(std::move(chain));
+  }
+}
+
+/** Do one iteration of every chain.
  *
  * @return :: true if iterations must be continued, false otherwise
  */
@@ -181,12 +291,47 @@ bool FABADAMinimizer::iterate(size_t /*iteration*/) {
     throw std::runtime_error("Cost function isn't set up.");
   }
 
+  if (m_chains.empty()) {
+    return advanceChain();
+  }
+
+  // The chains share nothing but the domain and the data, which are only read
+  const auto nChains = static_cast<int>(m_chains.size()) + 1;
+  std::vector<std::exception_ptr> errors(nChains);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < nChains; ++i) {
+    auto &chain = i == 0 ? *this : *m_chains[i - 1];
+    if (chain.m_finished)
+      continue;
+    try {
+      chain.m_finished = !chain.advanceChain();
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+  for (const auto &error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  ++m_iterationOfChains;
+  gelmanRubinConvergenceCheck();
+
+  return !m_finished || std::any_of(m_chains.cbegin(), m_chains.cend(),
+                                    [](const auto &chain) { return !chain->m_finished; });
+}
+
+/** Do one iteration of this chain.
+ *
+ * @return :: true if the chain must be continued, false otherwise
+ */
+bool FABADAMinimizer::advanceChain() {
   size_t m = m_nParams;
 
   // Just for the last iteration. For doing exactly the indicated
   // number of iterations.
   if (m_converged && m_counter == m_chainIterations - 1) {
-    size_t t = getProperty("ChainLength");
+    size_t t = m_chainLength;
     m = t % m_nParams;
     if (m == 0)
       m = m_nParams;
@@ -284,7 +429,7 @@ bool FABADAMinimizer::iterate(size_t /*iteration*/) {
   // Evaluates if iterations should continue or not
   return iterationContinuation();
 
-} // Iterate() end
+} // advanceChain() end
 
 double FABADAMinimizer::costFunctionVal() { return m_chi2; }
 
@@ -312,7 +457,19 @@ void FABADAMinimizer::finalize() {
   std::vector<double> errorLeft(m_nParams);
   std::vector<double> errorRight(m_nParams);
 
-  calculateConvChainAndBestParameters(convLength, nSteps, reducedConvergedChain, bestParameters, errorLeft, errorRight);
+  // The converged parts of all chains
+  const auto convergedChain = pooledConvergedChain();
+  convLength = std::min(convLength, convergedChain[0].size() / static_cast<size_t>(nSteps));
+
+  if (!m_chains.empty()) {
+    const auto factors = gelmanRubin();
+    for (size_t j = 0; j < factors.size(); ++j) {
+      g_log.notice() << "Gelman-Rubin statistic of " << m_fitFunction->parameterName(j) << ": " << factors[j] << '\n';
+    }
+  }
+
+  calculateConvChainAndBestParameters(convergedChain, convLength, nSteps, reducedConvergedChain, bestParameters,
+                                      errorLeft, errorRight);
 
   if (!getPropertyValue("Parameters").empty()) {
     outputParameterTable(bestParameters, errorLeft, errorRight);
@@ -339,7 +496,7 @@ void FABADAMinimizer::finalize() {
   double mostPchi2 = outputPDF(convLength, reducedConvergedChain);
 
   if (!getPropertyValue("ConvergedChain").empty()) {
-    outputConvergedChains(convLength, nSteps);
+    outputConvergedChains(convergedChain, convLength, nSteps);
   }
 
   if (!getPropertyValue("CostFunctionTable").empty()) {
@@ -360,7 +517,7 @@ void FABADAMinimizer::finalize() {
  * @return :: the step
  */
 double FABADAMinimizer::gaussianStep(const double &jump) {
-  return Kernel::normal_distribution<double>(0.0, std::abs(jump))(rng);
+  return Kernel::normal_distribution<double>(0.0, std::abs(jump))(m_rng);
 }
 
 /** If the new point is out of its bounds, it is changed to fit in the bound
@@ -474,7 +631,7 @@ void FABADAMinimizer::algorithmDisplacement(const size_t &parameterIndex, const
     double prob = exp((m_chi2 - chi2New) / (2.0 * m_temperature));
 
     // Decide if changing or not
-    double p = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    double p = std::uniform_real_distribution<double>(0.0, 1.0)(m_rng);
     if (p <= prob) {
       for (size_t j = 0; j < m_nParams; j++) {
         m_chain[j].emplace_back(newParameters.get(j));
@@ -574,24 +731,11 @@ void FABADAMinimizer::convergenceCheck() {
     // consider only the data of the converged part of the chain, when updating
     // the jump.
     if (t == m_nParams) {
-      m_converged = true;
-
       if (ImmobilityConv)
         g_log.warning() << "Convergence detected through immobility."
                            " It might be a bad convergence.\n";
 
-      m_convPoint = m_counterGlobal * m_nParams + 1;
-      m_counter = 0;
-      for (size_t i = 0; i < m_nParams; ++i) {
-        m_changes[i] = 0;
-      }
-
-      // If done with a different temperature, the error would be
-      // wrongly obtained (because the temperature modifies the
-      // chi-square landscape)
-      // Although keeping ergodicity, more iterations will be needed
-      // because a wrong step is initially used.
-      m_temperature = 1.0;
+      setConverged();
     }
 
     // All parameters should converge at the same iteration
@@ -604,6 +748,113 @@ void FABADAMinimizer::convergenceCheck() {
   }
 }
 
+/** Mark the chain as converged. The following iterations make up the
+ * converged chain.
+ */
+void FABADAMinimizer::setConverged() {
+  m_converged = true;
+  m_convPoint = m_counterGlobal * m_nParams + 1;
+  m_counter = 0;
+  for (size_t i = 0; i < m_nParams; ++i) {
+    m_changes[i] = 0;
+  }
+
+  // If done with a different temperature, the error would be
+  // wrongly obtained (because the temperature modifies the
+  // chi-square landscape)
+  // Although keeping ergodicity, more iterations will be needed
+  // because a wrong step is initially used.
+  m_temperature = 1.0;
+}
+
+/** With several chains, end the burn-in of the chains that have not converged
+ * yet if the second halves of all chains agree according to the Gelman-Rubin
+ * statistic. Checked every JUMP_CHECKING_RATE iterations of the chains, also
+ * once this chain has finished, and only once every chain still burning in is
+ * past the simulated annealing and LOWER_CONVERGENCE_LIMIT iterations.
+ */
+void FABADAMinimizer::gelmanRubinConvergenceCheck() {
+  const double criterion = getProperty("GelmanRubinCriterion");
+  if (criterion == 0.0 || m_iterationOfChains % JUMP_CHECKING_RATE != 0)
+    return;
+
+  std::vector<FABADAMinimizer *> chains{this};
+  for (const auto &chain : m_chains)
+    chains.emplace_back(chain.get());
+  if (std::all_of(chains.cbegin(), chains.cend(), [](const auto *chain) { return chain->m_converged; }))
+    return;
+  if (std::any_of(chains.cbegin(), chains.cend(), [](const auto *chain) {
+        return !chain->m_converged && (chain->m_leftRefrPoints != 0 || chain->m_counter <= LOWER_CONVERGENCE_LIMIT);
+      }))
+    return;
+
+  size_t n = m_chain[0].size();
+  for (const auto *chain : chains)
+    n = std::min(n, chain->m_chain[0].size());
+  n /= 2;
+  if (n < 2)
+    return;
+
+  for (size_t j = 0; j < m_nParams; ++j) {
+    std::vector<const double *> samples;
+    for (const auto *chain : chains)
+      samples.emplace_back(chain->m_chain[j].data() + chain->m_chain[j].size() - n);
+    if (potentialScaleReduction(samples, n) >= criterion)
+      return;
+  }
+
+  g_log.information() << "Chains have converged according to the Gelman-Rubin statistic after "
+                      << m_iterationOfChains << " iterations.\n";
+  for (auto *chain : chains) {
+    if (!chain->m_converged)
+      chain->setConverged();
+  }
+}
+
+/** Gelman-Rubin potential scale reduction factor of each parameter over the
+ * converged parts of the chains. Values close to 1 indicate that the chains
+ * sample the same distribution.
+ *
+ * @return :: the factor of each parameter, empty with a single chain
+ */
+std::vector<double> FABADAMinimizer::gelmanRubin() const {
+  std::vector<double> factors;
+  if (m_chains.empty())
+    return factors;
+  std::vector<const FABADAMinimizer *> chains{this};
+  for (const auto &chain : m_chains)
+    chains.emplace_back(chain.get());
+  size_t n = std::numeric_limits<size_t>::max();
+  for (const auto *chain : chains)
+    n = std::min(n, chain->m_chain[0].size() - chain->m_convPoint);
+  if (n < 2)
+    return factors;
+  for (size_t j = 0; j < m_nParams; ++j) {
+    std::vector<const double *> samples;
+    for (const auto *chain : chains)
+      samples.emplace_back(chain->m_chain[j].data() + chain->m_convPoint);
+    factors.emplace_back(potentialScaleReduction(samples, n));
+  }
+  return factors;
+}
+
+/** The converged parts of this chain and of the chains run alongside it.
+ *
+ * @return :: the pooled chain of each parameter followed by that of the chi
+ * square
+ */
+std::vector<std::vector<double>> FABADAMinimizer::pooledConvergedChain() const {
+  std::vector<std::vector<double>> pooled(m_nParams + 1);
+  auto append = [&pooled](const FABADAMinimizer &chain) {
+    for (size_t j = 0; j < pooled.size(); ++j)
+      pooled[j].insert(pooled[j].end(), chain.m_chain[j].begin() + chain.m_convPoint, chain.m_chain[j].end());
+  };
+  append(*this);
+  for (const auto &chain : m_chains)
+    append(*chain);
+  return pooled;
+}
+
 /** Refrigerates the system if appropriate
  *
  */
@@ -693,11 +944,13 @@ void FABADAMinimizer::outputChains() {
 
 /** Create the workspace containing the converged chain
  *
+ * @param convergedChain :: the converged parts of all chains
  * @param convLength :: length of the converged chain
  * @param nSteps :: number of steps done between chain points to avoid
  *correlation
  */
-void FABADAMinimizer::outputConvergedChains(size_t convLength, int nSteps) {
+void FABADAMinimizer::outputConvergedChains(const std::vector<std::vector<double>> &convergedChain, size_t convLength,
+                                            int nSteps) {
 
   // Create the workspace for the converged part of the chain.
   API::MatrixWorkspace_sptr wsConv;
@@ -710,9 +963,7 @@ void FABADAMinimizer::outputConvergedChains(size_t convLength, int nSteps) {
 
   // Do one iteration for each parameter plus one for Chi square.
   for (size_t j = 0; j < m_nParams + 1; ++j) {
-    std::vector<double>::const_iterator first = m_chain[j].begin() + m_convPoint;
-    std::vector<double>::const_iterator last = m_chain[j].end();
-    std::vector<double> convChain(first, last);
+    const auto &convChain = convergedChain[j];
     auto &X = wsConv->mutableX(j);
     auto &Y = wsConv->mutableY(j);
     for (size_t k = 0; k < convLength; ++k) {
@@ -904,6 +1155,7 @@ void FABADAMinimizer::outputParameterTable(const std::vector<double> &bestParame
 /** Create the reduced convergence chain and calculate the best parameter values
  *and errors
  *
+ * @param convergedChain :: the converged parts of all chains
  * @param convLength :: length of the converged chain
  * @param nSteps :: number of steps done between chain points to avoid
  * @param reducedChain :: [output] the reduced chain
@@ -914,7 +1166,8 @@ void FABADAMinimizer::outputParameterTable(const std::vector<double> &bestParame
  * @param errorRight :: [output] vector containing the sqrt of the mean square
  *right deviation
  */
-void FABADAMinimizer::calculateConvChainAndBestParameters(size_t convLength, int nSteps,
+void FABADAMinimizer::calculateConvChainAndBestParameters(const std::vector<std::vector<double>> &convergedChain,
+                                                          size_t convLength, int nSteps,
                                                           std::vector<std::vector<double>> &reducedChain,
                                                           std::vector<double> &bestParameters,
                                                           std::vector<double> &errorLeft,
@@ -925,13 +1178,13 @@ void FABADAMinimizer::calculateConvChainAndBestParameters(size_t convLength, int
     // Write first element of the reduced chain
     for (size_t e = 0; e <= m_nParams; ++e) {
       std::vector<double> v;
-      v.emplace_back(m_chain[e][m_convPoint]);
+      v.emplace_back(convergedChain[e][0]);
       reducedChain.emplace_back(std::move(v));
     }
 
     // Calculate the reducedConvergedChain for the cost fuction.
     for (size_t k = 1; k < convLength; ++k) {
-      reducedChain[m_nParams].emplace_back(m_chain[m_nParams][nSteps * k + m_convPoint]);
+      reducedChain[m_nParams].emplace_back(convergedChain[m_nParams][nSteps * k]);
     }
 
     // Calculate the position of the minimum Chi square value
@@ -942,7 +1195,7 @@ void FABADAMinimizer::calculateConvChainAndBestParameters(size_t convLength, int
     for (size_t j = 0; j < m_nParams; ++j) {
       // Obs: Starts at 1 (0 already added)
       for (size_t k = 1; k < convLength; ++k) {
-        reducedChain[j].emplace_back(m_chain[j][m_convPoint + nSteps * k]);
+        reducedChain[j].emplace_back(convergedChain[j][nSteps * k]);
       }
       // best fit parameters taken
       bestParameters[j] = reducedChain[j][positionMinChi2 - reducedChain[m_nParams].begin()];
@@ -990,8 +1243,7 @@ void FABADAMinimizer::initChainsAndParameters() {
     m_parameters.resize(m_nParams);
   }
 
-  size_t n = getProperty("ChainLength");
-  m_chainIterations = size_t(ceil(double(n) / double(m_nParams)));
+  m_chainIterations = size_t(ceil(double(m_chainLength) / double(m_nParams)));
 
   // Save parameter constraints
   for (size_t i = 0; i < m_nParams; ++i) {
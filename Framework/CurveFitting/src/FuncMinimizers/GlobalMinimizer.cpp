@@ -0,0 +1,392 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidCurveFitting/FuncMinimizers/GlobalMinimizer.h"
+#include "MantidCurveFitting/Constraints/BoundaryConstraint.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncFitting.h"
+#include "MantidCurveFitting/SeqDomain.h"
+
+#include "MantidAPI/CostFunctionFactory.h"
+#include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionValues.h"
+
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/ListValidator.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/SobolSequence.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Mantid::CurveFitting::FuncMinimisers {
+namespace {
+/// static logger
+Kernel::Logger g_log("GlobalMinimizer");
+
+const std::string MULTI_START("MultiStart");
+const std::string DIFFERENTIAL_EVOLUTION("DifferentialEvolution");
+/// The largest number of dimensions of the GSL Sobol generator
+const size_t MAX_SOBOL_DIMENSIONS = 40;
+} // namespace
+
+DECLARE_FUNCMINIMIZER(GlobalMinimizer, Global)
+
+GlobalMinimizer::GlobalMinimizer() : m_maxIterations(0) {
+  declareProperty("Method", MULTI_START,
+                  std::make_shared<Kernel::StringListValidator>(
+                      std::vector<std::string>{MULTI_START, DIFFERENTIAL_EVOLUTION}),
+                  "MultiStart: run the local minimizer from several starting points. "
+                  "DifferentialEvolution: evolve a population of points.");
+  declareProperty("LocalMinimizer", std::string("Levenberg-Marquardt"),
+                  "The minimizer used from each starting point and to refine the result of differential evolution.");
+  auto atLeastFour = std::make_shared<Kernel::BoundedValidator<int>>();
+  atLeastFour->setLower(4);
+  declareProperty("NumberOfStarts", 16, atLeastFour,
+                  "Number of starting points of MultiStart or the population size of DifferentialEvolution.");
+  auto positive = std::make_shared<Kernel::BoundedValidator<double>>();
+  positive->setLower(0.0);
+  declareProperty("SearchRange", 1.0, positive,
+                  "Relative range searched around the initial value of a parameter without a boundary constraint.");
+  declareProperty("Seed", 1, "Seed of the random numbers of DifferentialEvolution.");
+  declareProperty("MutationFactor", 0.7, positive, "Differential weight of DifferentialEvolution.");
+  auto probability = std::make_shared<Kernel::BoundedValidator<double>>(0.0, 1.0);
+  declareProperty("CrossoverProbability", 0.9, probability, "Crossover probability of DifferentialEvolution.");
+  declareProperty("Tolerance", 1e-6, positive,
+                  "DifferentialEvolution has converged when the costs of the population differ by less than "
+                  "Tolerance * (1 + |best cost|).");
+}
+
+/** Initialize minimizer.
+ * @param function :: The cost function to minimize.
+ * @param maxIterations :: Maximum number of iterations of the local minimizer
+ * and of differential evolution generations.
+ */
+void GlobalMinimizer::initialize(API::ICostFunction_sptr function, size_t maxIterations) {
+  const std::string localMinimizer = getProperty("LocalMinimizer");
+  if (localMinimizer.compare(0, name().size(), name()) == 0) {
+    throw std::invalid_argument("GlobalMinimizer: LocalMinimizer cannot be another global minimizer.");
+  }
+  m_costFunction = std::move(function);
+  m_maxIterations = maxIterations;
+  setSearchBox();
+
+  const int nPoints = getProperty("NumberOfStarts");
+  m_copies = costFunctionCopies(static_cast<size_t>(nPoints));
+
+  const size_t np = m_costFunction->nParams();
+  m_best.parameters.resize(np);
+  for (size_t i = 0; i < np; ++i) {
+    m_best.parameters[i] = m_costFunction->getParameter(i);
+  }
+  m_best.cost = cost(*m_costFunction, m_best.parameters);
+
+  m_population.clear();
+  if (getPropertyValue("Method") == DIFFERENTIAL_EVOLUTION) {
+    const int seed = getProperty("Seed");
+    m_random = std::make_unique<Kernel::MersenneTwister>(static_cast<size_t>(seed));
+    for (auto &point : startingPoints(static_cast<size_t>(nPoints))) {
+      m_population.push_back({std::move(point)});
+    }
+    evaluate(m_population);
+    for (const auto &member : m_population) {
+      accept(member);
+    }
+    setParameters(*m_costFunction, m_best.parameters);
+  }
+}
+
+/** Do one iteration: all local minimizations of MultiStart or one
+ * generation of DifferentialEvolution.
+ * @param iteration :: The current iteration number.
+ * @return :: true if iterations should be continued.
+ */
+bool GlobalMinimizer::iterate(size_t iteration) {
+  if (!m_costFunction) {
+    throw std::runtime_error("Cost function isn't set up.");
+  }
+  if (m_costFunction->nParams() == 0) {
+    m_errorString = "success";
+    return false;
+  }
+  if (getPropertyValue("Method") == MULTI_START) {
+    return multiStart();
+  }
+  return evolve(iteration);
+}
+
+/// Return the lowest value of the cost function found.
+double GlobalMinimizer::costFunctionVal() { return m_best.cost; }
+
+/// Set the box searched from the boundary constraints and initial values.
+void GlobalMinimizer::setSearchBox() {
+  const size_t np = m_costFunction->nParams();
+  const double range = getProperty("SearchRange");
+  auto fitting = std::dynamic_pointer_cast<CostFunctions::CostFuncFitting>(m_costFunction);
+  m_lower.resize(np);
+  m_upper.resize(np);
+  for (size_t i = 0; i < np; ++i) {
+    const double value = m_costFunction->getParameter(i);
+    const double halfWidth = range * (value != 0.0 ? std::fabs(value) : 1.0);
+    m_lower[i] = value - halfWidth;
+    m_upper[i] = value + halfWidth;
+    if (!fitting) {
+      continue;
+    }
+    const auto function = fitting->getFittingFunction();
+    const auto *boundary = dynamic_cast<Constraints::BoundaryConstraint *>(
+        function->getConstraint(function->parameterIndex(fitting->parameterName(i))));
+    if (!boundary) {
+      continue;
+    }
+    if (boundary->hasLower()) {
+      m_lower[i] = boundary->lower();
+      if (!boundary->hasUpper()) {
+        m_upper[i] = std::max(m_upper[i], m_lower[i] + 2.0 * halfWidth);
+      }
+    }
+    if (boundary->hasUpper()) {
+      m_upper[i] = boundary->upper();
+      if (!boundary->hasLower()) {
+        m_lower[i] = std::min(m_lower[i], m_upper[i] - 2.0 * halfWidth);
+      }
+    }
+  }
+}
+
+/** Points filling the search box. The first point is the initial guess, the
+ * others come from a Sobol sequence or, for too many parameters for it, from
+ * a seeded pseudo-random generator.
+ * @param n :: The number of points.
+ */
+std::vector<std::vector<double>> GlobalMinimizer::startingPoints(size_t n) const {
+  const size_t np = m_costFunction->nParams();
+  std::vector<std::vector<double>> points(n, std::vector<double>(np));
+  for (size_t i = 0; i < np; ++i) {
+    points[0][i] = m_costFunction->getParameter(i);
+  }
+  if (np == 0) {
+    return points;
+  }
+  std::unique_ptr<Kernel::NDRandomNumberGenerator> sobol;
+  std::unique_ptr<Kernel::MersenneTwister> random;
+  if (np <= MAX_SOBOL_DIMENSIONS) {
+    sobol = std::make_unique<Kernel::SobolSequence>(static_cast<unsigned int>(np));
+  } else {
+    const int seed = getProperty("Seed");
+    random = std::make_unique<Kernel::MersenneTwister>(static_cast<size_t>(seed));
+  }
+  std::vector<double> u(np);
+  for (size_t k = 1; k < n; ++k) {
+    if (sobol) {
+      u = sobol->nextPoint();
+    } else {
+      std::generate(u.begin(), u.end(), [&random] { return random->nextValue(); });
+    }
+    for (size_t i = 0; i < np; ++i) {
+      points[k][i] = m_lower[i] + u[i] * (m_upper[i] - m_lower[i]);
+    }
+  }
+  return points;
+}
+
+/** Independent copies of the cost function, one per point, so that points can
+ * be evaluated in parallel. Copies share the domain and data but not the
+ * function. Returns an empty vector if the cost function cannot be copied
+ * safely, in which case points are evaluated serially.
+ * @param n :: The number of copies.
+ */
+std::vector<API::ICostFunction_sptr> GlobalMinimizer::costFunctionCopies(size_t n) const {
+  std::vector<API::ICostFunction_sptr> copies;
+  auto fitting = std::dynamic_pointer_cast<CostFunctions::CostFuncFitting>(m_costFunction);
+  // Sequential domains reuse internal buffers and cannot be shared
+  if (!fitting || std::dynamic_pointer_cast<SeqDomain>(fitting->getDomain())) {
+    return copies;
+  }
+  try {
+    for (size_t i = 0; i < n; ++i) {
+      auto copy = std::dynamic_pointer_cast<CostFunctions::CostFuncFitting>(
+          API::CostFunctionFactory::Instance().create(fitting->name()));
+      if (!copy) {
+        return {};
+      }
+      copy->setFittingFunction(fitting->getFittingFunction()->clone(), fitting->getDomain(),
+                               std::make_shared<API::FunctionValues>(*fitting->getValues()));
+      if (copy->nParams() != fitting->nParams()) {
+        return {};
+      }
+      copies.emplace_back(std::move(copy));
+    }
+  } catch (std::exception &e) {
+    g_log.debug() << "Cannot copy cost function " << fitting->name() << ", evaluating serially: " << e.what()
+                  << '\n';
+    copies.clear();
+  }
+  return copies;
+}
+
+/// Set the parameters of a cost function and apply the ties of the fitting function.
+void GlobalMinimizer::setParameters(API::ICostFunction &costFunction, const std::vector<double> &parameters) const {
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    costFunction.setParameter(i, parameters[i]);
+  }
+  if (auto *fitting = dynamic_cast<CostFunctions::CostFuncFitting *>(&costFunction)) {
+    fitting->applyTies();
+  }
+}
+
+/// Value of a cost function at a point, infinite if it is not a number.
+double GlobalMinimizer::cost(API::ICostFunction &costFunction, const std::vector<double> &parameters) const {
+  setParameters(costFunction, parameters);
+  const double value = costFunction.val();
+  return std::isnan(value) ? std::numeric_limits<double>::infinity() : value;
+}
+
+/** Run the local minimizer from a starting point.
+ * @param minimizer :: The local minimizer.
+ * @param costFunction :: The cost function to minimize.
+ * @param start :: The starting point.
+ * @return :: The local minimum found.
+ */
+GlobalMinimizer::Candidate GlobalMinimizer::localMinimum(API::IFuncMinimizer &minimizer,
+                                                         const API::ICostFunction_sptr &costFunction,
+                                                         const std::vector<double> &start) const {
+  setParameters(*costFunction, start);
+  minimizer.initialize(costFunction, m_maxIterations);
+  minimizer.minimize(m_maxIterations);
+  Candidate result;
+  result.parameters.resize(start.size());
+  for (size_t i = 0; i < start.size(); ++i) {
+    result.parameters[i] = costFunction->getParameter(i);
+  }
+  result.cost = cost(*costFunction, result.parameters);
+  return result;
+}
+
+/** Calculate the cost of every candidate, in parallel if the cost function
+ * could be copied. A candidate whose evaluation throws gets an infinite cost.
+ * @param candidates :: The candidates to evaluate.
+ */
+void GlobalMinimizer::evaluate(std::vector<Candidate> &candidates) const {
+  const auto n = static_cast<int>(candidates.size());
+  if (m_copies.size() < candidates.size()) {
+    for (auto &candidate : candidates) {
+      candidate.cost = cost(*m_costFunction, candidate.parameters);
+    }
+    return;
+  }
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < n; ++i) {
+    try {
+      candidates[i].cost = cost(*m_copies[i], candidates[i].parameters);
+    } catch (std::exception &) {
+      candidates[i].cost = std::numeric_limits<double>::infinity();
+    }
+  }
+}
+
+/// Run the local minimizer from every starting point and keep the best result.
+bool GlobalMinimizer::multiStart() {
+  const int nPoints = getProperty("NumberOfStarts");
+  const auto points = startingPoints(static_cast<size_t>(nPoints));
+  const std::string localMinimizer = getProperty("LocalMinimizer");
+  std::vector<API::IFuncMinimizer_sptr> minimizers(points.size());
+  for (auto &minimizer : minimizers) {
+    minimizer = API::FuncMinimizerFactory::Instance().createMinimizer(localMinimizer);
+  }
+  std::vector<Candidate> minima(points.size());
+  const auto n = static_cast<int>(points.size());
+  if (m_copies.size() < points.size()) {
+    for (int i = 0; i < n; ++i) {
+      minima[i] = localMinimum(*minimizers[i], m_costFunction, points[i]);
+    }
+  } else {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < n; ++i) {
+      try {
+        minima[i] = localMinimum(*minimizers[i], m_copies[i], points[i]);
+      } catch (std::exception &) {
+        minima[i] = {points[i]};
+      }
+    }
+  }
+  // Reduce in order so that the result does not depend on the scheduling
+  for (const auto &minimum : minima) {
+    accept(minimum);
+  }
+  setParameters(*m_costFunction, m_best.parameters);
+  return false;
+}
+
+/** One generation of differential evolution (DE/rand/1/bin). When the
+ * population has converged the best member is refined with the local
+ * minimizer.
+ * @param iteration :: The generation number.
+ * @return :: true if the population has not converged yet.
+ */
+bool GlobalMinimizer::evolve(size_t /*iteration*/) {
+  const double mutation = getProperty("MutationFactor");
+  const double crossover = getProperty("CrossoverProbability");
+  const double tolerance = getProperty("Tolerance");
+  const size_t np = m_costFunction->nParams();
+  const auto n = static_cast<int>(m_population.size());
+
+  // Trial points are drawn serially so that they only depend on the seed
+  std::vector<Candidate> trials(m_population.size());
+  for (int i = 0; i < n; ++i) {
+    int r1, r2, r3;
+    do {
+      r1 = m_random->nextInt(0, n - 1);
+    } while (r1 == i);
+    do {
+      r2 = m_random->nextInt(0, n - 1);
+    } while (r2 == i || r2 == r1);
+    do {
+      r3 = m_random->nextInt(0, n - 1);
+    } while (r3 == i || r3 == r1 || r3 == r2);
+    const auto forced = static_cast<size_t>(m_random->nextInt(0, static_cast<int>(np) - 1));
+    auto &trial = trials[i].parameters;
+    trial = m_population[i].parameters;
+    for (size_t j = 0; j < np; ++j) {
+      if (j == forced || m_random->nextValue() < crossover) {
+        const double value = m_population[r1].parameters[j] +
+                             mutation * (m_population[r2].parameters[j] - m_population[r3].parameters[j]);
+        trial[j] = std::clamp(value, m_lower[j], m_upper[j]);
+      }
+    }
+  }
+  evaluate(trials);
+
+  for (int i = 0; i < n; ++i) {
+    if (trials[i].cost <= m_population[i].cost) {
+      m_population[i] = std::move(trials[i]);
+    }
+    accept(m_population[i]);
+  }
+
+  const auto [lowest, highest] = std::minmax_element(
+      m_population.cbegin(), m_population.cend(),
+      [](const Candidate &lhs, const Candidate &rhs) { return lhs.cost < rhs.cost; });
+  if (highest->cost - lowest->cost > tolerance * (1.0 + std::fabs(lowest->cost))) {
+    setParameters(*m_costFunction, m_best.parameters);
+    return true;
+  }
+
+  const std::string localMinimizer = getProperty("LocalMinimizer");
+  auto minimizer = API::FuncMinimizerFactory::Instance().createMinimizer(localMinimizer);
+  accept(localMinimum(*minimizer, m_costFunction, m_best.parameters));
+  setParameters(*m_costFunction, m_best.parameters);
+  return false;
+}
+
+/// Keep a candidate if it is better than the best one found so far.
+void GlobalMinimizer::accept(const Candidate &candidate) {
+  if (candidate.cost < m_best.cost) {
+    m_best = candidate;
+  }
+}
+
+} // namespace Mantid::CurveFitting::FuncMinimisers
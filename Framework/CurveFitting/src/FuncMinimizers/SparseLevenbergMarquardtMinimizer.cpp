@@ -0,0 +1,629 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidCurveFitting/FuncMinimizers/SparseLevenbergMarquardtMinimizer.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
+#include "MantidCurveFitting/EigenVector.h"
+#include "MantidCurveFitting/Jacobian.h"
+
+#include "MantidAPI/CompositeDomain.h"
+#include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/IConstraint.h"
+#include "MantidAPI/MultiDomainFunction.h"
+#include "MantidAPI/ParameterTie.h"
+
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <Eigen/Dense>
+
+#include <cmath>
+#include <exception>
+#include <limits>
+
+namespace Mantid::CurveFitting::FuncMinimisers {
+namespace {
+/// static logger object
+Kernel::Logger g_log("SparseLevenbergMarquardt");
+
+constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+/// Rethrow the first exception caught in a parallel loop
+void rethrowFirst(const std::vector<std::exception_ptr> &errors) {
+  for (const auto &error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+} // namespace
+
+// clang-format off
+DECLARE_FUNCMINIMIZER(SparseLevenbergMarquardtMinimizer, Levenberg-MarquardtSparse)
+// clang-format on
+
+SparseLevenbergMarquardtMinimizer::SparseLevenbergMarquardtMinimizer()
+    : IFuncMinimizer(), m_tau(1e-6), m_mu(0.0), m_nu(2.0), m_rho(1.0), m_F(0.0) {
+  declareProperty("MuMax", 1e6, "Maximum value of mu - a stopping parameter in failure.");
+  declareProperty("AbsError", 0.0001,
+                  "Absolute error allowed for parameters - "
+                  "a stopping parameter in success.");
+  declareProperty("Verbose", false, "Make output more verbose.");
+}
+
+/// Initialize minimizer, i.e. pass a function to minimize.
+void SparseLevenbergMarquardtMinimizer::initialize(API::ICostFunction_sptr function, size_t /*maxIterations*/) {
+  m_costFunction = std::dynamic_pointer_cast<CostFunctions::CostFuncLeastSquares>(function);
+  if (!m_costFunction) {
+    throw std::invalid_argument("Sparse Levenberg-Marquardt minimizer works only with "
+                                "least squares cost functions. Different function was given.");
+  }
+  if (!m_costFunction->getValues()) {
+    throw std::invalid_argument("Sparse Levenberg-Marquardt minimizer cannot fit a sequential domain.");
+  }
+  m_mu = 0;
+  m_nu = 2.0;
+  m_rho = 1.0;
+  m_D.clear();
+  setBlocks();
+}
+
+/**
+ * Split the active parameters into the local parameters of the parts of the
+ * domain and the shared ones.
+ */
+void SparseLevenbergMarquardtMinimizer::setBlocks() {
+  const auto function = m_costFunction->getFittingFunction();
+  const auto nActive = m_costFunction->nParams();
+  m_blocks.clear();
+  m_shared.clear();
+  m_activeIndex.assign(function->nParams(), npos);
+  m_owner.assign(nActive, npos);
+  m_position.assign(nActive, 0);
+  for (size_t ip = 0, i = 0; ip < function->nParams(); ++ip) {
+    if (function->isActive(ip))
+      m_activeIndex[ip] = i++;
+  }
+
+  auto addParameters = [this](const Member &member, size_t owner, const std::vector<bool> &sharedByTie) {
+    for (size_t k = 0; k < member.function->nParams(); ++k) {
+      const auto ip = member.parameterOffset + k;
+      const auto i = m_activeIndex[ip];
+      if (i == npos)
+        continue;
+      const auto parameterOwner = sharedByTie[ip] ? npos : owner;
+      m_owner[i] = parameterOwner;
+      auto &indices = parameterOwner == npos ? m_shared : m_blocks[parameterOwner].local;
+      m_position[i] = indices.size();
+      indices.emplace_back(i);
+    }
+  };
+
+  const auto multiDomain = std::dynamic_pointer_cast<API::MultiDomainFunction>(function);
+  const auto composite = dynamic_cast<const API::CompositeDomain *>(m_costFunction->getDomain().get());
+  if (!multiDomain || !composite) {
+    // The function's own derivatives take care of its ties and NumDeriv
+    m_numericalDerivatives = false;
+    Block block;
+    block.domain = m_costFunction->getDomain().get();
+    block.localMembers.emplace_back(Member{function, 0});
+    m_blocks.emplace_back(std::move(block));
+    addParameters(m_blocks.front().localMembers.front(), 0, std::vector<bool>(function->nParams(), false));
+    return;
+  }
+
+  // A parameter that a tie of another member refers to changes the values
+  // of that member too, so it is shared. The chain rule through the ties is
+  // only followed by numerical derivatives, as in the dense minimizers.
+  std::vector<bool> sharedByTie(function->nParams(), false);
+  m_numericalDerivatives = multiDomain->getAttribute("NumDeriv").asBool();
+  for (size_t ip = 0; ip < function->nParams(); ++ip) {
+    const auto *tie = function->getTie(ip);
+    if (!tie || tie->isConstant())
+      continue;
+    m_numericalDerivatives = true;
+    for (const auto &reference : tie->getRHSParameters()) {
+      const auto ir = function->getParameterIndex(reference);
+      if (ir < function->nParams() && multiDomain->functionIndex(ir) != multiDomain->functionIndex(ip))
+        sharedByTie[ir] = true;
+    }
+  }
+
+  const auto nParts = composite->getNParts();
+  m_blocks.resize(nParts);
+  for (size_t iPart = 0, offset = 0; iPart < nParts; ++iPart) {
+    m_blocks[iPart].domain = &composite->getDomain(iPart);
+    m_blocks[iPart].valueOffset = offset;
+    offset += m_blocks[iPart].domain->size();
+  }
+  std::vector<size_t> domains;
+  for (size_t iFun = 0, parameterOffset = 0; iFun < multiDomain->nFunctions(); ++iFun) {
+    multiDomain->getDomainIndices(iFun, nParts, domains);
+    const Member member{multiDomain->getFunction(iFun), parameterOffset};
+    parameterOffset += member.function->nParams();
+    const bool shared = domains.size() != 1;
+    addParameters(member, shared ? npos : domains.front(), sharedByTie);
+    for (const auto iPart : domains) {
+      if (iPart >= nParts) {
+        throw std::invalid_argument("Function domain index is out of range.");
+      }
+      auto &members = shared ? m_blocks[iPart].sharedMembers : m_blocks[iPart].localMembers;
+      members.emplace_back(member);
+    }
+  }
+}
+
+/**
+ * Add the values and the derivatives of a member function to a block.
+ * @param member :: The member function
+ * @param block :: The block to update
+ */
+void SparseLevenbergMarquardtMinimizer::addDerivatives(const Member &member, Block &block) const {
+  const auto &domain = *block.domain;
+  const auto ny = domain.size();
+  API::FunctionValues values(domain);
+  member.function->function(domain, values);
+  for (size_t i = 0; i < ny; ++i) {
+    block.calculated(i) += values.getCalculated(i);
+  }
+
+  const auto np = member.function->nParams();
+  Jacobian jacobian(ny, np);
+  member.function->functionDeriv(domain, jacobian);
+  const auto &derivatives = jacobian.data();
+  for (size_t k = 0; k < np; ++k) {
+    const auto i = m_activeIndex[member.parameterOffset + k];
+    if (i == npos)
+      continue;
+    auto &J = m_owner[i] == npos ? block.sharedJacobian : block.localJacobian;
+    const auto column = m_position[i];
+    for (size_t j = 0; j < ny; ++j) {
+      J(j, column) += derivatives[j * np + k];
+    }
+  }
+}
+
+/**
+ * Calculate the values of all the members applied to a block.
+ * @param block :: The block
+ */
+Eigen::VectorXd SparseLevenbergMarquardtMinimizer::evaluate(const Block &block) const {
+  const auto &domain = *block.domain;
+  Eigen::VectorXd calculated = Eigen::VectorXd::Zero(static_cast<Eigen::Index>(domain.size()));
+  for (const auto *members : {&block.localMembers, &block.sharedMembers}) {
+    for (const auto &member : *members) {
+      API::FunctionValues values(domain);
+      member.function->function(domain, values);
+      for (size_t i = 0; i < domain.size(); ++i) {
+        calculated(i) += values.getCalculated(i);
+      }
+    }
+  }
+  return calculated;
+}
+
+/**
+ * Calculate the values and the derivatives of the blocks numerically, the
+ * same way as IFunction::calNumericalDeriv. A step of a local parameter only
+ * needs its own block to be evaluated again.
+ */
+void SparseLevenbergMarquardtMinimizer::calculateNumericalDerivatives() {
+  const auto function = m_costFunction->getFittingFunction();
+  const auto nShared = static_cast<Eigen::Index>(m_shared.size());
+  function->applyTies();
+  for (auto &block : m_blocks) {
+    block.calculated = evaluate(block);
+    block.localJacobian = Eigen::MatrixXd::Zero(block.calculated.size(), block.local.size());
+    block.sharedJacobian = Eigen::MatrixXd::Zero(block.calculated.size(), nShared);
+  }
+
+  for (size_t ip = 0; ip < function->nParams(); ++ip) {
+    const auto i = m_activeIndex[ip];
+    if (i == npos)
+      continue;
+    const double value = function->activeParameter(ip);
+    const double stepped = value + function->calculateStepSize(value);
+    function->setActiveParameter(ip, stepped);
+    function->applyTies();
+    const double step = stepped - value;
+    const auto column = static_cast<Eigen::Index>(m_position[i]);
+    if (m_owner[i] == npos) {
+      for (auto &block : m_blocks) {
+        block.sharedJacobian.col(column) = (evaluate(block) - block.calculated) / step;
+      }
+    } else {
+      auto &block = m_blocks[m_owner[i]];
+      block.localJacobian.col(column) = (evaluate(block) - block.calculated) / step;
+    }
+    function->setActiveParameter(ip, value);
+    function->applyTies();
+  }
+}
+
+/**
+ * Calculate the gradient and the blocks of the Hessian of the cost function
+ * at the current parameters.
+ */
+void SparseLevenbergMarquardtMinimizer::calculateDerivatives() {
+  const auto nBlocks = static_cast<int>(m_blocks.size());
+  const auto nShared = m_shared.size();
+
+  if (m_numericalDerivatives) {
+    // Steps change the parameters of the whole function, so this is serial
+    calculateNumericalDerivatives();
+  } else {
+    std::vector<std::exception_ptr> errors(m_blocks.size());
+    // A member with local parameters is evaluated on a single part of the
+    // domain, so the blocks can be calculated concurrently.
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int iBlock = 0; iBlock < nBlocks; ++iBlock) {
+      auto &block = m_blocks[iBlock];
+      const auto ny = block.domain->size();
+      block.calculated = Eigen::VectorXd::Zero(ny);
+      block.localJacobian = Eigen::MatrixXd::Zero(ny, block.local.size());
+      block.sharedJacobian = Eigen::MatrixXd::Zero(ny, nShared);
+      try {
+        for (const auto &member : block.localMembers) {
+          addDerivatives(member, block);
+        }
+      } catch (...) {
+        errors[iBlock] = std::current_exception();
+      }
+    }
+    rethrowFirst(errors);
+
+    // A member with shared parameters is evaluated on several parts of the
+    // domain and a function is not safe to evaluate from several threads.
+    for (auto &block : m_blocks) {
+      for (const auto &member : block.sharedMembers) {
+        addDerivatives(member, block);
+      }
+    }
+  }
+
+  const auto values = m_costFunction->getValues();
+  for (const auto &block : m_blocks) {
+    for (Eigen::Index i = 0; i < block.calculated.size(); ++i) {
+      values->setCalculated(block.valueOffset + i, block.calculated(i));
+    }
+  }
+  const auto weights = m_costFunction->getFitWeights(values);
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int iBlock = 0; iBlock < nBlocks; ++iBlock) {
+    auto &block = m_blocks[iBlock];
+    const auto ny = block.calculated.size();
+    Eigen::VectorXd residuals(ny);
+    for (Eigen::Index i = 0; i < ny; ++i) {
+      const auto j = block.valueOffset + i;
+      const auto w = weights[j];
+      residuals(i) = (block.calculated(i) - values->getFitData(j)) * w;
+      block.localJacobian.row(i) *= w;
+      block.sharedJacobian.row(i) *= w;
+    }
+    const auto &Jl = block.localJacobian;
+    const auto &Js = block.sharedJacobian;
+    block.A.noalias() = Jl.transpose() * Jl;
+    block.B.noalias() = Jl.transpose() * Js;
+    block.C.noalias() = Js.transpose() * Js;
+    block.localGradient.noalias() = Jl.transpose() * residuals;
+    block.sharedGradient.noalias() = Js.transpose() * residuals;
+    // The Jacobians are not needed until the next good iteration
+    block.localJacobian.resize(0, 0);
+    block.sharedJacobian.resize(0, 0);
+  }
+
+  // Sum the shared contributions in a fixed order
+  m_gradient = Eigen::VectorXd::Zero(static_cast<Eigen::Index>(m_costFunction->nParams()));
+  m_sharedHessian = Eigen::MatrixXd::Zero(nShared, nShared);
+  for (const auto &block : m_blocks) {
+    for (size_t k = 0; k < block.local.size(); ++k) {
+      m_gradient(block.local[k]) = block.localGradient(k);
+    }
+    for (size_t k = 0; k < nShared; ++k) {
+      m_gradient(m_shared[k]) += block.sharedGradient(k);
+    }
+    m_sharedHessian += block.C;
+  }
+  addPenalty();
+}
+
+/**
+ * Add the derivatives of the constraints' penalties, as
+ * CostFuncFitting::valDerivHessian does.
+ */
+void SparseLevenbergMarquardtMinimizer::addPenalty() {
+  if (!m_costFunction->includePenalty())
+    return;
+  const auto function = m_costFunction->getFittingFunction();
+  for (size_t ip = 0; ip < function->nParams(); ++ip) {
+    const auto i = m_activeIndex[ip];
+    API::IConstraint *c = function->getConstraint(ip);
+    if (i == npos || !c)
+      continue;
+    m_gradient(i) += c->checkDeriv();
+    const auto k = m_position[i];
+    if (m_owner[i] == npos) {
+      m_sharedHessian(k, k) += c->checkDeriv2();
+    } else {
+      m_blocks[m_owner[i]].A(k, k) += c->checkDeriv2();
+    }
+  }
+}
+
+/**
+ * Get a diagonal element of the undamped Hessian.
+ * @param i :: Index of an active parameter
+ */
+double SparseLevenbergMarquardtMinimizer::hessianDiagonal(size_t i) const {
+  const auto k = m_position[i];
+  return m_owner[i] == npos ? m_sharedHessian(k, k) : m_blocks[m_owner[i]].A(k, k);
+}
+
+/**
+ * Solve the damped normal equations H * dx == -der, eliminating the local
+ * parameters of each block first.
+ * @param dx :: Output corrections to the active parameters
+ * @return true if successful
+ */
+bool SparseLevenbergMarquardtMinimizer::solve(Eigen::VectorXd &dx) {
+  const auto n = m_gradient.size();
+  const auto nShared = static_cast<Eigen::Index>(m_shared.size());
+
+  // Damping and scaling factors, the same as in LevenbergMarquardtMDMinimizer
+  Eigen::VectorXd damping(n);
+  Eigen::VectorXd sf(n);
+  for (Eigen::Index i = 0; i < n; ++i) {
+    double d = std::fabs(m_gradient(i));
+    if (m_D[i] > d)
+      d = m_D[i];
+    m_D[i] = d;
+    damping(i) = m_mu * d;
+    const double tmp = hessianDiagonal(i) + damping(i);
+    sf(i) = std::sqrt(tmp);
+    if (tmp == 0.0) {
+      m_errorString = "Function doesn't depend on parameter " + m_costFunction->parameterName(i);
+      return false;
+    }
+  }
+
+  // Scaled gradient and Hessian blocks of the shared parameters
+  Eigen::VectorXd sharedSf(nShared);
+  Eigen::VectorXd sharedGradient(nShared);
+  for (Eigen::Index k = 0; k < nShared; ++k) {
+    const auto i = m_shared[k];
+    sharedSf(k) = sf(i);
+    sharedGradient(k) = m_gradient(i) / sf(i);
+  }
+  Eigen::MatrixXd S = m_sharedHessian;
+  for (Eigen::Index k = 0; k < nShared; ++k) {
+    S(k, k) += damping(m_shared[k]);
+  }
+  S = sharedSf.asDiagonal().inverse() * S * sharedSf.asDiagonal().inverse();
+  Eigen::VectorXd rhs = -sharedGradient;
+
+  const auto nBlocks = static_cast<int>(m_blocks.size());
+  std::vector<char> singular(m_blocks.size(), 0);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int iBlock = 0; iBlock < nBlocks; ++iBlock) {
+    auto &block = m_blocks[iBlock];
+    const auto nLocal = static_cast<Eigen::Index>(block.local.size());
+    if (nLocal == 0) {
+      block.AinvB = Eigen::MatrixXd::Zero(0, nShared);
+      block.AinvG = Eigen::VectorXd::Zero(0);
+      block.schur = Eigen::MatrixXd::Zero(nShared, nShared);
+      block.schurRhs = Eigen::VectorXd::Zero(nShared);
+      continue;
+    }
+    Eigen::VectorXd localSf(nLocal);
+    Eigen::VectorXd localGradient(nLocal);
+    Eigen::MatrixXd A = block.A;
+    for (Eigen::Index k = 0; k < nLocal; ++k) {
+      const auto i = block.local[k];
+      localSf(k) = sf(i);
+      localGradient(k) = m_gradient(i) / sf(i);
+      A(k, k) += damping(i);
+    }
+    A = localSf.asDiagonal().inverse() * A * localSf.asDiagonal().inverse();
+    const Eigen::MatrixXd B = localSf.asDiagonal().inverse() * block.B * sharedSf.asDiagonal().inverse();
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXd> dec(A);
+    if (!dec.isInvertible()) {
+      singular[iBlock] = 1;
+      continue;
+    }
+    block.AinvB = dec.solve(B);
+    block.AinvG = dec.solve(localGradient);
+    block.schur.noalias() = B.transpose() * block.AinvB;
+    block.schurRhs.noalias() = B.transpose() * block.AinvG;
+  }
+
+  // Schur complement on the shared parameters, summed in a fixed order
+  for (size_t iBlock = 0; iBlock < m_blocks.size(); ++iBlock) {
+    if (singular[iBlock]) {
+      m_errorString = "Matrix A is singular.";
+      return false;
+    }
+    S -= m_blocks[iBlock].schur;
+    rhs += m_blocks[iBlock].schurRhs;
+  }
+
+  Eigen::VectorXd sharedDx(nShared);
+  if (nShared > 0) {
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXd> dec(S);
+    if (!dec.isInvertible()) {
+      m_errorString = "Matrix A is singular.";
+      return false;
+    }
+    sharedDx = dec.solve(rhs);
+  }
+
+  // Back substitution and restoring the scaling
+  dx.resize(n);
+  for (Eigen::Index k = 0; k < nShared; ++k) {
+    dx(m_shared[k]) = sharedDx(k) / sharedSf(k);
+  }
+  for (const auto &block : m_blocks) {
+    const Eigen::VectorXd localDx = -block.AinvG - block.AinvB * sharedDx;
+    for (size_t k = 0; k < block.local.size(); ++k) {
+      dx(block.local[k]) = localDx(k) / sf(block.local[k]);
+    }
+  }
+  return true;
+}
+
+/**
+ * Calculate the change of the cost function predicted by its quadratic
+ * approximation: dL = - der * dx - 0.5 * dx * hessian * dx.
+ * @param dx :: Corrections to the active parameters
+ */
+double SparseLevenbergMarquardtMinimizer::predictedReduction(const Eigen::VectorXd &dx) const {
+  const auto nShared = static_cast<Eigen::Index>(m_shared.size());
+  Eigen::VectorXd sharedDx(nShared);
+  for (Eigen::Index k = 0; k < nShared; ++k) {
+    sharedDx(k) = dx(m_shared[k]);
+  }
+  double quadratic = sharedDx.dot(m_sharedHessian * sharedDx);
+  for (const auto &block : m_blocks) {
+    Eigen::VectorXd localDx(block.local.size());
+    for (size_t k = 0; k < block.local.size(); ++k) {
+      localDx(k) = dx(block.local[k]);
+    }
+    quadratic += localDx.dot(block.A * localDx) + 2.0 * localDx.dot(block.B * sharedDx);
+  }
+  return -m_gradient.dot(dx) - 0.5 * quadratic;
+}
+
+/// Do one iteration.
+bool SparseLevenbergMarquardtMinimizer::iterate(size_t /*iteration*/) {
+  const bool verbose = getProperty("Verbose");
+  const double muMax = getProperty("MuMax");
+  const double absError = getProperty("AbsError");
+
+  if (!m_costFunction) {
+    throw std::runtime_error("Cost function isn't set up.");
+  }
+  size_t n = m_costFunction->nParams();
+
+  if (n == 0) {
+    m_errorString = "No parameters to fit.";
+    return false;
+  }
+
+  if (m_mu > muMax) {
+    m_errorString = "Failed to converge, maximum mu reached.";
+    return false;
+  }
+
+  // calculate the first and second derivatives of the cost function.
+  if (m_mu == 0.0 || m_rho > 0) {
+    // calculate everything first time or
+    // if last iteration was good
+    m_F = m_costFunction->val();
+    calculateDerivatives();
+  }
+  // else if m_rho < 0 last iteration was bad: reuse the derivatives
+
+  if (m_mu == 0) // first iteration or accidental zero
+  {
+    m_mu = m_tau;
+    m_nu = 2.0;
+  }
+
+  if (verbose) {
+    g_log.warning() << "mu=" << m_mu << " shared parameters=" << m_shared.size() << " blocks=" << m_blocks.size()
+                    << '\n';
+  }
+
+  if (m_D.empty()) {
+    m_D.resize(n);
+  }
+
+  Eigen::VectorXd dx;
+  if (!solve(dx)) {
+    return false;
+  }
+
+  // save previous state
+  m_costFunction->push();
+  // Update the parameters of the cost function.
+  EigenVector parameters(n);
+  m_costFunction->getParameters(parameters);
+  for (size_t i = 0; i < n; ++i) {
+    parameters[i] += dx(i);
+  }
+  m_costFunction->setParameters(parameters);
+  m_costFunction->getFittingFunction()->applyTies();
+
+  const double dL = predictedReduction(dx);
+  double F1 = m_costFunction->val();
+  if (verbose) {
+    g_log.warning() << "Old cost function " << m_F << '\n';
+    g_log.warning() << "New cost function " << F1 << '\n';
+    g_log.warning() << "Linear part " << dL << '\n';
+  }
+
+  // Try the stop condition
+  if (m_rho >= 0) {
+    if (dx.norm() < absError) {
+      if (verbose) {
+        g_log.warning() << "Successful fit, parameters changed by less than " << absError << '\n';
+      }
+      return false;
+    }
+    if (m_rho == 0) {
+      if (m_F != F1) {
+        this->m_errorString = "Failed to converge, rho == 0";
+      }
+      return false;
+    }
+  }
+
+  if (fabs(dL) == 0.0) {
+    if (m_F == F1)
+      m_rho = 1.0;
+    else
+      m_rho = 0;
+  } else {
+    m_rho = (m_F - F1) / dL;
+    if (m_rho == 0) {
+      return false;
+    }
+  }
+
+  if (m_rho > 0) { // good progress, decrease m_mu but no more than by 1/3
+    // rho = 1 - (2*rho - 1)^3
+    m_rho = 2.0 * m_rho - 1.0;
+    m_rho = 1.0 - m_rho * m_rho * m_rho;
+    const double I3 = 1.0 / 3.0;
+    if (m_rho > I3)
+      m_rho = I3;
+    if (m_rho < 0.0001)
+      m_rho = 0.1;
+    m_mu *= m_rho;
+    m_nu = 2.0;
+    m_F = F1;
+    // drop saved state, accept new parameters
+    m_costFunction->drop();
+  } else { // bad iteration. increase m_mu and revert changes to parameters
+    m_mu *= m_nu;
+    m_nu *= 2.0;
+    // undo parameter update
+    m_costFunction->pop();
+    m_F = m_costFunction->val();
+  }
+
+  return true;
+}
+
+/// Return current value of the cost function
+double SparseLevenbergMarquardtMinimizer::costFunctionVal() {
+  if (!m_costFunction) {
+    throw std::runtime_error("Cost function isn't set up.");
+  }
+  return m_costFunction->val();
+}
+
+} // namespace Mantid::CurveFitting::FuncMinimisers
@@ -17,6 +17,32 @@
 
 namespace Mantid::CurveFitting::Functions {
 
+namespace {
+/// The exponential terms of the function
+struct Terms {
+  /// exp(A/2*(A*S^2+2*diff))*erfc((A*S^2+diff)/sqrt(2*S^2))
+  double rising;
+  /// exp(B/2*(B*S^2-2*diff))*erfc((B*S^2-diff)/sqrt(2*S^2))
+  double decaying;
+};
+
+/**
+ * Calculate the terms of the function at one point.
+ * @param a :: The A parameter
+ * @param b :: The B parameter
+ * @param s2 :: The S parameter squared
+ * @param diff :: The distance from the peak position
+ */
+Terms calculateTerms(const double a, const double b, const double s2, const double diff) {
+  const double sqrt2s = std::sqrt(2 * s2);
+  Terms terms;
+  // combine the exponentials with the logarithm of erfc to prevent overflow
+  terms.rising = std::exp(a / 2 * (a * s2 + 2 * diff) + gsl_sf_log_erfc((a * s2 + diff) / sqrt2s));
+  terms.decaying = std::exp(b / 2 * (b * s2 - 2 * diff) + gsl_sf_log_erfc((b * s2 - diff) / sqrt2s));
+  return terms;
+}
+} // namespace
+
 using namespace CurveFitting;
 
 using namespace Kernel;
@@ -124,31 +150,71 @@ void BackToBackExponential::function1D(double *out, const double *xValues, const
     extent = s;
   extent *= 100;
 
-  double s2 = s * s;
+  const double s2 = s * s;
   double normFactor = a * b / (a + b) / 2;
   // Needed for IntegratePeaksMD for cylinder profile fitted with b=0
   if (normFactor == 0.0)
     normFactor = 1.0;
   for (size_t i = 0; i < nData; i++) {
-    double diff = xValues[i] - x0;
+    const double diff = xValues[i] - x0;
     if (fabs(diff) < extent) {
-      double val = 0.0;
-      double arg1 = a / 2 * (a * s2 + 2 * diff);
-      val += exp(arg1 + gsl_sf_log_erfc((a * s2 + diff) / sqrt(2 * s2))); // prevent overflow
-      double arg2 = b / 2 * (b * s2 - 2 * diff);
-      val += exp(arg2 + gsl_sf_log_erfc((b * s2 - diff) / sqrt(2 * s2))); // prevent overflow
-      out[i] = I * val * normFactor;
+      const auto terms = calculateTerms(a, b, s2, diff);
+      out[i] = I * (terms.rising + terms.decaying) * normFactor;
     } else
       out[i] = 0.0;
   }
 }
 
 /**
- * Evaluate function derivatives numerically.
+ * Evaluate function derivatives analytically. Each erfc term differentiates
+ * to itself plus exp(-diff^2/(2*S^2)) times a constant, so a point costs the
+ * same two erfc as the function value.
  */
 void BackToBackExponential::functionDeriv1D(Jacobian *jacobian, const double *xValues, const size_t nData) {
-  FunctionDomain1DView domain(xValues, nData);
-  this->calNumericalDeriv(domain, *jacobian);
+  const double I = getParameter(0);
+  const double a = getParameter(1);
+  const double b = getParameter(2);
+  const double x0 = getParameter(3);
+  const double s = getParameter(4);
+
+  // the same extent as in function1D
+  double extent = expWidth();
+  if (s > extent)
+    extent = s;
+  extent *= 100;
+
+  const double s2 = s * s;
+  double normFactor = a * b / (a + b) / 2;
+  double normDerivA = b * b / (a + b) / (a + b) / 2;
+  double normDerivB = a * a / (a + b) / (a + b) / 2;
+  // Needed for IntegratePeaksMD for cylinder profile fitted with b=0
+  if (normFactor == 0.0) {
+    normFactor = 1.0;
+    normDerivA = 0.0;
+    normDerivB = 0.0;
+  }
+  const double sqrt2OverPi = std::sqrt(2.0 / M_PI);
+  // The function depends on |S| only through the erfc arguments
+  const double absS = std::abs(s);
+  const double signS = s < 0.0 ? -1.0 : 1.0;
+  for (size_t i = 0; i < nData; i++) {
+    const double diff = xValues[i] - x0;
+    if (fabs(diff) >= extent) {
+      for (size_t j = 0; j < 5; ++j) {
+        jacobian->set(i, j, 0.0);
+      }
+      continue;
+    }
+    const auto terms = calculateTerms(a, b, s2, diff);
+    const double sum = terms.rising + terms.decaying;
+    const double gaussian = sqrt2OverPi * std::exp(-diff * diff / (2 * s2));
+    jacobian->set(i, 0, normFactor * sum);
+    jacobian->set(i, 1, I * (normDerivA * sum + normFactor * ((a * s2 + diff) * terms.rising - absS * gaussian)));
+    jacobian->set(i, 2, I * (normDerivB * sum + normFactor * ((b * s2 - diff) * terms.decaying - absS * gaussian)));
+    jacobian->set(i, 3, -I * normFactor * (a * terms.rising - b * terms.decaying));
+    jacobian->set(i, 4,
+                  I * normFactor * (s * (a * a * terms.rising + b * b * terms.decaying) - signS * (a + b) * gaussian));
+  }
 }
 
 /**
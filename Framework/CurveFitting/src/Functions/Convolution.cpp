@@ -18,6 +18,8 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <map>
+#include <mutex>
 
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_fft_halfcomplex.h>
@@ -101,17 +103,58 @@ void Convolution::setAttribute(const std::string &attName, const IFunction::Attr
 namespace {
 // anonymous namespace for local definitions
 
-// A struct incapsulating workspaces for real fft
-struct RealFFTWorkspace {
-  explicit RealFFTWorkspace(size_t nData)
-      : workspace(gsl_fft_real_workspace_alloc(nData)), wavetable(gsl_fft_real_wavetable_alloc(nData)) {}
-  ~RealFFTWorkspace() {
+/// Maximum number of transform sizes whose wavetables are kept
+constexpr size_t MAX_CACHED_PLANS = 32;
+
+/// Wavetables of the forward and inverse real FFT of one size. They are only
+/// read by the transforms, so they are shared between calls and threads.
+struct FFTPlan {
+  explicit FFTPlan(size_t nData)
+      : wavetable(gsl_fft_real_wavetable_alloc(nData)), inverseWavetable(gsl_fft_halfcomplex_wavetable_alloc(nData)) {}
+  ~FFTPlan() {
+    gsl_fft_halfcomplex_wavetable_free(inverseWavetable);
     gsl_fft_real_wavetable_free(wavetable);
-    gsl_fft_real_workspace_free(workspace);
   }
-  gsl_fft_real_workspace *workspace;
+  FFTPlan(const FFTPlan &) = delete;
+  FFTPlan &operator=(const FFTPlan &) = delete;
   gsl_fft_real_wavetable *wavetable;
+  gsl_fft_halfcomplex_wavetable *inverseWavetable;
 };
+
+/// Returns the plan for transforms of size nData, creating it on first use
+std::shared_ptr<const FFTPlan> fftPlan(size_t nData) {
+  static std::mutex mutex;
+  static std::map<size_t, std::shared_ptr<const FFTPlan>> plans;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto plan = plans.find(nData);
+  if (plan == plans.end()) {
+    if (plans.size() >= MAX_CACHED_PLANS)
+      plans.clear();
+    plan = plans.emplace(nData, std::make_shared<FFTPlan>(nData)).first;
+  }
+  return plan->second;
+}
+
+/// Scratch space of the transforms, which can't be shared between threads.
+/// Each thread keeps the one it used last.
+gsl_fft_real_workspace *fftWorkspace(size_t nData) {
+  struct Workspace {
+    ~Workspace() {
+      if (workspace)
+        gsl_fft_real_workspace_free(workspace);
+    }
+    gsl_fft_real_workspace *workspace = nullptr;
+    size_t size = 0;
+  };
+  thread_local Workspace scratch;
+  if (scratch.size != nData) {
+    if (scratch.workspace)
+      gsl_fft_real_workspace_free(scratch.workspace);
+    scratch.workspace = gsl_fft_real_workspace_alloc(nData);
+    scratch.size = nData;
+  }
+  return scratch.workspace;
+}
 } // namespace
 
 /**
@@ -168,11 +211,11 @@ void Convolution::functionFFTMode(const FunctionDomain &domain, FunctionValues &
   const auto &d1d = dynamic_cast<const FunctionDomain1D &>(domain);
   size_t nData = domain.size();
   const double *xValues = d1d.getPointerAt(0);
-  refreshResolution();
-  RealFFTWorkspace workspace(nData);
+  const auto plan = fftPlan(nData);
+  auto *workspace = fftWorkspace(nData);
   int n2 = static_cast<int>(nData) / 2;
   bool odd = n2 * 2 != static_cast<int>(nData);
-  if (m_resolution.empty()) {
+  if (!isResolutionCached(true, xValues, nData)) {
     m_resolution.resize(nData);
     // the resolution must be defined on interval -L < xr < L, L ==
     // (xValues[nData-1] - xValues[0]) / 2
@@ -206,9 +249,10 @@ void Convolution::functionFFTMode(const FunctionDomain &domain, FunctionValues &
         m_resolution[n2 + i] = tmp;
       }
     }
-    gsl_fft_real_transform(m_resolution.data(), 1, nData, workspace.wavetable, workspace.workspace);
+    gsl_fft_real_transform(m_resolution.data(), 1, nData, plan->wavetable, workspace);
     std::transform(m_resolution.begin(), m_resolution.end(), m_resolution.begin(),
                    std::bind(std::multiplies<double>(), _1, dx));
+    cacheResolution(true, xValues, nData);
   }
 
   // Now m_resolution contains fourier transform of the resolution
@@ -259,7 +303,7 @@ void Convolution::functionFFTMode(const FunctionDomain &domain, FunctionValues &
   if (!deltaFunctionsOnly) {
     // Transform the model function
     getFunction(1)->function(domain, values);
-    gsl_fft_real_transform(out, 1, nData, workspace.wavetable, workspace.workspace);
+    gsl_fft_real_transform(out, 1, nData, plan->wavetable, workspace);
 
     // Fourier transform is integration - multiply by the step in the
     // integration variable
@@ -283,9 +327,7 @@ void Convolution::functionFFTMode(const FunctionDomain &domain, FunctionValues &
     }
 
     // Inverse fourier transform of fun
-    gsl_fft_halfcomplex_wavetable *wavetable_r = gsl_fft_halfcomplex_wavetable_alloc(nData);
-    gsl_fft_halfcomplex_inverse(out, 1, nData, wavetable_r, workspace.workspace);
-    gsl_fft_halfcomplex_wavetable_free(wavetable_r);
+    gsl_fft_halfcomplex_inverse(out, 1, nData, plan->inverseWavetable, workspace);
 
     // Inverse fourier transform is integration - multiply by the step in the
     // integration variable
@@ -335,8 +377,6 @@ void Convolution::functionDirectMode(const FunctionDomain &domain, FunctionValue
                                                            // x-values
   auto ixN = nData - ixP - 1;                              // negative x-values (ixP+ixN=nData-1)
 
-  refreshResolution();
-
   // double the domain where to evaluate the convolution. Guarantees complete
   // overlap betwen convolution and signal in the original range.
   const size_t mData = nData + ixN + ixP; // equal to 2*nData-1
@@ -348,16 +388,17 @@ void Convolution::functionDirectMode(const FunctionDomain &domain, FunctionValue
     xValuesExtd[i] = -Dx + static_cast<double>(i) * dx;
   }
 
-  if (m_resolution.empty()) {
+  if (!isResolutionCached(false, xValues, nData)) {
     m_resolution.resize(nData);
-  }
-  // Fill m_resolution with the resolution function data
-  // Lines 341-349 is duplicated in functionFFTmode. To be cleanup
-  // in issue 16064
-  evaluateFunctionOnRange(getFunction(0), nData, &xValues[0], m_resolution);
+    // Fill m_resolution with the resolution function data
+    // Lines 341-349 is duplicated in functionFFTmode. To be cleanup
+    // in issue 16064
+    evaluateFunctionOnRange(getFunction(0), nData, &xValues[0], m_resolution);
 
-  // Reverse the axis of the resolution data
-  std::reverse(m_resolution.begin(), m_resolution.end());
+    // Reverse the axis of the resolution data
+    std::reverse(m_resolution.begin(), m_resolution.end());
+    cacheResolution(false, xValues, nData);
+  }
 
   // check for delta functions
   std::vector<std::shared_ptr<DeltaFunction>> dltFuns;
@@ -483,19 +524,12 @@ size_t Convolution::addFunction(IFunction_sptr f) {
 void Convolution::setUpForFit() { m_resolution.clear(); }
 
 /// Deletes and zeroes pointer m_resolution forsing function(...) to recalculate
-/// the resolution function
+/// the resolution function if any of its parameters has changed
 void Convolution::refreshResolution() const {
-  // refresh when calculation for the first time
-  bool needRefreshing = m_resolution.empty();
-  if (!needRefreshing) {
-    // if resolution has active parameters always refresh
-    IFunction &res = *getFunction(0);
-    for (size_t i = 0; i < res.nParams(); ++i) {
-      if (res.isActive(i)) {
-        needRefreshing = true;
-        break;
-      }
-    }
+  const IFunction &res = *getFunction(0);
+  bool needRefreshing = m_resolutionParameters.size() != res.nParams();
+  for (size_t i = 0; i < res.nParams() && !needRefreshing; ++i) {
+    needRefreshing = res.getParameter(i) != m_resolutionParameters[i];
   }
   if (!needRefreshing)
     return;
@@ -503,4 +537,35 @@ void Convolution::refreshResolution() const {
   m_resolution.clear();
 }
 
+/**
+ * Check if m_resolution holds the resolution for a domain and the current
+ * values of the resolution parameters.
+ * @param fftMode :: True for the transform used in FFT mode, false for the
+ * reversed resolution used in direct mode
+ * @param xValues :: The x-values of the domain
+ * @param nData :: The size of the domain
+ */
+bool Convolution::isResolutionCached(bool fftMode, const double *xValues, size_t nData) const {
+  refreshResolution();
+  return !m_resolution.empty() && m_resolutionFFTMode == fftMode && m_resolutionX.size() == nData &&
+         std::equal(m_resolutionX.cbegin(), m_resolutionX.cend(), xValues);
+}
+
+/**
+ * Record the domain and resolution parameters that m_resolution was
+ * calculated for.
+ * @param fftMode :: True if m_resolution holds the transform used in FFT mode
+ * @param xValues :: The x-values of the domain
+ * @param nData :: The size of the domain
+ */
+void Convolution::cacheResolution(bool fftMode, const double *xValues, size_t nData) const {
+  const IFunction &res = *getFunction(0);
+  m_resolutionParameters.resize(res.nParams());
+  for (size_t i = 0; i < res.nParams(); ++i) {
+    m_resolutionParameters[i] = res.getParameter(i);
+  }
+  m_resolutionX.assign(xValues, xValues + nData);
+  m_resolutionFFTMode = fftMode;
+}
+
 } // namespace Mantid::CurveFitting::Functions
@@ -300,7 +300,7 @@ DECLARE_FUNCTION(PawleyFunction)
 /// Constructor
 PawleyFunction::PawleyFunction()
     : IPawleyFunction(), m_compositeFunction(), m_pawleyParameterFunction(), m_peakProfileComposite(), m_hkls(),
-      m_dUnit(), m_wsUnit(), m_peakRadius(5) {
+      m_dUnit(), m_wsUnit(), m_peakRadius(5), m_peakCache() {
   auto peakRadius = Kernel::ConfigService::Instance().getValue<int>("curvefitting.peakRadius");
   m_peakRadius = peakRadius.get_value_or(5);
 }
@@ -419,6 +419,9 @@ size_t PawleyFunction::calculateFunctionValues(const API::IPeakFunction_sptr &pe
  * parameter. The value is set as center parameter on the internally stored
  * PeakFunctions.
  *
+ * The values of each peak are kept and reused until one of its parameters
+ * changes.
+ *
  * @param domain :: Function domain.
  * @param values :: Function values.
  */
@@ -433,16 +436,26 @@ void PawleyFunction::function(const FunctionDomain &domain, FunctionValues &valu
 
     setPeakPositions(centreName, zeroShift, cell);
 
+    // Only the peaks with changed parameters are calculated again
+    m_peakCache.setDomain(domain1D.getPointerAt(0), domain1D.size());
     FunctionValues localValues;
 
     for (size_t i = 0; i < m_peakProfileComposite->nFunctions(); ++i) {
       IPeakFunction_sptr peak = std::dynamic_pointer_cast<IPeakFunction>(m_peakProfileComposite->getFunction(i));
 
-      try {
-        size_t offset = calculateFunctionValues(peak, domain1D, localValues);
-        values.addToCalculated(offset, localValues);
-      } catch (const std::invalid_argument &) {
-        // do nothing
+      const PeakProfileCache::Profile *profile = m_peakCache.find(i, peak);
+      if (!profile) {
+        try {
+          size_t offset = calculateFunctionValues(peak, domain1D, localValues);
+          profile = &m_peakCache.store(i, peak, offset, localValues.getPointerToCalculated(0), localValues.size());
+        } catch (const std::invalid_argument &) {
+          // the peak is outside of the domain
+          profile = &m_peakCache.store(i, peak, 0, nullptr, 0);
+        }
+      }
+
+      for (size_t j = 0; j < profile->values.size(); ++j) {
+        values.addToCalculated(profile->offset + j, profile->values[j]);
       }
     }
 
@@ -458,6 +471,7 @@ void PawleyFunction::clearPeaks() {
       std::dynamic_pointer_cast<CompositeFunction>(FunctionFactory::Instance().createFunction("CompositeFunction"));
   m_compositeFunction->replaceFunction(1, m_peakProfileComposite);
   m_hkls.clear();
+  m_peakCache.clear();
 }
 
 /// Clears peaks and adds a peak for each hkl, all with the same FWHM and
@@ -8,6 +8,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Functions/StaticKuboToyabe.h"
+#include "MantidAPI/DualNumber.h"
 #include "MantidAPI/FunctionFactory.h"
 #include <cmath>
 
@@ -19,6 +20,14 @@ using namespace Kernel;
 
 using namespace API;
 
+namespace {
+template <typename T> T staticKuboToyabe(double x, const T &A, const T &G) {
+  using std::exp;
+  using std::pow;
+  return A * (exp(-pow(G * x, 2.0) / 2.0) * (1.0 - pow(G * x, 2.0)) * 2.0 / 3.0 + 1.0 / 3);
+}
+} // namespace
+
 DECLARE_FUNCTION(StaticKuboToyabe)
 
 void StaticKuboToyabe::init() {
@@ -31,7 +40,17 @@ void StaticKuboToyabe::function1D(double *out, const double *xValues, const size
   const double G = getParameter("Delta");
 
   for (size_t i = 0; i < nData; i++) {
-    out[i] = A * (exp(-pow(G * xValues[i], 2) / 2) * (1 - pow(G * xValues[i], 2)) * 2.0 / 3 + 1.0 / 3);
+    out[i] = staticKuboToyabe(xValues[i], A, G);
+  }
+}
+
+void StaticKuboToyabe::functionDeriv1D(Jacobian *out, const double *xValues, const size_t nData) {
+  using Dual = DualNumber<2>;
+  const auto A = Dual::variable(getParameter("A"), 0);
+  const auto G = Dual::variable(getParameter("Delta"), 1);
+
+  for (size_t i = 0; i < nData; i++) {
+    setJacobianRow(out, i, staticKuboToyabe(xValues[i], A, G));
   }
 }
 
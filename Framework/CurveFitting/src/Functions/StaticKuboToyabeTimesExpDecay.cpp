@@ -5,6 +5,7 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidCurveFitting/Functions/StaticKuboToyabeTimesExpDecay.h"
+#include "MantidAPI/DualNumber.h"
 #include "MantidAPI/FunctionFactory.h"
 #include <cmath>
 
@@ -16,6 +17,17 @@ using namespace Kernel;
 
 using namespace API;
 
+namespace {
+template <typename T> T staticKuboToyabeTimesExpDecay(double x, const T &A, const T &D, const T &L) {
+  using std::exp;
+  using std::pow;
+  const double C1 = 2.0 / 3;
+  const double C2 = 1.0 / 3;
+  const T DXSquared = pow(D * x, 2.0);
+  return A * (exp(-DXSquared / 2.0) * (1.0 - DXSquared) * C1 + C2) * exp(-L * x);
+}
+} // namespace
+
 DECLARE_FUNCTION(StaticKuboToyabeTimesExpDecay)
 
 void StaticKuboToyabeTimesExpDecay::init() {
@@ -29,13 +41,19 @@ void StaticKuboToyabeTimesExpDecay::function1D(double *out, const double *xValue
   const double D = getParameter("Delta");
   const double L = getParameter("Lambda");
 
-  const double C1 = 2.0 / 3;
-  const double C2 = 1.0 / 3;
+  for (size_t i = 0; i < nData; i++) {
+    out[i] = staticKuboToyabeTimesExpDecay(xValues[i], A, D, L);
+  }
+}
+
+void StaticKuboToyabeTimesExpDecay::functionDeriv1D(Jacobian *out, const double *xValues, const size_t nData) {
+  using Dual = DualNumber<3>;
+  const auto A = Dual::variable(getParameter("A"), 0);
+  const auto D = Dual::variable(getParameter("Delta"), 1);
+  const auto L = Dual::variable(getParameter("Lambda"), 2);
 
   for (size_t i = 0; i < nData; i++) {
-    double x = xValues[i];
-    double DXSquared = pow(D * x, 2);
-    out[i] = A * (exp(-DXSquared / 2) * (1 - DXSquared) * C1 + C2) * exp(-L * x);
+    setJacobianRow(out, i, staticKuboToyabeTimesExpDecay(xValues[i], A, D, L));
   }
 }
 
@@ -5,6 +5,7 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidCurveFitting/Functions/StaticKuboToyabeTimesGausDecay.h"
+#include "MantidAPI/DualNumber.h"
 #include "MantidAPI/FunctionFactory.h"
 #include <cmath>
 
@@ -16,6 +17,23 @@ using namespace Kernel;
 
 using namespace API;
 
+namespace {
+template <typename T> T staticKuboToyabeTimesGausDecay(double x, const T &A, const T &D, const T &S) {
+  using std::exp;
+  using std::pow;
+  // Precalculate squares
+  const T D2 = pow(D, 2.0);
+  const T S2 = pow(S, 2.0);
+
+  // Precalculate constants
+  const double C1 = 2.0 / 3;
+  const double C2 = 1.0 / 3;
+
+  const double x2 = pow(x, 2);
+  return A * (exp(-(x2 * D2) / 2.0) * (1.0 - x2 * D2) * C1 + C2) * exp(-S2 * x2);
+}
+} // namespace
+
 DECLARE_FUNCTION(StaticKuboToyabeTimesGausDecay)
 
 void StaticKuboToyabeTimesGausDecay::init() {
@@ -29,17 +47,19 @@ void StaticKuboToyabeTimesGausDecay::function1D(double *out, const double *xValu
   const double D = getParameter("Delta");
   const double S = getParameter("Sigma");
 
-  // Precalculate squares
-  const double D2 = pow(D, 2);
-  const double S2 = pow(S, 2);
+  for (size_t i = 0; i < nData; i++) {
+    out[i] = staticKuboToyabeTimesGausDecay(xValues[i], A, D, S);
+  }
+}
 
-  // Precalculate constants
-  const double C1 = 2.0 / 3;
-  const double C2 = 1.0 / 3;
+void StaticKuboToyabeTimesGausDecay::functionDeriv1D(Jacobian *out, const double *xValues, const size_t nData) {
+  using Dual = DualNumber<3>;
+  const auto A = Dual::variable(getParameter("A"), 0);
+  const auto D = Dual::variable(getParameter("Delta"), 1);
+  const auto S = Dual::variable(getParameter("Sigma"), 2);
 
   for (size_t i = 0; i < nData; i++) {
-    double x2 = pow(xValues[i], 2);
-    out[i] = A * (exp(-(x2 * D2) / 2) * (1 - x2 * D2) * C1 + C2) * exp(-S2 * x2);
+    setJacobianRow(out, i, staticKuboToyabeTimesGausDecay(xValues[i], A, D, S));
   }
 }
 } // namespace Mantid::CurveFitting::Functions
@@ -8,6 +8,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Functions/StretchExpMuon.h"
+#include "MantidAPI/DualNumber.h"
 #include "MantidAPI/FunctionFactory.h"
 #include <cmath>
 
@@ -19,6 +20,14 @@ using namespace Kernel;
 
 using namespace API;
 
+namespace {
+template <typename T> T stretchExp(double x, const T &A, const T &lambda, const T &beta) {
+  using std::exp;
+  using std::pow;
+  return A * exp(-pow(lambda * x, beta));
+}
+} // namespace
+
 DECLARE_FUNCTION(StretchExpMuon)
 
 void StretchExpMuon::init() {
@@ -33,7 +42,18 @@ void StretchExpMuon::function1D(double *out, const double *xValues, const size_t
   const double b = getParameter("Beta");
 
   for (size_t i = 0; i < nData; i++) {
-    out[i] = A * exp(-pow(G * xValues[i], b));
+    out[i] = stretchExp(xValues[i], A, G, b);
+  }
+}
+
+void StretchExpMuon::functionDeriv1D(Jacobian *out, const double *xValues, const size_t nData) {
+  using Dual = DualNumber<3>;
+  const auto A = Dual::variable(getParameter("A"), 0);
+  const auto G = Dual::variable(getParameter("Lambda"), 1);
+  const auto b = Dual::variable(getParameter("Beta"), 2);
+
+  for (size_t i = 0; i < nData; i++) {
+    setJacobianRow(out, i, stretchExp(xValues[i], A, G, b));
   }
 }
 
@@ -8,11 +8,16 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Functions/UserFunction.h"
+#include "MantidAPI/CompiledExpression.h"
+#include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/MuParserUtils.h"
 #include "MantidGeometry/muParser_Silent.h"
+#include "MantidKernel/Logger.h"
 #include <boost/tokenizer.hpp>
 
+#include <cmath>
+
 namespace Mantid::CurveFitting::Functions {
 
 using namespace CurveFitting;
@@ -24,6 +29,11 @@ using Mantid::API::MuParserUtils::extraOneVarFunctions;
 using namespace Kernel;
 using namespace API;
 
+namespace {
+/// static logger
+Kernel::Logger g_log("UserFunction");
+} // namespace
+
 /// Constructor
 UserFunction::UserFunction() : m_parser(new mu::Parser()), m_x(0.), m_x_set(false) {
   extraOneVarFunctions(*m_parser);
@@ -68,6 +78,7 @@ void UserFunction::setAttribute(const std::string &attName, const Attribute &val
   }
 
   m_x_set = false;
+  m_compiled.reset();
   clearAllParameters();
 
   try {
@@ -98,6 +109,59 @@ void UserFunction::setAttribute(const std::string &attName, const Attribute &val
   }
 
   m_parser->SetExpr(m_formula);
+  compileFormula();
+}
+
+/** Compile the formula for array evaluation and analytical derivatives.
+ * muParser defines the meaning of a formula, so the compiled formula is only
+ * used if it is supported and gives the same values as muParser at a few
+ * test points.
+ */
+void UserFunction::compileFormula() {
+  std::vector<std::string> names(nParams());
+  std::vector<double> parameters(nParams());
+  for (size_t i = 0; i < nParams(); ++i) {
+    names[i] = parameterName(i);
+    parameters[i] = 0.61 + 0.17 * static_cast<double>(i);
+  }
+  try {
+    auto compiled = std::make_unique<CompiledExpression>(m_formula, "x", names);
+
+    mu::Parser parser;
+    extraOneVarFunctions(parser);
+    double x = 0.;
+    parser.DefineVar("x", &x);
+    for (size_t i = 0; i < nParams(); ++i) {
+      parser.DefineVar(names[i], &parameters[i]);
+    }
+    parser.SetExpr(m_formula);
+    const std::vector<double> xValues{-2.3, 0.37, 1.91};
+    std::vector<double> values(xValues.size());
+    compiled->evaluate(values.data(), xValues.data(), xValues.size(), parameters.data());
+    for (size_t i = 0; i < xValues.size(); ++i) {
+      x = xValues[i];
+      const double expected = parser.Eval();
+      const bool bothNaN = std::isnan(expected) && std::isnan(values[i]);
+      if (!bothNaN && expected != values[i] &&
+          !(std::abs(expected - values[i]) <= 1e-9 * std::max(1.0, std::abs(expected)))) {
+        g_log.debug() << "Formula " << m_formula << " is evaluated by muParser\n";
+        return;
+      }
+    }
+    m_compiled = std::move(compiled);
+  } catch (std::invalid_argument &) {
+    // Not supported by the compiled expression: use muParser
+  } catch (mu::Parser::exception_type &) {
+  }
+}
+
+/// Returns the current values of the parameters, in declaration order
+std::vector<double> UserFunction::parameterValues() const {
+  std::vector<double> values(nParams());
+  for (size_t i = 0; i < nParams(); ++i) {
+    values[i] = getParameter(i);
+  }
+  return values;
 }
 
 /** Calculate the fitting function.
@@ -111,6 +175,10 @@ void UserFunction::function1D(double *out, const double *xValues, const size_t n
   if (m_formula.empty()) {
     throw std::invalid_argument("Empty formula supplied for user function");
   }
+  if (m_compiled) {
+    m_compiled->evaluate(out, xValues, nData, parameterValues().data());
+    return;
+  }
   for (size_t i = 0; i < nData; i++) {
     m_x = xValues[i];
     try {
@@ -128,6 +196,11 @@ void UserFunction::function1D(double *out, const double *xValues, const size_t n
  * respect to the fitting parameters
  */
 void UserFunction::functionDeriv(const API::FunctionDomain &domain, API::Jacobian &jacobian) {
+  const auto *domain1D = dynamic_cast<const FunctionDomain1D *>(&domain);
+  if (m_compiled && domain1D && domain1D->size() > 0 && !dynamic_cast<const FunctionDomain1DHistogram *>(&domain)) {
+    m_compiled->evaluateDerivatives(jacobian, domain1D->getPointerAt(0), domain1D->size(), parameterValues().data());
+    return;
+  }
   calNumericalDeriv(domain, jacobian);
 }
 
@@ -0,0 +1,78 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidCurveFitting/PeakProfileCache.h"
+
+#include <algorithm>
+
+namespace Mantid::CurveFitting {
+
+/**
+ * Set the domain the profiles are calculated on. If it differs from the
+ * domain of the stored profiles they are all discarded.
+ * @param x :: Pointer to the first x value.
+ * @param n :: Number of x values.
+ */
+void PeakProfileCache::setDomain(const double *x, std::size_t n) {
+  if (m_domain.size() == n && std::equal(m_domain.begin(), m_domain.end(), x)) {
+    return;
+  }
+  m_domain.assign(x, x + n);
+  m_entries.clear();
+}
+
+/**
+ * Get the stored profile of a peak. The profile is returned only if it was
+ * calculated for the same function with the same parameter values.
+ * @param i :: Index of the peak.
+ * @param peak :: The peak function.
+ * @return :: Pointer to the profile or nullptr if it must be recalculated.
+ */
+const PeakProfileCache::Profile *PeakProfileCache::find(std::size_t i, const API::IFunction_sptr &peak) const {
+  if (i >= m_entries.size()) {
+    return nullptr;
+  }
+  const auto &entry = m_entries[i];
+  if (entry.peak != peak || entry.parameters.size() != peak->nParams()) {
+    return nullptr;
+  }
+  for (std::size_t ip = 0; ip < entry.parameters.size(); ++ip) {
+    if (entry.parameters[ip] != peak->getParameter(ip)) {
+      return nullptr;
+    }
+  }
+  return &entry.profile;
+}
+
+/**
+ * Store the profile of a peak with the current values of its parameters.
+ * @param i :: Index of the peak.
+ * @param peak :: The peak function.
+ * @param offset :: Index of the first value in the domain.
+ * @param values :: Pointer to the calculated values.
+ * @param n :: Number of the values.
+ * @return :: The stored profile.
+ */
+const PeakProfileCache::Profile &PeakProfileCache::store(std::size_t i, const API::IFunction_sptr &peak,
+                                                         std::size_t offset, const double *values, std::size_t n) {
+  if (i >= m_entries.size()) {
+    m_entries.resize(i + 1);
+  }
+  auto &entry = m_entries[i];
+  entry.peak = peak;
+  entry.parameters.resize(peak->nParams());
+  for (std::size_t ip = 0; ip < entry.parameters.size(); ++ip) {
+    entry.parameters[ip] = peak->getParameter(ip);
+  }
+  entry.profile.offset = offset;
+  entry.profile.values.assign(values, values + n);
+  return entry.profile;
+}
+
+/// Discard all profiles.
+void PeakProfileCache::clear() { m_entries.clear(); }
+
+} // namespace Mantid::CurveFitting
@@ -343,6 +343,37 @@ public:
     AnalysisDataService::Instance().clear();
   }
 
+  void test_individual_fits_are_returned_in_input_order() {
+    const int nSpectra = 40;
+    auto ws = WorkspaceCreationHelper::create2DWorkspaceFromFunction(Fun(), nSpectra, -5.0, 5.0, 0.1, false);
+    AnalysisDataService::Instance().add("PLOTPEAKBYLOGVALUETEST_WS", ws);
+    PlotPeakByLogValue alg;
+    alg.initialize();
+    alg.setPropertyValue("Input", "PLOTPEAKBYLOGVALUETEST_WS,i0:" + std::to_string(nSpectra - 1));
+    alg.setPropertyValue("OutputWorkspace", "PlotPeakResult");
+    alg.setPropertyValue("FitType", "Individual");
+    alg.setProperty("OutputFitStatus", true);
+    alg.setPropertyValue("Function", "name=PLOTPEAKBYLOGVALUETEST_Fun,A=0.5");
+    alg.execute();
+    TS_ASSERT(alg.isExecuted());
+
+    TWS_type result = WorkspaceCreationHelper::getWS<TableWorkspace>("PlotPeakResult");
+    TS_ASSERT_EQUALS(result->rowCount(), nSpectra);
+    // each spectrum contains values equal to its spectrum number
+    for (int i = 0; i < nSpectra; ++i) {
+      TS_ASSERT_DELTA(result->Double(i, 0), double(i + 1), 1e-15);
+      TS_ASSERT_DELTA(result->Double(i, 1), double(i + 1), 1e-10);
+    }
+    std::vector<std::string> status = alg.getProperty("OutputStatus");
+    TS_ASSERT_EQUALS(status.size(), nSpectra);
+
+    // As for a serial run the function holds the result of the last fit
+    IFunction_sptr fun = alg.getProperty("Function");
+    TS_ASSERT_DELTA(fun->getParameter("A"), double(nSpectra), 1e-10);
+
+    AnalysisDataService::Instance().clear();
+  }
+
   void test_passWorkspaceIndexToFunction_composit_function_case() {
     auto ws = WorkspaceCreationHelper::create2DWorkspaceFromFunction(Fun(), 3, -5.0, 5.0, 0.1, false);
     AnalysisDataService::Instance().add("PLOTPEAKBYLOGVALUETEST_WS", ws);
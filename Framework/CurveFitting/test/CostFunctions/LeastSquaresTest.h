@@ -21,9 +21,12 @@
 #include "MantidCurveFitting/Functions/LinearBackground.h"
 #include "MantidCurveFitting/Functions/UserFunction.h"
 #include "MantidCurveFitting/GSLFunctions.h"
+#include "MantidCurveFitting/Jacobian.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <gsl/gsl_blas.h>
 #include <sstream>
+#include <tuple>
 
 using namespace Mantid;
 using namespace Mantid::CurveFitting;
@@ -167,6 +170,76 @@ public:
     TS_ASSERT_DELTA(g.get(1), 0.9, 1e-10);
   }
 
+  void test_valDerivHessian_does_not_depend_on_number_of_threads() {
+    const size_t nData = 5000;
+    std::vector<double> x(nData), y(nData), e(nData);
+    for (size_t i = 0; i < nData; ++i) {
+      x[i] = 0.002 * static_cast<double>(i);
+      y[i] = 1.0 + 0.5 * x[i] + 3.0 * std::exp(-0.5 * std::pow((x[i] - 5.0) / 0.3, 2)) + 0.1 * std::sin(7.0 * x[i]);
+      e[i] = 1.0 + 0.01 * static_cast<double>(i % 13);
+    }
+    API::FunctionDomain1D_sptr domain(new API::FunctionDomain1DVector(x));
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    values->setFitData(y);
+    values->setFitWeights(e);
+
+    auto fun = std::make_shared<API::CompositeFunction>();
+    auto background = std::make_shared<LinearBackground>();
+    background->initialize();
+    background->setParameter("A0", 0.9);
+    background->setParameter("A1", 0.4);
+    auto peak = std::make_shared<Gaussian>();
+    peak->initialize();
+    peak->setHeight(2.5);
+    peak->setCentre(5.1);
+    peak->setFwhm(0.8);
+    fun->addFunction(background);
+    fun->addFunction(peak);
+    fun->fix(1);
+
+    const auto evaluate = [&](int nThreads) {
+      PARALLEL_SET_NUM_THREADS(nThreads);
+      auto costFun = std::make_shared<CostFuncLeastSquares>();
+      costFun->setFittingFunction(fun, domain, values);
+      const double value = costFun->valDerivHessian();
+      return std::make_tuple(value, costFun->getDeriv(), costFun->getHessian());
+    };
+    const auto maxThreads = PARALLEL_GET_MAX_THREADS;
+    const auto [value1, der1, hessian1] = evaluate(1);
+    const auto [valueN, derN, hessianN] = evaluate(std::max(maxThreads, 4));
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+
+    TS_ASSERT_EQUALS(value1, valueN);
+    TS_ASSERT_EQUALS(der1.size(), 4);
+    for (size_t i = 0; i < der1.size(); ++i) {
+      TS_ASSERT_EQUALS(der1.get(i), derN.get(i));
+      for (size_t j = 0; j < der1.size(); ++j) {
+        TS_ASSERT_EQUALS(hessian1.get(i, j), hessianN.get(i, j));
+        TS_ASSERT_EQUALS(hessian1.get(i, j), hessian1.get(j, i));
+      }
+    }
+
+    // Compare with a plain summation
+    auto costFun = std::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, domain, values);
+    TS_ASSERT_DELTA(costFun->val(), value1, 1e-10 * value1);
+    Mantid::CurveFitting::Jacobian jacobian(nData, fun->nParams());
+    fun->function(*domain, *values);
+    fun->functionDeriv(*domain, jacobian);
+    const std::vector<size_t> active{0, 2, 3, 4};
+    for (size_t a = 0; a < active.size(); ++a) {
+      double der = 0.0;
+      double hessian = 0.0;
+      for (size_t k = 0; k < nData; ++k) {
+        const double w = values->getFitWeight(k);
+        der += (values->getCalculated(k) - y[k]) * w * w * jacobian.get(k, active[a]);
+        hessian += jacobian.get(k, active[a]) * jacobian.get(k, active[0]) * w * w;
+      }
+      TS_ASSERT_DELTA(der1.get(a), der, 1e-9 * std::abs(der));
+      TS_ASSERT_DELTA(hessian1.get(a, 0), hessian, 1e-9 * std::abs(hessian));
+    }
+  }
+
   void test_linear_correction_is_good_approximation() {
     const double a = 1.0;
     const double b = 2.0;
@@ -372,6 +372,72 @@ public:
     TS_ASSERT_EQUALS(height, 1.002);
   }
 
+  void test_expDecay_with_parallel_chains() {
+    auto ws2 = createExpDecayWorkspace();
+
+    Mantid::API::IFunction_sptr fun(new ExpDecay);
+    fun->setParameter("Height", 8.);
+    fun->setParameter("Lifetime", 1.0);
+
+    Fit fit;
+    fit.initialize();
+    fit.setChild(true);
+    fit.setProperty("Function", fun);
+    fit.setProperty("InputWorkspace", ws2);
+    fit.setProperty("WorkspaceIndex", 0);
+    fit.setProperty("CreateOutput", true);
+    fit.setProperty("MaxIterations", 100000);
+    fit.setProperty("Minimizer", "FABADA,ChainLength=10000,StepsBetweenValues="
+                                 "10,ConvergenceCriteria=0.1,NumberOfChains=4,"
+                                 "ConvergedChain=ConvergedChain,Parameters=Parameters");
+
+    TS_ASSERT_THROWS_NOTHING(fit.execute());
+    TS_ASSERT(fit.isExecuted());
+    TS_ASSERT_EQUALS(fit.getPropertyValue("OutputStatus"), "success");
+
+    TS_ASSERT_DELTA(fun->getParameter("Height"), 10.0, 0.1);
+    TS_ASSERT_DELTA(fun->getParameter("Lifetime"), 0.5, 0.01);
+    TS_ASSERT_DELTA(fun->getError(0), 0.7, 1e-1);
+    TS_ASSERT_DELTA(fun->getError(1), 0.06, 1e-2);
+
+    // The converged parts of the four chains are pooled
+    MatrixWorkspace_sptr convChain = fit.getProperty("ConvergedChain");
+    TS_ASSERT(convChain);
+    TS_ASSERT_EQUALS(convChain->x(0).size(), 1000);
+  }
+
+  void test_gelmanRubin() {
+    FABADAMinimizer single;
+    single.setProperty("ChainLength", static_cast<size_t>(2000));
+    single.initialize(createCostFunc(), 100000);
+    TS_ASSERT(single.minimize(100000));
+    TS_ASSERT(single.gelmanRubin().empty());
+
+    FABADAMinimizer fabada;
+    fabada.setProperty("ChainLength", static_cast<size_t>(8000));
+    fabada.setProperty("NumberOfChains", 4);
+    fabada.initialize(createCostFunc(), 100000);
+    TS_ASSERT(fabada.minimize(100000));
+    const auto factors = fabada.gelmanRubin();
+    TS_ASSERT_EQUALS(factors.size(), 2);
+    for (const double factor : factors) {
+      TS_ASSERT_LESS_THAN(factor, 1.2);
+    }
+  }
+
+  void test_gelmanRubin_criterion_ends_the_burn_in_of_every_chain() {
+    FABADAMinimizer fabada;
+    fabada.setProperty("ChainLength", static_cast<size_t>(8000));
+    fabada.setProperty("NumberOfChains", 4);
+    fabada.setProperty("GelmanRubinCriterion", 1.1);
+    fabada.initialize(createCostFunc(), 100000);
+    // Every chain completes its converged part
+    TS_ASSERT(fabada.minimize(100000));
+    for (const double factor : fabada.gelmanRubin()) {
+      TS_ASSERT_LESS_THAN(factor, 1.2);
+    }
+  }
+
 private:
   MatrixWorkspace_sptr createExpDecayWorkspace() {
     MatrixWorkspace_sptr ws2(new WorkspaceTester);
@@ -0,0 +1,161 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/ICostFunction.h"
+#include "MantidCurveFitting/Constraints/BoundaryConstraint.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
+#include "MantidCurveFitting/FuncMinimizers/GlobalMinimizer.h"
+#include "MantidCurveFitting/FuncMinimizers/LevenbergMarquardtMDMinimizer.h"
+#include "MantidCurveFitting/Functions/UserFunction.h"
+
+using namespace Mantid;
+using namespace Mantid::CurveFitting;
+using namespace Mantid::CurveFitting::FuncMinimisers;
+using namespace Mantid::CurveFitting::CostFunctions;
+using namespace Mantid::CurveFitting::Constraints;
+using namespace Mantid::CurveFitting::Functions;
+using namespace Mantid::API;
+
+/// A double well in a with the deeper minimum at a = -2.03, b = 1
+class GlobalMinimizerTestCostFunction : public ICostFunction {
+  double a, b;
+
+public:
+  GlobalMinimizerTestCostFunction() : a(2), b(0) {}
+  std::string name() const override { return "GlobalMinimizerTestCostFunction"; }
+  double getParameter(size_t i) const override {
+    if (i == 0)
+      return a;
+    return b;
+  }
+  void setParameter(size_t i, const double &value) override {
+    if (i == 0) {
+      a = value;
+    } else {
+      b = value;
+    }
+  }
+  size_t nParams() const override { return 2; }
+  double val() const override { return (a * a - 4.0) * (a * a - 4.0) + a + (b - 1.0) * (b - 1.0); }
+  void deriv(std::vector<double> &) const override {}
+  double valAndDeriv(std::vector<double> &) const override { return 0.0; }
+};
+
+class GlobalMinimizerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static GlobalMinimizerTest *createSuite() { return new GlobalMinimizerTest(); }
+  static void destroySuite(GlobalMinimizerTest *suite) { delete suite; }
+
+  void test_multi_start_finds_deeper_minimum() { checkDoubleWell("MultiStart"); }
+
+  void test_differential_evolution_finds_deeper_minimum() { checkDoubleWell("DifferentialEvolution"); }
+
+  void test_multi_start_fits_peak_far_from_initial_guess() {
+    auto fun = createPeak();
+    fun->addConstraint(std::make_unique<BoundaryConstraint>(fun.get(), "c", 0.0, 10.0));
+    auto costFun = createCostFunction(fun);
+
+    // A local minimizer cannot find the peak from here
+    LevenbergMarquardtMDMinimizer local;
+    local.initialize(createCostFunction(createPeak()));
+    local.minimize();
+
+    GlobalMinimizer s;
+    s.setPropertyValue("Method", "MultiStart");
+    s.initialize(costFun);
+    TS_ASSERT(s.minimize());
+    TS_ASSERT_DELTA(fun->getParameter("c"), 7.0, 1e-4);
+    TS_ASSERT_DELTA(fun->getParameter("h"), 2.0, 1e-4);
+    TS_ASSERT_DELTA(s.costFunctionVal(), 0.0, 1e-8);
+    TS_ASSERT_DELTA(costFun->val(), s.costFunctionVal(), 1e-12);
+    TS_ASSERT(s.costFunctionVal() < local.costFunctionVal());
+  }
+
+  void test_differential_evolution_respects_bounds() {
+    auto fun = createPeak();
+    fun->addConstraint(std::make_unique<BoundaryConstraint>(fun.get(), "c", 0.0, 5.0));
+    auto costFun = createCostFunction(fun);
+
+    GlobalMinimizer s;
+    s.setPropertyValue("Method", "DifferentialEvolution");
+    s.initialize(costFun);
+    s.minimize();
+    TS_ASSERT_LESS_THAN_EQUALS(fun->getParameter("c"), 5.01);
+  }
+
+  void test_differential_evolution_is_reproducible() {
+    double first(0.0);
+    for (int run = 0; run < 2; ++run) {
+      auto fun = createPeak();
+      fun->addConstraint(std::make_unique<BoundaryConstraint>(fun.get(), "c", 0.0, 10.0));
+      GlobalMinimizer s;
+      s.setPropertyValue("Method", "DifferentialEvolution");
+      s.setProperty("Seed", 7);
+      s.initialize(createCostFunction(fun));
+      s.minimize();
+      if (run == 0) {
+        first = fun->getParameter("c");
+      } else {
+        TS_ASSERT_EQUALS(fun->getParameter("c"), first);
+      }
+    }
+  }
+
+  void test_local_minimizer_cannot_be_global() {
+    GlobalMinimizer s;
+    s.setPropertyValue("LocalMinimizer", "Global");
+    TS_ASSERT_THROWS(s.initialize(std::make_shared<GlobalMinimizerTestCostFunction>()),
+                     const std::invalid_argument &);
+  }
+
+private:
+  void checkDoubleWell(const std::string &method) {
+    auto fun = std::make_shared<GlobalMinimizerTestCostFunction>();
+    GlobalMinimizer s;
+    s.setPropertyValue("Method", method);
+    s.setPropertyValue("LocalMinimizer", "Simplex");
+    s.setProperty("SearchRange", 3.0);
+    s.initialize(fun);
+    TS_ASSERT(s.minimize());
+    TS_ASSERT_DELTA(fun->getParameter(0), -2.031, 0.01);
+    TS_ASSERT_DELTA(fun->getParameter(1), 1.0, 0.01);
+    TS_ASSERT_DELTA(s.costFunctionVal(), fun->val(), 1e-12);
+  }
+
+  std::shared_ptr<UserFunction> createPeak() {
+    auto fun = std::make_shared<UserFunction>();
+    fun->setAttributeValue("Formula", "h*exp(-(x-c)^2/0.5)");
+    fun->setParameter("h", 1.0);
+    fun->setParameter("c", 1.0);
+    return fun;
+  }
+
+  std::shared_ptr<CostFuncLeastSquares> createCostFunction(const std::shared_ptr<UserFunction> &fun) {
+    API::FunctionDomain1D_sptr domain(new API::FunctionDomain1DVector(0.0, 10.0, 101));
+    API::FunctionValues mockData(*domain);
+    UserFunction dataMaker;
+    dataMaker.setAttributeValue("Formula", "h*exp(-(x-c)^2/0.5)");
+    dataMaker.setParameter("h", 2.0);
+    dataMaker.setParameter("c", 7.0);
+    dataMaker.function(*domain, mockData);
+
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    values->setFitDataFromCalculated(mockData);
+    values->setFitWeights(1.0);
+
+    auto costFun = std::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, domain, values);
+    return costFun;
+  }
+};
@@ -0,0 +1,258 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/JointDomain.h"
+#include "MantidAPI/MultiDomainFunction.h"
+#include "MantidCurveFitting/Constraints/BoundaryConstraint.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncPoisson.h"
+#include "MantidCurveFitting/FuncMinimizers/LevenbergMarquardtMDMinimizer.h"
+#include "MantidCurveFitting/FuncMinimizers/SparseLevenbergMarquardtMinimizer.h"
+#include "MantidCurveFitting/Functions/UserFunction.h"
+
+#include "MantidFrameworkTestHelpers/MultiDomainFunctionHelper.h"
+
+using namespace Mantid;
+using namespace Mantid::CurveFitting;
+using namespace Mantid::CurveFitting::FuncMinimisers;
+using namespace Mantid::CurveFitting::CostFunctions;
+using namespace Mantid::CurveFitting::Constraints;
+using namespace Mantid::CurveFitting::Functions;
+using namespace Mantid::API;
+
+class SparseLevenbergMarquardtTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SparseLevenbergMarquardtTest *createSuite() { return new SparseLevenbergMarquardtTest(); }
+  static void destroySuite(SparseLevenbergMarquardtTest *suite) { delete suite; }
+
+  void test_single_domain() {
+    API::FunctionDomain1D_sptr domain(new API::FunctionDomain1DVector(0.0, 10.0, 20));
+    API::FunctionValues mockData(*domain);
+    UserFunction dataMaker;
+    dataMaker.setAttributeValue("Formula", "a*x+b+h*exp(-s*x^2)");
+    dataMaker.setParameter("a", 1.1);
+    dataMaker.setParameter("b", 2.2);
+    dataMaker.setParameter("h", 3.3);
+    dataMaker.setParameter("s", 0.2);
+    dataMaker.function(*domain, mockData);
+
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    values->setFitDataFromCalculated(mockData);
+    values->setFitWeights(1.0);
+
+    auto fun = std::make_shared<UserFunction>();
+    fun->setAttributeValue("Formula", "a*x+b+h*exp(-s*x^2)");
+    fun->setParameter("a", 1.);
+    fun->setParameter("b", 2.);
+    fun->setParameter("h", 3.);
+    fun->setParameter("s", 0.1);
+
+    auto costFun = std::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, domain, values);
+
+    SparseLevenbergMarquardtMinimizer s;
+    s.initialize(costFun);
+    TS_ASSERT(s.minimize());
+    TS_ASSERT_EQUALS(s.getError(), "success");
+    TS_ASSERT_DELTA(costFun->val(), 0.0, 0.0001);
+    TS_ASSERT_DELTA(fun->getParameter("a"), 1.1, 0.001);
+    TS_ASSERT_DELTA(fun->getParameter("b"), 2.2, 0.001);
+    TS_ASSERT_DELTA(fun->getParameter("h"), 3.3, 0.001);
+    TS_ASSERT_DELTA(fun->getParameter("s"), 0.2, 0.001);
+  }
+
+  void test_all_parameters_shared() {
+    auto domain = Mantid::FrameworkTestHelpers::makeMultiDomainDomain3();
+
+    auto values = std::make_shared<FunctionValues>(*domain);
+    auto &d0 = static_cast<const FunctionDomain1D &>(domain->getDomain(0));
+    for (size_t i = 0; i < d0.size(); ++i) {
+      values->setFitData(i, 3.0 + 6.0 * d0[i]);
+    }
+    auto &d1 = static_cast<const FunctionDomain1D &>(domain->getDomain(1));
+    for (size_t i = 0; i < d1.size(); ++i) {
+      values->setFitData(9 + i, 1.0 + 3.0 * d1[i]);
+    }
+    auto &d2 = static_cast<const FunctionDomain1D &>(domain->getDomain(2));
+    for (size_t i = 0; i < d2.size(); ++i) {
+      values->setFitData(19 + i, 2.0 + 4.0 * d2[i]);
+    }
+    values->setFitWeights(1);
+
+    auto multi = Mantid::FrameworkTestHelpers::makeMultiDomainFunction3();
+    auto costFun = std::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(multi, domain, values);
+
+    SparseLevenbergMarquardtMinimizer s;
+    s.initialize(costFun);
+    TS_ASSERT(s.minimize());
+    TS_ASSERT_EQUALS(s.getError(), "success");
+    TS_ASSERT_DELTA(s.costFunctionVal(), 0, 1e-4);
+    TS_ASSERT_DELTA(multi->getFunction(0)->getParameter("A"), 0, 1e-8);
+    TS_ASSERT_DELTA(multi->getFunction(0)->getParameter("B"), 1, 1e-8);
+    TS_ASSERT_DELTA(multi->getFunction(1)->getParameter("A"), 1, 1e-8);
+    TS_ASSERT_DELTA(multi->getFunction(1)->getParameter("B"), 2, 1e-8);
+    TS_ASSERT_DELTA(multi->getFunction(2)->getParameter("A"), 2, 1e-8);
+    TS_ASSERT_DELTA(multi->getFunction(2)->getParameter("B"), 3, 1e-8);
+  }
+
+  void test_local_peaks_and_shared_background() {
+    const size_t nDomains = 12;
+    auto multi = createGlobalFunction(nDomains);
+    auto costFun = createCostFunction(multi, nDomains);
+
+    SparseLevenbergMarquardtMinimizer s;
+    s.initialize(costFun);
+    TS_ASSERT(s.minimize());
+    TS_ASSERT_EQUALS(s.getError(), "success");
+    TS_ASSERT_DELTA(s.costFunctionVal(), 0.0, 1e-8);
+    for (size_t i = 0; i < nDomains; ++i) {
+      TS_ASSERT_DELTA(multi->getFunction(i)->getParameter("h"), height(i), 1e-5);
+      TS_ASSERT_DELTA(multi->getFunction(i)->getParameter("c"), centre(i), 1e-5);
+    }
+    TS_ASSERT_DELTA(multi->getFunction(nDomains)->getParameter("b"), 0.3, 1e-5);
+  }
+
+  void test_same_result_as_dense_minimizer() {
+    const size_t nDomains = 5;
+    auto sparseFun = createGlobalFunction(nDomains);
+    auto denseFun = createGlobalFunction(nDomains);
+    // Start further away so that some iterations are rejected
+    for (const auto &multi : {sparseFun, denseFun}) {
+      multi->getFunction(nDomains)->setParameter("b", 1.0);
+    }
+    auto sparseCost = createCostFunction(sparseFun, nDomains);
+    auto denseCost = createCostFunction(denseFun, nDomains);
+
+    SparseLevenbergMarquardtMinimizer sparse;
+    sparse.initialize(sparseCost);
+    sparse.minimize();
+    LevenbergMarquardtMDMinimizer dense;
+    dense.initialize(denseCost);
+    dense.minimize();
+
+    TS_ASSERT_EQUALS(sparse.getError(), dense.getError());
+    TS_ASSERT_DELTA(sparse.costFunctionVal(), dense.costFunctionVal(), 1e-10);
+    for (size_t i = 0; i < sparseFun->nParams(); ++i) {
+      TS_ASSERT_DELTA(sparseFun->getParameter(i), denseFun->getParameter(i), 1e-6);
+    }
+  }
+
+  void test_ties_between_domains_give_the_same_result_as_dense_minimizer() {
+    const size_t nDomains = 4;
+    auto sparseFun = createGlobalFunction(nDomains);
+    auto denseFun = createGlobalFunction(nDomains);
+    // The centre of the first peak is local to its domain but for the ties
+    for (const auto &multi : {sparseFun, denseFun}) {
+      for (size_t i = 1; i < nDomains; ++i) {
+        multi->tie("f" + std::to_string(i) + ".c", "f0.c");
+      }
+    }
+    auto sparseCost = createCostFunction(sparseFun, nDomains);
+    auto denseCost = createCostFunction(denseFun, nDomains);
+
+    SparseLevenbergMarquardtMinimizer sparse;
+    sparse.initialize(sparseCost);
+    TS_ASSERT(sparse.minimize());
+    LevenbergMarquardtMDMinimizer dense;
+    dense.initialize(denseCost);
+    dense.minimize();
+
+    TS_ASSERT_EQUALS(sparse.getError(), "success");
+    TS_ASSERT_EQUALS(sparse.getError(), dense.getError());
+    TS_ASSERT_DELTA(sparse.costFunctionVal(), dense.costFunctionVal(), 1e-10);
+    for (size_t i = 0; i < sparseFun->nParams(); ++i) {
+      TS_ASSERT_DELTA(sparseFun->getParameter(i), denseFun->getParameter(i), 1e-6);
+    }
+    TS_ASSERT_DELTA(sparseFun->getFunction(nDomains - 1)->getParameter("c"),
+                    sparseFun->getFunction(0)->getParameter("c"), 1e-12);
+  }
+
+  void test_constraint_on_shared_parameter() {
+    const size_t nDomains = 4;
+    double expected(0.0);
+    for (const bool sparse : {false, true}) {
+      auto multi = createGlobalFunction(nDomains);
+      auto background = multi->getFunction(nDomains);
+      background->addConstraint(std::make_unique<BoundaryConstraint>(background.get(), "b", 0.0, 0.2));
+      auto costFun = createCostFunction(multi, nDomains);
+      if (sparse) {
+        SparseLevenbergMarquardtMinimizer s;
+        s.initialize(costFun);
+        s.minimize();
+        TS_ASSERT_DELTA(background->getParameter("b"), expected, 1e-6);
+      } else {
+        LevenbergMarquardtMDMinimizer s;
+        s.initialize(costFun);
+        s.minimize();
+        expected = background->getParameter("b");
+        TS_ASSERT_LESS_THAN(expected, 0.25);
+      }
+    }
+  }
+
+  void test_requires_least_squares() {
+    SparseLevenbergMarquardtMinimizer s;
+    TS_ASSERT_THROWS(s.initialize(std::make_shared<CostFuncPoisson>()), const std::invalid_argument &);
+  }
+
+private:
+  static double height(size_t i) { return 1.0 + 0.1 * static_cast<double>(i); }
+  static double centre(size_t i) { return 5.0 + 0.05 * static_cast<double>(i); }
+
+  /// A peak local to each domain and a background shared by all domains
+  std::shared_ptr<MultiDomainFunction> createGlobalFunction(size_t nDomains) {
+    auto multi = std::make_shared<MultiDomainFunction>();
+    for (size_t i = 0; i < nDomains; ++i) {
+      auto peak = std::make_shared<UserFunction>();
+      peak->setAttributeValue("Formula", "h*exp(-(x-c)^2/0.5)");
+      peak->setParameter("h", 1.0);
+      peak->setParameter("c", 5.2);
+      multi->addFunction(peak);
+    }
+    auto background = std::make_shared<UserFunction>();
+    background->setAttributeValue("Formula", "b");
+    background->setParameter("b", 0.0);
+    multi->addFunction(background);
+
+    multi->clearDomainIndices();
+    for (size_t i = 0; i < nDomains; ++i) {
+      multi->setDomainIndex(i, i);
+    }
+    return multi;
+  }
+
+  std::shared_ptr<CostFuncLeastSquares> createCostFunction(const std::shared_ptr<MultiDomainFunction> &multi,
+                                                           size_t nDomains) {
+    auto domain = std::make_shared<JointDomain>();
+    for (size_t i = 0; i < nDomains; ++i) {
+      domain->addDomain(std::make_shared<FunctionDomain1DVector>(0.0, 10.0, 51));
+    }
+    auto values = std::make_shared<FunctionValues>(*domain);
+    size_t offset = 0;
+    for (size_t i = 0; i < nDomains; ++i) {
+      const auto &x = static_cast<const FunctionDomain1D &>(domain->getDomain(i));
+      for (size_t j = 0; j < x.size(); ++j) {
+        const double dx = x[j] - centre(i);
+        values->setFitData(offset + j, height(i) * std::exp(-dx * dx / 0.5) + 0.3);
+      }
+      offset += x.size();
+    }
+    values->setFitWeights(1.0);
+
+    auto costFun = std::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(multi, domain, values);
+    return costFun;
+  }
+};
@@ -11,6 +11,7 @@
 #include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionValues.h"
 #include "MantidCurveFitting/Functions/BackToBackExponential.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include <cmath>
 
@@ -204,4 +205,31 @@ public:
     TS_ASSERT_EQUALS(b2bExp.intensity(), 2.1);
     TS_ASSERT_EQUALS(b2bExp.intensityError(), b2bExp.getError("I"));
   }
+
+  void test_analytical_derivatives_match_numerical() { checkDerivatives(0.7); }
+
+  void test_analytical_derivatives_match_numerical_for_negative_S() { checkDerivatives(-0.7); }
+
+private:
+  void checkDerivatives(double s) {
+    BackToBackExponential b2bExp;
+    b2bExp.initialize();
+    b2bExp.setParameter("I", 3.0);
+    b2bExp.setParameter("A", 1.5);
+    b2bExp.setParameter("B", 0.3);
+    b2bExp.setParameter("X0", 0.2);
+    b2bExp.setParameter("S", s);
+    b2bExp.setStepSizeMethod(Mantid::API::IFunction::StepSizeMethod::SQRT_EPSILON);
+
+    Mantid::API::FunctionDomain1DVector x(-5, 10, 31);
+    Mantid::CurveFitting::Jacobian analytical(x.size(), 5);
+    Mantid::CurveFitting::Jacobian numerical(x.size(), 5);
+    b2bExp.functionDeriv(x, analytical);
+    b2bExp.calNumericalDeriv(x, numerical);
+    for (size_t i = 0; i < x.size(); ++i) {
+      for (size_t j = 0; j < 5; ++j) {
+        TS_ASSERT_DELTA(analytical.get(i, j), numerical.get(i, j), 1e-5);
+      }
+    }
+  }
 };
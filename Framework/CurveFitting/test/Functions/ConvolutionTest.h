@@ -169,6 +169,15 @@ public:
   }
 };
 
+class ConvolutionTest_CountingGauss : public ConvolutionTest_Gauss {
+public:
+  void functionLocal(double *out, const double *xValues, const size_t nData) const override {
+    ++calls;
+    ConvolutionTest_Gauss::functionLocal(out, xValues, nData);
+  }
+  mutable size_t calls = 0;
+};
+
 DECLARE_FUNCTION(ConvolutionTest_Gauss)
 DECLARE_FUNCTION(ConvolutionTest_Lorentz)
 DECLARE_FUNCTION(ConvolutionTest_Linear)
@@ -363,6 +372,59 @@ public:
     }
   }
 
+  void test_fixed_resolution_is_evaluated_once() {
+    Convolution conv;
+    auto res = std::make_shared<ConvolutionTest_CountingGauss>();
+    conv.addFunction(res);
+    auto fun = std::make_shared<ConvolutionTest_Gauss>();
+    fun->setParameter("c", 0.5);
+    conv.addFunction(fun);
+
+    const auto x = symmetricRange(101, 0.1);
+    FunctionDomain1DView xView(x.data(), x.size());
+    FunctionValues out(xView);
+    for (size_t i = 0; i < 3; ++i) {
+      fun->setParameter("h", 1.0 + static_cast<double>(i));
+      conv.function(xView, out);
+    }
+    TS_ASSERT_EQUALS(res->calls, 1);
+  }
+
+  void test_resolution_is_recalculated_when_its_parameters_or_the_domain_change() {
+    Convolution conv;
+    auto res = std::make_shared<ConvolutionTest_Gauss>();
+    res->setParameter("s", 2.0);
+    conv.addFunction(res);
+    auto fun = std::make_shared<ConvolutionTest_Gauss>();
+    conv.addFunction(fun);
+
+    auto x = symmetricRange(101, 0.1);
+    FunctionDomain1DView xView(x.data(), x.size());
+    FunctionValues out(xView);
+    conv.function(xView, out);
+
+    // A fixed parameter set directly must not leave a stale resolution
+    res->setParameter("h", 2.0);
+    FunctionValues scaled(xView);
+    conv.function(xView, scaled);
+    for (size_t i = 0; i < x.size(); ++i) {
+      TS_ASSERT_DELTA(scaled.getCalculated(i), 2.0 * out.getCalculated(i), 1e-10);
+    }
+
+    // Same size, different step
+    const auto wider = symmetricRange(101, 0.15);
+    FunctionDomain1DView widerView(wider.data(), wider.size());
+    FunctionValues cached(widerView), fresh(widerView);
+    conv.function(widerView, cached);
+    Convolution reference;
+    reference.addFunction(res->clone());
+    reference.addFunction(fun->clone());
+    reference.function(widerView, fresh);
+    for (size_t i = 0; i < wider.size(); ++i) {
+      TS_ASSERT_DELTA(cached.getCalculated(i), fresh.getCalculated(i), 1e-12);
+    }
+  }
+
   void testAttributesSetUpCorrectlyForConvolution() {
     Convolution conv;
     auto func = std::make_shared<ConvolutionTest_LinearWithAttributes>();
@@ -466,4 +528,13 @@ public:
     TS_ASSERT(categories.size() == 1);
     TS_ASSERT(categories[0] == "General");
   }
+
+private:
+  std::vector<double> symmetricRange(size_t n, double dx) {
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) {
+      x[i] = (static_cast<double>(i) - static_cast<double>(n / 2)) * dx;
+    }
+    return x;
+  }
 };
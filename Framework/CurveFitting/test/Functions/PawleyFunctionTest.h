@@ -8,6 +8,8 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidCurveFitting/Functions/PawleyFunction.h"
 #include "MantidGeometry/Crystal/PointGroup.h"
 
@@ -394,7 +396,62 @@ public:
     TS_ASSERT_EQUALS(parameters->getParameter("Gamma"), 90.0);
   }
 
+  void testPawleyFunctionReusesUnchangedPeaks() {
+    auto fn = createCubicFunction();
+    FunctionDomain1DVector domain(2.0, 6.0, 400);
+    FunctionValues values(domain);
+    fn->function(domain, values);
+
+    // Only the changed peak is calculated again
+    fn->getPeakFunction(1)->setHeight(7.0);
+    fn->function(domain, values);
+
+    auto reference = createCubicFunction();
+    reference->getPeakFunction(1)->setHeight(7.0);
+    valuesAreEqual(*reference, domain, values);
+
+    // All peaks move with the lattice parameter
+    fn->getPawleyParameterFunction()->setParameter("a", 5.1);
+    fn->function(domain, values);
+
+    reference->getPawleyParameterFunction()->setParameter("a", 5.1);
+    valuesAreEqual(*reference, domain, values);
+  }
+
+  void testPawleyFunctionRecalculatesOnNewDomain() {
+    auto fn = createCubicFunction();
+    FunctionDomain1DVector domain(2.0, 6.0, 400);
+    FunctionValues values(domain);
+    fn->function(domain, values);
+
+    FunctionDomain1DVector otherDomain(2.5, 5.5, 300);
+    FunctionValues otherValues(otherDomain);
+    fn->function(otherDomain, otherValues);
+
+    auto reference = createCubicFunction();
+    valuesAreEqual(*reference, otherDomain, otherValues);
+  }
+
 private:
+  std::shared_ptr<PawleyFunction> createCubicFunction() {
+    auto fn = std::make_shared<PawleyFunction>();
+    fn->initialize();
+    fn->setLatticeSystem("Cubic");
+    fn->setUnitCell("5.0 5.0 5.0");
+    fn->addPeak(V3D(1, 0, 0), 0.05, 3.0);
+    fn->addPeak(V3D(1, 1, 0), 0.05, 4.0);
+    fn->addPeak(V3D(1, 1, 1), 0.05, 5.0);
+    return fn;
+  }
+
+  void valuesAreEqual(const PawleyFunction &reference, const FunctionDomain1D &domain, const FunctionValues &values) {
+    FunctionValues expected(domain);
+    reference.function(domain, expected);
+    for (size_t i = 0; i < domain.size(); ++i) {
+      TS_ASSERT_EQUALS(values[i], expected[i]);
+    }
+  }
+
   void cellParametersAre(const UnitCell &cell, double a, double b, double c, double alpha, double beta, double gamma) {
     TS_ASSERT_DELTA(cell.a(), a, 1e-9);
     TS_ASSERT_DELTA(cell.b(), b, 1e-9);
@@ -9,6 +9,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "MantidCurveFitting/Functions/StaticKuboToyabe.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 using namespace Mantid::CurveFitting::Functions;
 
@@ -46,4 +47,22 @@ public:
     TS_ASSERT_DELTA(y[8], 0.0194, 1e-4);
     TS_ASSERT_DELTA(y[9], 0.0372, 1e-4);
   }
+
+  void test_derivatives_match_numerical_derivatives() {
+    StaticKuboToyabe fun;
+    fun.initialize();
+    fun.setParameter("A", 0.45);
+    fun.setParameter("Delta", 1.05);
+
+    Mantid::API::FunctionDomain1DVector x(0, 2, 10);
+    Mantid::CurveFitting::Jacobian analytical(x.size(), 2);
+    Mantid::CurveFitting::Jacobian numerical(x.size(), 2);
+    fun.functionDeriv(x, analytical);
+    fun.calNumericalDeriv(x, numerical);
+    for (size_t i = 0; i < x.size(); ++i) {
+      for (size_t j = 0; j < 2; ++j) {
+        TS_ASSERT_DELTA(analytical.get(i, j), numerical.get(i, j), 1e-3);
+      }
+    }
+  }
 };
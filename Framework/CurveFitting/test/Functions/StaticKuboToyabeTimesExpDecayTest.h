@@ -9,6 +9,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "MantidCurveFitting/Functions/StaticKuboToyabeTimesExpDecay.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 using Mantid::CurveFitting::Functions::StaticKuboToyabeTimesExpDecay;
 
@@ -63,4 +64,23 @@ public:
   }
 
   StaticKuboToyabeTimesExpDecay fn;
+
+  void test_derivatives_match_numerical_derivatives() {
+    StaticKuboToyabeTimesExpDecay fun;
+    fun.initialize();
+    fun.setParameter("A", 0.5);
+    fun.setParameter("Delta", 0.3);
+    fun.setParameter("Lambda", 0.4);
+
+    Mantid::API::FunctionDomain1DVector x(0, 2, 10);
+    Mantid::CurveFitting::Jacobian analytical(x.size(), 3);
+    Mantid::CurveFitting::Jacobian numerical(x.size(), 3);
+    fun.functionDeriv(x, analytical);
+    fun.calNumericalDeriv(x, numerical);
+    for (size_t i = 0; i < x.size(); ++i) {
+      for (size_t j = 0; j < 3; ++j) {
+        TS_ASSERT_DELTA(analytical.get(i, j), numerical.get(i, j), 1e-3);
+      }
+    }
+  }
 };
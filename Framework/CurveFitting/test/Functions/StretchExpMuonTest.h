@@ -9,6 +9,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "MantidCurveFitting/Functions/StretchExpMuon.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 using namespace Mantid::CurveFitting::Functions;
 
@@ -45,4 +46,23 @@ public:
     TS_ASSERT_DELTA(y[8], 0.1214, 1e-4);
     TS_ASSERT_DELTA(y[9], 0.1068, 1e-4);
   }
+
+  void test_derivatives_match_numerical_derivatives() {
+    StretchExpMuon fun;
+    fun.initialize();
+    fun.setParameter("A", 1.0);
+    fun.setParameter("Lambda", 2.5);
+    fun.setParameter("Beta", 0.5);
+
+    Mantid::API::FunctionDomain1DVector x(0, 2, 10);
+    Mantid::CurveFitting::Jacobian analytical(x.size(), 3);
+    Mantid::CurveFitting::Jacobian numerical(x.size(), 3);
+    fun.functionDeriv(x, analytical);
+    fun.calNumericalDeriv(x, numerical);
+    for (size_t i = 0; i < x.size(); ++i) {
+      for (size_t j = 0; j < 3; ++j) {
+        TS_ASSERT_DELTA(analytical.get(i, j), numerical.get(i, j), 1e-3);
+      }
+    }
+  }
 };
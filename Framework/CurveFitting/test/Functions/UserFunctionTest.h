@@ -12,6 +12,8 @@
 #include "MantidAPI/Jacobian.h"
 #include "MantidCurveFitting/Functions/UserFunction.h"
 
+#include <cmath>
+
 using namespace Mantid::CurveFitting;
 using namespace Mantid::CurveFitting::Functions;
 using namespace Mantid::API;
@@ -77,6 +79,77 @@ public:
     TS_ASSERT(categories[0] == "General");
   }
 
+  void test_compiled_formula_has_analytical_derivatives() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute("h*exp(-(x-c)^2/(2*s^2))+b"));
+    fun.setParameter("h", 2.5);
+    fun.setParameter("c", 0.3);
+    fun.setParameter("s", 0.4);
+    fun.setParameter("b", 0.1);
+
+    const size_t nData = 500;
+    std::vector<double> x(nData), y(nData);
+    for (size_t i = 0; i < nData; i++) {
+      x[i] = -1.0 + 0.005 * static_cast<double>(i);
+    }
+    fun.function1D(y.data(), x.data(), nData);
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(nData, 4);
+    fun.functionDeriv(domain, J);
+
+    for (size_t i = 0; i < nData; i++) {
+      const double d = x[i] - 0.3;
+      const double g = exp(-d * d / (2 * 0.4 * 0.4));
+      TS_ASSERT_DELTA(y[i], 2.5 * g + 0.1, 1e-12);
+      TS_ASSERT_DELTA(J.get(i, 0), g, 1e-12);
+      TS_ASSERT_DELTA(J.get(i, 1), 2.5 * g * d / (0.4 * 0.4), 1e-12);
+      TS_ASSERT_DELTA(J.get(i, 2), 2.5 * g * d * d / (0.4 * 0.4 * 0.4), 1e-12);
+      TS_ASSERT_DELTA(J.get(i, 3), 1.0, 1e-12);
+    }
+  }
+
+  void test_analytical_derivatives_are_finite_at_zero() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute("A*exp(-(L*x)^B)"));
+    fun.setParameter("A", 2.0);
+    fun.setParameter("L", 0.8);
+    fun.setParameter("B", 1.5);
+
+    const std::vector<double> x{0.0, 1.0};
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(static_cast<int>(x.size()), 3);
+    fun.functionDeriv(domain, J);
+
+    // At x = 0 the function does not depend on L or B
+    TS_ASSERT_DELTA(J.get(0, 0), 1.0, 1e-12);
+    TS_ASSERT_EQUALS(J.get(0, 1), 0.0);
+    TS_ASSERT_EQUALS(J.get(0, 2), 0.0);
+    const double u = std::pow(0.8, 1.5), g = std::exp(-u);
+    TS_ASSERT_DELTA(J.get(1, 0), g, 1e-12);
+    TS_ASSERT_DELTA(J.get(1, 1), -2.0 * g * 1.5 * u / 0.8, 1e-12);
+    TS_ASSERT_DELTA(J.get(1, 2), -2.0 * g * u * std::log(0.8), 1e-12);
+  }
+
+  void test_formula_that_cannot_be_compiled_is_evaluated_by_muParser() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute("x>1?a*x:b"));
+    fun.setParameter("a", 2.0);
+    fun.setParameter("b", -1.0);
+
+    const std::vector<double> x{0.5, 1.5, 2.5};
+    std::vector<double> y(x.size());
+    fun.function1D(y.data(), x.data(), x.size());
+    TS_ASSERT_DELTA(y[0], -1.0, 1e-12);
+    TS_ASSERT_DELTA(y[1], 3.0, 1e-12);
+    TS_ASSERT_DELTA(y[2], 5.0, 1e-12);
+
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(static_cast<int>(x.size()), 2);
+    fun.functionDeriv(domain, J);
+    TS_ASSERT_DELTA(J.get(0, 1), 1.0, 1e-6);
+    TS_ASSERT_DELTA(J.get(2, 0), 2.5, 1e-6);
+  }
+
   void test_setAttribute_will_reevaluate_function_if_it_has_changed() {
     UserFunction fun;
     fun.setAttribute("Formula", UserFunction::Attribute("a*x"));
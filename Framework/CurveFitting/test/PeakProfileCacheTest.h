@@ -0,0 +1,99 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidCurveFitting/Functions/Gaussian.h"
+#include "MantidCurveFitting/PeakProfileCache.h"
+
+using Mantid::CurveFitting::PeakProfileCache;
+using Mantid::CurveFitting::Functions::Gaussian;
+
+class PeakProfileCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PeakProfileCacheTest *createSuite() { return new PeakProfileCacheTest(); }
+  static void destroySuite(PeakProfileCacheTest *suite) { delete suite; }
+
+  PeakProfileCacheTest() : m_x{1.0, 2.0, 3.0, 4.0}, m_values{0.5, 1.5} {}
+
+  void test_find_returns_stored_profile() {
+    PeakProfileCache cache;
+    cache.setDomain(m_x.data(), m_x.size());
+    auto peak = createPeak();
+
+    TS_ASSERT(!cache.find(0, peak));
+    cache.store(0, peak, 1, m_values.data(), m_values.size());
+
+    const auto *profile = cache.find(0, peak);
+    TS_ASSERT(profile);
+    TS_ASSERT_EQUALS(profile->offset, 1);
+    TS_ASSERT_EQUALS(profile->values, m_values);
+    TS_ASSERT(!cache.find(1, peak));
+  }
+
+  void test_changed_parameter_invalidates_profile() {
+    PeakProfileCache cache;
+    cache.setDomain(m_x.data(), m_x.size());
+    auto peak = createPeak();
+    auto other = createPeak();
+    cache.store(0, peak, 1, m_values.data(), m_values.size());
+    cache.store(1, other, 0, m_values.data(), m_values.size());
+
+    peak->setParameter("Height", 2.0);
+    TS_ASSERT(!cache.find(0, peak));
+    TS_ASSERT(cache.find(1, other));
+  }
+
+  void test_different_function_invalidates_profile() {
+    PeakProfileCache cache;
+    cache.setDomain(m_x.data(), m_x.size());
+    cache.store(0, createPeak(), 1, m_values.data(), m_values.size());
+
+    TS_ASSERT(!cache.find(0, createPeak()));
+  }
+
+  void test_domain_change_invalidates_profiles() {
+    PeakProfileCache cache;
+    cache.setDomain(m_x.data(), m_x.size());
+    auto peak = createPeak();
+    cache.store(0, peak, 1, m_values.data(), m_values.size());
+
+    auto x = m_x;
+    cache.setDomain(x.data(), x.size());
+    TS_ASSERT(cache.find(0, peak));
+
+    x[2] = 3.5;
+    cache.setDomain(x.data(), x.size());
+    TS_ASSERT(!cache.find(0, peak));
+  }
+
+  void test_clear() {
+    PeakProfileCache cache;
+    cache.setDomain(m_x.data(), m_x.size());
+    auto peak = createPeak();
+    cache.store(0, peak, 1, m_values.data(), m_values.size());
+
+    cache.clear();
+    TS_ASSERT(!cache.find(0, peak));
+  }
+
+private:
+  Mantid::API::IFunction_sptr createPeak() {
+    auto peak = std::make_shared<Gaussian>();
+    peak->initialize();
+    peak->setParameter("Height", 1.0);
+    peak->setParameter("PeakCentre", 2.5);
+    peak->setParameter("Sigma", 0.5);
+    return peak;
+  }
+
+  std::vector<double> m_x;
+  std::vector<double> m_values;
+};
@@ -380,6 +380,17 @@ inline bool TableColumn<Kernel::V3D>::compareVectorsRelError(const std::vector<K
   return true;
 }
 
+/// Strings too long for their own buffer hold their characters on the heap
+template <> inline long int TableColumn<std::string>::sizeOfData() const {
+  const size_t localCapacity = std::string().capacity();
+  size_t dataSize = m_data.size() * sizeof(std::string);
+  for (const auto &str : m_data) {
+    if (str.capacity() > localCapacity)
+      dataSize += str.capacity() + 1;
+  }
+  return static_cast<long int>(dataSize);
+}
+
 /// Template specialization for strings so they can contain spaces
 template <> inline void TableColumn<std::string>::read(size_t index, const std::string &text) {
   /* As opposed to other types, assigning strings via a stream does not work if
@@ -242,20 +242,19 @@ void ScanningWorkspaceBuilder::buildPositions(Geometry::DetectorInfo &outputDete
 }
 
 void ScanningWorkspaceBuilder::buildRelativeRotationsForScans(Geometry::DetectorInfo &outputDetectorInfo) const {
+  // All non-monitor detectors move rigidly, which DetectorInfo stores as one
+  // transformation per time index instead of per detector and time index.
+  std::vector<size_t> detectorIndices;
+  detectorIndices.reserve(outputDetectorInfo.size());
   for (size_t i = 0; i < outputDetectorInfo.size(); ++i) {
-    for (size_t j = 0; j < outputDetectorInfo.scanCount(); ++j) {
-      if (outputDetectorInfo.isMonitor({i, j}))
-        continue;
-      auto position = outputDetectorInfo.position({i, j});
-      const auto rotation = Kernel::Quat(m_instrumentAngles[j], m_rotationAxis);
-      position -= m_rotationPosition;
-      rotation.rotate(position);
-      position += m_rotationPosition;
-      outputDetectorInfo.setPosition({i, j}, position);
-      const auto &oldRotation = outputDetectorInfo.rotation({i, j});
-      outputDetectorInfo.setRotation({i, j}, rotation * oldRotation);
-    }
+    if (!outputDetectorInfo.isMonitor(i))
+      detectorIndices.emplace_back(i);
   }
+  std::vector<Kernel::Quat> rotations;
+  rotations.reserve(m_instrumentAngles.size());
+  for (const auto angle : m_instrumentAngles)
+    rotations.emplace_back(angle, m_rotationAxis);
+  outputDetectorInfo.rotateDetectors(detectorIndices, m_rotationPosition, rotations);
 }
 
 void ScanningWorkspaceBuilder::createTimeOrientedIndexInfo(MatrixWorkspace &ws) const {
@@ -542,7 +542,10 @@ public:
       make_scanning_workspace(100, 50, 100);
   }
 
-  void make_scanning_workspace(size_t nDetectors, size_t nTimeIndexes, size_t nBins) {
+  void test_large_scanning_workspace_with_relative_rotations() { make_scanning_workspace(1000, 500, 1000, true); }
+
+  void make_scanning_workspace(size_t nDetectors, size_t nTimeIndexes, size_t nBins,
+                               const bool relativeRotations = false) {
 
     const auto &instrument = createSimpleInstrument(nDetectors, nTimeIndexes);
 
@@ -553,6 +556,12 @@ public:
 
     auto builder = ScanningWorkspaceBuilder(instrument, nTimeIndexes, nBins);
     builder.setTimeRanges(timeRanges);
+    if (relativeRotations) {
+      std::vector<double> angles(nTimeIndexes);
+      for (size_t i = 0; i < nTimeIndexes; ++i)
+        angles[i] = 0.1 * static_cast<double>(i);
+      builder.setRelativeRotationsForScans(angles, V3D(0, 0, 0), V3D(0, 1, 0));
+    }
     MatrixWorkspace_const_sptr ws;
     ws = builder.buildWorkspace();
   }
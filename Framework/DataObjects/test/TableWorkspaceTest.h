@@ -438,6 +438,25 @@ public:
     TS_ASSERT_DELTA(100, tw.getLogs()->getPropertyValueAsType<double>("SomeDouble"), 1.e-7);
   }
 
+  void test_getMemorySize_counts_every_column() {
+    TableWorkspace tw(100);
+    const size_t empty = tw.getMemorySize();
+    tw.addColumn("double", "a");
+    const size_t oneColumn = tw.getMemorySize();
+    TS_ASSERT_EQUALS(oneColumn, empty + 100 * sizeof(double));
+    tw.addColumn("int", "b");
+    TS_ASSERT_EQUALS(tw.getMemorySize(), oneColumn + 100 * sizeof(int));
+  }
+
+  void test_getMemorySize_counts_long_strings() {
+    TableWorkspace tw(10);
+    auto column = tw.addColumn("str", "a");
+    const size_t shortStrings = tw.getMemorySize();
+    TS_ASSERT_EQUALS(shortStrings, 10 * sizeof(std::string) + tw.getLogs()->getMemorySize());
+    column->cell<std::string>(0) = std::string(1000, 'x');
+    TS_ASSERT_LESS_THAN_EQUALS(shortStrings + 1000, tw.getMemorySize());
+  }
+
   void test_known_to_property_for_unmangling() {
     Mantid::API::WorkspaceProperty<TableWorkspace> property("DummyProperty", "DummyWorkspace",
                                                             Mantid::Kernel::Direction::Input);
@@ -26,6 +26,7 @@ namespace API {
 class SpectrumInfo;
 }
 namespace Geometry {
+class DetectorSpatialIndex;
 class IDetector;
 class Instrument;
 
@@ -93,6 +94,8 @@ public:
   void setPosition(const std::pair<size_t, size_t> &index, const Kernel::V3D &position);
   void setRotation(const size_t index, const Kernel::Quat &rotation);
   void setRotation(const std::pair<size_t, size_t> &index, const Kernel::Quat &rotation);
+  void rotateDetectors(const std::vector<size_t> &detectorIndices, const Kernel::V3D &centre,
+                       const std::vector<Kernel::Quat> &rotations);
 
   const Geometry::IDetector &detector(const size_t index) const;
 
@@ -110,6 +113,8 @@ public:
   size_t scanCount() const;
   const std::vector<std::pair<Types::Core::DateAndTime, Types::Core::DateAndTime>> scanIntervals() const;
 
+  std::shared_ptr<const DetectorSpatialIndex> spatialIndex() const;
+
   friend class API::SpectrumInfo;
   friend class Instrument;
 
@@ -132,6 +137,10 @@ private:
 
   mutable std::vector<std::shared_ptr<const Geometry::IDetector>> m_lastDetector;
   mutable std::vector<size_t> m_lastIndex;
+
+  /// Cached spatial index, rebuilt when the detector positions change
+  mutable std::shared_ptr<const DetectorSpatialIndex> m_spatialIndex;
+  mutable std::mutex m_spatialIndexMutex;
 };
 
 using DetectorInfoIt = DetectorInfoIterator<DetectorInfo>;
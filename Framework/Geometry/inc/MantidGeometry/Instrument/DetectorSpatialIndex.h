@@ -0,0 +1,69 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+
+/** DetectorSpatialIndex : a static KD-tree over the positions of the
+  (non-monitor) detectors of a DetectorInfo supporting radius and k-nearest
+  neighbour queries.
+
+  The tree is stored implicitly: points are permuted so that every subrange
+  [begin, end) is a node whose median element is the splitting point.
+  Queries are const and may be run concurrently.
+
+  Use DetectorInfo::spatialIndex() to obtain an index that is cached and
+  rebuilt automatically when detectors move.
+*/
+class MANTID_GEOMETRY_DLL DetectorSpatialIndex {
+public:
+  /// A query result
+  struct Neighbour {
+    /// Index of the detector in DetectorInfo
+    size_t detectorIndex;
+    /// Distance from the query position
+    double distance;
+  };
+
+  DetectorSpatialIndex(std::vector<Kernel::V3D> positions, std::vector<size_t> detectorIndices,
+                       const uint64_t positionVersion = 0);
+
+  /// Number of indexed detectors
+  size_t size() const { return m_points.size(); }
+  /// Version of the DetectorInfo positions the index was built from
+  uint64_t positionVersion() const { return m_positionVersion; }
+
+  /// All detectors within radius of centre, ordered by distance
+  std::vector<Neighbour> findInRadius(const Kernel::V3D &centre, const double radius) const;
+  /// The k detectors closest to centre, ordered by distance
+  std::vector<Neighbour> findNearest(const Kernel::V3D &centre, const size_t k) const;
+
+private:
+  void build(std::vector<size_t> &order, const size_t begin, const size_t end);
+  void radiusSearch(const size_t begin, const size_t end, const Kernel::V3D &centre, const double radius2,
+                    std::vector<Neighbour> &result) const;
+  void nearestSearch(const size_t begin, const size_t end, const Kernel::V3D &centre, const size_t k,
+                     std::vector<Neighbour> &heap) const;
+
+  /// Detector positions in tree order
+  std::vector<Kernel::V3D> m_points;
+  /// Detector indices in tree order
+  std::vector<size_t> m_detectorIndices;
+  /// Split axis of the node whose median is at the given position
+  std::vector<uint8_t> m_axes;
+  uint64_t m_positionVersion;
+};
+
+} // namespace Geometry
+} // namespace Mantid
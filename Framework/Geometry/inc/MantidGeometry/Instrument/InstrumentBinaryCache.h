@@ -0,0 +1,56 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+
+#include <cstdint>
+#include <string>
+
+namespace Mantid {
+namespace Geometry {
+class Instrument;
+
+/** InstrumentBinaryCache stores a fully built base instrument (component tree,
+  detector and monitor flags, shapes, reference frame, validity range and the
+  parameters collected from the definition) in a versioned binary file so that
+  subsequent sessions can skip parsing the instrument definition XML.
+
+  The file starts with a header holding a magic string, the format version and
+  a key (the mangled instrument name, which already contains the SHA-1 of the
+  IDF contents). The payload is protected by a checksum. On reading the file is
+  memory mapped and every field is bounds checked; any mismatch or corruption
+  makes read() return false so the caller can fall back to the XML parser.
+
+  Only instruments built from plain components, assemblies, object components
+  and detectors with CSG shapes are supported; see canCache().
+*/
+class MANTID_GEOMETRY_DLL InstrumentBinaryCache {
+public:
+  /// Version of the on-disk format. Bump when the layout changes.
+  static constexpr uint32_t FormatVersion = 1;
+  /// File extension used for cache files
+  static const std::string &fileExtension();
+
+  explicit InstrumentBinaryCache(std::string filename);
+
+  /// Whether the given base instrument can be represented in the cache
+  static bool canCache(const Instrument &instrument);
+
+  /// Write the base instrument to the cache file
+  void write(const Instrument &instrument, const std::string &key) const;
+  /// Populate an empty base instrument from the cache file
+  bool read(Instrument &instrument, const std::string &key) const;
+
+  const std::string &filename() const { return m_filename; }
+
+private:
+  std::string m_filename;
+};
+
+} // namespace Geometry
+} // namespace Mantid
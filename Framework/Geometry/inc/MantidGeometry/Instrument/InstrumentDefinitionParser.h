@@ -54,6 +54,9 @@ public:
   /// Parse XML contents
   std::shared_ptr<Instrument> parseXML(Kernel::ProgressBase *progressReporter);
 
+  /// Read the instrument from the binary cache, or parse the XML and write it
+  std::shared_ptr<Instrument> parseXMLWithBinaryCache(Kernel::ProgressBase *progressReporter);
+
   /// Add/overwrite any parameters specified in instrument with param values
   /// specified in <component-link> XML elements
   void setComponentLinks(std::shared_ptr<Geometry::Instrument> &instrument, Poco::XML::Element *pRootElem,
@@ -76,6 +79,9 @@ public:
   /// creates a vtp filename from a given xml filename
   const std::string createVTPFileName();
 
+  /// creates a binary instrument cache filename from a given xml filename
+  const std::string createBinaryCacheFileName();
+
 private:
   /// shared Constructor logic
   void initialise(const std::string &filename, const std::string &instName, const std::string &xmlText,
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "MantidGeometry/DllConfig.h"
+#include <cstdint>
 #include <iomanip>
 #include <memory>
 #include <sstream>
@@ -68,6 +69,8 @@ public:
   virtual std::string getShortDescription() const;
   /// set visibility:
   virtual void setVisible(const bool &visible) { m_visible = visible; }
+  /// Number of in-place changes made to the values of any parameters
+  static uint64_t valueChanges();
   /// Equality operator
   bool operator==(const Parameter &rhs) const {
     if (this->name() == rhs.name() && this->type() == rhs.type() && this->asString() == rhs.asString())
@@ -84,6 +87,8 @@ protected:
       @param t :: Value to set
   */
   template <class T> void set(const T &t);
+  /// Record that the value of a parameter has been changed in place
+  static void recordValueChange();
 
   friend class ParameterFactory;
   /// Constructor
@@ -168,18 +173,25 @@ template <class T> void Parameter::set(const T &t) {
 template <class Type> void ParameterType<Type>::fromString(const std::string &value) {
   std::istringstream istr(value);
   istr >> m_value;
+  recordValueChange();
 }
 
 /**
  * Specialization for a string.
  */
-template <> inline void ParameterType<std::string>::fromString(const std::string &value) { m_value = value; }
+template <> inline void ParameterType<std::string>::fromString(const std::string &value) {
+  m_value = value;
+  recordValueChange();
+}
 
 /** Set the value of the parameter via the assignment operator
  * @tparam The parameter type
  * @param value :: The value of the parameter
  */
-template <class Type> void ParameterType<Type>::setValue(const Type &value) { m_value = value; }
+template <class Type> void ParameterType<Type>::setValue(const Type &value) {
+  m_value = value;
+  recordValueChange();
+}
 
 /** Set the value of the parameter via the assignment operator
  * @param value :: The value of the parameter
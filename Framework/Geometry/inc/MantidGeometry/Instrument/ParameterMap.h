@@ -14,7 +14,9 @@
 
 #include "tbb/concurrent_unordered_map.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <typeinfo>
 #include <vector>
 
@@ -26,6 +28,7 @@ namespace Geometry {
 class ComponentInfo;
 class DetectorInfo;
 class Instrument;
+class ParameterMapSnapshot;
 
 /** @class ParameterMap ParameterMap.h
 
@@ -86,12 +89,15 @@ public:
   inline void clear() {
     m_map.clear();
     clearPositionSensitiveCaches();
+    invalidateSnapshot();
   }
   /// method swaps two parameter maps contents  each other. All caches contents
   /// is nullified (TO DO: it can be efficiently swapped too)
   void swap(ParameterMap &other) {
     m_map.swap(other.m_map);
     clearPositionSensitiveCaches();
+    invalidateSnapshot();
+    other.invalidateSnapshot();
   }
   /// Clear any parameters with the given name
   void clearParametersByName(const std::string &name);
@@ -263,6 +269,11 @@ public:
   void setCachedRotation(const IComponent *comp, const Kernel::Quat &rotation) const;
   /// Attempts to retrieve a rotation from the rotation cache
   bool getCachedRotation(const IComponent *comp, Kernel::Quat &rotation) const;
+  /// Returns an immutable, read-optimised view of the map for lookups from
+  /// parallel loops. Built on first use and rebuilt after every mutation.
+  std::shared_ptr<const ParameterMapSnapshot> snapshot() const;
+  /// Returns the snapshot once repeated lookups pay for building it, or nullptr
+  std::shared_ptr<const ParameterMapSnapshot> snapshotForRepeatedLookups() const;
   /// Persist a representation of the Parameter map to the open Nexus file
   void saveNexus(::NeXus::File *file, const std::string &group) const;
   /// Copy pairs (oldComp->id,Parameter) to the m_map assigning the new
@@ -303,6 +314,10 @@ private:
   /// const version of the internal function to get position of the parameter in
   /// the parameter map
   component_map_cit positionOf(const IComponent *comp, const char *name, const char *type) const;
+  /// Discard the snapshot after a mutation
+  void invalidateSnapshot();
+  /// Version the snapshot is compared against
+  uint64_t version() const;
   /// calculate relative error for use in diff
   bool relErr(double x1, double x2, double errorVal) const;
 
@@ -315,6 +330,16 @@ private:
   std::unique_ptr<Kernel::Cache<const ComponentID, Kernel::V3D>> m_cacheLocMap;
   /// internal cache map instance for cached rotation values
   std::unique_ptr<Kernel::Cache<const ComponentID, Kernel::Quat>> m_cacheRotMap;
+  /// Read-optimised snapshot, published with std::atomic_load/atomic_store
+  mutable std::shared_ptr<const ParameterMapSnapshot> m_snapshot;
+  /// Serialises building the snapshot, readers of a current one do not take it
+  mutable std::mutex m_snapshotMutex;
+  /// Number of mutations of the map
+  std::atomic<uint64_t> m_mutations{0};
+  /// Version at which m_lookupsSinceChange started counting
+  mutable std::atomic<uint64_t> m_lookupVersion{0};
+  /// Lookups through snapshotForRepeatedLookups() since the map last changed
+  mutable std::atomic<size_t> m_lookupsSinceChange{0};
 
   /// Pointer to the DetectorInfo wrapper. NULL unless the instrument is
   /// associated with an ExperimentInfo object.
@@ -0,0 +1,121 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/IComponent.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class ComponentInfo;
+class Parameter;
+class ParameterMap;
+
+/** ParameterMapSnapshot : an immutable, read-optimised view of a ParameterMap.
+
+  Parameter names are interned once so that lookups compare integers instead
+  of strings, and parameters are stored per component index of ComponentInfo in
+  contiguous arrays instead of a hash map keyed by component pointer. Dense
+  per-detector columns of double parameters, resolved recursively up the
+  component tree, are built lazily on first request and are safe to read from
+  parallel loops. The values of double parameters are copied when the snapshot
+  is taken, so the columns are not affected by later changes to the map.
+
+  Parameters attached to components that are not part of the ComponentInfo
+  (e.g. those of a physical instrument) remain accessible via the
+  IComponent based lookups.
+
+  Obtain a snapshot with ParameterMap::snapshot(). The map stops handing out
+  a snapshot once the map is mutated or a parameter value is changed in
+  place, so a snapshot reflects the state of the map at the time it was taken.
+*/
+class MANTID_GEOMETRY_DLL ParameterMapSnapshot {
+public:
+  /// Value returned by nameIndex for names that are not present in the map
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  /// Dense column of a double parameter indexed by detector index
+  class DoubleColumn {
+  public:
+    /// Whether the detector (or any of its parents) has the parameter
+    bool has(const size_t detectorIndex) const { return m_present[detectorIndex] != 0; }
+    /// The value for the detector. Only meaningful if has() is true
+    double value(const size_t detectorIndex) const { return m_values[detectorIndex]; }
+    size_t size() const { return m_values.size(); }
+
+  private:
+    std::vector<double> m_values;
+    std::vector<char> m_present;
+    friend class ParameterMapSnapshot;
+  };
+
+  ParameterMapSnapshot(const ParameterMap &map, const ComponentInfo &componentInfo, const size_t numberOfDetectors);
+  ParameterMapSnapshot(const ParameterMapSnapshot &) = delete;
+  ParameterMapSnapshot &operator=(const ParameterMapSnapshot &) = delete;
+  ~ParameterMapSnapshot();
+
+  /// Interned index of a parameter name (case insensitive), or npos
+  size_t nameIndex(const std::string &name) const;
+  /// Number of distinct parameter names
+  size_t numberOfNames() const { return m_names.size(); }
+
+  /// Parameter attached directly to a component index, or nullptr
+  std::shared_ptr<Parameter> get(const size_t componentIndex, const size_t nameIndex) const;
+  /// Parameter of a component index or its closest parent, or nullptr
+  std::shared_ptr<Parameter> getRecursive(size_t componentIndex, const size_t nameIndex) const;
+  /// Parameter of a component or its closest parent, or nullptr
+  std::shared_ptr<Parameter> getRecursive(const IComponent *comp, const std::string &name) const;
+
+  /// Double parameter resolved recursively for every detector
+  const DoubleColumn &doubleColumn(const size_t nameIndex) const;
+  /// Double parameter resolved recursively for every detector
+  const DoubleColumn &doubleColumn(const std::string &name) const;
+
+private:
+  using Entry = std::pair<size_t, std::shared_ptr<Parameter>>;
+  std::shared_ptr<Parameter> findEntry(const Entry *begin, const Entry *end, const size_t nameIndex) const;
+  std::shared_ptr<Parameter> getUnindexed(const IComponent *comp, const size_t nameIndex) const;
+  void buildDoubleColumn(const size_t nameIndex) const;
+
+  /// Lower case parameter names and their interned index
+  std::unordered_map<std::string, size_t> m_names;
+  /// Parent component index of each component, npos for the root
+  std::vector<size_t> m_parents;
+  /// Component pointer to index, for IComponent based lookups
+  std::unordered_map<ComponentID, size_t> m_componentIndices;
+  /// Offsets into m_entries for each component index (CSR layout)
+  std::vector<size_t> m_offsets;
+  /// Parameters of all indexed components, grouped by component index
+  std::vector<Entry> m_entries;
+  /// Value of each entry of m_entries when the snapshot was taken
+  std::vector<double> m_entryValues;
+  /// Whether each entry of m_entries is a double parameter
+  std::vector<char> m_entryIsDouble;
+  /// Parameters of components that are not part of the ComponentInfo
+  std::unordered_map<ComponentID, std::vector<Entry>> m_unindexed;
+  size_t m_numberOfDetectors;
+  /// Version of the map the snapshot was taken at, see ParameterMap::snapshot()
+  uint64_t m_version = 0;
+
+  /// Lazily built double columns, one per interned name
+  mutable std::vector<std::unique_ptr<DoubleColumn>> m_doubleColumns;
+  mutable std::unique_ptr<std::once_flag[]> m_doubleColumnFlags;
+
+  friend class ParameterMap;
+};
+
+} // namespace Geometry
+} // namespace Mantid
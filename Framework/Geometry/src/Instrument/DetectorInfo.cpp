@@ -11,6 +11,7 @@
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidGeometry/Instrument/DetectorInfoIterator.h"
+#include "MantidGeometry/Instrument/DetectorSpatialIndex.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidKernel/EigenConversionHelpers.h"
 #include "MantidKernel/Exception.h"
@@ -48,7 +49,12 @@ DetectorInfo::DetectorInfo(std::unique_ptr<Beamline::DetectorInfo> detectorInfo,
 DetectorInfo::DetectorInfo(const DetectorInfo &other)
     : m_detectorInfo(std::make_unique<Beamline::DetectorInfo>(*other.m_detectorInfo)), m_instrument(other.m_instrument),
       m_detectorIDs(other.m_detectorIDs), m_detIDToIndex(other.m_detIDToIndex),
-      m_lastDetector(PARALLEL_GET_MAX_THREADS), m_lastIndex(PARALLEL_GET_MAX_THREADS, -1) {}
+      m_lastDetector(PARALLEL_GET_MAX_THREADS), m_lastIndex(PARALLEL_GET_MAX_THREADS, -1) {
+  // The index is immutable and tagged with the version of the positions it
+  // was built from, so sharing it is safe.
+  std::lock_guard<std::mutex> lock(other.m_spatialIndexMutex);
+  m_spatialIndex = other.m_spatialIndex;
+}
 
 /// Assigns the contents of the non-wrapping part of `rhs` to this.
 DetectorInfo &DetectorInfo::operator=(const DetectorInfo &rhs) {
@@ -388,6 +394,31 @@ void DetectorInfo::setRotation(const std::pair<size_t, size_t> &index, const Ker
   m_detectorInfo->setRotation(index, Kernel::toQuaterniond(rotation));
 }
 
+/** Rotate detectors around a centre, with one rotation per time index.
+ *
+ * At each time index the rotation is applied to the current positions and
+ * rotations of the detectors. For scans built by merging identical time
+ * indices this is stored as one transformation per time index rather than a
+ * position and rotation per detector and time index. Not thread safe.
+ *
+ * @param detectorIndices :: Unique indices of the detectors to rotate
+ * @param centre :: Centre of rotation
+ * @param rotations :: Rotation for each time index
+ */
+void DetectorInfo::rotateDetectors(const std::vector<size_t> &detectorIndices, const Kernel::V3D &centre,
+                                   const std::vector<Kernel::Quat> &rotations) {
+  const auto c = Kernel::toVector3d(centre);
+  Beamline::ScanTransforms::Transforms transforms(rotations.size());
+  for (size_t timeIndex = 0; timeIndex < rotations.size(); ++timeIndex) {
+    auto &transform = transforms[timeIndex];
+    transform.rotation = Kernel::toQuaterniond(rotations[timeIndex]).normalized();
+    transform.translation = c - transform.rotation * c;
+  }
+  for (const auto index : detectorIndices)
+    clearPositionDependentParameters(index);
+  m_detectorInfo->transformDetectors(detectorIndices, transforms);
+}
+
 /// Return a const reference to the detector with given index.
 const Geometry::IDetector &DetectorInfo::detector(const size_t index) const { return getDetector(index); }
 
@@ -426,6 +457,33 @@ const std::vector<std::pair<Types::Core::DateAndTime, Types::Core::DateAndTime>>
   return {intervals.begin(), intervals.end()};
 }
 
+/** Returns a spatial index over the positions of all non-monitor detectors.
+ *
+ * The index is built on first use and cached. It is rebuilt on the next call
+ * after any detector has been moved, including moves of parent components via
+ * ComponentInfo. Holding on to the returned index is safe, but it will not
+ * reflect subsequent moves. Not supported for scanning instruments. */
+std::shared_ptr<const DetectorSpatialIndex> DetectorInfo::spatialIndex() const {
+  if (isScanning())
+    throw std::runtime_error("DetectorInfo::spatialIndex is not supported for scanning instruments");
+  const auto version = m_detectorInfo->positionVersion();
+  std::lock_guard<std::mutex> lock(m_spatialIndexMutex);
+  if (!m_spatialIndex || m_spatialIndex->positionVersion() != version) {
+    std::vector<Kernel::V3D> positions;
+    std::vector<size_t> indices;
+    positions.reserve(size());
+    indices.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+      if (isMonitor(i))
+        continue;
+      positions.emplace_back(position(i));
+      indices.emplace_back(i);
+    }
+    m_spatialIndex = std::make_shared<const DetectorSpatialIndex>(std::move(positions), std::move(indices), version);
+  }
+  return m_spatialIndex;
+}
+
 const DetectorInfoConstIt DetectorInfo::cbegin() const { return DetectorInfoConstIt(*this, 0, size()); }
 
 const DetectorInfoConstIt DetectorInfo::cend() const { return DetectorInfoConstIt(*this, size(), size()); }
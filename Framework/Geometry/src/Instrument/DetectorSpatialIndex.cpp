@@ -0,0 +1,187 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Instrument/DetectorSpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace Mantid::Geometry {
+using Kernel::V3D;
+
+namespace {
+/// Nodes with at most this many points are searched linearly
+constexpr size_t LEAF_SIZE = 8;
+
+double distanceSquared(const V3D &a, const V3D &b) {
+  const auto d = a - b;
+  return d.norm2();
+}
+
+bool closer(const DetectorSpatialIndex::Neighbour &a, const DetectorSpatialIndex::Neighbour &b) {
+  return a.distance < b.distance || (a.distance == b.distance && a.detectorIndex < b.detectorIndex);
+}
+} // namespace
+
+/**
+ * Index an arbitrary set of positions
+ * @param positions :: Positions to index
+ * @param detectorIndices :: Detector index reported for each position
+ * @param positionVersion :: Version of the source positions, see
+ * Beamline::DetectorInfo::positionVersion
+ */
+DetectorSpatialIndex::DetectorSpatialIndex(std::vector<V3D> positions, std::vector<size_t> detectorIndices,
+                                           const uint64_t positionVersion)
+    : m_points(std::move(positions)), m_detectorIndices(std::move(detectorIndices)), m_axes(m_points.size(), 0),
+      m_positionVersion(positionVersion) {
+  if (m_points.size() != m_detectorIndices.size())
+    throw std::invalid_argument("DetectorSpatialIndex: positions and detector indices must have the same size");
+  std::vector<size_t> order(m_points.size());
+  std::iota(order.begin(), order.end(), 0);
+  build(order, 0, order.size());
+  // Store the points in tree order
+  std::vector<V3D> points;
+  std::vector<size_t> indices;
+  points.reserve(order.size());
+  indices.reserve(order.size());
+  for (const auto i : order) {
+    points.emplace_back(m_points[i]);
+    indices.emplace_back(m_detectorIndices[i]);
+  }
+  m_points = std::move(points);
+  m_detectorIndices = std::move(indices);
+}
+
+/// Recursively partition order[begin, end) around the median of its widest
+/// axis
+void DetectorSpatialIndex::build(std::vector<size_t> &order, const size_t begin, const size_t end) {
+  if (end - begin <= LEAF_SIZE)
+    return;
+  V3D low(m_points[order[begin]]);
+  V3D high(low);
+  for (size_t i = begin + 1; i < end; ++i) {
+    const auto &point = m_points[order[i]];
+    for (size_t axis = 0; axis < 3; ++axis) {
+      low[axis] = std::min(low[axis], point[axis]);
+      high[axis] = std::max(high[axis], point[axis]);
+    }
+  }
+  const auto extent = high - low;
+  uint8_t axis = 0;
+  if (extent[1] > extent[axis])
+    axis = 1;
+  if (extent[2] > extent[axis])
+    axis = 2;
+
+  const auto mid = begin + (end - begin) / 2;
+  std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                   [this, axis](const size_t a, const size_t b) { return m_points[a][axis] < m_points[b][axis]; });
+  m_axes[mid] = axis;
+  build(order, begin, mid);
+  build(order, mid + 1, end);
+}
+
+/**
+ * @param centre :: Query position
+ * @param radius :: Search radius. Detectors at exactly this distance are
+ * included.
+ * @return All indexed detectors within radius of centre, closest first
+ */
+std::vector<DetectorSpatialIndex::Neighbour> DetectorSpatialIndex::findInRadius(const V3D &centre,
+                                                                                const double radius) const {
+  if (radius < 0.0)
+    throw std::invalid_argument("DetectorSpatialIndex::findInRadius: radius must not be negative");
+  std::vector<Neighbour> result;
+  radiusSearch(0, m_points.size(), centre, radius * radius, result);
+  for (auto &neighbour : result)
+    neighbour.distance = std::sqrt(neighbour.distance);
+  std::sort(result.begin(), result.end(), closer);
+  return result;
+}
+
+/**
+ * @param centre :: Query position
+ * @param k :: Number of detectors to find
+ * @return The min(k, size()) indexed detectors closest to centre, closest
+ * first. Ties are broken by detector index.
+ */
+std::vector<DetectorSpatialIndex::Neighbour> DetectorSpatialIndex::findNearest(const V3D &centre,
+                                                                               const size_t k) const {
+  std::vector<Neighbour> heap;
+  if (k == 0)
+    return heap;
+  heap.reserve(k + 1);
+  nearestSearch(0, m_points.size(), centre, k, heap);
+  std::sort_heap(heap.begin(), heap.end(), closer);
+  for (auto &neighbour : heap)
+    neighbour.distance = std::sqrt(neighbour.distance);
+  return heap;
+}
+
+// Distances are kept squared during the search
+void DetectorSpatialIndex::radiusSearch(const size_t begin, const size_t end, const V3D &centre,
+                                        const double radius2, std::vector<Neighbour> &result) const {
+  if (end - begin <= LEAF_SIZE) {
+    for (size_t i = begin; i < end; ++i) {
+      const auto d2 = distanceSquared(m_points[i], centre);
+      if (d2 <= radius2)
+        result.emplace_back(Neighbour{m_detectorIndices[i], d2});
+    }
+    return;
+  }
+  const auto mid = begin + (end - begin) / 2;
+  const auto axis = m_axes[mid];
+  const auto d2 = distanceSquared(m_points[mid], centre);
+  if (d2 <= radius2)
+    result.emplace_back(Neighbour{m_detectorIndices[mid], d2});
+  const auto delta = centre[axis] - m_points[mid][axis];
+  if (delta <= 0.0 || delta * delta <= radius2)
+    radiusSearch(begin, mid, centre, radius2, result);
+  if (delta >= 0.0 || delta * delta <= radius2)
+    radiusSearch(mid + 1, end, centre, radius2, result);
+}
+
+// heap is a max-heap on distance holding the best candidates found so far
+void DetectorSpatialIndex::nearestSearch(const size_t begin, const size_t end, const V3D &centre, const size_t k,
+                                         std::vector<Neighbour> &heap) const {
+  const auto consider = [&](const size_t i) {
+    const Neighbour candidate{m_detectorIndices[i], distanceSquared(m_points[i], centre)};
+    if (heap.size() < k) {
+      heap.emplace_back(candidate);
+      std::push_heap(heap.begin(), heap.end(), closer);
+    } else if (closer(candidate, heap.front())) {
+      std::pop_heap(heap.begin(), heap.end(), closer);
+      heap.back() = candidate;
+      std::push_heap(heap.begin(), heap.end(), closer);
+    }
+  };
+  if (end - begin <= LEAF_SIZE) {
+    for (size_t i = begin; i < end; ++i)
+      consider(i);
+    return;
+  }
+  const auto mid = begin + (end - begin) / 2;
+  const auto axis = m_axes[mid];
+  consider(mid);
+  const auto delta = centre[axis] - m_points[mid][axis];
+  const bool leftFirst = delta <= 0.0;
+  // Search the side containing centre first, then the other side only if it
+  // can hold a closer point than the current worst candidate
+  if (leftFirst)
+    nearestSearch(begin, mid, centre, k, heap);
+  else
+    nearestSearch(mid + 1, end, centre, k, heap);
+  if (heap.size() < k || delta * delta <= heap.front().distance) {
+    if (leftFirst)
+      nearestSearch(mid + 1, end, centre, k, heap);
+    else
+      nearestSearch(begin, mid, centre, k, heap);
+  }
+}
+
+} // namespace Mantid::Geometry
@@ -0,0 +1,634 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Instrument/InstrumentBinaryCache.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/CompAssembly.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/ObjComponent.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidKernel/Interpolation.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/Quat.h"
+#include "MantidKernel/V3D.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/SharedMemory.h>
+#include <Poco/TemporaryFile.h>
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Mantid::Geometry {
+namespace {
+/// static logger
+Kernel::Logger g_log("InstrumentBinaryCache");
+
+constexpr char MAGIC[8] = {'M', 'T', 'D', 'I', 'N', 'S', 'T', 'C'};
+/// Written in native byte order; a file produced on a machine with a different
+/// byte order is rejected
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/// Component kinds that can be stored in the cache
+enum class Kind : uint8_t { Component = 0, Assembly = 1, ObjComponent = 2, Detector = 3 };
+
+/// Flags stored per component
+enum Flags : uint8_t { IsMonitor = 1, IsSource = 2, IsSample = 4 };
+
+/// Index of the instrument itself in the component table
+constexpr uint64_t ROOT_INDEX = 0;
+constexpr int64_t NO_SHAPE = -1;
+
+/// 64 bit FNV-1a hash used to detect truncated or corrupted payloads
+uint64_t fnv1a(const char *data, size_t size) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/// Returns the cache kind of a component or false if it cannot be cached
+bool kindOf(const IComponent &comp, Kind &kind) {
+  const auto type = comp.type();
+  if (type == "LogicalComponent")
+    kind = Kind::Component;
+  else if (type == "CompAssembly")
+    kind = Kind::Assembly;
+  else if (type == "PhysicalComponent")
+    kind = Kind::ObjComponent;
+  else if (type == "DetectorComponent")
+    kind = Kind::Detector;
+  else
+    return false;
+  return true;
+}
+
+uint8_t axisOf(const Kernel::V3D &vec) {
+  if (vec.X() != 0.)
+    return X;
+  if (vec.Y() != 0.)
+    return Y;
+  return Z;
+}
+
+/// Append-only serialisation buffer
+class Writer {
+public:
+  template <typename T> void put(const T &value) {
+    m_buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+  void put(const std::string &value) {
+    put(static_cast<uint64_t>(value.size()));
+    m_buffer.append(value);
+  }
+  void put(const Kernel::V3D &value) {
+    put(value.X());
+    put(value.Y());
+    put(value.Z());
+  }
+  void put(const Kernel::Quat &value) {
+    put(value.real());
+    put(value.imagI());
+    put(value.imagJ());
+    put(value.imagK());
+  }
+  const std::string &buffer() const { return m_buffer; }
+
+private:
+  std::string m_buffer;
+};
+
+/// Bounds checked reader over a (memory mapped) byte range
+class Reader {
+public:
+  Reader(const char *begin, const char *end) : m_pos(begin), m_end(end) {}
+  template <typename T> T get() {
+    require(sizeof(T));
+    T value;
+    std::memcpy(&value, m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return value;
+  }
+  std::string getString() {
+    const auto size = get<uint64_t>();
+    require(size);
+    std::string value(m_pos, size);
+    m_pos += size;
+    return value;
+  }
+  Kernel::V3D getV3D() {
+    const auto x = get<double>();
+    const auto y = get<double>();
+    const auto z = get<double>();
+    return Kernel::V3D(x, y, z);
+  }
+  Kernel::Quat getQuat() {
+    const auto w = get<double>();
+    const auto a = get<double>();
+    const auto b = get<double>();
+    const auto c = get<double>();
+    return Kernel::Quat(w, a, b, c);
+  }
+  /// Number of elements of the given size that could still be read. Used to
+  /// reject absurd counts before reserving memory.
+  uint64_t checkCount(uint64_t count, size_t minElementSize) const {
+    if (count > static_cast<uint64_t>(m_end - m_pos) / minElementSize)
+      throw std::runtime_error("Element count exceeds cache size");
+    return count;
+  }
+  const char *position() const { return m_pos; }
+  bool atEnd() const { return m_pos == m_end; }
+
+private:
+  void require(uint64_t size) const {
+    if (size > static_cast<uint64_t>(m_end - m_pos))
+      throw std::runtime_error("Unexpected end of instrument cache");
+  }
+  const char *m_pos;
+  const char *m_end;
+};
+
+struct ComponentRecord {
+  Kind kind;
+  uint64_t parent;
+  std::string name;
+  Kernel::V3D position;
+  Kernel::Quat rotation;
+  int64_t shape;
+  detid_t id;
+  uint8_t flags;
+};
+
+/// Fields of an XMLInstrumentParameter, with the component replaced by its index
+struct ParameterRecord {
+  uint64_t component;
+  std::string logfileID;
+  std::string value;
+  std::string interpolation;
+  std::string formula;
+  std::string formulaUnit;
+  std::string resultUnit;
+  std::string paramName;
+  std::string type;
+  std::string tie;
+  std::vector<std::string> constraint;
+  std::string penaltyFactor;
+  std::string fitFunc;
+  std::string extractSingleValueAs;
+  std::string eq;
+  double angleConvertConst;
+  std::string description;
+  std::string visible;
+};
+
+/// Decoded contents of a cache file, fully validated before it is applied
+struct CacheContents {
+  std::string name;
+  std::string defaultView;
+  std::string defaultViewAxis;
+  Kernel::V3D position;
+  Kernel::Quat rotation;
+  int64_t validFrom;
+  int64_t validTo;
+  uint8_t up, alongBeam, thetaSign, handedness;
+  std::string origin;
+  std::map<std::string, std::string> logfileUnits;
+  std::vector<std::pair<std::string, std::string>> shapes;
+  std::vector<ComponentRecord> components;
+  std::vector<ParameterRecord> parameters;
+};
+
+CacheContents decode(Reader &in) {
+  CacheContents contents;
+  contents.name = in.getString();
+  contents.defaultView = in.getString();
+  contents.defaultViewAxis = in.getString();
+  contents.position = in.getV3D();
+  contents.rotation = in.getQuat();
+  contents.validFrom = in.get<int64_t>();
+  contents.validTo = in.get<int64_t>();
+  contents.up = in.get<uint8_t>();
+  contents.alongBeam = in.get<uint8_t>();
+  contents.thetaSign = in.get<uint8_t>();
+  contents.handedness = in.get<uint8_t>();
+  if (contents.up > Z || contents.alongBeam > Z || contents.thetaSign > Z || contents.handedness > Right)
+    throw std::runtime_error("Invalid reference frame");
+  contents.origin = in.getString();
+
+  const auto nUnits = in.checkCount(in.get<uint64_t>(), 2 * sizeof(uint64_t));
+  for (uint64_t i = 0; i < nUnits; ++i) {
+    auto key = in.getString();
+    contents.logfileUnits[key] = in.getString();
+  }
+
+  const auto nShapes = in.checkCount(in.get<uint64_t>(), 2 * sizeof(uint64_t));
+  contents.shapes.reserve(nShapes);
+  for (uint64_t i = 0; i < nShapes; ++i) {
+    auto id = in.getString();
+    contents.shapes.emplace_back(std::move(id), in.getString());
+  }
+
+  const auto nComponents = in.checkCount(in.get<uint64_t>(), sizeof(uint64_t));
+  contents.components.reserve(nComponents);
+  for (uint64_t i = 0; i < nComponents; ++i) {
+    ComponentRecord record;
+    const auto kind = in.get<uint8_t>();
+    if (kind > static_cast<uint8_t>(Kind::Detector))
+      throw std::runtime_error("Invalid component kind");
+    record.kind = static_cast<Kind>(kind);
+    record.parent = in.get<uint64_t>();
+    // Parents always precede their children; index 0 is the instrument
+    if (record.parent > i ||
+        (record.parent != ROOT_INDEX && contents.components[record.parent - 1].kind != Kind::Assembly))
+      throw std::runtime_error("Invalid component parent");
+    record.name = in.getString();
+    record.position = in.getV3D();
+    record.rotation = in.getQuat();
+    record.shape = in.get<int64_t>();
+    if (record.shape < NO_SHAPE || record.shape >= static_cast<int64_t>(nShapes))
+      throw std::runtime_error("Invalid shape index");
+    record.id = in.get<detid_t>();
+    record.flags = in.get<uint8_t>();
+    contents.components.emplace_back(std::move(record));
+  }
+
+  const auto nParameters = in.checkCount(in.get<uint64_t>(), sizeof(uint64_t));
+  contents.parameters.reserve(nParameters);
+  for (uint64_t i = 0; i < nParameters; ++i) {
+    ParameterRecord record;
+    record.component = in.get<uint64_t>();
+    if (record.component > nComponents)
+      throw std::runtime_error("Invalid parameter component");
+    record.logfileID = in.getString();
+    record.value = in.getString();
+    record.interpolation = in.getString();
+    record.formula = in.getString();
+    record.formulaUnit = in.getString();
+    record.resultUnit = in.getString();
+    record.paramName = in.getString();
+    record.type = in.getString();
+    record.tie = in.getString();
+    const auto nConstraints = in.checkCount(in.get<uint64_t>(), sizeof(uint64_t));
+    for (uint64_t j = 0; j < nConstraints; ++j)
+      record.constraint.emplace_back(in.getString());
+    record.penaltyFactor = in.getString();
+    record.fitFunc = in.getString();
+    record.extractSingleValueAs = in.getString();
+    record.eq = in.getString();
+    record.angleConvertConst = in.get<double>();
+    record.description = in.getString();
+    record.visible = in.getString();
+    contents.parameters.emplace_back(std::move(record));
+  }
+  if (!in.atEnd())
+    throw std::runtime_error("Trailing data in instrument cache");
+  return contents;
+}
+
+/// Build the component tree and populate the instrument from decoded contents
+void apply(const CacheContents &contents, Instrument &instrument) {
+  ShapeFactory shapeFactory;
+  std::vector<std::shared_ptr<IObject>> shapes;
+  shapes.reserve(contents.shapes.size());
+  for (const auto &[id, xml] : contents.shapes) {
+    auto shape = xml.empty() ? std::make_shared<CSGObject>() : shapeFactory.createShape(xml, false);
+    shape->setID(id);
+    shapes.emplace_back(std::move(shape));
+  }
+
+  std::vector<IComponent *> components{&instrument};
+  std::vector<CompAssembly *> assemblies{&instrument};
+  components.reserve(contents.components.size() + 1);
+  assemblies.reserve(contents.components.size() + 1);
+  std::vector<const IDetector *> monitors;
+  const IComponent *source = nullptr;
+  const IComponent *sample = nullptr;
+  for (const auto &record : contents.components) {
+    auto *parent = assemblies[record.parent];
+    auto shape = record.shape == NO_SHAPE ? std::shared_ptr<IObject>() : shapes[record.shape];
+    Component *comp = nullptr;
+    CompAssembly *assembly = nullptr;
+    switch (record.kind) {
+    case Kind::Component:
+      comp = new Component(record.name, parent);
+      break;
+    case Kind::Assembly:
+      comp = assembly = new CompAssembly(record.name, parent);
+      break;
+    case Kind::ObjComponent:
+      comp = new ObjComponent(record.name, shape, parent);
+      break;
+    case Kind::Detector: {
+      auto *det = new Detector(record.name, record.id, shape, parent);
+      if (record.flags & IsMonitor)
+        monitors.emplace_back(det);
+      else
+        instrument.markAsDetectorIncomplete(det);
+      comp = det;
+      break;
+    }
+    }
+    parent->add(comp);
+    comp->setPos(record.position);
+    comp->setRot(record.rotation);
+    if (record.flags & IsSource)
+      source = comp;
+    if (record.flags & IsSample)
+      sample = comp;
+    components.emplace_back(comp);
+    assemblies.emplace_back(assembly);
+  }
+  instrument.setPos(contents.position);
+  instrument.setRot(contents.rotation);
+  instrument.markAsDetectorFinalize();
+  for (const auto *monitor : monitors)
+    instrument.markAsMonitor(monitor);
+  if (source)
+    instrument.markAsSource(source);
+  if (sample)
+    instrument.markAsSamplePos(sample);
+
+  instrument.setValidFromDate(Types::Core::DateAndTime(contents.validFrom));
+  instrument.setValidToDate(Types::Core::DateAndTime(contents.validTo));
+  instrument.setDefaultView(contents.defaultView);
+  instrument.setDefaultViewAxis(contents.defaultViewAxis);
+  instrument.setReferenceFrame(std::make_shared<ReferenceFrame>(
+      static_cast<PointingAlong>(contents.up), static_cast<PointingAlong>(contents.alongBeam),
+      static_cast<PointingAlong>(contents.thetaSign), static_cast<Handedness>(contents.handedness), contents.origin));
+  instrument.getLogfileUnit() = contents.logfileUnits;
+
+  auto &logfileCache = instrument.getLogfileCache();
+  for (auto param : contents.parameters) {
+    auto interpolation = std::make_shared<Kernel::Interpolation>();
+    if (!param.interpolation.empty()) {
+      std::istringstream interpolationStream(param.interpolation);
+      interpolationStream >> *interpolation;
+    }
+    const auto *comp = components[param.component];
+    auto xmlParam = std::make_shared<XMLInstrumentParameter>(
+        param.logfileID, param.value, interpolation, param.formula, param.formulaUnit, param.resultUnit,
+        param.paramName, param.type, param.tie, param.constraint, param.penaltyFactor, param.fitFunc,
+        param.extractSingleValueAs, param.eq, comp, param.angleConvertConst, param.description, param.visible);
+    logfileCache.emplace(std::make_pair(param.paramName, comp), std::move(xmlParam));
+  }
+}
+} // namespace
+
+/// File extension used for cache files
+const std::string &InstrumentBinaryCache::fileExtension() {
+  static const std::string extension(".instcache");
+  return extension;
+}
+
+/** Constructor
+ * @param filename :: Full path of the cache file to read or write
+ */
+InstrumentBinaryCache::InstrumentBinaryCache(std::string filename) : m_filename(std::move(filename)) {}
+
+/** Check whether a base instrument can be stored in the cache. Instruments
+ * with specialised assemblies (rectangular, grid and structured detectors,
+ * ObjCompAssembly), mesh shapes, side-by-side view positions or a separate
+ * physical instrument are not supported.
+ * @param instrument :: The base instrument
+ * @return True if write() would produce a complete cache
+ */
+bool InstrumentBinaryCache::canCache(const Instrument &instrument) {
+  if (instrument.isParametrized() || instrument.getPhysicalInstrument())
+    return false;
+  std::vector<IComponent_const_sptr> children;
+  instrument.getChildren(children, true);
+  for (const auto &child : children) {
+    Kind kind;
+    if (!kindOf(*child, kind) || child->getSideBySideViewPos())
+      return false;
+    if (const auto *obj = dynamic_cast<const ObjComponent *>(child.get())) {
+      const auto shape = obj->shape();
+      if (shape && !std::dynamic_pointer_cast<const CSGObject>(shape))
+        return false;
+    }
+  }
+  return true;
+}
+
+/** Write the base instrument to the cache file. The file is written next to
+ * its final location and renamed into place so concurrent readers never see
+ * a partially written cache.
+ * @param instrument :: The base instrument, canCache() must return true
+ * @param key :: Key identifying the instrument definition, e.g. its mangled name
+ */
+void InstrumentBinaryCache::write(const Instrument &instrument, const std::string &key) const {
+  if (!canCache(instrument))
+    throw std::invalid_argument("Instrument " + instrument.getName() + " cannot be stored in a binary cache");
+
+  Writer payload;
+  payload.put(instrument.getName());
+  payload.put(instrument.getDefaultView());
+  payload.put(instrument.getDefaultAxis());
+  payload.put(instrument.getRelativePos());
+  payload.put(instrument.getRelativeRot());
+  payload.put(instrument.getValidFromDate().totalNanoseconds());
+  payload.put(instrument.getValidToDate().totalNanoseconds());
+  const auto frame = instrument.getReferenceFrame();
+  payload.put(static_cast<uint8_t>(frame->pointingUp()));
+  payload.put(static_cast<uint8_t>(frame->pointingAlongBeam()));
+  payload.put(axisOf(frame->vecThetaSign()));
+  payload.put(static_cast<uint8_t>(frame->getHandedness()));
+  payload.put(frame->origin());
+
+  const auto &units = instrument.getLogfileUnit();
+  payload.put(static_cast<uint64_t>(units.size()));
+  for (const auto &[unitKey, unit] : units) {
+    payload.put(unitKey);
+    payload.put(unit);
+  }
+
+  // Depth-first traversal so that parents always precede their children
+  std::vector<IComponent_const_sptr> children;
+  instrument.getChildren(children, true);
+  std::unordered_map<const IComponent *, uint64_t> indices{{instrument.getComponentID(), ROOT_INDEX}};
+  std::unordered_map<const IObject *, int64_t> shapeIndices;
+  std::vector<std::shared_ptr<const CSGObject>> shapes;
+  Writer components;
+  components.put(static_cast<uint64_t>(children.size()));
+  const auto source = instrument.getSource();
+  const auto sample = instrument.getSample();
+  for (const auto &child : children) {
+    Kind kind;
+    kindOf(*child, kind);
+    const auto parent = indices.at(child->getParent()->getComponentID());
+    indices.emplace(child->getComponentID(), indices.size());
+
+    int64_t shapeIndex = NO_SHAPE;
+    detid_t id = 0;
+    uint8_t flags = 0;
+    if (const auto *obj = dynamic_cast<const ObjComponent *>(child.get())) {
+      if (auto shape = std::dynamic_pointer_cast<const CSGObject>(obj->shape())) {
+        const auto inserted = shapeIndices.emplace(shape.get(), static_cast<int64_t>(shapes.size()));
+        if (inserted.second)
+          shapes.emplace_back(std::move(shape));
+        shapeIndex = inserted.first->second;
+      }
+    }
+    if (const auto *det = dynamic_cast<const Detector *>(child.get())) {
+      id = det->getID();
+      if (instrument.isMonitor(id))
+        flags |= IsMonitor;
+    }
+    if (source && source->getComponentID() == child->getComponentID())
+      flags |= IsSource;
+    if (sample && sample->getComponentID() == child->getComponentID())
+      flags |= IsSample;
+
+    components.put(static_cast<uint8_t>(kind));
+    components.put(parent);
+    components.put(child->getName());
+    components.put(child->getRelativePos());
+    components.put(child->getRelativeRot());
+    components.put(shapeIndex);
+    components.put(id);
+    components.put(flags);
+  }
+
+  payload.put(static_cast<uint64_t>(shapes.size()));
+  for (const auto &shape : shapes) {
+    payload.put(shape->id());
+    payload.put(shape->getShapeXML());
+  }
+  const auto &componentBuffer = components.buffer();
+  std::string payloadBuffer = payload.buffer() + componentBuffer;
+
+  Writer parameters;
+  const auto &logfileCache = instrument.getLogfileCache();
+  parameters.put(static_cast<uint64_t>(logfileCache.size()));
+  for (const auto &item : logfileCache) {
+    const auto &param = *item.second;
+    const auto index = indices.find(param.m_component);
+    if (index == indices.end())
+      throw std::runtime_error("Parameter " + param.m_paramName + " is attached to a component outside the instrument");
+    parameters.put(index->second);
+    parameters.put(param.m_logfileID);
+    parameters.put(param.m_value);
+    std::ostringstream interpolation;
+    if (param.m_interpolation)
+      interpolation << std::setprecision(std::numeric_limits<double>::max_digits10) << *param.m_interpolation;
+    parameters.put(interpolation.str());
+    parameters.put(param.m_formula);
+    parameters.put(param.m_formulaUnit);
+    parameters.put(param.m_resultUnit);
+    parameters.put(param.m_paramName);
+    parameters.put(param.m_type);
+    parameters.put(param.m_tie);
+    parameters.put(static_cast<uint64_t>(param.m_constraint.size()));
+    for (const auto &constraint : param.m_constraint)
+      parameters.put(constraint);
+    parameters.put(param.m_penaltyFactor);
+    parameters.put(param.m_fittingFunction);
+    parameters.put(param.m_extractSingleValueAs);
+    parameters.put(param.m_eq);
+    parameters.put(param.m_angleConvertConst);
+    parameters.put(param.m_description);
+    parameters.put(param.m_visible);
+  }
+  payloadBuffer += parameters.buffer();
+
+  Writer header;
+  header.put(MAGIC);
+  header.put(FormatVersion);
+  header.put(BYTE_ORDER_MARK);
+  header.put(key);
+  header.put(static_cast<uint64_t>(payloadBuffer.size()));
+  header.put(fnv1a(payloadBuffer.data(), payloadBuffer.size()));
+
+  // Write to a name unique to this process and call, in the same directory, so
+  // that concurrent writers never share a partial file and the rename is atomic
+  const std::string partial = Poco::TemporaryFile::tempName(Poco::Path(m_filename).parent().toString());
+  try {
+    {
+      std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+      out.write(header.buffer().data(), header.buffer().size());
+      out.write(payloadBuffer.data(), payloadBuffer.size());
+      if (!out)
+        throw std::runtime_error("Failed to write instrument cache " + partial);
+    }
+    Poco::File(partial).renameTo(m_filename);
+  } catch (...) {
+    Poco::File partialFile(partial);
+    if (partialFile.exists())
+      partialFile.remove();
+    throw;
+  }
+  g_log.debug() << "Wrote instrument cache " << m_filename << " (" << children.size() << " components)\n";
+}
+
+/** Populate an empty base instrument from the cache file. The file is memory
+ * mapped and fully decoded and validated before anything is added to the
+ * instrument, so on failure the instrument is left untouched.
+ * @param instrument :: An empty, non-parametrized instrument
+ * @param key :: Key that the cache must have been written with
+ * @return True if the instrument was populated from the cache
+ */
+bool InstrumentBinaryCache::read(Instrument &instrument, const std::string &key) const {
+  if (instrument.isParametrized() || instrument.nelements() != 0)
+    throw std::invalid_argument("InstrumentBinaryCache::read requires an empty base instrument");
+
+  Poco::File file(m_filename);
+  if (!file.exists() || file.getSize() == 0)
+    return false;
+
+  CacheContents contents;
+  try {
+    Poco::SharedMemory mapping(file, Poco::SharedMemory::AM_READ);
+    Reader in(mapping.begin(), mapping.end());
+    char magic[sizeof(MAGIC)];
+    for (auto &c : magic)
+      c = in.get<char>();
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+      throw std::runtime_error("Not an instrument cache file");
+    const auto version = in.get<uint32_t>();
+    if (version != FormatVersion)
+      throw std::runtime_error("Unsupported cache version " + std::to_string(version));
+    if (in.get<uint32_t>() != BYTE_ORDER_MARK)
+      throw std::runtime_error("Cache written with a different byte order");
+    if (in.getString() != key)
+      throw std::runtime_error("Cache key does not match the instrument definition");
+    const auto payloadSize = in.get<uint64_t>();
+    const auto checksum = in.get<uint64_t>();
+    const char *payloadBegin = in.position();
+    if (payloadSize != static_cast<uint64_t>(mapping.end() - payloadBegin))
+      throw std::runtime_error("Cache size does not match its header");
+    if (checksum != fnv1a(payloadBegin, payloadSize))
+      throw std::runtime_error("Cache checksum mismatch");
+    Reader payload(payloadBegin, mapping.end());
+    contents = decode(payload);
+  } catch (std::exception &e) {
+    g_log.information() << "Ignoring instrument cache " << m_filename << ": " << e.what() << '\n';
+    return false;
+  }
+  if (contents.name != instrument.getName()) {
+    g_log.information() << "Ignoring instrument cache " << m_filename << ": it holds instrument " << contents.name
+                        << '\n';
+    return false;
+  }
+  apply(contents, instrument);
+  g_log.debug() << "Read instrument cache " << m_filename << " (" << contents.components.size() << " components)\n";
+  return true;
+}
+
+} // namespace Mantid::Geometry
@@ -8,6 +8,7 @@
 #include <sstream>
 
 #include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/InstrumentBinaryCache.h"
 #include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
 #include "MantidGeometry/Instrument/ObjCompAssembly.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
@@ -279,6 +280,41 @@ Instrument_sptr InstrumentDefinitionParser::parseXML(Kernel::ProgressBase *progr
   return m_instrument;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Create the instrument from the binary instrument cache if a valid cache
+ * exists for this definition, otherwise fully parse the XML contents and write
+ * the cache for subsequent sessions. The cache is used only if the
+ * instrumentDefinition.binarycache configuration key is On.
+ *
+ * @param progressReporter :: Optional Progress reporter object. If NULL, no
+ * progress reporting.
+ * @return the instrument that was created
+ */
+Instrument_sptr InstrumentDefinitionParser::parseXMLWithBinaryCache(Kernel::ProgressBase *progressReporter) {
+  const bool useCache =
+      ConfigService::Instance().getValue<bool>("instrumentDefinition.binarycache").get_value_or(false);
+  const std::string cacheFile = useCache ? createBinaryCacheFileName() : std::string();
+  if (cacheFile.empty())
+    return parseXML(progressReporter);
+
+  const std::string key = getMangledName();
+  InstrumentBinaryCache cache(cacheFile);
+  if (cache.read(*m_instrument, key)) {
+    g_log.information() << "Loaded instrument " << m_instName << " from binary cache " << cacheFile << '\n';
+    return m_instrument;
+  }
+
+  auto instrument = parseXML(progressReporter);
+  if (InstrumentBinaryCache::canCache(*instrument)) {
+    try {
+      cache.write(*instrument, key);
+    } catch (std::exception &e) {
+      g_log.warning() << "Unable to write binary instrument cache " << cacheFile << ": " << e.what() << '\n';
+    }
+  }
+  return instrument;
+}
+
 /**
  * Collect some information about types for later use including:
  * - populate directory getTypeElement
@@ -2978,6 +3014,23 @@ const std::string InstrumentDefinitionParser::createVTPFileName() {
   return retVal;
 }
 
+/** Generates a binary instrument cache filename from a xml filename
+ *
+ *  @return The cache filename
+ *
+ */
+const std::string InstrumentDefinitionParser::createBinaryCacheFileName() {
+  std::string retVal;
+  std::string filename = getMangledName();
+  if (!filename.empty()) {
+    Poco::Path path(ConfigService::Instance().getVTPFileDirectory());
+    path.makeDirectory();
+    path.append(filename + InstrumentBinaryCache::fileExtension());
+    retVal = path.toString();
+  }
+  return retVal;
+}
+
 /** Return a subelement of an XML element, but also checks that there exist
  *exactly one entry
  *  of this subelement.
@@ -10,6 +10,7 @@
 #include "MantidKernel/Quat.h"
 #include "MantidKernel/RegistrationHelper.h"
 #include "MantidKernel/V3D.h"
+#include <atomic>
 #include <sstream>
 
 /* Register classes into the factory
@@ -22,6 +23,20 @@
   }
 
 namespace Mantid::Geometry {
+namespace {
+/// Counts the in-place changes to parameter values, see Parameter::valueChanges()
+std::atomic<uint64_t> g_valueChanges{0};
+} // namespace
+
+/** The number of times the value of any parameter has been changed in place
+ * (via fromString or ParameterMap) since start up. Views holding copies of
+ * parameter values compare it to tell whether they are still current.
+ * @returns The number of changes
+ */
+uint64_t Parameter::valueChanges() { return g_valueChanges.load(std::memory_order_acquire); }
+
+/// Increments the count returned by valueChanges()
+void Parameter::recordValueChange() { g_valueChanges.fetch_add(1, std::memory_order_acq_rel); }
 
 /** Return the value of the parameter as a string
  * @tparam T The type of the parameter
@@ -11,8 +11,10 @@
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidGeometry/Instrument/ParComponentFactory.h"
 #include "MantidGeometry/Instrument/ParameterFactory.h"
+#include "MantidGeometry/Instrument/ParameterMapSnapshot.h"
 #include "MantidKernel/Cache.h"
 #include "MantidKernel/MultiThreaded.h"
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <cstring>
 #include <nexus/NeXusFile.hpp>
@@ -51,6 +53,10 @@ const std::string SCALE_PARAM_NAME = "sca";
 // static logger reference
 Kernel::Logger g_log("ParameterMap");
 
+// snapshotForRepeatedLookups() builds a snapshot once the lookups since the last
+// change reach the number of detectors divided by this
+constexpr size_t DETECTORS_PER_SNAPSHOT_LOOKUP = 16;
+
 void checkIsNotMaskingParameter(const std::string &name) {
   if (name == std::string("masked"))
     throw std::runtime_error("Masking data (\"masked\") cannot be stored in "
@@ -303,6 +309,7 @@ void ParameterMap::clearParametersByName(const std::string &name) {
       ++itr;
     }
   }
+  invalidateSnapshot();
   // Check if the caches need invalidating
   if (name == pos() || name == rot())
     clearPositionSensitiveCaches();
@@ -325,6 +332,7 @@ void ParameterMap::clearParametersByName(const std::string &name, const ICompone
         ++it;
       }
     }
+    invalidateSnapshot();
 
     // Check if the caches need invalidating
     if (name == pos() || name == rot())
@@ -386,6 +394,9 @@ void ParameterMap::add(const IComponent *comp, const std::shared_ptr<Parameter>
     m_map.insert(std::make_pair(comp->getComponentID(), par));
 #endif
   }
+  // Only after the change, so that a snapshot built concurrently with it is
+  // not left in place
+  invalidateSnapshot();
 }
 
 /** Create or adjust "pos" parameter for a component
@@ -596,6 +607,7 @@ void ParameterMap::forceUnsafeSetMasked(const IComponent *comp, bool value) {
 #else
   m_map.insert(std::make_pair(comp->getComponentID(), param));
 #endif
+  invalidateSnapshot();
 }
 
 /**
@@ -955,6 +967,60 @@ void ParameterMap::clearPositionSensitiveCaches() {
   m_cacheRotMap->clear();
 }
 
+/**
+ * Return a read-optimised snapshot of the map. The snapshot is built on the
+ * first call and shared by subsequent callers until the map is modified or the
+ * value of a parameter is changed in place. Readers of a current snapshot do
+ * not take a lock. Requires the map to be associated with an instrument.
+ * @returns The snapshot
+ */
+std::shared_ptr<const ParameterMapSnapshot> ParameterMap::snapshot() const {
+  auto current = std::atomic_load(&m_snapshot);
+  if (current && current->m_version == version())
+    return current;
+  // Only one thread builds, the others wait for it and share the result
+  std::lock_guard<std::mutex> lock(m_snapshotMutex);
+  const auto builtAt = version();
+  current = std::atomic_load(&m_snapshot);
+  if (current && current->m_version == builtAt)
+    return current;
+  auto built = std::make_shared<ParameterMapSnapshot>(*this, componentInfo(), detectorInfo().size());
+  // A change made during the build leaves a version that does not match,
+  // so the snapshot is rebuilt on the next call
+  built->m_version = builtAt;
+  current = std::move(built);
+  std::atomic_store(&m_snapshot, current);
+  return current;
+}
+
+/**
+ * Return the snapshot if it is current or once the lookups made since the map
+ * last changed are enough to pay for building it, otherwise nullptr. Use this
+ * for lookups that may be interleaved with changes to the map, where the
+ * caller falls back to searching the map itself.
+ * @returns The snapshot or nullptr
+ */
+std::shared_ptr<const ParameterMapSnapshot> ParameterMap::snapshotForRepeatedLookups() const {
+  const auto current = version();
+  if (auto existing = std::atomic_load(&m_snapshot); existing && existing->m_version == current)
+    return existing;
+  if (m_lookupVersion.exchange(current) != current)
+    m_lookupsSinceChange = 0;
+  const auto threshold = std::max<size_t>(1, detectorInfo().size() / DETECTORS_PER_SNAPSHOT_LOOKUP);
+  if (++m_lookupsSinceChange < threshold)
+    return nullptr;
+  return snapshot();
+}
+
+/// Version of the map and its parameter values, changed by every mutation
+uint64_t ParameterMap::version() const { return m_mutations.load() + Parameter::valueChanges(); }
+
+/// Discards the snapshot so that the next call to snapshot() rebuilds it
+void ParameterMap::invalidateSnapshot() {
+  ++m_mutations;
+  std::atomic_store(&m_snapshot, std::shared_ptr<const ParameterMapSnapshot>());
+}
+
 /// Sets a cached location on the location cache
 /// @param comp :: The Component to set the location of
 /// @param location :: The location
@@ -994,7 +1060,6 @@ bool ParameterMap::getCachedRotation(const IComponent *comp, Quat &rotation) con
  */
 void ParameterMap::copyFromParameterMap(const IComponent *oldComp, const IComponent *newComp,
                                         const ParameterMap *oldPMap) {
-
   auto oldParameterNames = oldPMap->names(oldComp);
   for (const auto &oldParameterName : oldParameterNames) {
     Parameter_sptr thisParameter = oldPMap->get(oldComp, oldParameterName);
@@ -1005,6 +1070,7 @@ void ParameterMap::copyFromParameterMap(const IComponent *oldComp, const ICompon
     m_map.insert(std::make_pair(newComp->getComponentID(), std::move(thisParameter)));
 #endif
   }
+  invalidateSnapshot();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1110,6 +1176,7 @@ void ParameterMap::setInstrument(const Instrument *instrument) {
   if (!instrument) {
     m_componentInfo = nullptr;
     m_detectorInfo = nullptr;
+    invalidateSnapshot();
     return;
   }
   if (m_instrument)
@@ -1120,6 +1187,7 @@ void ParameterMap::setInstrument(const Instrument *instrument) {
                            "base instrument, not a parametrized instrument");
   m_instrument = instrument;
   std::tie(m_componentInfo, m_detectorInfo) = m_instrument->makeBeamline(*this);
+  invalidateSnapshot();
 }
 
 } // namespace Mantid::Geometry
@@ -0,0 +1,207 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Instrument/ParameterMapSnapshot.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Instrument/Parameter.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+namespace Mantid::Geometry {
+
+/**
+ * Build the snapshot
+ * @param map :: The parameter map to take a snapshot of
+ * @param componentInfo :: ComponentInfo of the instrument the map belongs to
+ * @param numberOfDetectors :: Number of detectors, i.e. the size of the
+ * detector columns
+ */
+ParameterMapSnapshot::ParameterMapSnapshot(const ParameterMap &map, const ComponentInfo &componentInfo,
+                                           const size_t numberOfDetectors)
+    : m_parents(componentInfo.size(), npos), m_offsets(componentInfo.size() + 1, 0),
+      m_numberOfDetectors(numberOfDetectors) {
+  const auto nComponents = componentInfo.size();
+  m_componentIndices.reserve(nComponents);
+  for (size_t i = 0; i < nComponents; ++i) {
+    m_componentIndices.emplace(const_cast<IComponent *>(componentInfo.componentID(i)), i);
+    if (componentInfo.hasParent(i))
+      m_parents[i] = componentInfo.parent(i);
+  }
+
+  // Intern names and sort the parameters into buckets by component index
+  std::vector<size_t> entryComponent;
+  entryComponent.reserve(map.size());
+  std::vector<Entry> entries;
+  entries.reserve(map.size());
+  for (const auto &item : map) {
+    const auto param = std::atomic_load(&item.second);
+    if (!param || !item.first)
+      continue;
+    const auto name = boost::algorithm::to_lower_copy(param->name());
+    const auto interned = m_names.emplace(name, m_names.size()).first->second;
+    const auto index = m_componentIndices.find(item.first);
+    if (index == m_componentIndices.end()) {
+      m_unindexed[item.first].emplace_back(interned, param);
+    } else {
+      entryComponent.emplace_back(index->second);
+      entries.emplace_back(interned, param);
+      ++m_offsets[index->second + 1];
+    }
+  }
+  for (size_t i = 0; i < nComponents; ++i)
+    m_offsets[i + 1] += m_offsets[i];
+  m_entries.resize(entries.size());
+  m_entryValues.resize(entries.size(), 0.0);
+  m_entryIsDouble.resize(entries.size(), 0);
+  auto next = m_offsets;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const auto position = next[entryComponent[i]]++;
+    // Parameter objects are shared with the map and may be changed in place
+    // later on, so the values for the columns are taken now
+    if (entries[i].second->type() == ParameterMap::pDouble()) {
+      m_entryValues[position] = entries[i].second->value<double>();
+      m_entryIsDouble[position] = 1;
+    }
+    m_entries[position] = std::move(entries[i]);
+  }
+
+  m_doubleColumns.resize(m_names.size());
+  m_doubleColumnFlags = std::make_unique<std::once_flag[]>(m_names.size());
+}
+
+// Defined in source for forward declaration of Parameter
+ParameterMapSnapshot::~ParameterMapSnapshot() = default;
+
+/**
+ * @param name :: A parameter name. The lookup is case insensitive, like the
+ * lookups of ParameterMap.
+ * @return The interned index of the name or npos if no component has a
+ * parameter with this name
+ */
+size_t ParameterMapSnapshot::nameIndex(const std::string &name) const {
+  const auto it = m_names.find(boost::algorithm::to_lower_copy(name));
+  return it == m_names.end() ? npos : it->second;
+}
+
+std::shared_ptr<Parameter> ParameterMapSnapshot::findEntry(const Entry *begin, const Entry *end,
+                                                           const size_t nameIndex) const {
+  for (auto it = begin; it != end; ++it) {
+    if (it->first == nameIndex)
+      return it->second;
+  }
+  return nullptr;
+}
+
+/**
+ * @param componentIndex :: Index of the component in ComponentInfo
+ * @param nameIndex :: Interned name index
+ * @return The parameter attached to the component or nullptr
+ */
+std::shared_ptr<Parameter> ParameterMapSnapshot::get(const size_t componentIndex, const size_t nameIndex) const {
+  if (nameIndex == npos)
+    return nullptr;
+  return findEntry(m_entries.data() + m_offsets[componentIndex], m_entries.data() + m_offsets[componentIndex + 1],
+                   nameIndex);
+}
+
+/**
+ * @param componentIndex :: Index of the component in ComponentInfo
+ * @param nameIndex :: Interned name index
+ * @return The parameter of the component or its closest parent that has one,
+ * or nullptr
+ */
+std::shared_ptr<Parameter> ParameterMapSnapshot::getRecursive(size_t componentIndex, const size_t nameIndex) const {
+  if (nameIndex == npos)
+    return nullptr;
+  while (componentIndex != npos) {
+    if (auto param = get(componentIndex, nameIndex))
+      return param;
+    componentIndex = m_parents[componentIndex];
+  }
+  return nullptr;
+}
+
+std::shared_ptr<Parameter> ParameterMapSnapshot::getUnindexed(const IComponent *comp, const size_t nameIndex) const {
+  const auto it = m_unindexed.find(comp->getComponentID());
+  if (it == m_unindexed.end())
+    return nullptr;
+  const auto &entries = it->second;
+  return findEntry(entries.data(), entries.data() + entries.size(), nameIndex);
+}
+
+/**
+ * Equivalent of ParameterMap::getRecursive. Components that are not part of
+ * the ComponentInfo are looked up by pointer, walking the parents of the
+ * component until an indexed one is found.
+ * @param comp :: The component to start the search with
+ * @param name :: Parameter name
+ * @return The first matching parameter or nullptr
+ */
+std::shared_ptr<Parameter> ParameterMapSnapshot::getRecursive(const IComponent *comp, const std::string &name) const {
+  const auto interned = nameIndex(name);
+  if (interned == npos || !comp)
+    return nullptr;
+  std::shared_ptr<const IComponent> compInFocus(comp, NoDeleting());
+  while (compInFocus) {
+    const auto index = m_componentIndices.find(compInFocus->getComponentID());
+    if (index != m_componentIndices.end())
+      return getRecursive(index->second, interned);
+    if (auto param = getUnindexed(compInFocus.get(), interned))
+      return param;
+    compInFocus = compInFocus->getParent();
+  }
+  return nullptr;
+}
+
+/**
+ * Return the values of a double parameter for every detector, resolved
+ * recursively. The column is built on the first call for each name; building
+ * is thread safe.
+ * @param nameIndex :: Interned name index
+ * @return The column
+ */
+const ParameterMapSnapshot::DoubleColumn &ParameterMapSnapshot::doubleColumn(const size_t nameIndex) const {
+  if (nameIndex >= m_doubleColumns.size())
+    throw std::out_of_range("ParameterMapSnapshot::doubleColumn: invalid parameter name index");
+  std::call_once(m_doubleColumnFlags[nameIndex], &ParameterMapSnapshot::buildDoubleColumn, this, nameIndex);
+  return *m_doubleColumns[nameIndex];
+}
+
+/**
+ * @param name :: Parameter name
+ * @return The column
+ * @throws std::out_of_range if no component has a parameter with this name
+ */
+const ParameterMapSnapshot::DoubleColumn &ParameterMapSnapshot::doubleColumn(const std::string &name) const {
+  const auto interned = nameIndex(name);
+  if (interned == npos)
+    throw std::out_of_range("ParameterMapSnapshot::doubleColumn: no parameter named " + name);
+  return doubleColumn(interned);
+}
+
+void ParameterMapSnapshot::buildDoubleColumn(const size_t nameIndex) const {
+  auto column = std::make_unique<DoubleColumn>();
+  column->m_values.resize(m_numberOfDetectors, 0.0);
+  column->m_present.resize(m_numberOfDetectors, 0);
+  for (size_t i = 0; i < m_numberOfDetectors; ++i) {
+    // Same semantics as ParameterMap::getRecursive with type "double"
+    for (auto index = i; index != npos && !column->m_present[i]; index = m_parents[index]) {
+      for (auto entry = m_offsets[index]; entry != m_offsets[index + 1]; ++entry) {
+        if (m_entries[entry].first != nameIndex)
+          continue;
+        if (m_entryIsDouble[entry]) {
+          column->m_values[i] = m_entryValues[entry];
+          column->m_present[i] = 1;
+        }
+        break;
+      }
+    }
+  }
+  m_doubleColumns[nameIndex] = std::move(column);
+}
+
+} // namespace Mantid::Geometry
@@ -0,0 +1,175 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidFrameworkTestHelpers/ComponentCreationHelper.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/DetectorSpatialIndex.h"
+#include "MantidGeometry/Instrument/InstrumentVisitor.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::V3D;
+
+class DetectorSpatialIndexTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static DetectorSpatialIndexTest *createSuite() { return new DetectorSpatialIndexTest(); }
+  static void destroySuite(DetectorSpatialIndexTest *suite) { delete suite; }
+
+  void setUp() override {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    m_positions.clear();
+    m_indices.clear();
+    for (size_t i = 0; i < 500; ++i) {
+      m_positions.emplace_back(dist(gen), dist(gen), 0.1 * dist(gen));
+      m_indices.emplace_back(2 * i);
+    }
+  }
+
+  void test_mismatched_sizes_throw() {
+    TS_ASSERT_THROWS(DetectorSpatialIndex({V3D(0, 0, 0)}, {}), const std::invalid_argument &);
+  }
+
+  void test_empty_index() {
+    DetectorSpatialIndex index({}, {});
+    TS_ASSERT_EQUALS(index.size(), 0);
+    TS_ASSERT(index.findInRadius(V3D(0, 0, 0), 1.0).empty());
+    TS_ASSERT(index.findNearest(V3D(0, 0, 0), 3).empty());
+  }
+
+  void test_negative_radius_throws() {
+    DetectorSpatialIndex index({V3D(0, 0, 0)}, {0});
+    TS_ASSERT_THROWS(index.findInRadius(V3D(0, 0, 0), -1.0), const std::invalid_argument &);
+  }
+
+  void test_findInRadius_matches_brute_force() {
+    DetectorSpatialIndex index(m_positions, m_indices);
+    TS_ASSERT_EQUALS(index.size(), m_positions.size());
+    for (const auto radius : {0.0, 0.05, 0.2, 3.0}) {
+      for (const auto &centre : {m_positions[0], m_positions[123], V3D(0.5, -0.5, 0.0), V3D(5, 5, 5)}) {
+        const auto expected = bruteForce(centre);
+        std::vector<DetectorSpatialIndex::Neighbour> inRadius;
+        std::copy_if(expected.begin(), expected.end(), std::back_inserter(inRadius),
+                     [radius](const auto &neighbour) { return neighbour.distance <= radius; });
+        assertSame(index.findInRadius(centre, radius), inRadius);
+      }
+    }
+  }
+
+  void test_findNearest_matches_brute_force() {
+    DetectorSpatialIndex index(m_positions, m_indices);
+    for (const size_t k : {1, 8, 50, 1000}) {
+      for (const auto &centre : {m_positions[7], V3D(0.1, 0.2, 0.0), V3D(-3, 0, 0)}) {
+        auto expected = bruteForce(centre);
+        expected.resize(std::min(k, expected.size()));
+        assertSame(index.findNearest(centre, k), expected);
+      }
+    }
+    TS_ASSERT(index.findNearest(V3D(0, 0, 0), 0).empty());
+  }
+
+  void test_duplicate_positions_are_ordered_by_index() {
+    DetectorSpatialIndex index(std::vector<V3D>(20, V3D(1, 1, 1)), {19, 18, 17, 16, 15, 14, 13, 12, 11, 10,
+                                                                     9,  8,  7,  6,  5,  4,  3,  2,  1,  0});
+    const auto nearest = index.findNearest(V3D(1, 1, 1), 3);
+    TS_ASSERT_EQUALS(nearest.size(), 3);
+    for (size_t i = 0; i < nearest.size(); ++i) {
+      TS_ASSERT_EQUALS(nearest[i].detectorIndex, i);
+      TS_ASSERT_EQUALS(nearest[i].distance, 0.0);
+    }
+    TS_ASSERT_EQUALS(index.findInRadius(V3D(1, 1, 1), 0.0).size(), 20);
+  }
+
+  void test_detector_info_index_excludes_monitors() {
+    auto instrument = ComponentCreationHelper::createTestInstrumentRectangular(2, 4, 0.008, 5.0, true);
+    auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    const auto &detectorInfo = *wrappers.second;
+    const auto index = detectorInfo.spatialIndex();
+    size_t monitors = 0;
+    for (size_t i = 0; i < detectorInfo.size(); ++i)
+      monitors += detectorInfo.isMonitor(i) ? 1 : 0;
+    TS_ASSERT_DIFFERS(monitors, 0);
+    TS_ASSERT_EQUALS(index->size(), detectorInfo.size() - monitors);
+    for (const auto &neighbour : index->findInRadius(V3D(0, 0, 0), 1000.0))
+      TS_ASSERT(!detectorInfo.isMonitor(neighbour.detectorIndex));
+
+    const auto nearest = index->findNearest(detectorInfo.position(3), 1);
+    TS_ASSERT_EQUALS(nearest.size(), 1);
+    TS_ASSERT_EQUALS(nearest[0].detectorIndex, 3);
+  }
+
+  void test_detector_info_index_is_cached_and_rebuilt_after_moves() {
+    auto instrument = ComponentCreationHelper::createTestInstrumentRectangular(1, 4);
+    auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    auto &componentInfo = *wrappers.first;
+    auto &detectorInfo = *wrappers.second;
+
+    const auto first = detectorInfo.spatialIndex();
+    TS_ASSERT_EQUALS(detectorInfo.spatialIndex(), first);
+
+    const V3D target(100, 100, 100);
+    detectorInfo.setPosition(5, target);
+    const auto second = detectorInfo.spatialIndex();
+    TS_ASSERT_DIFFERS(second, first);
+    TS_ASSERT_EQUALS(second->findNearest(target, 1)[0].detectorIndex, 5);
+    // The old index is untouched
+    TS_ASSERT_DIFFERS(first->findNearest(target, 1)[0].detectorIndex, 5);
+
+    // Moving the bank moves all of its detectors
+    const auto bank = componentInfo.parent(0);
+    const auto offset = V3D(-50, 0, 0);
+    componentInfo.setPosition(bank, componentInfo.position(bank) + offset);
+    const auto third = detectorInfo.spatialIndex();
+    TS_ASSERT_DIFFERS(third, second);
+    TS_ASSERT_EQUALS(third->findNearest(detectorInfo.position(0), 1)[0].detectorIndex, 0);
+    TS_ASSERT_EQUALS(third->findInRadius(detectorInfo.position(0), 0.0).size(), 1);
+  }
+
+  void test_copied_detector_info_shares_index_until_moved() {
+    auto instrument = ComponentCreationHelper::createTestInstrumentRectangular(1, 4);
+    auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    const auto &detectorInfo = *wrappers.second;
+    const auto index = detectorInfo.spatialIndex();
+
+    DetectorInfo copy(detectorInfo);
+    TS_ASSERT_EQUALS(copy.spatialIndex(), index);
+    copy.setPosition(0, V3D(7, 7, 7));
+    TS_ASSERT_DIFFERS(copy.spatialIndex(), index);
+    TS_ASSERT_EQUALS(detectorInfo.spatialIndex(), index);
+  }
+
+private:
+  std::vector<DetectorSpatialIndex::Neighbour> bruteForce(const V3D &centre) const {
+    std::vector<DetectorSpatialIndex::Neighbour> result;
+    for (size_t i = 0; i < m_positions.size(); ++i)
+      result.emplace_back(DetectorSpatialIndex::Neighbour{m_indices[i], m_positions[i].distance(centre)});
+    std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+      return a.distance < b.distance || (a.distance == b.distance && a.detectorIndex < b.detectorIndex);
+    });
+    return result;
+  }
+
+  void assertSame(const std::vector<DetectorSpatialIndex::Neighbour> &actual,
+                  const std::vector<DetectorSpatialIndex::Neighbour> &expected) const {
+    TS_ASSERT_EQUALS(actual.size(), expected.size());
+    for (size_t i = 0; i < std::min(actual.size(), expected.size()); ++i) {
+      TS_ASSERT_EQUALS(actual[i].detectorIndex, expected[i].detectorIndex);
+      TS_ASSERT_DELTA(actual[i].distance, expected[i].distance, 1e-12);
+    }
+  }
+
+  std::vector<V3D> m_positions;
+  std::vector<size_t> m_indices;
+};
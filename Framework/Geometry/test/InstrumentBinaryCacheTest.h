@@ -0,0 +1,234 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidFrameworkTestHelpers/ComponentCreationHelper.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/InstrumentBinaryCache.h"
+#include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Strings.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::ConfigService;
+using Mantid::Kernel::V3D;
+
+class InstrumentBinaryCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static InstrumentBinaryCacheTest *createSuite() { return new InstrumentBinaryCacheTest(); }
+  static void destroySuite(InstrumentBinaryCacheTest *suite) { delete suite; }
+
+  InstrumentBinaryCacheTest()
+      : m_idf(ConfigService::Instance().getInstrumentDirectory() + "/unit_testing/IDF_for_UNIT_TESTING2.xml"),
+        m_cacheFile(Poco::Path(ConfigService::Instance().getTempDir())
+                        .append("InstrumentBinaryCacheTest" + InstrumentBinaryCache::fileExtension())
+                        .toString()) {}
+
+  void tearDown() override {
+    Poco::File cache(m_cacheFile);
+    if (cache.exists())
+      cache.remove();
+  }
+
+  void test_round_trip_reproduces_parsed_instrument() {
+    auto parser = makeParser();
+    const auto parsed = parser.parseXML(nullptr);
+    const auto key = parser.getMangledName();
+    TS_ASSERT(InstrumentBinaryCache::canCache(*parsed));
+    InstrumentBinaryCache cache(m_cacheFile);
+    TS_ASSERT_THROWS_NOTHING(cache.write(*parsed, key));
+
+    auto cached = std::make_shared<Instrument>(parsed->getName());
+    TS_ASSERT(cache.read(*cached, key));
+
+    TS_ASSERT_EQUALS(cached->getValidFromDate(), parsed->getValidFromDate());
+    TS_ASSERT_EQUALS(cached->getValidToDate(), parsed->getValidToDate());
+    TS_ASSERT_EQUALS(cached->getDefaultView(), parsed->getDefaultView());
+    TS_ASSERT_EQUALS(cached->getReferenceFrame()->pointingUp(), parsed->getReferenceFrame()->pointingUp());
+    TS_ASSERT_EQUALS(cached->getReferenceFrame()->pointingAlongBeam(),
+                     parsed->getReferenceFrame()->pointingAlongBeam());
+
+    TS_ASSERT_EQUALS(cached->getSource()->getName(), parsed->getSource()->getName());
+    TS_ASSERT_EQUALS(cached->getSource()->getPos(), parsed->getSource()->getPos());
+    TS_ASSERT_EQUALS(cached->getSample()->getPos(), parsed->getSample()->getPos());
+
+    const auto detIDs = parsed->getDetectorIDs();
+    TS_ASSERT_EQUALS(cached->getDetectorIDs(), detIDs);
+    TS_ASSERT_EQUALS(cached->getMonitors(), parsed->getMonitors());
+    for (const auto id : detIDs) {
+      const auto expected = parsed->getDetector(id);
+      const auto actual = cached->getDetector(id);
+      TS_ASSERT_EQUALS(actual->getFullName(), expected->getFullName());
+      TS_ASSERT_DELTA(actual->getPos().distance(expected->getPos()), 0.0, 1e-12);
+      TS_ASSERT_EQUALS(actual->getRotation(), expected->getRotation());
+      TS_ASSERT_EQUALS(actual->shape()->getBoundingBox().width(), expected->shape()->getBoundingBox().width());
+    }
+
+    const auto expectedParams = logfileParameters(*parsed);
+    TS_ASSERT(!expectedParams.empty());
+    TS_ASSERT_EQUALS(logfileParameters(*cached), expectedParams);
+  }
+
+  void test_parser_uses_cache_on_second_load() {
+    auto &config = ConfigService::Instance();
+    const auto previous = config.getString("instrumentDefinition.binarycache");
+    config.setString("instrumentDefinition.binarycache", "On");
+    auto first = makeParser();
+    const auto cacheFile = first.createBinaryCacheFileName();
+    if (Poco::File(cacheFile).exists())
+      Poco::File(cacheFile).remove();
+    const auto parsed = first.parseXMLWithBinaryCache(nullptr);
+    TS_ASSERT(Poco::File(cacheFile).exists());
+
+    auto second = makeParser();
+    const auto cached = second.parseXMLWithBinaryCache(nullptr);
+    TS_ASSERT_EQUALS(cached->getDetectorIDs(), parsed->getDetectorIDs());
+    TS_ASSERT_EQUALS(cached->getFilename(), parsed->getFilename());
+    Poco::File(cacheFile).remove();
+    config.setString("instrumentDefinition.binarycache", previous);
+  }
+
+  void test_parser_does_not_write_cache_when_switched_off() {
+    auto &config = ConfigService::Instance();
+    const auto previous = config.getString("instrumentDefinition.binarycache");
+    config.setString("instrumentDefinition.binarycache", "Off");
+    auto parser = makeParser();
+    const auto cacheFile = parser.createBinaryCacheFileName();
+    if (Poco::File(cacheFile).exists())
+      Poco::File(cacheFile).remove();
+    TS_ASSERT(parser.parseXMLWithBinaryCache(nullptr));
+    TS_ASSERT(!Poco::File(cacheFile).exists());
+    config.setString("instrumentDefinition.binarycache", previous);
+  }
+
+  void test_read_rejects_different_key() {
+    writeCache("key1");
+    Instrument instrument(makeParser().parseXML(nullptr)->getName());
+    TS_ASSERT(!InstrumentBinaryCache(m_cacheFile).read(instrument, "key2"));
+    TS_ASSERT_EQUALS(instrument.nelements(), 0);
+  }
+
+  void test_read_rejects_corrupted_payload() {
+    const auto name = writeCache("key");
+    {
+      std::fstream file(m_cacheFile, std::ios::in | std::ios::out | std::ios::binary);
+      file.seekp(-10, std::ios::end);
+      file.put('X');
+    }
+    Instrument instrument(name);
+    TS_ASSERT(!InstrumentBinaryCache(m_cacheFile).read(instrument, "key"));
+    TS_ASSERT_EQUALS(instrument.nelements(), 0);
+  }
+
+  void test_read_rejects_truncated_file() {
+    const auto name = writeCache("key");
+    const auto contents = Mantid::Kernel::Strings::loadFile(m_cacheFile);
+    {
+      std::ofstream file(m_cacheFile, std::ios::binary | std::ios::trunc);
+      file.write(contents.data(), contents.size() / 2);
+    }
+    Instrument instrument(name);
+    TS_ASSERT(!InstrumentBinaryCache(m_cacheFile).read(instrument, "key"));
+  }
+
+  void test_concurrent_writers_do_not_corrupt_the_cache() {
+    Poco::Path directory(ConfigService::Instance().getTempDir());
+    directory.makeDirectory().pushDirectory("InstrumentBinaryCacheTestDir");
+    Poco::File(directory).createDirectories();
+    const auto cacheName = "cache" + InstrumentBinaryCache::fileExtension();
+    const auto cacheFile = Poco::Path(directory).setFileName(cacheName).toString();
+    const auto instrument = makeParser().parseXML(nullptr);
+    auto writeRepeatedly = [&](const std::string &key) {
+      for (int i = 0; i < 10; ++i)
+        InstrumentBinaryCache(cacheFile).write(*instrument, key);
+    };
+    std::thread first(writeRepeatedly, "key1");
+    std::thread second(writeRepeatedly, "key2");
+    first.join();
+    second.join();
+
+    Instrument fromFirst(instrument->getName()), fromSecond(instrument->getName());
+    TS_ASSERT(InstrumentBinaryCache(cacheFile).read(fromFirst, "key1") ||
+              InstrumentBinaryCache(cacheFile).read(fromSecond, "key2"));
+    // No partial files are left behind
+    std::vector<std::string> files;
+    Poco::File(directory).list(files);
+    TS_ASSERT_EQUALS(files, std::vector<std::string>{cacheName});
+    Poco::File(directory).remove(true);
+  }
+
+  void test_read_missing_file_returns_false() {
+    Instrument instrument("missing");
+    TS_ASSERT(!InstrumentBinaryCache(m_cacheFile).read(instrument, "key"));
+  }
+
+  void test_read_requires_empty_instrument() {
+    writeCache("key");
+    auto instrument = ComponentCreationHelper::createTestInstrumentCylindrical(1);
+    TS_ASSERT_THROWS(InstrumentBinaryCache(m_cacheFile).read(*instrument, "key"), const std::invalid_argument &);
+  }
+
+  void test_cannot_cache_rectangular_detectors() {
+    const auto instrument = ComponentCreationHelper::createTestInstrumentRectangular(1, 4);
+    TS_ASSERT(!InstrumentBinaryCache::canCache(*instrument));
+    TS_ASSERT_THROWS(InstrumentBinaryCache(m_cacheFile).write(*instrument, "key"), const std::invalid_argument &);
+  }
+
+  void test_can_cache_cylindrical_test_instrument() {
+    const auto instrument = ComponentCreationHelper::createTestInstrumentCylindrical(2);
+    TS_ASSERT(InstrumentBinaryCache::canCache(*instrument));
+    InstrumentBinaryCache cache(m_cacheFile);
+    cache.write(*instrument, "key");
+    Instrument cached(instrument->getName());
+    TS_ASSERT(cache.read(cached, "key"));
+    TS_ASSERT_EQUALS(cached.getNumberDetectors(), instrument->getNumberDetectors());
+    TS_ASSERT_EQUALS(cached.getPos(), instrument->getPos());
+    TS_ASSERT_EQUALS(cached.getDetector(10)->getPos(), instrument->getDetector(10)->getPos());
+    TS_ASSERT_EQUALS(cached.getSample()->getName(), "sample");
+  }
+
+private:
+  InstrumentDefinitionParser makeParser() const {
+    return InstrumentDefinitionParser(m_idf, "For Unit Testing2", Mantid::Kernel::Strings::loadFile(m_idf));
+  }
+
+  /// The logfile parameters as "name|component|value|type", sorted. The
+  /// cache is keyed by component pointer so its order differs between
+  /// instruments.
+  static std::vector<std::string> logfileParameters(const Instrument &instrument) {
+    std::vector<std::string> parameters;
+    for (const auto &item : instrument.getLogfileCache()) {
+      const auto &param = *item.second;
+      parameters.emplace_back(param.m_paramName + "|" + param.m_component->getFullName() + "|" + param.m_value + "|" +
+                              param.m_type);
+    }
+    std::sort(parameters.begin(), parameters.end());
+    return parameters;
+  }
+
+  std::string writeCache(const std::string &key) const {
+    const auto instrument = makeParser().parseXML(nullptr);
+    InstrumentBinaryCache(m_cacheFile).write(*instrument, key);
+    return instrument->getName();
+  }
+
+  const std::string m_idf;
+  const std::string m_cacheFile;
+};
@@ -0,0 +1,201 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidFrameworkTestHelpers/ComponentCreationHelper.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/Parameter.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidGeometry/Instrument/ParameterMapSnapshot.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <cxxtest/TestSuite.h>
+
+using namespace Mantid::Geometry;
+
+class ParameterMapSnapshotTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ParameterMapSnapshotTest *createSuite() { return new ParameterMapSnapshotTest(); }
+  static void destroySuite(ParameterMapSnapshotTest *suite) { delete suite; }
+
+  void setUp() override {
+    m_baseInstrument = ComponentCreationHelper::createTestInstrumentCylindrical(2);
+    m_pmap = std::make_shared<ParameterMap>();
+    m_pmap->setInstrument(m_baseInstrument.get());
+    m_bank1 = m_baseInstrument->getComponentByName("bank1").get();
+    m_bank2 = m_baseInstrument->getComponentByName("bank2").get();
+  }
+
+  void test_snapshot_requires_instrument() {
+    ParameterMap pmap;
+    TS_ASSERT_THROWS(pmap.snapshot(), const std::runtime_error &);
+  }
+
+  void test_snapshot_is_shared_until_mutation() {
+    m_pmap->addDouble(m_bank1, "Efixed", 1.5);
+    const auto first = m_pmap->snapshot();
+    TS_ASSERT_EQUALS(m_pmap->snapshot(), first);
+    m_pmap->addDouble(m_bank1, "Efixed", 2.5);
+    const auto second = m_pmap->snapshot();
+    TS_ASSERT_DIFFERS(second, first);
+    const auto det = detectorOf(m_bank1);
+    TS_ASSERT_EQUALS(first->getRecursive(det.get(), "Efixed")->value<double>(), 1.5);
+    TS_ASSERT_EQUALS(second->getRecursive(det.get(), "Efixed")->value<double>(), 2.5);
+  }
+
+  void test_clear_parameters_invalidates_snapshot() {
+    m_pmap->addDouble(m_bank1, "Efixed", 1.5);
+    TS_ASSERT_DIFFERS(m_pmap->snapshot()->nameIndex("Efixed"), ParameterMapSnapshot::npos);
+    m_pmap->clearParametersByName("Efixed");
+    TS_ASSERT_EQUALS(m_pmap->snapshot()->nameIndex("Efixed"), ParameterMapSnapshot::npos);
+  }
+
+  void test_name_lookup_is_case_insensitive() {
+    m_pmap->addDouble(m_bank1, "Efixed", 1.5);
+    const auto snapshot = m_pmap->snapshot();
+    TS_ASSERT_EQUALS(snapshot->nameIndex("efixed"), snapshot->nameIndex("EFIXED"));
+    TS_ASSERT_EQUALS(snapshot->nameIndex("unknown"), ParameterMapSnapshot::npos);
+    TS_ASSERT(!snapshot->getRecursive(detectorOf(m_bank1).get(), "unknown"));
+  }
+
+  void test_getRecursive_matches_parameter_map() {
+    m_pmap->addDouble(m_baseInstrument.get(), "Efixed", 0.5);
+    m_pmap->addDouble(m_bank1, "Efixed", 1.5);
+    m_pmap->addString(m_bank2, "label", "second");
+    const auto det = detectorOf(m_bank1);
+    m_pmap->addDouble(det.get(), "Efixed", 3.5);
+    const auto snapshot = m_pmap->snapshot();
+
+    for (const auto id : m_baseInstrument->getDetectorIDs()) {
+      const auto detector = m_baseInstrument->getDetector(id);
+      for (const std::string name : {"Efixed", "label"}) {
+        const auto expected = m_pmap->getRecursive(detector.get(), name);
+        const auto actual = snapshot->getRecursive(detector.get(), name);
+        TS_ASSERT_EQUALS(actual, expected);
+        const auto index = m_pmap->detectorIndex(id);
+        TS_ASSERT_EQUALS(snapshot->getRecursive(index, snapshot->nameIndex(name)), expected);
+      }
+    }
+    TS_ASSERT_EQUALS(snapshot->getRecursive(det.get(), "Efixed")->value<double>(), 3.5);
+    TS_ASSERT_EQUALS(snapshot->getRecursive(m_bank2, "Efixed")->value<double>(), 0.5);
+  }
+
+  void test_double_column() {
+    m_pmap->addDouble(m_bank1, "Efixed", 1.5);
+    const auto det = detectorOf(m_bank1);
+    m_pmap->addDouble(det.get(), "Efixed", 3.5);
+    const auto otherDet = detectorOf(m_bank2);
+    // Not a double, so the column does not resolve it
+    m_pmap->addString(otherDet.get(), "Efixed", "text");
+    const auto snapshot = m_pmap->snapshot();
+
+    const auto &column = snapshot->doubleColumn("Efixed");
+    TS_ASSERT_EQUALS(column.size(), m_baseInstrument->getNumberDetectors());
+    TS_ASSERT_EQUALS(&snapshot->doubleColumn(snapshot->nameIndex("efixed")), &column);
+    for (const auto id : m_baseInstrument->getDetectorIDs()) {
+      const auto index = m_pmap->detectorIndex(id);
+      const auto detector = m_baseInstrument->getDetector(id);
+      const auto expected = m_pmap->getRecursive(detector.get(), "Efixed", ParameterMap::pDouble());
+      TS_ASSERT_EQUALS(column.has(index), static_cast<bool>(expected));
+      if (expected)
+        TS_ASSERT_EQUALS(column.value(index), expected->value<double>());
+    }
+    TS_ASSERT_EQUALS(column.value(m_pmap->detectorIndex(det->getID())), 3.5);
+    TS_ASSERT(!column.has(m_pmap->detectorIndex(otherDet->getID())));
+  }
+
+  void test_double_column_keeps_the_values_when_the_snapshot_was_taken() {
+    m_pmap->addDouble(m_bank1, "Efixed", 1.5);
+    const auto snapshot = m_pmap->snapshot();
+    // Change the shared Parameter in place and replace it before the column
+    // is first requested
+    m_pmap->get(m_bank1, "Efixed")->fromString("7.5");
+    m_pmap->addDouble(m_bank2, "Efixed", 2.5);
+
+    const auto &column = snapshot->doubleColumn("Efixed");
+    TS_ASSERT_EQUALS(column.value(m_pmap->detectorIndex(detectorOf(m_bank1)->getID())), 1.5);
+    TS_ASSERT(!column.has(m_pmap->detectorIndex(detectorOf(m_bank2)->getID())));
+    const auto &current = m_pmap->snapshot()->doubleColumn("Efixed");
+    TS_ASSERT_EQUALS(current.value(m_pmap->detectorIndex(detectorOf(m_bank1)->getID())), 7.5);
+    TS_ASSERT_EQUALS(current.value(m_pmap->detectorIndex(detectorOf(m_bank2)->getID())), 2.5);
+  }
+
+  void test_snapshot_is_rebuilt_after_a_value_is_changed_in_place() {
+    m_pmap->addDouble(m_bank1, "Efixed", 1.5);
+    const auto first = m_pmap->snapshot();
+    m_pmap->get(m_bank1, "Efixed")->fromString("7.5");
+    const auto second = m_pmap->snapshot();
+    TS_ASSERT_DIFFERS(second, first);
+    const auto index = m_pmap->detectorIndex(detectorOf(m_bank1)->getID());
+    TS_ASSERT_EQUALS(first->doubleColumn("Efixed").value(index), 1.5);
+    TS_ASSERT_EQUALS(second->doubleColumn("Efixed").value(index), 7.5);
+    TS_ASSERT_EQUALS(m_pmap->snapshot(), second);
+  }
+
+  void test_snapshotForRepeatedLookups_waits_until_the_lookups_pay_for_it() {
+    // 4 banks of 9 detectors, so a snapshot is built on the second lookup
+    // after every change
+    const auto instrument = ComponentCreationHelper::createTestInstrumentCylindrical(4);
+    ParameterMap pmap;
+    pmap.setInstrument(instrument.get());
+    const auto bank = instrument->getComponentByName("bank1").get();
+    pmap.addDouble(bank, "Efixed", 1.5);
+
+    TS_ASSERT(!pmap.snapshotForRepeatedLookups());
+    const auto first = pmap.snapshotForRepeatedLookups();
+    TS_ASSERT(first);
+    TS_ASSERT_EQUALS(pmap.snapshotForRepeatedLookups(), first);
+    TS_ASSERT_EQUALS(pmap.snapshot(), first);
+
+    // Alternating changes and lookups never build a snapshot
+    for (int i = 0; i < 4; ++i) {
+      pmap.addDouble(bank, "Efixed", 2.5 + i);
+      TS_ASSERT(!pmap.snapshotForRepeatedLookups());
+    }
+    pmap.get(bank, "Efixed")->fromString("9.5");
+    TS_ASSERT(!pmap.snapshotForRepeatedLookups());
+    const auto second = pmap.snapshotForRepeatedLookups();
+    TS_ASSERT(second);
+    const auto index = pmap.detectorIndex(instrument->getDetectorIDs().front());
+    TS_ASSERT_EQUALS(second->doubleColumn("Efixed").value(index), 9.5);
+  }
+
+  void test_double_column_unknown_name_throws() {
+    const auto snapshot = m_pmap->snapshot();
+    TS_ASSERT_THROWS(snapshot->doubleColumn("unknown"), const std::out_of_range &);
+    TS_ASSERT_THROWS(snapshot->doubleColumn(0), const std::out_of_range &);
+  }
+
+  void test_double_column_concurrent_access() {
+    m_pmap->addDouble(m_bank1, "Efixed", 1.5);
+    const auto snapshot = m_pmap->snapshot();
+    const auto expected = &snapshot->doubleColumn("Efixed");
+    int mismatches = 0;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 64; ++i) {
+      if (&snapshot->doubleColumn("Efixed") != expected) {
+        PARALLEL_ATOMIC
+        ++mismatches;
+      }
+    }
+    TS_ASSERT_EQUALS(mismatches, 0);
+  }
+
+private:
+  /// The first detector of bank1 or the last detector of bank2
+  IDetector_const_sptr detectorOf(const IComponent *bank) const {
+    const auto ids = m_baseInstrument->getDetectorIDs();
+    return m_baseInstrument->getDetector(bank == m_bank1 ? ids.front() : ids.back());
+  }
+
+  Instrument_sptr m_baseInstrument;
+  std::shared_ptr<ParameterMap> m_pmap;
+  const IComponent *m_bank1 = nullptr;
+  const IComponent *m_bank2 = nullptr;
+};
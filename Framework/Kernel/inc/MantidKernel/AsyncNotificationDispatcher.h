@@ -0,0 +1,58 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+
+#include <Poco/Notification.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Poco {
+class NotificationCenter;
+}
+
+namespace Mantid {
+namespace Kernel {
+
+/** AsyncNotificationDispatcher : Delivers notifications to the observers of a
+  Poco::NotificationCenter from a dedicated thread, so that the thread posting
+  them does not wait for the observers.
+
+  Notifications are delivered in the order they were posted. The thread takes
+  all the notifications queued while it was busy and delivers them as one
+  batch. The destructor delivers the notifications still queued.
+*/
+class MANTID_KERNEL_DLL AsyncNotificationDispatcher {
+public:
+  explicit AsyncNotificationDispatcher(Poco::NotificationCenter &center);
+  ~AsyncNotificationDispatcher();
+  AsyncNotificationDispatcher(const AsyncNotificationDispatcher &) = delete;
+  AsyncNotificationDispatcher &operator=(const AsyncNotificationDispatcher &) = delete;
+
+  void post(const Poco::Notification::Ptr &notification);
+  void flush();
+
+private:
+  void run();
+
+  Poco::NotificationCenter &m_center;
+  std::mutex m_mutex;
+  std::condition_variable m_queued, m_delivered;
+  std::deque<Poco::Notification::Ptr> m_queue;
+  /// Numbers of notifications posted and delivered so far
+  size_t m_numberPosted{0}, m_numberDelivered{0};
+  bool m_stop{false};
+  std::thread m_thread;
+};
+
+} // namespace Kernel
+} // namespace Mantid
@@ -13,12 +13,15 @@
 #include <boost/algorithm/string.hpp>
 #include <memory>
 #endif
+#include "MantidKernel/AsyncNotificationDispatcher.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
 #include <Poco/Notification.h>
 #include <Poco/NotificationCenter.h>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #ifdef _WIN32
 #define strcasecmp _stricmp
@@ -54,6 +57,15 @@ struct CaseInsensitiveCmp {
     This is the primary data service that  the users will interact with either
    through writing scripts or directly
     through the API. It is implemented as a singleton class.
+
+    The objects are held in a map that is never modified once it is published.
+    Changes are made to a copy, under a lock shared by the threads making
+    changes, which then replaces the published map. Lookups read the map
+    published last and do not wait for the lock, or for each other.
+
+    Notifications are sent synchronously by the thread making a change, unless
+    setAsynchronousNotifications() is turned on. They are then delivered in
+    order by a dedicated thread.
 */
 template <typename T> class DLLExport DataService {
 private:
@@ -199,7 +211,11 @@ public:
       // that's already in the map with a pointer to a different object).
       // Also, there's nothing to stop the same object from being added
       // more than once with different names.
-      success = datamap.insert(std::make_pair(name, Tobject)).second;
+      if (snapshot()->count(name) == 0) {
+        auto datamap = std::make_shared<svcmap>(*snapshot());
+        success = datamap->emplace(name, Tobject).second;
+        publish(std::move(datamap));
+      }
     }
     if (!success) {
       std::string error = " add : Unable to insert Data Object : '" + name + "'";
@@ -207,7 +223,7 @@ public:
       throw std::runtime_error(error);
     } else {
       g_log.debug() << "Add Data Object " << name << " successful\n";
-      notificationCenter.postNotification(new AddNotification(name, Tobject));
+      postNotification(new AddNotification(name, Tobject));
     }
   }
 
@@ -226,18 +242,22 @@ public:
     std::unique_lock<std::recursive_mutex> lock(m_mutex);
 
     // find if the Tobject already exists
-    auto it = datamap.find(name);
-    if (it != datamap.end()) {
+    const auto current = snapshot();
+    auto it = current->find(name);
+    if (it != current->end()) {
+      auto oldObject = it->second;
       lock.unlock();
       g_log.debug("Data Object '" + name + "' replaced in data service.\n");
 
-      notificationCenter.postNotification(new BeforeReplaceNotification(name, it->second, Tobject));
+      postNotification(new BeforeReplaceNotification(name, oldObject, Tobject));
 
       lock.lock();
-      it->second = Tobject;
+      auto datamap = std::make_shared<svcmap>(*snapshot());
+      (*datamap)[name] = Tobject;
+      publish(std::move(datamap));
       lock.unlock();
 
-      notificationCenter.postNotification(new AfterReplaceNotification(name, Tobject));
+      postNotification(new AfterReplaceNotification(name, Tobject));
     } else {
       // Avoid double-locking
       lock.unlock();
@@ -252,25 +272,26 @@ public:
     // Make DataService access thread-safe
     std::unique_lock<std::recursive_mutex> lock(m_mutex);
 
-    auto it = datamap.find(name);
-    if (it == datamap.end()) {
+    auto current = snapshot();
+    auto it = current->find(name);
+    if (it == current->end()) {
       lock.unlock();
       g_log.debug(" remove '" + name + "' cannot be found");
       return;
     }
-    // The map is shared across threads so the item is erased from the map
-    // before unlocking the mutex and is held in a local stack variable.
-    // This protects it from being modified by another thread.
-    auto data = std::move(it->second);
-    datamap.erase(it);
-
-    // Do NOT use "it" iterator after this point. Other threads may modify the
-    // map
+    // The item is erased from a copy of the map before unlocking the mutex
+    // and is held in a local stack variable.
+    auto data = it->second;
+    auto datamap = std::make_shared<svcmap>(*current);
+    datamap->erase(name);
+    publish(std::move(datamap));
+    current.reset();
+
     lock.unlock();
-    notificationCenter.postNotification(new PreDeleteNotification(name, data));
+    postNotification(new PreDeleteNotification(name, data));
     data.reset(); // DataService now has no references to the object
     g_log.debug("Data Object '" + name + "' deleted from data service.");
-    notificationCenter.postNotification(new PostDeleteNotification(name));
+    postNotification(new PostDeleteNotification(name));
   }
 
   //--------------------------------------------------------------------------
@@ -289,44 +310,39 @@ public:
     // Make DataService access thread-safe
     std::unique_lock<std::recursive_mutex> lock(m_mutex);
 
-    auto existingNameIter = datamap.find(oldName);
-    if (existingNameIter == datamap.end()) {
+    auto current = snapshot();
+    auto existingNameIter = current->find(oldName);
+    if (existingNameIter == current->end()) {
       lock.unlock();
       g_log.warning(" rename '" + oldName + "' cannot be found");
       return;
     }
 
-    auto existingNameObject = std::move(existingNameIter->second);
-    auto targetNameIter = datamap.find(newName);
+    auto existingNameObject = existingNameIter->second;
+    auto targetNameIter = current->find(newName);
+    const bool replacing = targetNameIter != current->end();
 
     // If we are overriding send a notification for observers
-    if (targetNameIter != datamap.end()) {
+    if (replacing) {
       auto targetNameObject = targetNameIter->second;
       // As we are renaming the existing name turns into the new name
       lock.unlock();
-      notificationCenter.postNotification(new BeforeReplaceNotification(newName, targetNameObject, existingNameObject));
+      postNotification(new BeforeReplaceNotification(newName, targetNameObject, existingNameObject));
       lock.lock();
     }
 
-    datamap.erase(existingNameIter);
+    auto datamap = std::make_shared<svcmap>(*snapshot());
+    datamap->erase(oldName);
+    (*datamap)[newName] = existingNameObject;
+    publish(std::move(datamap));
+    current.reset();
+    lock.unlock();
 
-    if (targetNameIter != datamap.end()) {
-      targetNameIter->second = std::move(existingNameObject);
-      lock.unlock();
-      notificationCenter.postNotification(new AfterReplaceNotification(newName, targetNameIter->second));
-    } else {
-      if (!(datamap.emplace(newName, std::move(existingNameObject)).second)) {
-        // should never happen
-        lock.unlock();
-        std::string error = " add : Unable to insert Data Object : '" + newName + "'";
-        g_log.error(error);
-        throw std::runtime_error(error);
-      } else {
-        lock.unlock();
-      }
+    if (replacing) {
+      postNotification(new AfterReplaceNotification(newName, existingNameObject));
     }
     g_log.debug("Data Object '" + oldName + "' renamed to '" + newName + "'");
-    notificationCenter.postNotification(new RenameNotification(oldName, newName));
+    postNotification(new RenameNotification(oldName, newName));
   }
 
   //--------------------------------------------------------------------------
@@ -335,9 +351,9 @@ public:
     {
       // Make DataService access thread-safe
       std::lock_guard<std::recursive_mutex> lock(m_mutex);
-      datamap.clear();
+      publish(std::make_shared<const svcmap>());
     }
-    notificationCenter.postNotification(new ClearNotification());
+    postNotification(new ClearNotification());
     g_log.debug() << typeid(this).name() << " cleared.\n";
   }
 
@@ -345,14 +361,113 @@ public:
   virtual void shutdown() { clear(); }
 
   //--------------------------------------------------------------------------
-  /** Get a shared pointer to a stored data object
-   * @param name :: name of the object */
-  std::shared_ptr<T> retrieve(const std::string &name) const {
+  /** Add or replace several objects at once. Other threads see either none or
+   * all of them. The notifications for each object are sent afterwards, in
+   * order, so a BeforeReplaceNotification is sent once the object has been
+   * replaced. The old object still exists when it is received.
+   * @param objects :: pairs of names and shared pointers to objects to add
+   * @throw std::runtime_error if a name is empty or a pointer is null
+   */
+  void addOrReplaceMany(const std::vector<std::pair<std::string, std::shared_ptr<T>>> &objects) {
+    for (const auto &object : objects) {
+      checkForEmptyName(object.first);
+      checkForNullPointer(object.second);
+    }
+
+    std::vector<std::shared_ptr<T>> replaced(objects.size());
+    {
+      // Make DataService access thread-safe
+      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      auto datamap = std::make_shared<svcmap>(*snapshot());
+      for (size_t i = 0; i < objects.size(); ++i) {
+        auto it = datamap->find(objects[i].first);
+        if (it != datamap->end()) {
+          replaced[i] = std::exchange(it->second, objects[i].second);
+        } else {
+          datamap->emplace(objects[i].first, objects[i].second);
+        }
+      }
+      publish(std::move(datamap));
+    }
+
+    for (size_t i = 0; i < objects.size(); ++i) {
+      const auto &name = objects[i].first;
+      if (replaced[i]) {
+        postNotification(new BeforeReplaceNotification(name, replaced[i], objects[i].second));
+        replaced[i].reset();
+        postNotification(new AfterReplaceNotification(name, objects[i].second));
+      } else {
+        postNotification(new AddNotification(name, objects[i].second));
+      }
+    }
+    g_log.debug() << "Added or replaced " << objects.size() << " Data Objects\n";
+  }
+
+  //--------------------------------------------------------------------------
+  /** Remove several objects at once. Other threads see either all or none of
+   * them. Names that cannot be found are ignored.
+   * @param names :: names of the objects
+   * @return the number of objects removed
+   */
+  size_t removeMany(const std::vector<std::string> &names) {
+    std::vector<std::pair<std::string, std::shared_ptr<T>>> removed;
+    {
+      // Make DataService access thread-safe
+      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      auto datamap = std::make_shared<svcmap>(*snapshot());
+      for (const auto &name : names) {
+        auto it = datamap->find(name);
+        if (it != datamap->end()) {
+          removed.emplace_back(name, std::move(it->second));
+          datamap->erase(it);
+        }
+      }
+      if (!removed.empty())
+        publish(std::move(datamap));
+    }
+
+    for (auto &object : removed) {
+      postNotification(new PreDeleteNotification(object.first, object.second));
+      object.second.reset(); // DataService now has no references to the object
+      postNotification(new PostDeleteNotification(object.first));
+    }
+    g_log.debug() << "Removed " << removed.size() << " Data Objects\n";
+    return removed.size();
+  }
+
+  //--------------------------------------------------------------------------
+  /** Replace an object by one standing in for it, but only if the service
+   * still holds the expected object. Observers are not notified as the name
+   * still refers to the same data.
+   * @param name :: name of the object
+   * @param expected :: the object the service must hold under the name
+   * @param replacement :: the object to store in its place
+   * @return true if the object was replaced
+   * @throw std::runtime_error if the replacement is null
+   */
+  bool exchange(const std::string &name, const std::shared_ptr<T> &expected, const std::shared_ptr<T> &replacement) {
+    checkForNullPointer(replacement);
     // Make DataService access thread-safe
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    {
+      const auto current = snapshot();
+      auto it = current->find(name);
+      if (it == current->end() || it->second != expected)
+        return false;
+    }
+    auto datamap = std::make_shared<svcmap>(*snapshot());
+    datamap->find(name)->second = replacement;
+    publish(std::move(datamap));
+    return true;
+  }
 
-    auto it = datamap.find(name);
-    if (it != datamap.end()) {
+  //--------------------------------------------------------------------------
+  /** Get a shared pointer to a stored data object
+   * @param name :: name of the object */
+  virtual std::shared_ptr<T> retrieve(const std::string &name) const {
+    const auto datamap = snapshot();
+    auto it = datamap->find(name);
+    if (it != datamap->end()) {
       return it->second;
     } else {
       throw Kernel::Exception::NotFoundError("Unable to find Data Object type with name '" + name + "': data service ",
@@ -367,21 +482,16 @@ public:
   }
 
   /// Check to see if a data object exists in the store
-  bool doesExist(const std::string &name) const {
-    // Make DataService access thread-safe
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-    auto it = datamap.find(name);
-    return it != datamap.end();
-  }
+  bool doesExist(const std::string &name) const { return snapshot()->count(name) > 0; }
 
   /// Return the number of objects stored by the data service
   size_t size() const {
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
+    const auto datamap = snapshot();
 
     if (showingHiddenObjects()) {
-      return datamap.size();
+      return datamap->size();
     } else {
-      return std::count_if(datamap.cbegin(), datamap.cend(),
+      return std::count_if(datamap->cbegin(), datamap->cend(),
                            [](const auto &it) { return !isHiddenDataServiceObject(it.first); });
     }
   }
@@ -410,23 +520,20 @@ public:
       }
     }
 
-    // Use the scoping of an if to handle our lock for duration
+    const auto datamap = snapshot();
     if (hiddenState == DataServiceHidden::Include) {
       // Getting hidden items
-      std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-      foundNames.reserve(datamap.size());
-      for (const auto &item : datamap) {
+      foundNames.reserve(datamap->size());
+      for (const auto &item : *datamap) {
         if (contain.empty()) {
           foundNames.emplace_back(item.first);
         } else if (item.first.find(contain) != std::string::npos) {
           foundNames.emplace_back(item.first);
         }
       }
-      // Lock released at end of scope here
     } else {
-      std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-      foundNames.reserve(datamap.size());
-      for (const auto &item : datamap) {
+      foundNames.reserve(datamap->size());
+      for (const auto &item : *datamap) {
         if (!isHiddenDataServiceObject(item.first)) {
           // This item is not hidden add it
           if (contain.empty()) {
@@ -436,7 +543,6 @@ public:
           }
         }
       }
-      // Lock released at end of scope here
     }
 
     // Now sort if told to
@@ -449,7 +555,7 @@ public:
 
   /// Get a vector of the pointers to the data objects stored by the service
   std::vector<std::shared_ptr<T>> getObjects(DataServiceHidden includeHidden = DataServiceHidden::Auto) const {
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
+    const auto datamap = snapshot();
 
     const bool alwaysIncludeHidden = includeHidden == DataServiceHidden::Include;
     const bool usingAuto = includeHidden == DataServiceHidden::Auto && showingHiddenObjects();
@@ -457,8 +563,8 @@ public:
     const bool showingHidden = alwaysIncludeHidden || usingAuto;
 
     std::vector<std::shared_ptr<T>> objects;
-    objects.reserve(datamap.size());
-    for (const auto &it : datamap) {
+    objects.reserve(datamap->size());
+    for (const auto &it : *datamap) {
       if (showingHidden || !isHiddenDataServiceObject(it.first)) {
         objects.emplace_back(it.second);
       }
@@ -477,6 +583,49 @@ public:
     return showingHiddenFlag.get_value_or(false);
   }
 
+  //--------------------------------------------------------------------------
+  /** Send a notification to the observers of the service. Use this rather than
+   * notificationCenter.postNotification(), so that notifications are
+   * delivered in order when they are asynchronous.
+   * @param notification :: The notification, owned by the service from now on
+   */
+  void postNotification(Poco::Notification *notification) {
+    Poco::Notification::Ptr ptr(notification);
+    if (const auto dispatcher = std::atomic_load(&m_dispatcher)) {
+      dispatcher->post(ptr);
+    } else {
+      notificationCenter.postNotification(ptr);
+    }
+  }
+
+  /** Deliver notifications from a dedicated thread, so that threads changing
+   * the service do not wait for the observers. Do not call this from an
+   * observer.
+   * @param on :: True to make notifications asynchronous. Turning them off
+   * delivers the notifications still queued first.
+   */
+  void setAsynchronousNotifications(bool on) {
+    std::shared_ptr<AsyncNotificationDispatcher> dispatcher;
+    {
+      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      dispatcher = std::atomic_load(&m_dispatcher);
+      if (on == bool(dispatcher))
+        return;
+      std::atomic_store(&m_dispatcher,
+                        on ? std::make_shared<AsyncNotificationDispatcher>(notificationCenter) : nullptr);
+    }
+    // The old dispatcher delivers its queue when it is destroyed
+  }
+
+  /// Are notifications delivered from a dedicated thread?
+  bool asynchronousNotifications() const { return bool(std::atomic_load(&m_dispatcher)); }
+
+  /// Wait for the asynchronous notifications sent so far to be delivered
+  void flushNotifications() {
+    if (const auto dispatcher = std::atomic_load(&m_dispatcher))
+      dispatcher->flush();
+  }
+
   /// Sends notifications to observers. Observers can subscribe to
   /// notificationCenter
   /// using Poco::NotificationCenter::addObserver(...)
@@ -489,10 +638,20 @@ public:
 
 protected:
   /// Protected constructor (singleton)
-  DataService(const std::string &name) : svcName(name), g_log(svcName) {}
-  virtual ~DataService() = default;
+  DataService(const std::string &name)
+      : svcName(name), m_datamap(std::make_shared<const svcmap>()), g_log(svcName) {}
+  virtual ~DataService() {
+    // Deliver the queued notifications while the service still exists
+    std::atomic_store(&m_dispatcher, std::shared_ptr<AsyncNotificationDispatcher>());
+  }
 
 private:
+  /// The map published last. It is never modified.
+  std::shared_ptr<const svcmap> snapshot() const { return std::atomic_load(&m_datamap); }
+
+  /// Replace the published map. Call this holding the lock.
+  void publish(std::shared_ptr<const svcmap> datamap) { std::atomic_store(&m_datamap, std::move(datamap)); }
+
   void checkForEmptyName(const std::string &name) {
     if (name.empty()) {
       const std::string error = "Add Data Object with empty name";
@@ -512,10 +671,12 @@ private:
   /// DataService name. This is set only at construction. DataService name
   /// should be provided when construction of derived classes
   const std::string svcName;
-  /// Map of objects in the data service
-  svcmap datamap;
-  /// Recursive mutex to avoid simultaneous access or notifications
+  /// Map of objects in the data service, replaced on every change
+  std::shared_ptr<const svcmap> m_datamap;
+  /// Recursive mutex to avoid simultaneous changes
   mutable std::recursive_mutex m_mutex;
+  /// Delivers the notifications if they are asynchronous
+  std::shared_ptr<AsyncNotificationDispatcher> m_dispatcher;
   /// Logger for this DataService
   Logger g_log;
 }; // End Class Data service
@@ -0,0 +1,93 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/AsyncNotificationDispatcher.h"
+#include "MantidKernel/Logger.h"
+
+#include <Poco/NotificationCenter.h>
+
+#include <exception>
+
+namespace Mantid::Kernel {
+
+namespace {
+/// static logger
+Logger g_log("AsyncNotificationDispatcher");
+} // namespace
+
+/**
+ * Start the thread delivering the notifications
+ * @param center :: The notification center of the observers, which must
+ * outlive the dispatcher.
+ */
+AsyncNotificationDispatcher::AsyncNotificationDispatcher(Poco::NotificationCenter &center)
+    : m_center(center), m_thread(&AsyncNotificationDispatcher::run, this) {}
+
+/// Deliver the queued notifications and stop the thread
+AsyncNotificationDispatcher::~AsyncNotificationDispatcher() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_queued.notify_one();
+  m_thread.join();
+}
+
+/**
+ * Queue a notification for delivery
+ * @param notification :: The notification
+ */
+void AsyncNotificationDispatcher::post(const Poco::Notification::Ptr &notification) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.emplace_back(notification);
+    ++m_numberPosted;
+  }
+  m_queued.notify_one();
+}
+
+/**
+ * Wait until the notifications posted so far have been delivered. Observers
+ * calling this while they are notified do not wait, as they would wait for
+ * themselves.
+ */
+void AsyncNotificationDispatcher::flush() {
+  if (std::this_thread::get_id() == m_thread.get_id())
+    return;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  const auto posted = m_numberPosted;
+  m_delivered.wait(lock, [this, posted]() { return m_numberDelivered >= posted; });
+}
+
+void AsyncNotificationDispatcher::run() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_queued.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty())
+      return;
+    std::deque<Poco::Notification::Ptr> batch;
+    batch.swap(m_queue);
+    lock.unlock();
+    for (const auto &notification : batch) {
+      // An observer that throws must not stop the others from being notified
+      try {
+        m_center.postNotification(notification);
+      } catch (std::exception &ex) {
+        g_log.error() << "Error delivering " << notification->name() << ": " << ex.what() << '\n';
+      } catch (...) {
+        g_log.error() << "Unknown error delivering " << notification->name() << '\n';
+      }
+    }
+    // Release the objects held by the notifications before taking the lock
+    const auto numberDelivered = batch.size();
+    batch.clear();
+    lock.lock();
+    m_numberDelivered += numberDelivered;
+    m_delivered.notify_all();
+  }
+}
+
+} // namespace Mantid::Kernel
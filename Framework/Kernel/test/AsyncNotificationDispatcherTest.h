@@ -0,0 +1,107 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/AsyncNotificationDispatcher.h"
+
+#include <Poco/NObserver.h>
+#include <Poco/NotificationCenter.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using Mantid::Kernel::AsyncNotificationDispatcher;
+
+namespace {
+class NumberedNotification : public Poco::Notification {
+public:
+  explicit NumberedNotification(int number) : number(number) {}
+  const int number;
+};
+} // namespace
+
+class AsyncNotificationDispatcherTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AsyncNotificationDispatcherTest *createSuite() { return new AsyncNotificationDispatcherTest(); }
+  static void destroySuite(AsyncNotificationDispatcherTest *suite) { delete suite; }
+
+  void setUp() override {
+    m_received.clear();
+    m_threads.clear();
+    m_throwOn = -1;
+  }
+
+  void test_notifications_are_delivered_in_order_from_another_thread() {
+    Poco::NotificationCenter center;
+    Poco::NObserver<AsyncNotificationDispatcherTest, NumberedNotification> observer(
+        *this, &AsyncNotificationDispatcherTest::handleNotification);
+    center.addObserver(observer);
+
+    AsyncNotificationDispatcher dispatcher(center);
+    for (int i = 0; i < 1000; ++i) {
+      dispatcher.post(new NumberedNotification(i));
+    }
+    dispatcher.flush();
+
+    TS_ASSERT_EQUALS(m_received.size(), 1000);
+    for (int i = 0; i < static_cast<int>(m_received.size()); ++i) {
+      TS_ASSERT_EQUALS(m_received[i], i);
+    }
+    TS_ASSERT_EQUALS(m_threads.size(), 1);
+    TS_ASSERT_DIFFERS(m_threads.front(), std::this_thread::get_id());
+    center.removeObserver(observer);
+  }
+
+  void test_destructor_delivers_queued_notifications() {
+    Poco::NotificationCenter center;
+    Poco::NObserver<AsyncNotificationDispatcherTest, NumberedNotification> observer(
+        *this, &AsyncNotificationDispatcherTest::handleNotification);
+    center.addObserver(observer);
+    {
+      AsyncNotificationDispatcher dispatcher(center);
+      dispatcher.post(new NumberedNotification(1));
+      dispatcher.post(new NumberedNotification(2));
+    }
+    TS_ASSERT_EQUALS(m_received, (std::vector<int>{1, 2}));
+    center.removeObserver(observer);
+  }
+
+  void test_observer_that_throws_does_not_stop_delivery() {
+    Poco::NotificationCenter center;
+    Poco::NObserver<AsyncNotificationDispatcherTest, NumberedNotification> observer(
+        *this, &AsyncNotificationDispatcherTest::handleNotification);
+    center.addObserver(observer);
+    m_throwOn = 1;
+
+    AsyncNotificationDispatcher dispatcher(center);
+    for (int i = 0; i < 3; ++i) {
+      dispatcher.post(new NumberedNotification(i));
+    }
+    dispatcher.flush();
+    TS_ASSERT_EQUALS(m_received, (std::vector<int>{0, 1, 2}));
+    center.removeObserver(observer);
+  }
+
+  void handleNotification(const Poco::AutoPtr<NumberedNotification> &notification) {
+    // Only the dispatcher thread calls this
+    m_received.emplace_back(notification->number);
+    if (m_threads.empty() || m_threads.back() != std::this_thread::get_id())
+      m_threads.emplace_back(std::this_thread::get_id());
+    if (notification->number == m_throwOn)
+      throw std::runtime_error("thrown on purpose");
+  }
+
+private:
+  std::vector<int> m_received;
+  std::vector<std::thread::id> m_threads;
+  int m_throwOn{-1};
+};
@@ -12,8 +12,10 @@
 #include <cxxtest/TestSuite.h>
 #include <memory>
 
+#include <atomic>
 #include <mutex>
 #include <sstream>
+#include <thread>
 
 using namespace Mantid;
 using namespace Mantid::Kernel;
@@ -445,6 +447,100 @@ public:
     TS_ASSERT_EQUALS(*svc.retrieve("item2345"), 2345);
   }
 
+  void test_addOrReplaceMany() {
+    Poco::NObserver<DataServiceTest, FakeDataService::AddNotification> addObserver(
+        *this, &DataServiceTest::handleAddNotification);
+    Poco::NObserver<DataServiceTest, FakeDataService::BeforeReplaceNotification> replaceObserver(
+        *this, &DataServiceTest::handleBeforeReplaceNotification);
+    svc.notificationCenter.addObserver(addObserver);
+    svc.notificationCenter.addObserver(replaceObserver);
+    svc.add("one", std::make_shared<int>(1));
+    notificationFlag = 0;
+
+    svc.addOrReplaceMany({{"One", std::make_shared<int>(11)}, {"two", std::make_shared<int>(2)}});
+    TS_ASSERT_EQUALS(svc.size(), 2);
+    TS_ASSERT_EQUALS(*svc.retrieve("one"), 11);
+    TS_ASSERT_EQUALS(*svc.retrieve("two"), 2);
+    // One replace and one add
+    TS_ASSERT_EQUALS(notificationFlag, 2);
+
+    // Nothing is added if one of the objects is invalid
+    TS_ASSERT_THROWS(svc.addOrReplaceMany({{"three", std::make_shared<int>(3)}, {"", std::make_shared<int>(4)}}),
+                     const std::runtime_error &);
+    TS_ASSERT(!svc.doesExist("three"));
+    svc.notificationCenter.removeObserver(addObserver);
+    svc.notificationCenter.removeObserver(replaceObserver);
+  }
+
+  void test_removeMany() {
+    Poco::NObserver<DataServiceTest, FakeDataService::PostDeleteNotification> observer(
+        *this, &DataServiceTest::handleCountPostDeleteNotification);
+    svc.notificationCenter.addObserver(observer);
+    svc.add("one", std::make_shared<int>(1));
+    svc.add("two", std::make_shared<int>(2));
+    svc.add("three", std::make_shared<int>(3));
+
+    TS_ASSERT_EQUALS(svc.removeMany({"one", "missing", "THREE"}), 2);
+    TS_ASSERT_EQUALS(svc.getObjectNames(), std::vector<std::string>{"two"});
+    TS_ASSERT_EQUALS(notificationFlag, 2);
+    svc.notificationCenter.removeObserver(observer);
+  }
+
+  void handleCountPostDeleteNotification(const Poco::AutoPtr<FakeDataService::PostDeleteNotification> &) {
+    ++notificationFlag;
+  }
+
+  void test_exchange_replaces_only_the_expected_object() {
+    Poco::NObserver<DataServiceTest, FakeDataService::BeforeReplaceNotification> observer(
+        *this, &DataServiceTest::handleBeforeReplaceNotification);
+    svc.notificationCenter.addObserver(observer);
+    auto one = std::make_shared<int>(1);
+    svc.add("one", one);
+
+    TS_ASSERT(!svc.exchange("one", std::make_shared<int>(1), std::make_shared<int>(2)));
+    TS_ASSERT_EQUALS(svc.retrieve("one"), one);
+    TS_ASSERT(!svc.exchange("missing", one, std::make_shared<int>(2)));
+    TS_ASSERT(!svc.doesExist("missing"));
+
+    TS_ASSERT(svc.exchange("One", one, std::make_shared<int>(2)));
+    TS_ASSERT_EQUALS(*svc.retrieve("one"), 2);
+    TS_ASSERT_EQUALS(one.use_count(), 1);
+    // Observers are not told
+    TS_ASSERT_EQUALS(notificationFlag, 0);
+    TS_ASSERT_THROWS(svc.exchange("one", svc.retrieve("one"), nullptr), const std::runtime_error &);
+    svc.notificationCenter.removeObserver(observer);
+  }
+
+  void test_asynchronousNotifications() {
+    Poco::NObserver<DataServiceTest, FakeDataService::AddNotification> observer(
+        *this, &DataServiceTest::handleAddNotification);
+    svc.notificationCenter.addObserver(observer);
+    vector.clear();
+    svc.setAsynchronousNotifications(true);
+    TS_ASSERT(svc.asynchronousNotifications());
+
+    for (int i = 0; i < 100; ++i) {
+      svc.add("item" + std::to_string(i), std::make_shared<int>(i));
+    }
+    svc.flushNotifications();
+    TS_ASSERT_EQUALS(notificationFlag, 100);
+
+    // Turning them off delivers the notifications still queued
+    svc.add("last", std::make_shared<int>(100));
+    svc.setAsynchronousNotifications(false);
+    TS_ASSERT(!svc.asynchronousNotifications());
+    TS_ASSERT_EQUALS(notificationFlag, 101);
+    TS_ASSERT_EQUALS(vector.size(), 101);
+    svc.notificationCenter.removeObserver(observer);
+  }
+
+  void test_rename_to_name_differing_in_case() {
+    svc.add("one", std::make_shared<int>(1));
+    svc.rename("one", "ONE");
+    TS_ASSERT_EQUALS(svc.getObjectNames(), std::vector<std::string>{"ONE"});
+    TS_ASSERT_EQUALS(*svc.retrieve("one"), 1);
+  }
+
   void test_prefixToHide() { TS_ASSERT_EQUALS(FakeDataService::prefixToHide(), "__"); }
 
   void test_isHiddenDataServiceObject() {
@@ -471,3 +567,42 @@ public:
     TS_ASSERT(!FakeDataService::showingHiddenObjects());
   }
 };
+
+class DataServiceTestPerformance : public CxxTest::TestSuite {
+public:
+  static DataServiceTestPerformance *createSuite() { return new DataServiceTestPerformance(); }
+  static void destroySuite(DataServiceTestPerformance *suite) { delete suite; }
+
+  DataServiceTestPerformance() {
+    for (int i = 0; i < 1000; ++i) {
+      svc.add("object" + std::to_string(i), std::make_shared<int>(i));
+    }
+  }
+
+  void test_lookups_while_another_thread_changes_the_service() {
+    std::atomic<bool> done{false};
+    std::thread writer([this, &done]() {
+      for (int i = 0; !done; i = (i + 1) % 100) {
+        svc.addOrReplace("changing" + std::to_string(i), std::make_shared<int>(i));
+      }
+    });
+
+    const int num = 2000000;
+    int found = 0;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < num; ++i) {
+      const std::string name = "object" + std::to_string(i % 1000);
+      if (svc.doesExist(name) && *svc.retrieve(name) == i % 1000) {
+        PARALLEL_ATOMIC
+        ++found;
+      }
+    }
+
+    done = true;
+    writer.join();
+    TS_ASSERT_EQUALS(found, num);
+  }
+
+private:
+  FakeDataService svc;
+};
@@ -10,6 +10,7 @@
 #include <cstring>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "ADARA.h"
 #include "MantidKernel/System.h"
@@ -225,6 +226,22 @@ public:
   uint32_t getSourceTOFOffset() const { return m_TOFOffset; }
   uint32_t curBankId() const { return m_bankId; }
 
+  // A bank of a source section. The events point into the packet, so a
+  // section is only valid as long as the packet's data.
+  struct BankSection {
+    uint32_t bankId;
+    uint32_t eventCount;
+    const Event *events;
+    bool isCorrected;
+    uint32_t tofOffset;
+  };
+
+  // All of the non-empty banks of the packet, found by walking the source
+  // and bank headers only. Unlike firstEvent() & nextEvent() this doesn't
+  // change the state of the packet, so the sections can be decoded in
+  // parallel.
+  std::vector<BankSection> bankSections() const;
+
   //        uint32_t curEventCount() const { return ((uint32_t *)m_curBank)[1];
   //        }
 
@@ -0,0 +1,40 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/ILiveListener.h"
+#include "MantidLiveData/DllConfig.h"
+
+#include <Poco/ActiveResult.h>
+
+namespace Mantid {
+namespace LiveData {
+
+/** BenchmarkLiveListener : Measures how fast a live listener decodes a stream
+  recorded by RecordLiveStream. The stream is replayed to the listener by
+  ReplayLiveStream while the data is extracted at a fixed interval, as
+  MonitorLiveData would.
+*/
+class MANTID_LIVEDATA_DLL BenchmarkLiveListener final : public API::Algorithm {
+public:
+  const std::string name() const override { return "BenchmarkLiveListener"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "DataHandling\\DataAcquisition"; }
+  const std::vector<std::string> seeAlso() const override { return {"RecordLiveStream", "ReplayLiveStream"}; }
+  const std::string summary() const override {
+    return "Measures the throughput of a live listener by replaying a recorded stream to it.";
+  }
+
+private:
+  void init() override;
+  void exec() override;
+  API::ILiveListener_sptr connectListener(const Poco::ActiveResult<bool> &replay);
+};
+
+} // namespace LiveData
+} // namespace Mantid
@@ -12,6 +12,7 @@
 #include "MantidLiveData/ISIS/TCPEventStreamDefs.h"
 
 #include "MantidAPI/LiveListener.h"
+#include "MantidAPI/LiveListenerBuffer.h"
 #include "MantidDataObjects/EventWorkspace.h"
 
 #include "Poco/Net/StreamSocket.h"
@@ -181,6 +182,9 @@ protected:
   std::vector<DataObjects::EventWorkspace_sptr> m_eventBuffer;
   /// Protects m_eventBuffer
   std::mutex m_mutex;
+  /// Swaps m_eventBuffer for empty buffers in extractData()
+  API::LiveListenerBuffer<DataObjects::EventWorkspace> m_bufferSwap{
+      API::LiveListenerBuffer<DataObjects::EventWorkspace>::Logs::ClearValues};
   /// Run start time
   Types::Core::DateAndTime m_startTime;
   /// Run number
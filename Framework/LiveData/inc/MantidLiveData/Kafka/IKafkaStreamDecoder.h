@@ -193,8 +193,6 @@ protected:
   template <typename T>
   std::shared_ptr<T> createBufferWorkspace(const std::string &workspaceClassName, size_t nspectra, const int32_t *spec,
                                            const int32_t *udet, uint32_t length);
-  template <typename T>
-  std::shared_ptr<T> createBufferWorkspace(const std::string &workspaceClassName, const std::shared_ptr<T> &parent);
 
   template <typename T>
   bool loadInstrument(const std::string &name, std::shared_ptr<T> workspace, const std::string &jsonGeometry = "");
@@ -65,24 +65,6 @@ std::shared_ptr<T> IKafkaStreamDecoder::createBufferWorkspace(const std::string
   return buffer;
 }
 
-/**
- * Create new buffer workspace from an existing copy
- * @param workspaceClassName the name of the workspace class to be created e.g
- * Workspace2D or EventWorkspace
- * @param parent A reference to an existing workspace
- */
-template <typename T>
-std::shared_ptr<T> IKafkaStreamDecoder::createBufferWorkspace(const std::string &workspaceClassName,
-                                                              const std::shared_ptr<T> &parent) {
-  auto buffer = std::static_pointer_cast<T>(
-      API::WorkspaceFactory::Instance().create(workspaceClassName, parent->getNumberHistograms(), 2, 1));
-  // Copy meta data
-  API::WorkspaceFactory::Instance().initializeFromParent(*parent, *buffer, false);
-  // Clear out the old logs, except for the most recent entry
-  buffer->mutableRun().clearOutdatedTimeSeriesLogValues();
-  return buffer;
-}
-
 template <typename T> void loadFromAlgorithm(const std::string &name, std::shared_ptr<T> workspace) {
   auto alg = API::AlgorithmManager::Instance().createUnmanaged("LoadInstrument");
   // Do not put the workspace in the ADS
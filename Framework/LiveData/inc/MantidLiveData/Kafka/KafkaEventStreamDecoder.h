@@ -6,12 +6,18 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
+#include "MantidAPI/LiveListenerBuffer.h"
 #include "MantidAPI/SpectraDetectorTypes.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidLiveData/Kafka/IKafkaBroker.h"
 #include "MantidLiveData/Kafka/IKafkaStreamDecoder.h"
 #include "MantidLiveData/Kafka/IKafkaStreamSubscriber.h"
+#include "MantidLiveData/Kafka/SPSCRingBuffer.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <thread>
 #include <vector>
 
 namespace Mantid {
@@ -21,19 +27,23 @@ namespace LiveData {
   3 topic names of the data streams.
 
   A call to capture() starts the process of capturing the stream on a separate
-  thread.
+  thread. Event messages are passed through a lock-free queue to a second
+  thread that decodes them into per-spectrum buffers.
 */
 class DLLExport KafkaEventStreamDecoder : public IKafkaStreamDecoder {
 public:
-  struct BufferedPulse {
-    Types::Core::DateAndTime pulseTime;
-    int periodNumber;
-  };
-
-  struct BufferedEvent {
-    size_t wsIdx;
-    uint64_t tof;
-    size_t pulseIndex;
+  /// Statistics of the queue of event messages waiting to be decoded
+  struct QueueStatistics {
+    /// Number of messages passed to the decoder thread
+    size_t queuedMessages;
+    /// Number of messages decoded by the decoder thread
+    size_t decodedMessages;
+    /// Largest number of messages in the queue
+    size_t maxQueuedMessages;
+    /// Number of times the capture thread had to wait for space in the queue
+    size_t numStalls;
+    /// Total time the capture thread waited, in seconds
+    double stallDuration;
   };
 
 public:
@@ -54,12 +64,23 @@ public:
   bool hasReachedEndOfRun() noexcept override;
   ///@}
 
+  QueueStatistics queueStatistics() const;
+
 private:
   void captureImplExcept() override;
+  void captureEvents();
+
+  void startDecoder();
+  void stopDecoder();
+  void decodeEvents();
+  void queueEventMessage(std::string &buffer);
+  void waitForDecoder(size_t nMessages);
+  void rethrowDecoderException();
 
-  void eventDataFromMessage(const std::string &buffer, size_t &eventCount, uint64_t &pulseTimeRet);
+  void eventDataFromMessage(const std::string &buffer);
 
   void flushIntermediateBuffer();
+  void flushAllEvents();
 
   /// Create the cache workspaces, LoadLiveData extracts data from these
   void initLocalCaches(const RunStartStruct &runStartData) override;
@@ -71,20 +92,40 @@ private:
 
   /// Local event workspace buffers
   std::vector<DataObjects::EventWorkspace_sptr> m_localEvents;
-
-  /// Intermediate buffer for received events yet to be populated in
-  /// m_localEvents
-  std::vector<BufferedEvent> m_receivedEventBuffer;
-  std::vector<BufferedPulse> m_receivedPulseBuffer;
-  /// Mutex protecting intermediate buffers
-  mutable std::mutex m_intermediateBufferMutex;
+  /// Swaps m_localEvents for empty buffers in extractDataImpl()
+  API::LiveListenerBuffer<DataObjects::EventWorkspace> m_bufferSwap;
+
+  /// Decoded events yet to be populated in m_localEvents, by period and
+  /// workspace index. Owned by the decoder thread while it is running.
+  std::vector<std::vector<std::vector<Types::Event::TofEvent>>> m_eventBuffers;
+  /// Workspace indices with buffered events, by period
+  std::vector<std::vector<size_t>> m_bufferedSpectra;
+  /// The number of buffered events
+  size_t m_numBufferedEvents;
   /// The number of events above which the intermediate buffer will be flushed
   const std::size_t m_intermediateBufferFlushThreshold;
-};
 
-DLLExport std::vector<size_t>
-computeGroupBoundaries(const std::vector<KafkaEventStreamDecoder::BufferedEvent> &eventBuffer,
-                       const size_t numberOfGroups);
+  /// Event messages waiting to be decoded
+  SPSCRingBuffer<std::string> m_eventMessages;
+  /// Thread decoding the event messages
+  std::thread m_decoderThread;
+  /// Number of event messages added to the queue
+  std::atomic<size_t> m_queuedMessages;
+  /// Mutex protecting the decoder state below
+  mutable std::mutex m_decoderMutex;
+  std::condition_variable m_decoderCV;
+  /// Number of event messages decoded
+  size_t m_decodedMessages;
+  /// Tells the decoder thread to finish once the queue is empty
+  bool m_stopDecoder;
+  /// First exception thrown by the decoder thread
+  std::exception_ptr m_decoderException;
+
+  /// Backpressure statistics
+  std::atomic<size_t> m_maxQueuedMessages;
+  std::atomic<size_t> m_numStalls;
+  std::atomic<int64_t> m_stallNanoseconds;
+};
 
 } // namespace LiveData
 } // namespace Mantid
@@ -46,6 +46,7 @@ public:
   bool connect(const Poco::Net::SocketAddress &address) override;
   void start(Types::Core::DateAndTime startTime = Types::Core::DateAndTime()) override;
   std::shared_ptr<API::Workspace> extractData() override;
+  void requestFullUpdate() override;
 
   //----------------------------------------------------------------------
   // State flags
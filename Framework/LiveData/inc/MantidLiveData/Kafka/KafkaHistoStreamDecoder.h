@@ -11,6 +11,8 @@
 #include "MantidLiveData/Kafka/IKafkaStreamDecoder.h"
 #include "MantidLiveData/Kafka/IKafkaStreamSubscriber.h"
 
+#include <vector>
+
 namespace Mantid {
 namespace LiveData {
 
@@ -38,6 +40,11 @@ public:
   bool hasData() const noexcept override;
   bool hasReachedEndOfRun() noexcept override { return !m_capturing; }
 
+  /// Only return the spectra that changed since the last extraction
+  void setDeltaUpdates(bool deltaUpdates);
+  /// Return every spectrum from the next extraction
+  void requestFullUpdate();
+
 private:
   void captureImplExcept() override;
 
@@ -51,6 +58,13 @@ private:
 private:
   std::string m_buffer;
   DataObjects::Workspace2D_sptr m_workspace;
+
+  /// Return only the changed spectra from extractData()
+  bool m_deltaUpdates{false};
+  /// Bin edges and counts of the last extraction, compared with the next
+  /// message in delta update mode
+  std::vector<double> m_lastBinEdges;
+  std::vector<double> m_lastCounts;
 };
 
 } // namespace LiveData
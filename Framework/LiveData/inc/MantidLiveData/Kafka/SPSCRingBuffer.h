@@ -0,0 +1,87 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace LiveData {
+
+/**
+  A fixed size, lock-free queue for passing items from one producer thread to
+  one consumer thread. tryPush() must only be called by the producer and
+  tryPop() only by the consumer; neither ever blocks.
+
+  The head and tail counters only ever increase, the slot of an item is its
+  counter modulo the capacity. Each counter is written by one thread only and
+  kept on its own cache line.
+*/
+template <typename T> class SPSCRingBuffer {
+public:
+  explicit SPSCRingBuffer(std::size_t capacity) : m_slots(capacity), m_head(0), m_tail(0) {
+    if (capacity == 0) {
+      throw std::invalid_argument("SPSCRingBuffer capacity must be greater than zero");
+    }
+  }
+
+  SPSCRingBuffer(const SPSCRingBuffer &) = delete;
+  SPSCRingBuffer &operator=(const SPSCRingBuffer &) = delete;
+
+  /**
+   * Add an item to the back of the queue. Called by the producer only.
+   * @param item :: The item to add. It is left untouched if the queue is full.
+   * @return :: True if the item was added, false if the queue is full.
+   */
+  bool tryPush(T &&item) {
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == m_slots.size()) {
+      return false;
+    }
+    m_slots[tail % m_slots.size()] = std::move(item);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Remove the item at the front of the queue. Called by the consumer only.
+   * @param item :: Set to the removed item.
+   * @return :: True if an item was removed, false if the queue is empty.
+   */
+  bool tryPop(T &item) {
+    const auto head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = std::move(m_slots[head % m_slots.size()]);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Number of items in the queue. Exact only when called by the producer or the consumer.
+  std::size_t size() const {
+    const auto head = m_head.load(std::memory_order_acquire);
+    return m_tail.load(std::memory_order_acquire) - head;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  std::size_t capacity() const { return m_slots.size(); }
+
+private:
+  std::vector<T> m_slots;
+  /// Number of items removed, written by the consumer
+  alignas(64) std::atomic<std::size_t> m_head;
+  /// Number of items added, written by the producer
+  alignas(64) std::atomic<std::size_t> m_tail;
+};
+
+} // namespace LiveData
+} // namespace Mantid
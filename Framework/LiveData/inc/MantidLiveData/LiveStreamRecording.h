@@ -0,0 +1,71 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidLiveData/DllConfig.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Poco {
+namespace Net {
+class StreamSocket;
+}
+} // namespace Poco
+
+namespace Mantid {
+namespace LiveData {
+
+/// A block of bytes received from a live data stream
+struct LiveStreamRecord {
+  /// Time the block was received, in nanoseconds since the recording started
+  int64_t time = 0;
+  std::vector<char> data;
+};
+
+/**
+  Writes the raw bytes received from a live data stream to a file together with
+  the time they arrived, so the stream can be replayed later with its original
+  timing. The file starts with a header followed by the records, each one
+  being the time (int64), the number of bytes (uint32) and the bytes. Numbers
+  are stored in the byte order of the machine.
+*/
+class MANTID_LIVEDATA_DLL LiveStreamRecordWriter {
+public:
+  explicit LiveStreamRecordWriter(const std::string &filename);
+  void write(int64_t time, const char *data, std::size_t size);
+  /// Number of records written
+  std::size_t numberOfRecords() const { return m_numberOfRecords; }
+  /// Number of stream bytes written
+  uint64_t numberOfBytes() const { return m_numberOfBytes; }
+
+private:
+  std::ofstream m_file;
+  std::size_t m_numberOfRecords;
+  uint64_t m_numberOfBytes;
+};
+
+/**
+  Reads the records of a file written by LiveStreamRecordWriter in order.
+*/
+class MANTID_LIVEDATA_DLL LiveStreamRecordReader {
+public:
+  explicit LiveStreamRecordReader(const std::string &filename);
+  bool next(LiveStreamRecord &record);
+
+private:
+  std::ifstream m_file;
+};
+
+/// Send all of the bytes to the socket, retrying partial sends
+MANTID_LIVEDATA_DLL void sendAll(Poco::Net::StreamSocket &socket, const char *data, int size);
+
+} // namespace LiveData
+} // namespace Mantid
@@ -37,12 +37,15 @@ public:
 private:
   void init() override;
 
-  Mantid::API::Workspace_sptr runProcessing(Mantid::API::Workspace_sptr inputWS, bool PostProcess);
+  Mantid::API::Workspace_sptr runProcessing(Mantid::API::Workspace_sptr inputWS, bool PostProcess,
+                                            bool PostProcessChunk = false);
   Mantid::API::Workspace_sptr processChunk(Mantid::API::Workspace_sptr chunkWS);
   void runPostProcessing();
+  void runIncrementalPostProcessing(const Mantid::API::Workspace_sptr &chunkWS);
 
   void replaceChunk(Mantid::API::Workspace_sptr chunkWS);
-  void addChunk(const Mantid::API::Workspace_sptr &chunkWS);
+  void replaceChangedSpectra(const Mantid::API::Workspace_sptr &chunkWS);
+  void addChunk(Mantid::API::Workspace_sptr &accumWS, const Mantid::API::Workspace_sptr &chunkWS);
   void addMatrixWSChunk(const API::Workspace_sptr &accumWS, const API::Workspace_sptr &chunkWS);
   void addMDWSChunk(API::Workspace_sptr &accumWS, const API::Workspace_sptr &chunkWS);
   void appendChunk(const Mantid::API::Workspace_sptr &chunkWS);
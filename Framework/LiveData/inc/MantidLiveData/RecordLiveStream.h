@@ -0,0 +1,38 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidLiveData/DllConfig.h"
+
+namespace Mantid {
+namespace LiveData {
+
+/** RecordLiveStream : Records the bytes a live data server sends to a
+  listener so they can be replayed with ReplayLiveStream.
+
+  The algorithm sits between the listener and the server: the listener
+  connects to Port, the algorithm connects to Address and forwards the traffic
+  in both directions, recording what the server sends.
+*/
+class MANTID_LIVEDATA_DLL RecordLiveStream final : public API::Algorithm {
+public:
+  const std::string name() const override { return "RecordLiveStream"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "DataHandling\\DataAcquisition"; }
+  const std::vector<std::string> seeAlso() const override { return {"ReplayLiveStream", "BenchmarkLiveListener"}; }
+  const std::string summary() const override {
+    return "Records the data stream sent by a live data server to a file.";
+  }
+
+private:
+  void init() override;
+  void exec() override;
+};
+
+} // namespace LiveData
+} // namespace Mantid
@@ -0,0 +1,36 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidLiveData/DllConfig.h"
+
+namespace Mantid {
+namespace LiveData {
+
+/** ReplayLiveStream : Acts as a live data server that sends a stream recorded
+  by RecordLiveStream to the first listener that connects to Port, either with
+  the recorded timing, sped up or as fast as possible.
+
+  Records that could not be sent on time because the listener did not keep up
+  are counted as late.
+*/
+class MANTID_LIVEDATA_DLL ReplayLiveStream final : public API::Algorithm {
+public:
+  const std::string name() const override { return "ReplayLiveStream"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "DataHandling\\DataAcquisition"; }
+  const std::vector<std::string> seeAlso() const override { return {"RecordLiveStream", "BenchmarkLiveListener"}; }
+  const std::string summary() const override { return "Replays a recorded live data stream to a listener."; }
+
+private:
+  void init() override;
+  void exec() override;
+};
+
+} // namespace LiveData
+} // namespace Mantid
@@ -10,6 +10,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAPI/LiveListener.h"
+#include "MantidAPI/LiveListenerBuffer.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidLiveData/ADARA/ADARAParser.h"
 
@@ -97,14 +98,18 @@ private:
   // Returns true if we've got a value for every log listed in m_requiredLogs
   bool haveRequiredLogs();
 
-  void appendEvent(const uint32_t pixelId, const double tof, const Mantid::Types::Core::DateAndTime pulseTime);
+  // An event of a banked event packet, ready to be added to m_eventBuffer
+  struct DecodedEvent {
+    size_t workspaceIndex;
+    double tof;
+  };
+  size_t decodeBank(const ADARA::BankedEventPkt::BankSection &section, std::vector<DecodedEvent> &events) const;
   // tof is "Time Of Flight" and is in units of microsecondss relative to the
   // start of the pulse
   // (There's some documentation that says nanoseconds, but Russell Taylor
   // assures me it's really is microseconds!)
-  // pulseTime is the start of the pulse relative to Jan 1, 1990.
-  // Both values are designed to be passed straight into the TofEvent
-  // constructor.
+  // It's designed to be passed straight into the TofEvent constructor
+  // together with the pulse time.
 
   ILiveListener::RunStatus m_status{RunStatus::NoRun};
   int m_runNumber{0};
@@ -116,6 +121,9 @@ private:
   detid2index_map m_indexMap;        // maps pixel id's to workspace indexes
   detid2index_map m_monitorIndexMap; // Same as above for the monitor workspace
 
+  // Events of each bank of the current banked event packet
+  std::vector<std::vector<DecodedEvent>> m_decodedBanks;
+
   // We need these 2 strings to initialize m_buffer
   std::string m_instrumentName;
   std::string m_instrumentXML;
@@ -133,6 +141,8 @@ private:
 
   Poco::Thread m_thread;
   std::mutex m_mutex; // protects m_buffer & m_status
+  // Swaps m_eventBuffer for an empty buffer in extractData()
+  API::LiveListenerBuffer<DataObjects::EventWorkspace> m_bufferSwap;
   bool m_pauseNetRead{false};
   bool m_stopThread{false}; // background thread checks this periodically.
                             // If true, the thread exits
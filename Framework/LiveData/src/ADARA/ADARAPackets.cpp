@@ -247,6 +247,33 @@ void BankedEventPkt::firstEventInBank() const {
   }
 }
 
+std::vector<BankedEventPkt::BankSection> BankedEventPkt::bankSections() const {
+  std::vector<BankSection> sections;
+  const unsigned numFields = m_lastFieldIndex + 1;
+  unsigned sourceIndex = 4;
+  while (sourceIndex + 4 <= numFields) {
+    const uint32_t bankCount = m_fields[sourceIndex + 3];
+    // Same as in firstEventInSource()
+    const uint32_t tofOffset = ((m_fields[sourceIndex + 2] & 0x7FFFFFFF) != 0);
+    const bool isCorrected = ((m_fields[sourceIndex + 2] & 0x80000000) != 0);
+    unsigned bankIndex = sourceIndex + 4;
+    for (uint32_t bank = 0; bank < bankCount; ++bank) {
+      if (bankIndex + 2 > numFields)
+        throw invalid_packet("BankedEvent packet bank header is truncated");
+      const uint32_t eventCount = m_fields[bankIndex + 1];
+      if (eventCount > (numFields - bankIndex - 2) / 2)
+        throw invalid_packet("BankedEvent packet bank events are truncated");
+      if (eventCount > 0) {
+        sections.push_back({m_fields[bankIndex], eventCount, reinterpret_cast<const Event *>(&m_fields[bankIndex + 2]),
+                            isCorrected, tofOffset});
+      }
+      bankIndex += 2 + 2 * eventCount;
+    }
+    sourceIndex = bankIndex;
+  }
+  return sections;
+}
+
 /* ------------------------------------------------------------------------ */
 
 BeamMonitorPkt::BeamMonitorPkt(const uint8_t *data, uint32_t len)
@@ -0,0 +1,202 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidLiveData/BenchmarkLiveListener.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidAPI/IEventWorkspace.h"
+#include "MantidAPI/ITableWorkspace.h"
+#include "MantidAPI/LiveListenerFactory.h"
+#include "MantidAPI/TableRow.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidAPI/WorkspaceGroup.h"
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/ListValidator.h"
+#include "MantidKernel/LiveListenerInfo.h"
+#include "MantidLiveData/Exception.h"
+
+#include <Poco/Thread.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace Mantid::LiveData {
+// Register the algorithm into the algorithm factory
+DECLARE_ALGORITHM(BenchmarkLiveListener)
+
+using namespace Kernel;
+using namespace API;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/// Number of events in an extracted chunk
+int64_t countEvents(const Workspace_sptr &ws) {
+  if (auto eventWS = std::dynamic_pointer_cast<const IEventWorkspace>(ws))
+    return static_cast<int64_t>(eventWS->getNumberEvents());
+  int64_t total = 0;
+  if (auto group = std::dynamic_pointer_cast<WorkspaceGroup>(ws)) {
+    for (int i = 0; i < group->getNumberOfEntries(); ++i)
+      total += countEvents(group->getItem(i));
+  }
+  return total;
+}
+
+/// Nearest rank percentile of sorted values
+double percentile(const std::vector<double> &sorted, double fraction) {
+  if (sorted.empty())
+    return 0.0;
+  const auto rank = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+  return sorted[std::min(rank, sorted.size() - 1)];
+}
+} // namespace
+
+/**
+ * Declare the algorithm properties
+ */
+void BenchmarkLiveListener::init() {
+  declareProperty(std::make_unique<FileProperty>("Filename", "", FileProperty::Load, ".livestream"),
+                  "A stream recorded by RecordLiveStream.");
+  declareProperty(std::make_unique<PropertyWithValue<std::string>>(
+                      "Listener", "", std::make_shared<StringListValidator>(LiveListenerFactory::Instance().getKeys())),
+                  "The listener to benchmark, it must understand the recorded stream.");
+  declareProperty(std::make_unique<PropertyWithValue<int>>("Port", 59876, Direction::Input),
+                  "The port the stream is replayed on.");
+  auto mustBePositive = std::make_shared<BoundedValidator<double>>();
+  mustBePositive->setLower(0.0);
+  declareProperty("SpeedFactor", 1.0, mustBePositive,
+                  "How much faster than recorded to replay the stream. If 0 it "
+                  "is sent as fast as the listener reads it.");
+  auto intervalMustBePositive = std::make_shared<BoundedValidator<double>>();
+  intervalMustBePositive->setLower(1e-3);
+  declareProperty("UpdateEvery", 0.1, intervalMustBePositive, "Time between extracting the data in seconds.");
+  declareProperty(std::make_unique<WorkspaceProperty<ITableWorkspace>>("OutputWorkspace", "", Direction::Output),
+                  "A table with the time, the number of events and the time "
+                  "taken by extractData for each update.");
+  declareProperty("NumberOfEvents", int64_t(0), "The number of events extracted.", Direction::Output);
+  declareProperty("EventsPerSecond", 0.0, "The rate events were extracted at, sustained over the replay.",
+                  Direction::Output);
+  declareProperty("ExtractTimeP50", 0.0, "Median time taken by extractData in milliseconds.", Direction::Output);
+  declareProperty("ExtractTimeP90", 0.0, "90th percentile of the time taken by extractData in milliseconds.",
+                  Direction::Output);
+  declareProperty("ExtractTimeP99", 0.0, "99th percentile of the time taken by extractData in milliseconds.",
+                  Direction::Output);
+  declareProperty("DrainTime", 0.0,
+                  "Time between the end of the replay and the last events "
+                  "being extracted in seconds.",
+                  Direction::Output);
+  declareProperty("LateRecords", 0,
+                  "The number of records the replay sent late because the "
+                  "listener did not read the stream fast enough.",
+                  Direction::Output);
+}
+
+/**
+ * Create the listener and connect it to the replay, retrying until the replay
+ * is listening.
+ * @param replay :: The result of the running replay.
+ * @return :: The connected listener.
+ */
+ILiveListener_sptr BenchmarkLiveListener::connectListener(const Poco::ActiveResult<bool> &replay) {
+  const LiveListenerInfo info(getPropertyValue("Listener"), "127.0.0.1:" + getPropertyValue("Port"));
+  const int maxAttempts = 100;
+  for (int attempt = 1;; ++attempt) {
+    try {
+      return LiveListenerFactory::Instance().create(info, true, this);
+    } catch (std::runtime_error &) {
+      if (attempt == maxAttempts || replay.available())
+        throw;
+    }
+    interruption_point();
+    Poco::Thread::sleep(100);
+  }
+}
+
+/**
+ * Execute the algorithm.
+ */
+void BenchmarkLiveListener::exec() {
+  const double updateEvery = getProperty("UpdateEvery");
+
+  auto replay = createChildAlgorithm("ReplayLiveStream", -1.0, -1.0);
+  replay->setPropertyValue("Filename", getPropertyValue("Filename"));
+  replay->setPropertyValue("Port", getPropertyValue("Port"));
+  replay->setPropertyValue("SpeedFactor", getPropertyValue("SpeedFactor"));
+  auto replayResult = replay->executeAsync();
+
+  auto table = WorkspaceFactory::Instance().createTable();
+  table->addColumn("double", "Time");
+  table->addColumn("long64", "Events");
+  table->addColumn("double", "ExtractTime");
+
+  int64_t totalEvents = 0;
+  std::vector<double> extractTimes;
+  const auto start = Clock::now();
+  auto replayEnd = start;
+  auto lastEvents = start;
+  try {
+    auto listener = connectListener(replayResult);
+    listener->start();
+
+    bool replayFinished = false;
+    auto nextUpdate = Clock::now();
+    while (true) {
+      nextUpdate += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(updateEvery));
+      std::this_thread::sleep_until(nextUpdate);
+      interruption_point();
+      // Checked before extracting so that all of the data sent is in the chunk
+      if (!replayFinished && replayResult.available()) {
+        replayFinished = true;
+        replayEnd = Clock::now();
+      }
+
+      const auto extractStart = Clock::now();
+      Workspace_sptr chunk;
+      try {
+        chunk = listener->extractData();
+      } catch (Exception::NotYet &) {
+        continue;
+      } catch (std::runtime_error &) {
+        // Listeners may report the end of the stream as an error
+        if (replayFinished)
+          break;
+        throw;
+      }
+      const auto extractEnd = Clock::now();
+      const int64_t events = countEvents(chunk);
+      extractTimes.emplace_back(std::chrono::duration<double, std::milli>(extractEnd - extractStart).count());
+      TableRow row = table->appendRow();
+      row << std::chrono::duration<double>(extractEnd - start).count() << events << extractTimes.back();
+
+      totalEvents += events;
+      if (events > 0)
+        lastEvents = extractEnd;
+      else if (replayFinished)
+        break;
+    }
+  } catch (...) {
+    replay->cancel();
+    replayResult.wait();
+    throw;
+  }
+  replayResult.wait();
+  if (!replay->isExecuted())
+    throw std::runtime_error("Replaying the stream failed, see the log for details.");
+
+  const double replayTime = std::chrono::duration<double>(replayEnd - start).count();
+  std::sort(extractTimes.begin(), extractTimes.end());
+  setProperty("OutputWorkspace", table);
+  setProperty("NumberOfEvents", totalEvents);
+  setProperty("EventsPerSecond", replayTime > 0 ? static_cast<double>(totalEvents) / replayTime : 0.0);
+  setProperty("ExtractTimeP50", percentile(extractTimes, 0.5));
+  setProperty("ExtractTimeP90", percentile(extractTimes, 0.9));
+  setProperty("ExtractTimeP99", percentile(extractTimes, 0.99));
+  setProperty("DrainTime", std::max(0.0, std::chrono::duration<double>(lastEvents - replayEnd).count()));
+  const int lateRecords = replay->getProperty("LateRecords");
+  setProperty("LateRecords", lateRecords);
+}
+
+} // namespace Mantid::LiveData
@@ -166,26 +166,13 @@ std::shared_ptr<API::Workspace> ISISLiveEventDataListener::extractData() {
     throw std::runtime_error("Background thread stopped.");
   }
 
-  std::lock_guard<std::mutex> scopedLock(m_mutex);
-
-  std::vector<DataObjects::EventWorkspace_sptr> outWorkspaces(m_numberOfPeriods);
-  for (size_t i = 0; i < static_cast<size_t>(m_numberOfPeriods); ++i) {
-
-    // Make a brand new EventWorkspace
-    DataObjects::EventWorkspace_sptr temp = std::dynamic_pointer_cast<DataObjects::EventWorkspace>(
-        API::WorkspaceFactory::Instance().create("EventWorkspace", m_eventBuffer[i]->getNumberHistograms(), 2, 1));
-
-    // Copy geometry over.
-    API::WorkspaceFactory::Instance().initializeFromParent(*m_eventBuffer[i], *temp, false);
-
-    // Clear out the old logs
-    temp->mutableRun().clearTimeSeriesLogs();
-
-    // Swap the workspaces
-    std::swap(m_eventBuffer[i], temp);
-
-    outWorkspaces[i] = temp;
+  std::vector<DataObjects::EventWorkspace_sptr> outWorkspaces;
+  {
+    std::lock_guard<std::mutex> scopedLock(m_mutex);
+    outWorkspaces = m_bufferSwap.swap(m_eventBuffer);
   }
+  // Create the buffers for the next call without blocking the background thread
+  m_bufferSwap.prepare(outWorkspaces);
 
   if (m_numberOfPeriods > 1) {
     // create a workspace group in case the data are multiperiod
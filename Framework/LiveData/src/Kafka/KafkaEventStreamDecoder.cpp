@@ -34,8 +34,6 @@ GNU_DIAG_ON("conversion")
 #include <numeric>
 #include <utility>
 
-#include <tbb/parallel_sort.h>
-
 using namespace Mantid::Types;
 using Mantid::Kernel::ConfigService;
 
@@ -61,6 +59,9 @@ const std::string RUN_START_PROPERTY = "run_start";
 const std::string EVENT_MESSAGE_ID = "ev42";
 const std::string SAMPLE_MESSAGE_ID = "f142";
 
+/// Number of event messages that can wait to be decoded
+constexpr size_t EVENT_MESSAGE_QUEUE_SIZE = 64;
+
 /**
  * Append sample log data to existing log or create a new log if one with
  * specified name does not already exist
@@ -83,22 +84,6 @@ void appendToLog(Mantid::API::Run &mutableRunInfo, const std::string &name, cons
   }
 }
 
-void sortIntermediateEventBuffer(
-    std::vector<Mantid::LiveData::KafkaEventStreamDecoder::BufferedEvent> &eventBuffer,
-    const std::vector<Mantid::LiveData::KafkaEventStreamDecoder::BufferedPulse> &pulseBuffer) {
-  tbb::parallel_sort(eventBuffer.begin(), eventBuffer.end(),
-                     [&](const Mantid::LiveData::KafkaEventStreamDecoder::BufferedEvent &lhs,
-                         const Mantid::LiveData::KafkaEventStreamDecoder::BufferedEvent &rhs) -> bool {
-                       const auto &lhsPulse = pulseBuffer[lhs.pulseIndex];
-                       const auto &rhsPulse = pulseBuffer[rhs.pulseIndex];
-
-                       /* If events are from different periods compare the period
-                        * numbers, otherwise compare the workspace index */
-                       return (lhsPulse.periodNumber != rhsPulse.periodNumber)
-                                  ? lhsPulse.periodNumber < rhsPulse.periodNumber
-                                  : lhs.wsIdx < rhs.wsIdx;
-                     });
-}
 } // namespace
 
 namespace Mantid::LiveData {
@@ -119,7 +104,9 @@ KafkaEventStreamDecoder::KafkaEventStreamDecoder(std::shared_ptr<IKafkaBroker> b
                                                  const std::string &chopperTopic, const std::string &monitorTopic,
                                                  const std::size_t bufferThreshold)
     : IKafkaStreamDecoder(std::move(broker), eventTopic, runInfoTopic, sampleEnvTopic, chopperTopic, monitorTopic),
-      m_intermediateBufferFlushThreshold(bufferThreshold) {
+      m_numBufferedEvents(0), m_intermediateBufferFlushThreshold(bufferThreshold),
+      m_eventMessages(EVENT_MESSAGE_QUEUE_SIZE), m_queuedMessages(0), m_decodedMessages(0), m_stopDecoder(false),
+      m_maxQueuedMessages(0), m_numStalls(0), m_stallNanoseconds(0) {
 #ifndef _OPENMP
   g_log.warning() << "Multithreading is not available on your system. This "
                      "is likely to be an issue with high event counts.\n";
@@ -149,15 +136,20 @@ KafkaEventStreamDecoder::~KafkaEventStreamDecoder() {
    * capture has fully completed before local state is deleted.
    */
   stopCapture();
+  stopDecoder();
 }
 
 KafkaEventStreamDecoder::KafkaEventStreamDecoder(KafkaEventStreamDecoder &&o) noexcept
-    : IKafkaStreamDecoder(std::move(o)), m_intermediateBufferFlushThreshold(o.m_intermediateBufferFlushThreshold) {
+    : IKafkaStreamDecoder(std::move(o)), m_numBufferedEvents(0),
+      m_intermediateBufferFlushThreshold(o.m_intermediateBufferFlushThreshold),
+      m_eventMessages(EVENT_MESSAGE_QUEUE_SIZE), m_queuedMessages(0), m_decodedMessages(0), m_stopDecoder(false),
+      m_maxQueuedMessages(0), m_numStalls(0), m_stallNanoseconds(0) {
 
-  std::scoped_lock lck(m_intermediateBufferMutex, m_mutex);
+  std::lock_guard<std::mutex> lck(m_mutex);
   m_localEvents = std::move(o.m_localEvents);
-  m_receivedEventBuffer = std::move(o.m_receivedEventBuffer);
-  m_receivedPulseBuffer = std::move(o.m_receivedPulseBuffer);
+  m_eventBuffers = std::move(o.m_eventBuffers);
+  m_bufferedSpectra = std::move(o.m_bufferedSpectra);
+  m_numBufferedEvents = o.m_numBufferedEvents;
 }
 
 /**
@@ -189,38 +181,74 @@ bool KafkaEventStreamDecoder::hasReachedEndOfRun() noexcept {
   return false;
 }
 
+/**
+ * Get the statistics of the queue between the capture and the decoder threads
+ * @return The number of queued and decoded messages, the largest number of
+ * messages in the queue and how often and for how long the capture thread had
+ * to wait for the decoder
+ */
+KafkaEventStreamDecoder::QueueStatistics KafkaEventStreamDecoder::queueStatistics() const {
+  size_t decodedMessages;
+  {
+    std::lock_guard<std::mutex> decoderLock(m_decoderMutex);
+    decodedMessages = m_decodedMessages;
+  }
+  return {m_queuedMessages, decodedMessages, m_maxQueuedMessages, m_numStalls,
+          static_cast<double>(m_stallNanoseconds) * 1e-9};
+}
+
 // -----------------------------------------------------------------------------
 // Private members
 // -----------------------------------------------------------------------------
 
 API::Workspace_sptr KafkaEventStreamDecoder::extractDataImpl() {
-  std::lock_guard<std::mutex> workspaceLock(m_mutex);
-  g_log.debug() << "Events since last timeout " << totalNumEventsSinceStart - totalNumEventsBeforeLastTimeout
-                << std::endl;
-  totalNumEventsBeforeLastTimeout = totalNumEventsSinceStart;
-
-  if (m_localEvents.size() == 1) {
-    auto temp = createBufferWorkspace<DataObjects::EventWorkspace>("EventWorkspace", m_localEvents.front());
-    std::swap(m_localEvents.front(), temp);
-    return temp;
-  } else if (m_localEvents.size() > 1) {
-    auto group = std::make_shared<API::WorkspaceGroup>();
-    size_t index(0);
-    for (auto &filledBuffer : m_localEvents) {
-      auto temp = createBufferWorkspace<DataObjects::EventWorkspace>("EventWorkspace", filledBuffer);
-      std::swap(m_localEvents[index++], temp);
-      group->addWorkspace(temp);
+  // Let the decoder catch up with the messages received so far
+  waitForDecoder(m_queuedMessages);
+
+  std::vector<DataObjects::EventWorkspace_sptr> filledBuffers;
+  {
+    std::lock_guard<std::mutex> workspaceLock(m_mutex);
+    g_log.debug() << "Events since last timeout " << totalNumEventsSinceStart - totalNumEventsBeforeLastTimeout
+                  << std::endl;
+    totalNumEventsBeforeLastTimeout = totalNumEventsSinceStart;
+
+    if (m_localEvents.empty()) {
+      throw Exception::NotYet("Local buffers not initialized.");
     }
-    return group;
-  } else {
-    throw Exception::NotYet("Local buffers not initialized.");
+    filledBuffers = m_bufferSwap.swap(m_localEvents);
+  }
+  // Create the buffers for the next call without blocking the decoder
+  m_bufferSwap.prepare(filledBuffers);
+
+  if (filledBuffers.size() == 1) {
+    return filledBuffers.front();
+  }
+  auto group = std::make_shared<API::WorkspaceGroup>();
+  for (const auto &filledBuffer : filledBuffers) {
+    group->addWorkspace(filledBuffer);
   }
+  return group;
 }
 
 /**
  * Exception-throwing variant of captureImpl(). Do not call this directly
  */
 void KafkaEventStreamDecoder::captureImplExcept() {
+  startDecoder();
+  try {
+    captureEvents();
+  } catch (...) {
+    stopDecoder();
+    throw;
+  }
+  stopDecoder();
+}
+
+/**
+ * Consume the messages from the streams. Event messages are queued for the
+ * decoder thread, all other messages are processed on this thread.
+ */
+void KafkaEventStreamDecoder::captureEvents() {
   g_log.debug("Event capture starting");
 
   // Load runstart struct then initialise the cache
@@ -259,7 +287,7 @@ void KafkaEventStreamDecoder::captureImplExcept() {
     if (m_endRun) {
       /* Ensure the intermediate buffer is flushed so as to prevent
        * EventWorksapces containing events from other runs. */
-      flushIntermediateBuffer();
+      flushAllEvents();
 
       waitForRunEndObservation();
       continue;
@@ -278,6 +306,7 @@ void KafkaEventStreamDecoder::captureImplExcept() {
       continue;
     }
 
+    rethrowDecoderException();
     writeChopperTimestampsToWorkspaceLogs(m_localEvents);
 
     const auto end = std::chrono::system_clock::now();
@@ -291,10 +320,17 @@ void KafkaEventStreamDecoder::captureImplExcept() {
       const auto mpp = static_cast<double>(numMessagesForSinglePulse) / static_cast<double>(pulseTimeCount);
       g_log.debug() << mpp << " event messages per pulse\n";
       g_log.debug() << "Achievable pulse rate is " << rate / mpp << "Hz\n";
-      g_log.debug() << "Average time taken to convert event messages "
-                    << totalEventFromMessageDuration / numEventFromMessageCalls << " seconds\n";
-      g_log.debug() << "Average time taken to populate workspace "
-                    << totalPopulateWorkspaceDuration / numPopulateWorkspaceCalls << " seconds\n";
+      {
+        std::lock_guard<std::mutex> decoderLock(m_decoderMutex);
+        g_log.debug() << "Average time taken to convert event messages "
+                      << totalEventFromMessageDuration / numEventFromMessageCalls << " seconds\n";
+        g_log.debug() << "Average time taken to populate workspace "
+                      << totalPopulateWorkspaceDuration / numPopulateWorkspaceCalls << " seconds\n";
+      }
+      const auto statistics = queueStatistics();
+      g_log.debug() << "At most " << statistics.maxQueuedMessages << " event messages waiting to be decoded, "
+                    << "waited " << statistics.numStalls << " times for " << statistics.stallDuration
+                    << " seconds in total\n";
       start = std::chrono::system_clock::now();
     }
 
@@ -311,8 +347,10 @@ void KafkaEventStreamDecoder::captureImplExcept() {
     // Check if we have an event message
     // Most will be event messages so we check for this type first
     if (flatbuffers::BufferHasIdentifier(reinterpret_cast<const uint8_t *>(buffer.c_str()), EVENT_MESSAGE_ID.c_str())) {
-      uint64_t currentPulseTime(-1);
-      eventDataFromMessage(buffer, nEvents, currentPulseTime);
+      const auto eventMsg = GetEventMessage(reinterpret_cast<const uint8_t *>(buffer.c_str()));
+      const auto currentPulseTime = static_cast<uint64_t>(eventMsg->pulse_time());
+      nEvents += eventMsg->time_of_flight()->size();
+      queueEventMessage(buffer);
 
       if (lastPulseTime == 0)
         lastPulseTime = currentPulseTime;
@@ -328,12 +366,6 @@ void KafkaEventStreamDecoder::captureImplExcept() {
       eventsPerMessage = nEvents - lastMessageEvents;
       lastMessageEvents = nEvents;
 
-      /* If there are enough events in the receive buffer then empty it into
-       * the EventWorkspace(s) */
-      if (m_receivedEventBuffer.size() > m_intermediateBufferFlushThreshold) {
-        flushIntermediateBuffer();
-      }
-
       totalNumEventsSinceStart = nEvents;
       ++nMessages;
       ++totalMessages;
@@ -350,7 +382,7 @@ void KafkaEventStreamDecoder::captureImplExcept() {
   }
 
   /* Flush any remaining events when capture is terminated */
-  flushIntermediateBuffer();
+  flushAllEvents();
 
   const auto globend = std::chrono::system_clock::now();
   const std::chrono::duration<double> dur = globend - globstart;
@@ -366,112 +398,219 @@ void KafkaEventStreamDecoder::captureImplExcept() {
   numEventFromMessageCalls = 0;
 }
 
-void KafkaEventStreamDecoder::eventDataFromMessage(const std::string &buffer, size_t &eventCount,
-                                                   uint64_t &pulseTimeRet) {
+/// Start the thread decoding the event messages
+void KafkaEventStreamDecoder::startDecoder() {
+  {
+    std::lock_guard<std::mutex> decoderLock(m_decoderMutex);
+    m_stopDecoder = false;
+    m_decoderException = nullptr;
+  }
+  m_decoderThread = std::thread([this]() { this->decodeEvents(); });
+}
+
+/// Stop the decoder thread once it has decoded all queued messages
+void KafkaEventStreamDecoder::stopDecoder() {
+  {
+    std::lock_guard<std::mutex> decoderLock(m_decoderMutex);
+    m_stopDecoder = true;
+  }
+  m_decoderCV.notify_all();
+  if (m_decoderThread.joinable()) {
+    m_decoderThread.join();
+  }
+}
+
+/**
+ * Body of the decoder thread. Decodes the queued event messages into the
+ * intermediate buffer and flushes it when it is full. Exceptions are kept to
+ * be rethrown on the capture thread.
+ */
+void KafkaEventStreamDecoder::decodeEvents() {
+  std::string buffer;
+  while (true) {
+    if (!m_eventMessages.tryPop(buffer)) {
+      std::unique_lock<std::mutex> decoderLock(m_decoderMutex);
+      if (m_stopDecoder && m_eventMessages.empty()) {
+        return;
+      }
+      // A message queued just before waiting is picked up after the timeout
+      m_decoderCV.wait_for(decoderLock, std::chrono::milliseconds(1),
+                           [this] { return m_stopDecoder || !m_eventMessages.empty(); });
+      continue;
+    }
+
+    try {
+      eventDataFromMessage(buffer);
+      /* If there are enough events in the receive buffer then empty it into
+       * the EventWorkspace(s) */
+      if (m_numBufferedEvents > m_intermediateBufferFlushThreshold) {
+        flushIntermediateBuffer();
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> decoderLock(m_decoderMutex);
+      if (!m_decoderException) {
+        m_decoderException = std::current_exception();
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> decoderLock(m_decoderMutex);
+      ++m_decodedMessages;
+    }
+    m_decoderCV.notify_all();
+  }
+}
+
+/**
+ * Pass an event message to the decoder thread. If the queue is full wait
+ * for the decoder to catch up.
+ * @param buffer The message, moved into the queue
+ */
+void KafkaEventStreamDecoder::queueEventMessage(std::string &buffer) {
+  const auto queued = m_eventMessages.size() + 1;
+  if (!m_eventMessages.tryPush(std::move(buffer))) {
+    const auto startTime = std::chrono::steady_clock::now();
+    do {
+      rethrowDecoderException();
+      std::this_thread::yield();
+    } while (!m_eventMessages.tryPush(std::move(buffer)));
+    const auto stall = std::chrono::steady_clock::now() - startTime;
+    ++m_numStalls;
+    m_stallNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(stall).count();
+  }
+  ++m_queuedMessages;
+  if (queued > m_maxQueuedMessages) {
+    m_maxQueuedMessages = queued;
+  }
+  m_decoderCV.notify_one();
+}
+
+/**
+ * Wait until the decoder thread has decoded a number of messages
+ * @param nMessages The number of messages counted since construction
+ */
+void KafkaEventStreamDecoder::waitForDecoder(size_t nMessages) {
+  std::unique_lock<std::mutex> decoderLock(m_decoderMutex);
+  m_decoderCV.wait(decoderLock, [&] { return m_decodedMessages >= nMessages; });
+}
+
+/// Rethrow an exception thrown by the decoder thread on the calling thread
+void KafkaEventStreamDecoder::rethrowDecoderException() {
+  std::lock_guard<std::mutex> decoderLock(m_decoderMutex);
+  if (m_decoderException) {
+    std::rethrow_exception(m_decoderException);
+  }
+}
+
+/**
+ * Decode an event message into the intermediate buffer. The events are
+ * appended directly from the message to the buffer of their spectrum.
+ * @param buffer An ev42 event message
+ */
+void KafkaEventStreamDecoder::eventDataFromMessage(const std::string &buffer) {
   /* Parse message */
   const auto eventMsg = GetEventMessage(reinterpret_cast<const uint8_t *>(buffer.c_str()));
 
   /* Parse pulse time */
-  pulseTimeRet = static_cast<uint64_t>(eventMsg->pulse_time());
-  const DateAndTime pulseTime(pulseTimeRet);
+  const DateAndTime pulseTime(static_cast<uint64_t>(eventMsg->pulse_time()));
 
   /* Get TOF and detector ID buffers */
   const auto &tofData = *(eventMsg->time_of_flight());
   const auto &detData = *(eventMsg->detector_id());
-  /* Increment event count */
   const auto nEvents = tofData.size();
-  eventCount += nEvents;
-
-  /* Create buffered pulse */
-  BufferedPulse pulse{pulseTime, 0};
 
   /* Perform facility specific operations */
+  int periodNumber = 0;
   if (eventMsg->facility_specific_data_type() == FacilityData::ISISData) {
     std::lock_guard<std::mutex> workspaceLock(m_mutex);
     const auto ISISMsg = static_cast<const ISISData *>(eventMsg->facility_specific_data());
-    pulse.periodNumber = static_cast<int>(ISISMsg->period_number());
-    auto periodWs = m_localEvents[pulse.periodNumber];
+    periodNumber = static_cast<int>(ISISMsg->period_number());
+    auto periodWs = m_localEvents[periodNumber];
     auto &mutableRunInfo = periodWs->mutableRun();
     mutableRunInfo.getTimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY)->addValue(pulseTime, ISISMsg->proton_charge());
   }
 
   const auto starttime = std::chrono::system_clock::now();
 
-  {
-    std::lock_guard<std::mutex> bufferLock(m_intermediateBufferMutex);
-
-    /* Store the buffered pulse */
-    m_receivedPulseBuffer.emplace_back(pulse);
-    const auto pulseIndex = m_receivedPulseBuffer.size() - 1;
-
-    /* Ensure storage for newly received events */
-    const auto oldBufferSize(m_receivedEventBuffer.size());
-    m_receivedEventBuffer.reserve(oldBufferSize + nEvents);
-
-    std::transform(detData.begin(), detData.end(), tofData.begin(), std::back_inserter(m_receivedEventBuffer),
-                   [&](uint64_t detId, uint64_t tof) -> BufferedEvent {
-                     const auto workspaceIndex = m_eventIdToWkspIdx(detId);
-                     return {workspaceIndex, tof, pulseIndex};
-                   });
+  auto &spectrumBuffers = m_eventBuffers[periodNumber];
+  auto &bufferedSpectra = m_bufferedSpectra[periodNumber];
+  for (flatbuffers::uoffset_t i = 0; i < nEvents; ++i) {
+    const auto workspaceIndex = m_eventIdToWkspIdx(detData[i]);
+    auto &events = spectrumBuffers[workspaceIndex];
+    if (events.empty()) {
+      bufferedSpectra.emplace_back(workspaceIndex);
+    }
+    // nanoseconds to microseconds
+    events.emplace_back(static_cast<double>(tofData[i]) * 1e-3, pulseTime);
   }
+  m_numBufferedEvents += nEvents;
 
   const auto endTime = std::chrono::system_clock::now();
   const std::chrono::duration<double> dur = endTime - starttime;
+  std::lock_guard<std::mutex> decoderLock(m_decoderMutex);
   totalEventFromMessageDuration += dur.count();
   numEventFromMessageCalls += 1;
 }
 
+/**
+ * Add the buffered events to the EventWorkspace(s). Must be called by the
+ * decoder thread or when the decoder is idle.
+ */
 void KafkaEventStreamDecoder::flushIntermediateBuffer() {
   /* Do nothing if there are no buffered events */
-  if (m_receivedEventBuffer.empty()) {
+  if (m_numBufferedEvents == 0) {
     return;
   }
 
-  g_log.debug() << "Populating event workspace with " << m_receivedEventBuffer.size() << " events\n";
+  g_log.debug() << "Populating event workspace with " << m_numBufferedEvents << " events\n";
 
   const auto startTime = std::chrono::system_clock::now();
 
-  std::lock_guard<std::mutex> bufferLock(m_intermediateBufferMutex);
-
-  sortIntermediateEventBuffer(m_receivedEventBuffer, m_receivedPulseBuffer);
-
-  /* Compute groups for parallel insertion */
-  const auto numberOfGroups = PARALLEL_GET_MAX_THREADS;
-  const auto groupBoundaries = computeGroupBoundaries(m_receivedEventBuffer, numberOfGroups);
-
-  /* Insert events into EventWorkspace(s) */
+  /* Insert events into EventWorkspace(s), one spectrum per task */
   {
     std::lock_guard<std::mutex> workspaceLock(m_mutex);
 
-    for (auto &ws : m_localEvents) {
+    for (size_t period = 0; period < m_localEvents.size(); ++period) {
+      auto &bufferedSpectra = m_bufferedSpectra[period];
+      if (bufferedSpectra.empty()) {
+        continue;
+      }
+      auto &ws = m_localEvents[period];
       ws->invalidateCommonBinsFlag();
-    }
-
-    PARALLEL_FOR_NO_WSP_CHECK()
-    for (auto group = 0; group < numberOfGroups; ++group) {
-      for (auto idx = groupBoundaries[group]; idx < groupBoundaries[group + 1]; ++idx) {
-        const auto &event = m_receivedEventBuffer[idx];
-        const auto &pulse = m_receivedPulseBuffer[event.pulseIndex];
-
-        auto *spectrum = m_localEvents[pulse.periodNumber]->getSpectrumUnsafe(event.wsIdx);
-
-        // nanoseconds to microseconds
-        spectrum->addEventQuickly(TofEvent(static_cast<double>(event.tof) * 1e-3, pulse.pulseTime));
+      auto &spectrumBuffers = m_eventBuffers[period];
+
+      const auto numberOfSpectra = static_cast<int64_t>(bufferedSpectra.size());
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int64_t i = 0; i < numberOfSpectra; ++i) {
+        const auto workspaceIndex = bufferedSpectra[i];
+        auto &events = spectrumBuffers[workspaceIndex];
+        *ws->getSpectrumUnsafe(workspaceIndex) += events;
+        // Keep the capacity for the next events of the spectrum
+        events.clear();
       }
+      bufferedSpectra.clear();
     }
   }
-
-  /* Clear buffers */
-  m_receivedPulseBuffer.clear();
-  m_receivedEventBuffer.clear();
+  m_numBufferedEvents = 0;
 
   const auto endTime = std::chrono::system_clock::now();
   const std::chrono::duration<double> dur = endTime - startTime;
   g_log.debug() << "Time to populate EventWorkspace: " << dur.count() << '\n';
 
+  std::lock_guard<std::mutex> decoderLock(m_decoderMutex);
   totalPopulateWorkspaceDuration += dur.count();
   numPopulateWorkspaceCalls += 1;
-} // namespace LiveData
+}
+
+/**
+ * Wait for the decoder to decode all queued messages and add all buffered
+ * events to the EventWorkspace(s). Called by the capture thread.
+ */
+void KafkaEventStreamDecoder::flushAllEvents() {
+  waitForDecoder(m_queuedMessages);
+  rethrowDecoderException();
+  flushIntermediateBuffer();
+}
 
 /**
  * Get sample environment log data from the flatbuffer and append it to the
@@ -609,51 +748,13 @@ void KafkaEventStreamDecoder::initLocalCaches(const RunStartStruct &runStartData
       m_localEvents[i] = eventBuffer->clone();
     }
   }
+  // The decoder is idle until the capture thread queues the next message
+  m_eventBuffers.assign(nperiods, std::vector<std::vector<TofEvent>>(eventBuffer->getNumberHistograms()));
+  m_bufferedSpectra.assign(nperiods, std::vector<size_t>());
+  m_numBufferedEvents = 0;
 
   // New caches so LoadLiveData's output workspace needs to be replaced
   m_dataReset = true;
 }
 
-std::vector<size_t>
-computeGroupBoundaries(const std::vector<Mantid::LiveData::KafkaEventStreamDecoder::BufferedEvent> &eventBuffer,
-                       const size_t numberOfGroups) {
-  std::vector<size_t> groupBoundaries(numberOfGroups + 1, eventBuffer.size());
-
-  /* First group always starts at beginning of buffer */
-  groupBoundaries[0] = 0;
-
-  const auto eventsPerGroup = std::max<size_t>(1, eventBuffer.size() / numberOfGroups);
-
-  /* Iterate over groups */
-  for (size_t group = 1; group < numberOfGroups; ++group) {
-    /* Calculate a reasonable end boundary for the group */
-    groupBoundaries[group] = std::min(groupBoundaries[group - 1] + eventsPerGroup - 1, eventBuffer.size());
-
-    /* If we have already gotten through all events then exit early, leaving
-     * some threads without events. */
-    if (groupBoundaries[group] == eventBuffer.size()) {
-      break;
-    }
-
-    /* Advance the end boundary of the group until all events for a given
-     * workspace index fall within a single group */
-    while (groupBoundaries[group] + 1 < eventBuffer.size() &&
-           (eventBuffer[groupBoundaries[group]].wsIdx == eventBuffer[groupBoundaries[group] + 1].wsIdx)) {
-      ++groupBoundaries[group];
-    }
-
-    /* Increment group end boundary (such that group is defined by [lower,
-     * upper) boundaries) */
-    ++groupBoundaries[group];
-
-    /* If we have already gotten through all events then exit early, leaving
-     * some threads without events. */
-    if (groupBoundaries[group] >= eventBuffer.size()) {
-      break;
-    }
-  }
-
-  return groupBoundaries;
-}
-
 } // namespace Mantid::LiveData
@@ -20,7 +20,13 @@ namespace Mantid::LiveData {
 
 DECLARE_LISTENER(KafkaHistoListener)
 
-KafkaHistoListener::KafkaHistoListener() { declareProperty("InstrumentName", ""); }
+KafkaHistoListener::KafkaHistoListener() {
+  declareProperty("InstrumentName", "");
+  declareProperty("DeltaUpdates", false,
+                  "If true, only the spectra that changed since the last "
+                  "update are extracted and copied into the output workspace. "
+                  "Requires AccumulationMethod=Replace.");
+}
 
 void KafkaHistoListener::setAlgorithm(const Mantid::API::IAlgorithm &callingAlgorithm) {
   this->updatePropertyValues(callingAlgorithm);
@@ -61,6 +67,8 @@ void KafkaHistoListener::start(Types::Core::DateAndTime startTime) {
                        "from arbitrary time."
                     << std::endl;
   }
+  const bool deltaUpdates = getProperty("DeltaUpdates");
+  m_decoder->setDeltaUpdates(deltaUpdates);
   m_decoder->startCapture(true);
 }
 
@@ -79,6 +87,12 @@ std::shared_ptr<API::Workspace> KafkaHistoListener::extractData() {
   return m_decoder->extractData();
 }
 
+/// @copydoc ILiveListener::requestFullUpdate
+void KafkaHistoListener::requestFullUpdate() {
+  if (m_decoder)
+    m_decoder->requestFullUpdate();
+}
+
 /// @copydoc ILiveListener::isConnected
 bool KafkaHistoListener::isConnected() { return (m_decoder ? m_decoder->isCapturing() : false); }
 
@@ -7,11 +7,13 @@
 #include "MantidLiveData/Kafka/KafkaHistoStreamDecoder.h"
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/Axis.h"
+#include "MantidAPI/ILiveListener.h"
 #include "MantidAPI/Run.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidHistogramData/BinEdges.h"
+#include "MantidIndexing/Extract.h"
 #include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/OptionalBool.h"
@@ -29,6 +31,8 @@ GNU_DIAG_ON("conversion")
 
 #include <json/json.h>
 
+#include <algorithm>
+#include <numeric>
 #include <utility>
 
 namespace {
@@ -72,6 +76,9 @@ KafkaHistoStreamDecoder::KafkaHistoStreamDecoder(KafkaHistoStreamDecoder &&rval)
   {
     std::lock_guard lck(m_mutex);
     m_buffer = std::move(rval.m_buffer);
+    m_deltaUpdates = rval.m_deltaUpdates;
+    m_lastBinEdges = std::move(rval.m_lastBinEdges);
+    m_lastCounts = std::move(rval.m_lastCounts);
   }
 }
 
@@ -85,6 +92,29 @@ bool KafkaHistoStreamDecoder::hasData() const noexcept {
   return !m_buffer.empty();
 }
 
+/**
+ * In delta update mode extractData() returns the whole histogram the first
+ * time and afterwards only the spectra that changed, marked with
+ * API::ILiveListener::DELTA_UPDATE_PROPERTY.
+ * @param deltaUpdates True to only return the changed spectra
+ */
+void KafkaHistoStreamDecoder::setDeltaUpdates(bool deltaUpdates) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_deltaUpdates = deltaUpdates;
+  m_lastBinEdges.clear();
+  m_lastCounts.clear();
+}
+
+/**
+ * Forget the counts of the last extraction so that the next one returns the
+ * whole histogram, e.g. because the caller could not use the last delta.
+ */
+void KafkaHistoStreamDecoder::requestFullUpdate() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_lastBinEdges.clear();
+  m_lastCounts.clear();
+}
+
 // -----------------------------------------------------------------------------
 // Private members
 // -----------------------------------------------------------------------------
@@ -116,20 +146,56 @@ API::Workspace_sptr KafkaHistoStreamDecoder::extractDataImpl() {
   auto *bindata = xbins->data();
   HistogramData::BinEdges binedges(&bindata[0], &bindata[xbins->size()]);
 
-  API::MatrixWorkspace_sptr ws{DataObjects::create<DataObjects::Workspace2D>(*m_workspace, nspectra, binedges)};
-
-  ws->setIndexInfo(m_workspace->indexInfo());
   auto data = histoMsg->data_as_ArrayDouble()->value();
+  const double *counts = data->data();
+
+  // Find the spectra that changed since the last extraction. If the binning
+  // changed everything is returned.
+  const bool delta = m_deltaUpdates && m_lastCounts.size() == data->size() &&
+                     std::equal(bindata, bindata + xbins->size(), m_lastBinEdges.begin(), m_lastBinEdges.end());
+  std::vector<size_t> changed;
+  if (delta) {
+    for (size_t i = 0; i < nspectra; ++i) {
+      const double *start = counts + (i * nbins);
+      if (!std::equal(start, start + nbins, m_lastCounts.data() + (i * nbins)))
+        changed.emplace_back(i);
+    }
+    // A workspace cannot be empty so send an unchanged spectrum instead
+    if (changed.empty() && nspectra > 0)
+      changed.emplace_back(0);
+  }
+
+  API::MatrixWorkspace_sptr ws;
+  if (delta) {
+    ws = DataObjects::create<DataObjects::Workspace2D>(
+        *m_workspace, Indexing::extract(m_workspace->indexInfo(), changed), binedges);
+    ws->mutableRun().addProperty(API::ILiveListener::DELTA_UPDATE_PROPERTY, true, true);
+  } else {
+    changed.resize(nspectra);
+    std::iota(changed.begin(), changed.end(), 0);
+    ws = DataObjects::create<DataObjects::Workspace2D>(*m_workspace, nspectra, binedges);
+    ws->setIndexInfo(m_workspace->indexInfo());
+  }
 
   // Set the units
   ws->getAxis(0)->setUnit(metadimx->unit()->c_str());
   ws->setYUnit(metadimy->unit()->c_str());
 
-  std::vector<double> counts;
-  for (size_t i = 0; i < nspectra; ++i) {
-    const double *start = data->data() + (i * nbins);
-    counts.assign(start, start + nbins);
-    ws->setCounts(i, counts);
+  std::vector<double> spectrumCounts;
+  for (size_t i = 0; i < changed.size(); ++i) {
+    const double *start = counts + (changed[i] * nbins);
+    spectrumCounts.assign(start, start + nbins);
+    ws->setCounts(i, spectrumCounts);
+  }
+
+  // Only remember the counts once the chunk has been built. If the caller
+  // fails to accumulate it, it asks for a full update via requestFullUpdate()
+  if (delta) {
+    for (const auto i : changed)
+      std::copy(counts + (i * nbins), counts + ((i + 1) * nbins), m_lastCounts.data() + (i * nbins));
+  } else if (m_deltaUpdates) {
+    m_lastBinEdges.assign(bindata, bindata + xbins->size());
+    m_lastCounts.assign(counts, counts + data->size());
   }
 
   return ws;
@@ -257,6 +323,12 @@ void KafkaHistoStreamDecoder::initLocalCaches(const RunStartStruct &runStartData
   if (nperiods > 1) {
     throw std::runtime_error("KafkaHistoStreamDecoder - Does not support multi-period data.");
   }
+  {
+    // The first extraction from the new caches returns every spectrum
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lastBinEdges.clear();
+    m_lastCounts.clear();
+  }
   // New caches so LoadLiveData's output workspace needs to be replaced
   m_dataReset = true;
 
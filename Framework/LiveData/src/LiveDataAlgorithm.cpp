@@ -118,6 +118,14 @@ void LiveDataAlgorithm::initProps() {
   declareProperty(std::make_unique<FileProperty>("PostProcessingScriptFilename", "", FileProperty::OptionalLoad, "py"),
                   " Python script that will be run to process the accumulated data.");
 
+  declareProperty("IncrementalPostProcessing", false,
+                  "Post-process each chunk only and add the result to the OutputWorkspace, "
+                  "instead of post-processing the whole AccumulationWorkspace on every update.\n"
+                  "The time taken by an update then does not grow with the length of the run.\n"
+                  "Only valid with the Add AccumulationMethod, and only if post-processing the sum "
+                  "of two chunks gives the sum of the post-processed chunks (e.g. Rebin, "
+                  "ConvertUnits, BinMD).");
+
   std::vector<std::string> runOptions{"Restart", "Stop", "Rename"};
   declareProperty("RunTransitionBehavior", "Restart", std::make_shared<StringListValidator>(runOptions),
                   "What to do at run start/end boundaries?\n"
@@ -369,6 +377,10 @@ std::map<std::string, std::string> LiveDataAlgorithm::validateInputs() {
     }
   }
 
+  const bool incremental = this->getProperty("IncrementalPostProcessing");
+  if (incremental && getPropertyValue("AccumulationMethod") != "Add")
+    out["IncrementalPostProcessing"] = "Incremental post-processing requires the Add AccumulationMethod.";
+
   // For StartLiveData and MonitorLiveData, make sure another thread is not
   // already using these names
   if (this->name() != "LoadLiveData") {
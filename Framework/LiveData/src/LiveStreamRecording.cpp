@@ -0,0 +1,112 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidLiveData/LiveStreamRecording.h"
+
+#include <Poco/Net/StreamSocket.h>
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace Mantid::LiveData {
+
+namespace {
+/// Identifies a live stream recording
+constexpr char MAGIC[8] = {'M', 'A', 'N', 'T', 'I', 'D', 'L', 'S'};
+/// Version of the file format
+constexpr uint32_t VERSION = 1;
+} // namespace
+
+/**
+ * Create the file and write its header.
+ * @param filename :: Path of the file, an existing file is overwritten.
+ */
+LiveStreamRecordWriter::LiveStreamRecordWriter(const std::string &filename)
+    : m_file(filename, std::ios::binary | std::ios::trunc), m_numberOfRecords(0), m_numberOfBytes(0) {
+  if (!m_file) {
+    throw std::runtime_error("Unable to open " + filename + " for writing");
+  }
+  m_file.write(MAGIC, sizeof(MAGIC));
+  m_file.write(reinterpret_cast<const char *>(&VERSION), sizeof(VERSION));
+}
+
+/**
+ * Append a block of stream bytes.
+ * @param time :: Time the bytes were received, in nanoseconds since the start
+ * of the recording.
+ * @param data :: Pointer to the bytes.
+ * @param size :: Number of bytes.
+ */
+void LiveStreamRecordWriter::write(int64_t time, const char *data, std::size_t size) {
+  if (size > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument("Live stream record is too large");
+  }
+  const auto recordSize = static_cast<uint32_t>(size);
+  m_file.write(reinterpret_cast<const char *>(&time), sizeof(time));
+  m_file.write(reinterpret_cast<const char *>(&recordSize), sizeof(recordSize));
+  m_file.write(data, static_cast<std::streamsize>(size));
+  if (!m_file) {
+    throw std::runtime_error("Failed to write the live stream recording");
+  }
+  ++m_numberOfRecords;
+  m_numberOfBytes += size;
+}
+
+/**
+ * Open a recording and check its header.
+ * @param filename :: Path of the file.
+ */
+LiveStreamRecordReader::LiveStreamRecordReader(const std::string &filename) : m_file(filename, std::ios::binary) {
+  if (!m_file) {
+    throw std::runtime_error("Unable to open " + filename);
+  }
+  char magic[sizeof(MAGIC)];
+  uint32_t version = 0;
+  m_file.read(magic, sizeof(magic));
+  m_file.read(reinterpret_cast<char *>(&version), sizeof(version));
+  if (!m_file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::runtime_error(filename + " is not a live stream recording");
+  }
+  if (version != VERSION) {
+    throw std::runtime_error(filename + " has unsupported live stream recording version " + std::to_string(version));
+  }
+}
+
+/**
+ * Read the next record.
+ * @param record :: Set to the record.
+ * @return :: False if the end of the recording was reached.
+ */
+bool LiveStreamRecordReader::next(LiveStreamRecord &record) {
+  uint32_t size = 0;
+  m_file.read(reinterpret_cast<char *>(&record.time), sizeof(record.time));
+  m_file.read(reinterpret_cast<char *>(&size), sizeof(size));
+  if (!m_file) {
+    return false;
+  }
+  record.data.resize(size);
+  m_file.read(record.data.data(), static_cast<std::streamsize>(size));
+  if (!m_file) {
+    throw std::runtime_error("The live stream recording is truncated");
+  }
+  return true;
+}
+
+/**
+ * Send all of the bytes, StreamSocket::sendBytes may send only some of them.
+ * @param socket :: The connected socket
+ * @param data :: The bytes to send
+ * @param size :: The number of bytes
+ */
+void sendAll(Poco::Net::StreamSocket &socket, const char *data, int size) {
+  int sent = 0;
+  while (sent < size) {
+    sent += socket.sendBytes(data + sent, size - sent);
+  }
+}
+
+} // namespace Mantid::LiveData
@@ -6,6 +6,7 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidLiveData/LoadLiveData.h"
 #include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/Run.h"
 #include "MantidAPI/Workspace.h"
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidDataObjects/EventWorkspace.h"
@@ -89,10 +90,13 @@ void LoadLiveData::init() { this->initProps(); }
  *
  * @param inputWS :: workspace being processed
  * @param PostProcess :: flag, TRUE if doing the post-processing
+ * @param PostProcessChunk :: flag, TRUE if the post-processing is applied to
+ *a chunk rather than to the accumulation workspace
  * @return the processed workspace. Will point to inputWS if no processing is to
  *do
  */
-Mantid::API::Workspace_sptr LoadLiveData::runProcessing(Mantid::API::Workspace_sptr inputWS, bool PostProcess) {
+Mantid::API::Workspace_sptr LoadLiveData::runProcessing(Mantid::API::Workspace_sptr inputWS, bool PostProcess,
+                                                        bool PostProcessChunk) {
   if (!inputWS)
     throw std::runtime_error("LoadLiveData::runProcessing() called for an empty input workspace.");
   // Prevent others writing to the workspace while we run.
@@ -114,8 +118,10 @@ Mantid::API::Workspace_sptr LoadLiveData::runProcessing(Mantid::API::Workspace_s
     // Transform the chunk in-place
     std::string outputName = inputName;
 
-    // Except, no need for anonymous names with the post-processing
-    if (PostProcess) {
+    // Except, no need for anonymous names with the post-processing of the
+    // accumulation workspace
+    const bool anonymousInput = !PostProcess || PostProcessChunk;
+    if (!anonymousInput) {
       inputName = this->getPropertyValue("AccumulationWorkspace");
       outputName = this->getPropertyValue("OutputWorkspace");
     }
@@ -167,7 +173,7 @@ Mantid::API::Workspace_sptr LoadLiveData::runProcessing(Mantid::API::Workspace_s
                                " Algorithm's OutputWorkspace property is not a WorkspaceProperty!");
     Workspace_sptr temp = wsProp->getWorkspace();
 
-    if (!PostProcess) {
+    if (anonymousInput) {
       if (!temp) {
         // a group workspace cannot be returned by wsProp
         temp = AnalysisDataService::Instance().retrieve(inputName);
@@ -216,20 +222,40 @@ void LoadLiveData::runPostProcessing() {
 }
 
 //----------------------------------------------------------------------------------------------
-/** Accumulate the data by adding (summing) to the output workspace.
+/** Post-process the chunk only and add the result to the output workspace.
+ * Valid when the post-processing of a sum of chunks is the sum of the
+ * post-processed chunks, so the work done does not depend on the length of
+ * the run.
+ * Sets the m_outputWS member.
+ *
+ * @param chunkWS :: processed live data chunk workspace
+ */
+void LoadLiveData::runIncrementalPostProcessing(const Mantid::API::Workspace_sptr &chunkWS) {
+  Workspace_sptr processed;
+  try {
+    processed = runProcessing(chunkWS, true, true);
+  } catch (...) {
+    g_log.error("While post processing chunk:");
+    throw;
+  }
+  this->addChunk(m_outputWS, processed);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Accumulate the data by adding (summing) to a workspace.
  * Calls the Plus algorithm
- * Sets m_accumWS.
  *
+ * @param accumWS :: the workspace to add to, m_accumWS or m_outputWS
  * @param chunkWS :: processed live data chunk workspace
  */
-void LoadLiveData::addChunk(const Mantid::API::Workspace_sptr &chunkWS) {
+void LoadLiveData::addChunk(Mantid::API::Workspace_sptr &accumWS, const Mantid::API::Workspace_sptr &chunkWS) {
   // Acquire locks on the workspaces we use
-  WriteLock _lock1(*m_accumWS);
+  WriteLock _lock1(*accumWS);
   ReadLock _lock2(*chunkWS);
 
   // ISIS multi-period data come in workspace groups
   if (WorkspaceGroup_sptr gws = std::dynamic_pointer_cast<WorkspaceGroup>(chunkWS)) {
-    WorkspaceGroup_sptr accum_gws = std::dynamic_pointer_cast<WorkspaceGroup>(m_accumWS);
+    WorkspaceGroup_sptr accum_gws = std::dynamic_pointer_cast<WorkspaceGroup>(accumWS);
     if (!accum_gws) {
       throw std::runtime_error("Two workspace groups are expected.");
     }
@@ -244,10 +270,10 @@ void LoadLiveData::addChunk(const Mantid::API::Workspace_sptr &chunkWS) {
     }
   } else if (std::dynamic_pointer_cast<MatrixWorkspace>(chunkWS)) {
     // If workspace is a Matrix workspace just add the chunk
-    addMatrixWSChunk(m_accumWS, chunkWS);
+    addMatrixWSChunk(accumWS, chunkWS);
   } else {
     // Assume MD Workspace
-    addMDWSChunk(m_accumWS, chunkWS);
+    addMDWSChunk(accumWS, chunkWS);
   }
 }
 
@@ -331,6 +357,42 @@ void LoadLiveData::replaceChunk(Mantid::API::Workspace_sptr chunkWS) {
   copyInstrument(instrumentWS.get(), m_accumWS.get());
 }
 
+//----------------------------------------------------------------------------------------------
+/** Accumulate the data by copying the spectra of a chunk that only holds the
+ * spectra that changed since the last update into the output workspace.
+ * The logs are replaced by those of the chunk.
+ *
+ * @param chunkWS :: processed live data chunk workspace, marked with
+ *ILiveListener::DELTA_UPDATE_PROPERTY
+ */
+void LoadLiveData::replaceChangedSpectra(const Mantid::API::Workspace_sptr &chunkWS) {
+  auto accumWS = std::dynamic_pointer_cast<MatrixWorkspace>(m_accumWS);
+  auto chunk = std::dynamic_pointer_cast<MatrixWorkspace>(chunkWS);
+  if (!accumWS || !chunk) {
+    throw std::runtime_error("Only the changed spectra of a MatrixWorkspace can "
+                             "be copied into the accumulation workspace.");
+  }
+  // Acquire locks on the workspaces we use
+  WriteLock _lock1(*accumWS);
+  ReadLock _lock2(*chunk);
+
+  specnum_t offset(0);
+  const auto indices = accumWS->getSpectrumToWorkspaceIndexVector(offset);
+  for (size_t i = 0; i < chunk->getNumberHistograms(); ++i) {
+    const specnum_t spectrumNo = chunk->getSpectrum(i).getSpectrumNo();
+    const auto position = static_cast<int64_t>(spectrumNo) + offset;
+    if (position < 0 || position >= static_cast<int64_t>(indices.size()) ||
+        accumWS->getSpectrum(indices[position]).getSpectrumNo() != spectrumNo) {
+      throw std::runtime_error("Spectrum " + std::to_string(spectrumNo) +
+                               " of the live data chunk is not in the accumulation workspace.");
+    }
+    accumWS->setHistogram(indices[position], chunk->histogram(i));
+  }
+
+  accumWS->mutableRun() = chunk->run();
+  accumWS->mutableRun().removeProperty(ILiveListener::DELTA_UPDATE_PROPERTY);
+}
+
 //----------------------------------------------------------------------------------------------
 /** Accumulate the data by appending the spectra into the
  * the output workspace.
@@ -498,72 +560,114 @@ void LoadLiveData::exec() {
   if (preserveEvents)
     this->updateDefaultBinBoundaries(chunkWS.get());
 
-  // Now we process the chunk
-  Workspace_sptr processed = this->processChunk(chunkWS);
-
-  EventWorkspace_sptr processedEvent = std::dynamic_pointer_cast<EventWorkspace>(processed);
-  if (!preserveEvents && processedEvent) {
-    // Convert the monitor workspace, if there is one and it's necessary
-    MatrixWorkspace_sptr monitorWS = processedEvent->monitorWorkspace();
-    auto monitorEventWS = std::dynamic_pointer_cast<EventWorkspace>(monitorWS);
-    if (monitorEventWS) {
-      auto monAlg = this->createChildAlgorithm("ConvertToMatrixWorkspace");
-      monAlg->setProperty("InputWorkspace", monitorEventWS);
-      monAlg->executeAsChildAlg();
-      if (!monAlg->isExecuted())
-        g_log.error("Failed to convert monitors from events to histogram form.");
-      monitorWS = monAlg->getProperty("OutputWorkspace");
-    }
-
-    // Now do the main workspace
-    Algorithm_sptr alg = this->createChildAlgorithm("ConvertToMatrixWorkspace");
-    alg->setProperty("InputWorkspace", processedEvent);
-    std::string outputName = "__anonymous_livedata_convert_" + this->getPropertyValue("OutputWorkspace");
-    alg->setPropertyValue("OutputWorkspace", outputName);
-    alg->execute();
-    if (!alg->isExecuted())
-      throw std::runtime_error("Error when calling ConvertToMatrixWorkspace "
-                               "(since PreserveEvents=False). See log.");
-    // Replace the "processed" workspace with the converted one.
-    MatrixWorkspace_sptr temp = alg->getProperty("OutputWorkspace");
-    if (monitorWS)
-      temp->setMonitorWorkspace(monitorWS); // Set back the monitor workspace
-    processed = temp;
-  }
+  // A chunk holding only the spectra that changed is lost if it is not
+  // accumulated, in which case the listener has to send everything again
+  const auto chunkMatrixWS = std::dynamic_pointer_cast<MatrixWorkspace>(chunkWS);
+  const bool deltaChunk = chunkMatrixWS && chunkMatrixWS->run().hasProperty(ILiveListener::DELTA_UPDATE_PROPERTY);
 
-  // How do we accumulate the data?
-  std::string accum = this->getPropertyValue("AccumulationMethod");
+  Workspace_sptr processed;
+  std::string accum;
+  bool postProcessChunk = false;
+  try {
+    // Now we process the chunk
+    processed = this->processChunk(chunkWS);
+
+    EventWorkspace_sptr processedEvent = std::dynamic_pointer_cast<EventWorkspace>(processed);
+    if (!preserveEvents && processedEvent) {
+      // Convert the monitor workspace, if there is one and it's necessary
+      MatrixWorkspace_sptr monitorWS = processedEvent->monitorWorkspace();
+      auto monitorEventWS = std::dynamic_pointer_cast<EventWorkspace>(monitorWS);
+      if (monitorEventWS) {
+        auto monAlg = this->createChildAlgorithm("ConvertToMatrixWorkspace");
+        monAlg->setProperty("InputWorkspace", monitorEventWS);
+        monAlg->executeAsChildAlg();
+        if (!monAlg->isExecuted())
+          g_log.error("Failed to convert monitors from events to histogram form.");
+        monitorWS = monAlg->getProperty("OutputWorkspace");
+      }
 
-  // If the AccumulationWorkspace does not exist, we always replace the
-  // AccumulationWorkspace.
-  // Also, if the listener said we are resetting the data, then we clear out the
-  // old.
-  if (!m_accumWS || dataReset)
-    accum = "Replace";
+      // Now do the main workspace
+      Algorithm_sptr alg = this->createChildAlgorithm("ConvertToMatrixWorkspace");
+      alg->setProperty("InputWorkspace", processedEvent);
+      std::string outputName = "__anonymous_livedata_convert_" + this->getPropertyValue("OutputWorkspace");
+      alg->setPropertyValue("OutputWorkspace", outputName);
+      alg->execute();
+      if (!alg->isExecuted())
+        throw std::runtime_error("Error when calling ConvertToMatrixWorkspace "
+                                 "(since PreserveEvents=False). See log.");
+      // Replace the "processed" workspace with the converted one.
+      MatrixWorkspace_sptr temp = alg->getProperty("OutputWorkspace");
+      if (monitorWS)
+        temp->setMonitorWorkspace(monitorWS); // Set back the monitor workspace
+      processed = temp;
+    }
 
-  g_log.notice() << "Performing the " << accum << " operation.\n";
+    // How do we accumulate the data?
+    accum = this->getPropertyValue("AccumulationMethod");
+
+    // If the AccumulationWorkspace does not exist, we always replace the
+    // AccumulationWorkspace.
+    // Also, if the listener said we are resetting the data, then we clear out the
+    // old.
+    if (!m_accumWS || dataReset)
+      accum = "Replace";
+
+    // Chunks holding only the changed spectra are copied into the
+    // accumulation workspace
+    if (deltaChunk) {
+      if (this->getPropertyValue("AccumulationMethod") != "Replace")
+        throw std::runtime_error("The listener only returned the spectra that "
+                                 "changed, this requires AccumulationMethod=Replace.");
+      if (!m_accumWS || dataReset)
+        throw std::runtime_error("The listener only returned the spectra that "
+                                 "changed but there is no workspace to copy them into. "
+                                 "The full data is requested for the next update.");
+      const auto processedMatrixWS = std::dynamic_pointer_cast<MatrixWorkspace>(processed);
+      if (!processedMatrixWS || !processedMatrixWS->run().hasProperty(ILiveListener::DELTA_UPDATE_PROPERTY))
+        throw std::runtime_error("The listener only returned the spectra that "
+                                 "changed but the processing did not keep the run of the chunk. "
+                                 "The full data is requested for the next update.");
+    }
 
-  // Perform the accumulation and set the AccumulationWorkspace workspace
-  if (accum == "Replace") {
-    this->replaceChunk(processed);
-  } else if (accum == "Append") {
-    this->appendChunk(processed);
-  } else {
-    // Default to Add.
-    this->addChunk(processed);
+    g_log.notice() << "Performing the " << accum << " operation.\n";
+
+    // Post-process only the new chunk if the output of the previous update can
+    // be added to
+    const bool incremental = this->getProperty("IncrementalPostProcessing");
+    postProcessChunk = incremental && accum == "Add" && m_outputWS && this->hasPostProcessing();
+
+    // Perform the accumulation and set the AccumulationWorkspace workspace
+    if (accum == "Replace") {
+      if (deltaChunk)
+        this->replaceChangedSpectra(processed);
+      else
+        this->replaceChunk(processed);
+    } else if (accum == "Append") {
+      this->appendChunk(processed);
+    } else {
+      // Default to Add.
+      this->addChunk(m_accumWS, processed);
 
-    // When adding events, the default bin boundaries may need to be updated.
-    // The function itself checks to see if it is appropriate
-    if (preserveEvents) {
-      this->updateDefaultBinBoundaries(m_accumWS.get());
+      // When adding events, the default bin boundaries may need to be updated.
+      // The function itself checks to see if it is appropriate
+      if (preserveEvents) {
+        this->updateDefaultBinBoundaries(m_accumWS.get());
+      }
     }
+  } catch (...) {
+    if (deltaChunk)
+      listener->requestFullUpdate();
+    throw;
   }
 
   // At this point, m_accumWS is set.
 
   if (this->hasPostProcessing()) {
     // ----------- Run post-processing -------------
-    this->runPostProcessing();
+    if (postProcessChunk)
+      this->runIncrementalPostProcessing(processed);
+    else
+      this->runPostProcessing();
     // Set both output workspaces
     this->setProperty("AccumulationWorkspace", m_accumWS);
     this->setProperty("OutputWorkspace", m_outputWS);
@@ -0,0 +1,125 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidLiveData/RecordLiveStream.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/MandatoryValidator.h"
+#include "MantidLiveData/LiveStreamRecording.h"
+
+#include <Poco/Net/NetException.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/StreamSocket.h>
+
+#include <chrono>
+
+namespace Mantid::LiveData {
+// Register the algorithm into the algorithm factory
+DECLARE_ALGORITHM(RecordLiveStream)
+
+using namespace Kernel;
+using namespace API;
+
+namespace {
+/// Size of the buffer used to receive the stream
+constexpr int BUFFER_SIZE = 65536;
+} // namespace
+
+/**
+ * Declare the algorithm properties
+ */
+void RecordLiveStream::init() {
+  declareProperty("Address", "", std::make_shared<MandatoryValidator<std::string>>(),
+                  "The address (host:port) of the live data server.");
+  declareProperty(std::make_unique<PropertyWithValue<int>>("Port", 59877, Direction::Input),
+                  "The port the listener connects to instead of the server.");
+  declareProperty(std::make_unique<FileProperty>("Filename", "", FileProperty::Save, ".livestream"),
+                  "The file to record the stream to.");
+  auto mustBePositive = std::make_shared<BoundedValidator<double>>();
+  mustBePositive->setLower(0.0);
+  declareProperty("Duration", 0.0, mustBePositive,
+                  "Time to record for in seconds. If 0 the recording stops when "
+                  "either side closes the connection or the algorithm is cancelled.");
+  declareProperty("Timeout", 60.0, mustBePositive,
+                  "Time to wait for the listener to connect in seconds.");
+  declareProperty("NumberOfRecords", 0, "The number of blocks of data recorded.", Direction::Output);
+  declareProperty("NumberOfBytes", int64_t(0), "The number of bytes recorded.", Direction::Output);
+}
+
+/**
+ * Execute the algorithm.
+ */
+void RecordLiveStream::exec() {
+  const std::string address = getProperty("Address");
+  const int port = getProperty("Port");
+  const double duration = getProperty("Duration");
+  const double timeout = getProperty("Timeout");
+
+  LiveStreamRecordWriter writer(getPropertyValue("Filename"));
+  Poco::Net::ServerSocket server(static_cast<Poco::UInt16>(port));
+  server.listen();
+
+  // Wait for the listener
+  const Poco::Timespan pollTime(0, 50000);
+  const auto waitStart = std::chrono::steady_clock::now();
+  while (!server.poll(pollTime, Poco::Net::Socket::SELECT_READ)) {
+    interruption_point();
+    if (std::chrono::duration<double>(std::chrono::steady_clock::now() - waitStart).count() > timeout) {
+      throw std::runtime_error("No listener connected to port " + std::to_string(port));
+    }
+  }
+  Poco::Net::StreamSocket client = server.acceptConnection();
+
+  Poco::Net::StreamSocket upstream;
+  upstream.connect(Poco::Net::SocketAddress(address), Poco::Timespan(static_cast<long>(timeout), 0));
+  g_log.notice() << "Recording the stream from " << address << '\n';
+
+  std::vector<char> buffer(BUFFER_SIZE);
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    while (true) {
+      try {
+        // Exit if the user presses cancel
+        interruption_point();
+      } catch (...) {
+        upstream.close();
+        client.close();
+        throw;
+      }
+      const auto elapsed = std::chrono::steady_clock::now() - start;
+      if (duration > 0 && std::chrono::duration<double>(elapsed).count() >= duration)
+        break;
+
+      // Pass on what the listener sends, e.g. a request for the data
+      if (client.poll(Poco::Timespan(0, 0), Poco::Net::Socket::SELECT_READ)) {
+        const int n = client.receiveBytes(buffer.data(), BUFFER_SIZE);
+        if (n <= 0)
+          break;
+        sendAll(upstream, buffer.data(), n);
+      }
+
+      if (upstream.poll(pollTime, Poco::Net::Socket::SELECT_READ)) {
+        const int n = upstream.receiveBytes(buffer.data(), BUFFER_SIZE);
+        if (n <= 0)
+          break;
+        const auto time =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        writer.write(time.count(), buffer.data(), static_cast<std::size_t>(n));
+        sendAll(client, buffer.data(), n);
+      }
+    }
+  } catch (Poco::Net::NetException &ex) {
+    g_log.warning() << "Connection lost, stopping the recording: " << ex.displayText() << '\n';
+  }
+  upstream.close();
+  client.close();
+
+  g_log.notice() << "Recorded " << writer.numberOfRecords() << " blocks, " << writer.numberOfBytes() << " bytes\n";
+  setProperty("NumberOfRecords", static_cast<int>(writer.numberOfRecords()));
+  setProperty("NumberOfBytes", static_cast<int64_t>(writer.numberOfBytes()));
+}
+
+} // namespace Mantid::LiveData
@@ -0,0 +1,138 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidLiveData/ReplayLiveStream.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidLiveData/LiveStreamRecording.h"
+
+#include <Poco/Net/NetException.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/StreamSocket.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace Mantid::LiveData {
+// Register the algorithm into the algorithm factory
+DECLARE_ALGORITHM(ReplayLiveStream)
+
+using namespace Kernel;
+using namespace API;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/// Size of the buffer used to discard what the listener sends
+constexpr int BUFFER_SIZE = 4096;
+} // namespace
+
+/**
+ * Declare the algorithm properties
+ */
+void ReplayLiveStream::init() {
+  declareProperty(std::make_unique<FileProperty>("Filename", "", FileProperty::Load, ".livestream"),
+                  "A stream recorded by RecordLiveStream.");
+  declareProperty(std::make_unique<PropertyWithValue<int>>("Port", 59876, Direction::Input),
+                  "The port the listener connects to.");
+  auto mustBePositive = std::make_shared<BoundedValidator<double>>();
+  mustBePositive->setLower(0.0);
+  declareProperty("SpeedFactor", 1.0, mustBePositive,
+                  "How much faster than recorded to send the stream, e.g. 2 "
+                  "halves the time between records. If 0 the records are sent "
+                  "as fast as the listener reads them.");
+  declareProperty("Timeout", 60.0, mustBePositive, "Time to wait for the listener to connect in seconds.");
+  declareProperty("LateThreshold", 10.0, mustBePositive,
+                  "A record sent more than this many milliseconds after its "
+                  "time is counted as late.");
+  declareProperty("NumberOfRecords", 0, "The number of records sent.", Direction::Output);
+  declareProperty("NumberOfBytes", int64_t(0), "The number of bytes sent.", Direction::Output);
+  declareProperty("LateRecords", 0,
+                  "The number of records sent late because the listener did not "
+                  "read the stream fast enough.",
+                  Direction::Output);
+  declareProperty("MaxDelay", 0.0, "The largest delay of a record in milliseconds.", Direction::Output);
+  declareProperty("ElapsedTime", 0.0, "The time taken to send the stream in seconds.", Direction::Output);
+}
+
+/**
+ * Execute the algorithm.
+ */
+void ReplayLiveStream::exec() {
+  const int port = getProperty("Port");
+  const double speed = getProperty("SpeedFactor");
+  const double timeout = getProperty("Timeout");
+  const double lateThreshold = getProperty("LateThreshold");
+
+  LiveStreamRecordReader reader(getPropertyValue("Filename"));
+  Poco::Net::ServerSocket server(static_cast<Poco::UInt16>(port));
+  server.listen();
+
+  // Wait for the listener
+  const Poco::Timespan pollTime(0, 50000);
+  const auto waitStart = Clock::now();
+  while (!server.poll(pollTime, Poco::Net::Socket::SELECT_READ)) {
+    interruption_point();
+    if (std::chrono::duration<double>(Clock::now() - waitStart).count() > timeout) {
+      throw std::runtime_error("No listener connected to port " + std::to_string(port));
+    }
+  }
+  Poco::Net::StreamSocket client = server.acceptConnection();
+  g_log.notice() << "Replaying the stream to " << client.peerAddress().toString() << '\n';
+
+  int numberOfRecords = 0;
+  int64_t numberOfBytes = 0;
+  int lateRecords = 0;
+  double maxDelay = 0.0;
+  LiveStreamRecord record;
+  std::vector<char> discard(BUFFER_SIZE);
+  const auto start = Clock::now();
+  try {
+    while (reader.next(record)) {
+      interruption_point();
+      // The replay does not answer requests from the listener, drop them
+      if (client.available() > 0)
+        client.receiveBytes(discard.data(), BUFFER_SIZE);
+
+      const auto size = static_cast<int>(record.data.size());
+      if (speed > 0) {
+        const auto scheduled =
+            start + std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double, std::nano>(static_cast<double>(record.time) / speed));
+        // Sleep in short steps so that the algorithm can be cancelled
+        for (auto now = Clock::now(); now < scheduled; now = Clock::now()) {
+          std::this_thread::sleep_until(std::min(scheduled, now + std::chrono::milliseconds(100)));
+          interruption_point();
+        }
+        sendAll(client, record.data.data(), size);
+        const double delay = std::chrono::duration<double, std::milli>(Clock::now() - scheduled).count();
+        if (delay > lateThreshold)
+          ++lateRecords;
+        maxDelay = std::max(maxDelay, delay);
+      } else {
+        sendAll(client, record.data.data(), size);
+      }
+      ++numberOfRecords;
+      numberOfBytes += size;
+    }
+  } catch (Poco::Net::NetException &ex) {
+    g_log.warning() << "The listener disconnected after " << numberOfRecords << " records: " << ex.displayText()
+                    << '\n';
+  }
+  const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  client.close();
+
+  g_log.notice() << "Sent " << numberOfRecords << " records, " << numberOfBytes << " bytes in " << elapsed << " s, "
+                 << lateRecords << " late records\n";
+  setProperty("NumberOfRecords", numberOfRecords);
+  setProperty("NumberOfBytes", numberOfBytes);
+  setProperty("LateRecords", lateRecords);
+  setProperty("MaxDelay", maxDelay);
+  setProperty("ElapsedTime", elapsed);
+}
+
+} // namespace Mantid::LiveData
@@ -18,6 +18,7 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/DateAndTime.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/OptionalBool.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/TimeSeriesProperty.h"
@@ -56,6 +57,9 @@ const std::string PAUSE_PROPERTY("pause");
 const std::string SCAN_PROPERTY("scan_index");
 const std::string PROTON_CHARGE_PROPERTY("proton_charge");
 
+// Packets with fewer events than this are decoded on one thread
+const size_t PARALLEL_DECODE_MIN_EVENTS = 10000;
+
 // These are names for some string properties (not time series)
 const std::string RUN_TITLE_PROPERTY("run_title");
 const std::string EXPERIMENT_ID_PROPERTY("experiment_identifier");
@@ -77,11 +81,23 @@ DECLARE_LISTENER(SNSLiveEventDataListener)
 namespace {
 /// static logger
 Kernel::Logger g_log("SNSLiveEventDataListener");
+
+/// Give an empty buffer a fresh monitor workspace like the one in the filled buffer
+void createMonitorBuffer(DataObjects::EventWorkspace &empty, const DataObjects::EventWorkspace &filled) {
+  auto monitorBuffer = filled.monitorWorkspace();
+  if (monitorBuffer) {
+    auto newMonitorBuffer =
+        WorkspaceFactory::Instance().create("EventWorkspace", monitorBuffer->getNumberHistograms(), 1, 1);
+    WorkspaceFactory::Instance().initializeFromParent(*monitorBuffer, *newMonitorBuffer, false);
+    empty.setMonitorWorkspace(newMonitorBuffer);
+  }
+}
 } // namespace
 
 /// Constructor
 SNSLiveEventDataListener::SNSLiveEventDataListener()
-    : LiveListener(), ADARA::Parser(), m_socket()
+    : LiveListener(), ADARA::Parser(), m_socket(),
+      m_bufferSwap(API::LiveListenerBuffer<DataObjects::EventWorkspace>::Logs::KeepLatestValue, createMonitorBuffer)
 // ADARA::Parser() will accept values for buffer size and max packet size,
 // but the defaults will work fine
 {
@@ -378,9 +394,6 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::BankedEventPkt &pkt) {
     }
   }
 
-  // A counter that we use for logging purposes
-  unsigned totalEvents = 0;
-
   // First, check to see if the run has been paused.  We don't process
   // the events if we're paused unless the user has specifically overridden
   // this behavior with the livelistener.keeppausedevents property.
@@ -388,8 +401,29 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::BankedEventPkt &pkt) {
     return false;
   }
 
-  // Append the events
   g_log.debug() << "----- Pulse ID: " << pkt.pulseId() << " -----\n";
+
+  // Decode the banks without holding the mutex: look up the workspace index
+  // and convert the time of flight of each event. The banks are independent,
+  // so large packets are decoded in parallel. The index map is only changed
+  // by this (the background) thread, so it's safe to read here.
+  const auto sections = pkt.bankSections();
+  size_t totalEvents = 0;
+  for (const auto &section : sections) {
+    totalEvents += section.eventCount;
+  }
+  // The buffers are kept between packets to reuse their memory
+  auto &decoded = m_decodedBanks;
+  if (decoded.size() < sections.size()) {
+    decoded.resize(sections.size());
+  }
+  std::vector<size_t> invalidPixels(sections.size(), 0);
+  PARALLEL_FOR_IF(totalEvents >= PARALLEL_DECODE_MIN_EVENTS)
+  for (int i = 0; i < static_cast<int>(sections.size()); ++i) {
+    invalidPixels[i] = decodeBank(sections[i], decoded[i]);
+  }
+
+  // Append the events
   // Scope braces
   {
     std::lock_guard<std::mutex> scopedLock(m_mutex);
@@ -403,36 +437,20 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::BankedEventPkt &pkt) {
         .getTimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY)
         ->addValue(eventTime, pkt.pulseCharge() * 10);
 
-    // Iterate through each event
-    const ADARA::Event *event = pkt.firstEvent();
-    unsigned lastBankID = pkt.curBankId();
-    // A counter that we use for logging purposes
-    unsigned eventsPerBank = 0;
-    while (event != nullptr) {
-      eventsPerBank++;
-      totalEvents++;
-      if (lastBankID < 0xFFFFFFFE) // Bank ID -1 & -2 are special cases and are
-                                   // not valid pixels
-      {
-        // appendEvent needs tof to be in units of microseconds, but it comes
-        // from the ADARA stream in units of 100ns.
-        if (pkt.getSourceCORFlag()) {
-          appendEvent(event->pixel, event->tof / 10.0, eventTime);
-        } else {
-          appendEvent(event->pixel, (event->tof + pkt.getSourceTOFOffset()) / 10.0, eventTime);
-        }
-      }
-
-      event = pkt.nextEvent();
-      if (pkt.curBankId() != lastBankID) {
-        g_log.debug() << "BankID " << lastBankID << " had " << eventsPerBank << " events\n";
-
-        lastBankID = pkt.curBankId();
-        eventsPerBank = 0;
+    for (size_t i = 0; i < sections.size(); ++i) {
+      for (const auto &event : decoded[i]) {
+        m_eventBuffer->getSpectrum(event.workspaceIndex).addEventQuickly(Types::Event::TofEvent(event.tof, eventTime));
       }
     }
   } // mutex automatically unlocks here
 
+  for (size_t i = 0; i < sections.size(); ++i) {
+    g_log.debug() << "BankID " << sections[i].bankId << " had " << sections[i].eventCount << " events\n";
+    if (invalidPixels[i] > 0) {
+      g_log.warning() << "BankID " << sections[i].bankId << " had " << invalidPixels[i]
+                      << " events with invalid pixel IDs\n";
+    }
+  }
   g_log.debug() << "Total Events: " << totalEvents << "\n";
   g_log.debug("-------------------------------");
 
@@ -1356,22 +1374,36 @@ bool SNSLiveEventDataListener::haveRequiredLogs() {
   return allFound;
 }
 
-/// Adds an event to the workspace
-void SNSLiveEventDataListener::appendEvent(const uint32_t pixelId, const double tof,
-                                           const Mantid::Types::Core::DateAndTime pulseTime)
-// NOTE: This function does NOT lock the mutex!  Make sure you do that
-// before calling this function!
-{
-  // It'd be nice to use operator[], but we might end up inserting a value....
-  // Have to use find() instead.
-  const auto it = m_indexMap.find(pixelId);
-  if (it != m_indexMap.end()) {
-    const std::size_t workspaceIndex = it->second;
-    Types::Event::TofEvent event(tof, pulseTime);
-    m_eventBuffer->getSpectrum(workspaceIndex).addEventQuickly(event);
-  } else {
-    g_log.warning() << "Invalid pixel ID: " << pixelId << " (TofF: " << tof << " microseconds)\n";
+/// Look up the workspace index and convert the time of flight of the events
+/// in a bank.
+/// NOTE: This function does NOT lock the mutex and may be called from several
+/// threads at once.  It must not modify the listener.
+/// @param section The bank to decode
+/// @param events Set to the decoded events
+/// @return The number of events with a pixel ID that isn't in the workspace
+size_t SNSLiveEventDataListener::decodeBank(const ADARA::BankedEventPkt::BankSection &section,
+                                            std::vector<DecodedEvent> &events) const {
+  events.clear();
+  // Bank ID -1 & -2 are special cases and are not valid pixels
+  if (section.bankId >= 0xFFFFFFFE) {
+    return 0;
   }
+
+  // The tof comes from the ADARA stream in units of 100ns and is needed in
+  // units of microseconds.
+  const uint32_t tofOffset = section.isCorrected ? 0 : section.tofOffset;
+  events.reserve(section.eventCount);
+  size_t invalidPixels = 0;
+  for (uint32_t i = 0; i < section.eventCount; ++i) {
+    const ADARA::Event &event = section.events[i];
+    const auto it = m_indexMap.find(event.pixel);
+    if (it != m_indexMap.end()) {
+      events.push_back({it->second, (event.tof + tofOffset) / 10.0});
+    } else {
+      ++invalidPixels;
+    }
+  }
+  return invalidPixels;
 }
 
 /// Retrieve buffered data
@@ -1410,37 +1442,23 @@ std::shared_ptr<Workspace> SNSLiveEventDataListener::extractData() {
 
   using namespace DataObjects;
 
-  // Make a brand new EventWorkspace
-  EventWorkspace_sptr temp = std::dynamic_pointer_cast<EventWorkspace>(
-      API::WorkspaceFactory::Instance().create("EventWorkspace", m_eventBuffer->getNumberHistograms(), 2, 1));
-
-  // Copy geometry over.
-  API::WorkspaceFactory::Instance().initializeFromParent(*m_eventBuffer, *temp, false);
-
-  // Clear out the old logs, except for the most recent entry
-  temp->mutableRun().clearOutdatedTimeSeriesLogValues();
-
-  // Clear out old monitor logs
-  for (auto &monitorLog : m_monitorLogs) {
-    temp->mutableRun().removeProperty(monitorLog);
-  }
-  m_monitorLogs.clear();
-
-  // Create a fresh monitor workspace and insert into the new 'main' workspace
-  auto monitorBuffer = m_eventBuffer->monitorWorkspace();
-  if (monitorBuffer) {
-    auto newMonitorBuffer =
-        WorkspaceFactory::Instance().create("EventWorkspace", monitorBuffer->getNumberHistograms(), 1, 1);
-    WorkspaceFactory::Instance().initializeFromParent(*monitorBuffer, *newMonitorBuffer, false);
-    temp->setMonitorWorkspace(newMonitorBuffer);
-  }
-
-  // Lock the mutex and swap the workspaces
+  // Swap the buffer for an empty one. The empty buffer keeps the most recent
+  // value of each log and gets a fresh monitor workspace.
+  EventWorkspace_sptr temp;
   {
     std::lock_guard<std::mutex> scopedLock(m_mutex);
-    std::swap(m_eventBuffer, temp);
+    temp = m_bufferSwap.swap(m_eventBuffer);
+
+    // Clear out old monitor logs
+    for (auto &monitorLog : m_monitorLogs) {
+      m_eventBuffer->mutableRun().removeProperty(monitorLog);
+    }
+    m_monitorLogs.clear();
   } // mutex automatically unlocks here
 
+  // Create the buffer for the next call without blocking the background thread
+  m_bufferSwap.prepare(temp);
+
   return temp;
 }
 
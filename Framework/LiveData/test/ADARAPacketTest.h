@@ -74,6 +74,34 @@ public:
     }
   }
 
+  void testBankedEventPacketSections() {
+    std::shared_ptr<ADARA::BankedEventPkt> pkt =
+        basicPacketTests<ADARA::BankedEventPkt>(bankedEventPacket, sizeof(bankedEventPacket), 728504567, 761741666);
+    if (pkt != nullptr) {
+      // Two banks with one event each in the first source, the second source
+      // has no banks
+      const auto sections = pkt->bankSections();
+      TS_ASSERT_EQUALS(sections.size(), 2);
+      if (sections.size() == 2) {
+        TS_ASSERT_EQUALS(sections[0].bankId, 0x02);
+        TS_ASSERT_EQUALS(sections[0].eventCount, 1);
+        TS_ASSERT(sections[0].isCorrected);
+        TS_ASSERT_EQUALS(sections[0].events[0].tof, 0x00023BD9);
+        TS_ASSERT_EQUALS(sections[0].events[0].pixel, 0x043C);
+        TS_ASSERT_EQUALS(sections[1].bankId, 0x13);
+        TS_ASSERT_EQUALS(sections[1].eventCount, 1);
+        TS_ASSERT_EQUALS(sections[1].events[0].tof, 0x00023F3A);
+        TS_ASSERT_EQUALS(sections[1].events[0].pixel, 0x49E2);
+      }
+
+      // Walking the sections agrees with iterating over the events
+      size_t numEvents = 0;
+      for (const ADARA::Event *event = pkt->firstEvent(); event; event = pkt->nextEvent())
+        ++numEvents;
+      TS_ASSERT_EQUALS(numEvents, 2);
+    }
+  }
+
   void testBeamMonitorPacketParser() {
     std::shared_ptr<ADARA::BeamMonitorPkt> pkt =
         basicPacketTests<ADARA::BeamMonitorPkt>(beamMonitorPacket, sizeof(beamMonitorPacket), 728504567, 761741666);
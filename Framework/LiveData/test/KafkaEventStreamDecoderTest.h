@@ -89,6 +89,38 @@ public:
     TS_ASSERT_EQUALS(11.0, eventWksp->getTofMax());
   }
 
+  void test_Event_Messages_Are_Queued_For_Decoding() {
+    using namespace ::testing;
+    using namespace KafkaTesting;
+    using Mantid::API::Workspace_sptr;
+    using Mantid::DataObjects::EventWorkspace;
+    using namespace Mantid::LiveData;
+
+    auto mockBroker = std::make_shared<MockKafkaBroker>();
+    EXPECT_CALL(*mockBroker, subscribe_(_, _))
+        .Times(Exactly(2))
+        .WillOnce(Return(new FakeISISEventSubscriber(1)))
+        .WillOnce(Return(new FakeRunInfoStreamSubscriber(1)));
+    auto testWrapper = createTestInstance(mockBroker);
+
+    testWrapper.runKafkaOneStep(); // Start up
+    TS_ASSERT_THROWS_NOTHING(testWrapper.stopCapture());
+
+    Workspace_sptr workspace;
+    TS_ASSERT_THROWS_NOTHING(workspace = testWrapper->extractData());
+    auto eventWksp = std::dynamic_pointer_cast<EventWorkspace>(workspace);
+    TS_ASSERT(eventWksp);
+    checkWorkspaceEventData(*eventWksp);
+
+    // Every queued message has been decoded into the workspace
+    const auto statistics = testWrapper->queueStatistics();
+    TS_ASSERT_LESS_THAN_EQUALS(1, statistics.queuedMessages);
+    TS_ASSERT_EQUALS(statistics.queuedMessages, statistics.decodedMessages);
+    TS_ASSERT_LESS_THAN_EQUALS(1, statistics.maxQueuedMessages);
+    TS_ASSERT_LESS_THAN_EQUALS(statistics.maxQueuedMessages, statistics.queuedMessages);
+    TS_ASSERT_EQUALS(6 * statistics.decodedMessages, eventWksp->getNumberEvents());
+  }
+
   void test_Multiple_Period_Event_Stream() {
     using namespace ::testing;
     using namespace KafkaTesting;
@@ -339,106 +371,6 @@ public:
     TSM_ASSERT_EQUALS("Expected 3 events from the event message", 3, eventWksp->getNumberEvents());
   }
 
-  void test_Compute_Bounds_Multiple_Threads() {
-    const std::vector<Mantid::LiveData::KafkaEventStreamDecoder::BufferedEvent> events = {
-        {0, 0, 0}, {0, 0, 0}, {1, 0, 0}, {1, 0, 0}, {2, 0, 0}, {2, 0, 0}, {3, 0, 0}, {3, 0, 0},
-        {4, 0, 0}, {4, 0, 0}, {5, 0, 0}, {5, 0, 0}, {6, 0, 0}, {6, 0, 0}, {7, 0, 0}, {7, 0, 0},
-    };
-
-    const auto groupBounds = computeGroupBoundaries(events, 8);
-    TS_ASSERT_EQUALS(9, groupBounds.size());
-
-    TS_ASSERT_EQUALS(0, groupBounds[0]);
-    TS_ASSERT_EQUALS(2, groupBounds[1]);
-    TS_ASSERT_EQUALS(4, groupBounds[2]);
-    TS_ASSERT_EQUALS(6, groupBounds[3]);
-    TS_ASSERT_EQUALS(8, groupBounds[4]);
-    TS_ASSERT_EQUALS(10, groupBounds[5]);
-    TS_ASSERT_EQUALS(12, groupBounds[6]);
-    TS_ASSERT_EQUALS(14, groupBounds[7]);
-    TS_ASSERT_EQUALS(events.size(), groupBounds[8]);
-  }
-
-  void test_Compute_Bounds_Multiple_Threads_Low_Events() {
-    const std::vector<Mantid::LiveData::KafkaEventStreamDecoder::BufferedEvent> events = {
-        {0, 0, 0}, {1, 0, 0}, {2, 0, 0}, {3, 0, 0}, {3, 0, 0}, {4, 0, 0},
-    };
-
-    const auto groupBounds = computeGroupBoundaries(events, 8);
-    TS_ASSERT_EQUALS(9, groupBounds.size());
-
-    const auto upper = events.size();
-
-    TS_ASSERT_EQUALS(0, groupBounds[0]);
-    TS_ASSERT_EQUALS(1, groupBounds[1]);
-    TS_ASSERT_EQUALS(2, groupBounds[2]);
-    TS_ASSERT_EQUALS(3, groupBounds[3]);
-    TS_ASSERT_EQUALS(5, groupBounds[4]);
-    TS_ASSERT_EQUALS(upper, groupBounds[5]);
-    TS_ASSERT_EQUALS(upper, groupBounds[6]);
-    TS_ASSERT_EQUALS(upper, groupBounds[7]);
-    TS_ASSERT_EQUALS(upper, groupBounds[8]);
-  }
-
-  void test_Compute_Bounds_Multiple_Threads_Very_Inbalanced() {
-    const std::vector<Mantid::LiveData::KafkaEventStreamDecoder::BufferedEvent> events = {/* 0 */
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-                                                                                          {0, 0, 0},
-
-                                                                                          /* 14 */
-                                                                                          {1, 0, 0},
-
-                                                                                          /* 15 */
-                                                                                          {2, 0, 0},
-
-                                                                                          /* 16 */
-                                                                                          {3, 0, 0},
-                                                                                          {3, 0, 0},
-
-                                                                                          /* 18 */
-                                                                                          {4, 0, 0}};
-
-    const auto groupBounds = computeGroupBoundaries(events, 8);
-    TS_ASSERT_EQUALS(9, groupBounds.size());
-
-    const auto upper = events.size();
-
-    /* Generated groups contain: 0  1,2  3  4 */
-    TS_ASSERT_EQUALS(0, groupBounds[0]);
-    TS_ASSERT_EQUALS(14, groupBounds[1]);
-    TS_ASSERT_EQUALS(16, groupBounds[2]);
-    TS_ASSERT_EQUALS(18, groupBounds[3]);
-    TS_ASSERT_EQUALS(upper, groupBounds[4]);
-    TS_ASSERT_EQUALS(upper, groupBounds[5]);
-    TS_ASSERT_EQUALS(upper, groupBounds[6]);
-    TS_ASSERT_EQUALS(upper, groupBounds[7]);
-    TS_ASSERT_EQUALS(upper, groupBounds[8]);
-  }
-
-  void test_Compute_Bounds_Single_Thread() {
-    const std::vector<Mantid::LiveData::KafkaEventStreamDecoder::BufferedEvent> events = {
-        {0, 0, 0}, {1, 0, 0}, {2, 0, 0}, {3, 0, 0}, {3, 0, 0}, {4, 0, 0},
-    };
-
-    const auto groupBounds = computeGroupBoundaries(events, 1);
-    TS_ASSERT_EQUALS(2, groupBounds.size());
-
-    TS_ASSERT_EQUALS(0, groupBounds[0]);
-    TS_ASSERT_EQUALS(events.size(), groupBounds[1]);
-  }
-
   //----------------------------------------------------------------------------
   // Failure tests
   //----------------------------------------------------------------------------
@@ -9,6 +9,7 @@
 #include "KafkaTestThreadHelper.h"
 #include "KafkaTesting.h"
 
+#include "MantidAPI/ILiveListener.h"
 #include "MantidAPI/Run.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidHistogramData/FixedLengthVector.h"
@@ -86,6 +87,62 @@ public:
     TS_ASSERT(Mock::VerifyAndClear(mockBroker.get()));
   }
 
+  void test_Histo_Stream_Delta_Updates() {
+    using namespace ::testing;
+    using namespace KafkaTesting;
+    using Mantid::API::ILiveListener;
+    using Mantid::API::Workspace_sptr;
+    using Mantid::DataObjects::Workspace2D;
+    using namespace Mantid::LiveData;
+
+    auto mockBroker = std::make_shared<MockKafkaBroker>();
+    EXPECT_CALL(*mockBroker, subscribe_(_, _))
+        .Times(Exactly(2))
+        .WillOnce(Return(new FakeHistoSubscriber()))
+        .WillOnce(Return(new FakeRunInfoStreamSubscriber(1)));
+
+    KafkaHistoStreamDecoder testInstance(mockBroker, "", "", "", "");
+    testInstance.setDeltaUpdates(true);
+    KafkaTestThreadHelper<KafkaHistoStreamDecoder> testHolder(std::move(testInstance));
+
+    testHolder.runKafkaOneStep(); // Init step
+    testHolder.runKafkaOneStep(); // Processing data step
+    Workspace_sptr first, second, third;
+    TS_ASSERT_THROWS_NOTHING(first = testHolder->extractData());
+    // Nothing has changed since the first extraction
+    TS_ASSERT_THROWS_NOTHING(second = testHolder->extractData());
+    // As if the caller failed to accumulate the second chunk
+    testHolder->requestFullUpdate();
+    TS_ASSERT_THROWS_NOTHING(third = testHolder->extractData());
+
+    // Shut down
+    testHolder.stopCapture();
+    TS_ASSERT(!testHolder->isCapturing());
+
+    // The first extraction holds every spectrum
+    auto firstWksp = std::dynamic_pointer_cast<Workspace2D>(first);
+    TS_ASSERT(firstWksp);
+    TS_ASSERT(!firstWksp->run().hasProperty(ILiveListener::DELTA_UPDATE_PROPERTY));
+    checkWorkspaceMetadata(*firstWksp);
+    checkWorkspaceHistoData(*firstWksp);
+
+    // Followed by only the spectra that changed
+    auto secondWksp = std::dynamic_pointer_cast<Workspace2D>(second);
+    TS_ASSERT(secondWksp);
+    TS_ASSERT(secondWksp->run().hasProperty(ILiveListener::DELTA_UPDATE_PROPERTY));
+    // A workspace cannot be empty so it has the first spectrum
+    TS_ASSERT_EQUALS(secondWksp->getNumberHistograms(), 1);
+    TS_ASSERT_EQUALS(secondWksp->getSpectrum(0).getSpectrumNo(), 1);
+    TS_ASSERT_EQUALS(secondWksp->y(0).rawData(), (std::vector<double>{100, 140}));
+
+    // Everything is sent again after a full update was requested
+    auto thirdWksp = std::dynamic_pointer_cast<Workspace2D>(third);
+    TS_ASSERT(thirdWksp);
+    TS_ASSERT(!thirdWksp->run().hasProperty(ILiveListener::DELTA_UPDATE_PROPERTY));
+    checkWorkspaceHistoData(*thirdWksp);
+    TS_ASSERT(Mock::VerifyAndClear(mockBroker.get()));
+  }
+
 private:
   void checkWorkspaceMetadata(const Mantid::DataObjects::Workspace2D &histoWksp) {
     TS_ASSERT(histoWksp.getInstrument());
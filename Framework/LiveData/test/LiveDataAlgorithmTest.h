@@ -84,6 +84,14 @@ public:
     alg.setPropertyValue("AccumulationWorkspace", "accum_ws");
     TSM_ASSERT("Is OK now", alg.validateInputs().empty());
 
+    alg.setProperty("IncrementalPostProcessing", true);
+    TSM_ASSERT("Incremental post-processing while adding", alg.validateInputs().empty());
+    alg.setPropertyValue("AccumulationMethod", "Replace");
+    TSM_ASSERT("Incremental post-processing needs Add",
+               !alg.validateInputs()["IncrementalPostProcessing"].empty());
+    alg.setPropertyValue("AccumulationMethod", "Add");
+    alg.setProperty("IncrementalPostProcessing", false);
+
     alg.setPropertyValue("AccumulationWorkspace", "out_ws");
     TSM_ASSERT("AccumulationWorkspace == OutputWorkspace", !alg.validateInputs()["AccumulationWorkspace"].empty());
 
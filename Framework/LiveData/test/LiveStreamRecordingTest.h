@@ -0,0 +1,75 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidLiveData/LiveStreamRecording.h"
+
+#include <Poco/File.h>
+#include <Poco/TemporaryFile.h>
+
+#include <fstream>
+#include <string>
+
+using Mantid::LiveData::LiveStreamRecord;
+using Mantid::LiveData::LiveStreamRecordReader;
+using Mantid::LiveData::LiveStreamRecordWriter;
+
+class LiveStreamRecordingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LiveStreamRecordingTest *createSuite() { return new LiveStreamRecordingTest(); }
+  static void destroySuite(LiveStreamRecordingTest *suite) { delete suite; }
+
+  void test_records_round_trip() {
+    Poco::TemporaryFile file;
+    const std::string first("first block"), second("second");
+    {
+      LiveStreamRecordWriter writer(file.path());
+      writer.write(10, first.data(), first.size());
+      writer.write(2000, second.data(), second.size());
+      writer.write(3000, nullptr, 0);
+      TS_ASSERT_EQUALS(writer.numberOfRecords(), 3);
+      TS_ASSERT_EQUALS(writer.numberOfBytes(), first.size() + second.size());
+    }
+
+    LiveStreamRecordReader reader(file.path());
+    LiveStreamRecord record;
+    TS_ASSERT(reader.next(record));
+    TS_ASSERT_EQUALS(record.time, 10);
+    TS_ASSERT_EQUALS(std::string(record.data.begin(), record.data.end()), first);
+    TS_ASSERT(reader.next(record));
+    TS_ASSERT_EQUALS(record.time, 2000);
+    TS_ASSERT_EQUALS(std::string(record.data.begin(), record.data.end()), second);
+    TS_ASSERT(reader.next(record));
+    TS_ASSERT_EQUALS(record.time, 3000);
+    TS_ASSERT(record.data.empty());
+    TS_ASSERT(!reader.next(record));
+  }
+
+  void test_file_that_is_not_a_recording_throws() {
+    Poco::TemporaryFile file;
+    std::ofstream(file.path()) << "not a recording";
+    TS_ASSERT_THROWS(LiveStreamRecordReader reader(file.path()), const std::runtime_error &);
+  }
+
+  void test_truncated_recording_throws() {
+    Poco::TemporaryFile file;
+    const std::string data("some bytes");
+    {
+      LiveStreamRecordWriter writer(file.path());
+      writer.write(0, data.data(), data.size());
+    }
+    Poco::File(file.path()).setSize(Poco::File(file.path()).getSize() - 2);
+
+    LiveStreamRecordReader reader(file.path());
+    LiveStreamRecord record;
+    TS_ASSERT_THROWS(reader.next(record), const std::runtime_error &);
+  }
+};
@@ -7,11 +7,14 @@
 #pragma once
 
 #include "MantidAPI/AlgorithmFactory.h"
+#include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/LiveListener.h"
 #include "MantidAPI/LiveListenerFactory.h"
 #include "MantidAPI/Run.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidFrameworkTestHelpers/FacilityHelper.h"
 #include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidKernel/ConfigService.h"
@@ -49,6 +52,43 @@ public:
   }
 };
 
+/// Gives back three spectra the first time and only spectrum 2, marked as
+/// a delta update, afterwards until a full update is requested
+class FakeDeltaUpdateListener final : public API::LiveListener {
+public:
+  std::string name() const override { return "FakeDeltaUpdateListener"; }
+  bool supportsHistory() const override { return false; }
+  bool buffersEvents() const override { return false; }
+  bool connect(const Poco::Net::SocketAddress &) override { return true; }
+  void start(Types::Core::DateAndTime) override {}
+  Workspace_sptr extractData() override {
+    using namespace Mantid::HistogramData;
+    MatrixWorkspace_sptr ws;
+    if (m_sendFull) {
+      ws = create<Workspace2D>(3, Histogram(BinEdges{0, 1, 2}, Counts{1, 1}));
+      m_sendFull = false;
+    } else {
+      ws = create<Workspace2D>(1, Histogram(BinEdges{0, 1, 2}, Counts{5, 6}));
+      ws->getSpectrum(0).setSpectrumNo(2);
+      ws->mutableRun().addProperty(ILiveListener::DELTA_UPDATE_PROPERTY, true);
+    }
+    ws->mutableRun().addProperty("run_number", std::string("1234"));
+    return ws;
+  }
+  void requestFullUpdate() override {
+    m_sendFull = true;
+    ++fullUpdatesRequested;
+  }
+  bool isConnected() override { return true; }
+  RunStatus runStatus() override { return Running; }
+  int runNumber() const override { return 1234; }
+
+  int fullUpdatesRequested{0};
+
+private:
+  bool m_sendFull{true};
+};
+
 class LoadLiveDataTest : public CxxTest::TestSuite {
 public:
   // This pair of boilerplate methods prevent the suite being created statically
@@ -232,6 +272,64 @@ public:
     TS_ASSERT_EQUALS(ws1->monitorWorkspace(), ws2->monitorWorkspace());
   }
 
+  //--------------------------------------------------------------------------------------------
+  /** Run an Add with the chunks rebinned and the output post-processed
+   * incrementally by a coarser rebin */
+  void doIncrementalExec() {
+    FacilityHelper::ScopedFacilities loadTESTFacility("unit_testing/UnitTestFacilities.xml", "TEST");
+
+    LoadLiveData alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Instrument", "TestDataListener"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("AccumulationMethod", "Add"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("ProcessingAlgorithm", "Rebin"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("ProcessingProperties", "Params=40e3, 1e3, 60e3"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("PostProcessingAlgorithm", "Rebin"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("PostProcessingProperties", "Params=40e3, 2e3, 60e3"));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("PreserveEvents", false));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("IncrementalPostProcessing", true));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("AccumulationWorkspace", "fake_accum"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("OutputWorkspace", "fake"));
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+  }
+
+  /** Post-processing only the new chunk gives the same output as
+   * post-processing the whole accumulation workspace */
+  void test_add_IncrementalPostProcessing() {
+    doIncrementalExec();
+    doIncrementalExec();
+
+    auto accum = AnalysisDataService::Instance().retrieveWS<Workspace2D>("fake_accum");
+    auto output = AnalysisDataService::Instance().retrieveWS<Workspace2D>("fake");
+    TS_ASSERT_EQUALS(accum->blocksize(), 20);
+    TS_ASSERT_EQUALS(output->getNumberHistograms(), 2);
+    TS_ASSERT_EQUALS(output->blocksize(), 10);
+
+    // Post-process the accumulated data in one go to compare
+    auto rebin = AlgorithmManager::Instance().createUnmanaged("Rebin");
+    rebin->initialize();
+    rebin->setChild(true);
+    rebin->setProperty("InputWorkspace", std::dynamic_pointer_cast<MatrixWorkspace>(accum));
+    rebin->setPropertyValue("OutputWorkspace", "unused");
+    rebin->setPropertyValue("Params", "40e3, 2e3, 60e3");
+    rebin->execute();
+    MatrixWorkspace_sptr expected = rebin->getProperty("OutputWorkspace");
+
+    double total = 0;
+    for (size_t i = 0; i < output->getNumberHistograms(); ++i) {
+      const auto &y = output->y(i);
+      const auto &expectedY = expected->y(i);
+      for (size_t j = 0; j < y.size(); ++j) {
+        TS_ASSERT_DELTA(y[j], expectedY[j], 1e-8);
+        total += y[j];
+      }
+    }
+    // Two chunks of 100 events per spectrum
+    TS_ASSERT_DELTA(total, 400.0, 1e-4);
+    TS_ASSERT_EQUALS(AnalysisDataService::Instance().size(), 2);
+  }
+
   //--------------------------------------------------------------------------------------------
   /** Simple processing of a chunk */
   void test_ProcessChunk_DoPreserveEvents() {
@@ -334,6 +432,56 @@ public:
     TS_ASSERT_EQUALS(ws->getNPoints(), 400);
   }
 
+  //--------------------------------------------------------------------------------------------
+  void test_replace_copies_changed_spectra() {
+    auto listener = std::make_shared<FakeDeltaUpdateListener>();
+    auto ws1 = doExec<Workspace2D>("Replace", "", "", "", "", true, listener);
+    TS_ASSERT_EQUALS(ws1->getNumberHistograms(), 3);
+
+    auto ws2 = doExec<Workspace2D>("Replace", "", "", "", "", true, listener);
+    TSM_ASSERT("The spectra are copied into the same workspace", ws1 == ws2);
+    TS_ASSERT_EQUALS(ws2->getNumberHistograms(), 3);
+    TS_ASSERT_EQUALS(ws2->y(0).rawData(), (std::vector<double>{1, 1}));
+    TS_ASSERT_EQUALS(ws2->y(1).rawData(), (std::vector<double>{5, 6}));
+    TS_ASSERT_EQUALS(ws2->y(2).rawData(), (std::vector<double>{1, 1}));
+    TS_ASSERT_EQUALS(ws2->getSpectrum(1).getSpectrumNo(), 2);
+    TS_ASSERT(!ws2->run().hasProperty(ILiveListener::DELTA_UPDATE_PROPERTY));
+    TS_ASSERT_EQUALS(listener->fullUpdatesRequested, 0);
+  }
+
+  void test_changed_spectra_without_output_workspace_request_full_update() {
+    auto listener = std::make_shared<FakeDeltaUpdateListener>();
+    doExec<Workspace2D>("Replace", "", "", "", "", true, listener);
+    // The output workspace is deleted between updates
+    AnalysisDataService::Instance().remove("fake");
+    TS_ASSERT(!runLoadLiveData("Replace", listener));
+    TS_ASSERT_EQUALS(listener->fullUpdatesRequested, 1);
+
+    // The next update is complete again
+    auto ws = doExec<Workspace2D>("Replace", "", "", "", "", true, listener);
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(), 3);
+    TS_ASSERT_EQUALS(ws->y(1).rawData(), (std::vector<double>{1, 1}));
+  }
+
+  void test_changed_spectra_that_cannot_be_accumulated_request_full_update() {
+    auto listener = std::make_shared<FakeDeltaUpdateListener>();
+    doExec<Workspace2D>("Add", "", "", "", "", true, listener);
+    TS_ASSERT(!runLoadLiveData("Add", listener));
+    TS_ASSERT_EQUALS(listener->fullUpdatesRequested, 1);
+  }
+
+  void test_changed_spectra_not_marked_after_processing_request_full_update() {
+    auto listener = std::make_shared<FakeDeltaUpdateListener>();
+    const std::string dropMarker = std::string("Name=") + ILiveListener::DELTA_UPDATE_PROPERTY;
+    doExec<Workspace2D>("Replace", "DeleteLog", dropMarker, "", "", true, listener);
+    TS_ASSERT(!runLoadLiveData("Replace", listener, "DeleteLog", dropMarker));
+    TS_ASSERT_EQUALS(listener->fullUpdatesRequested, 1);
+    // The accumulated data is not replaced by the changed spectra alone
+    auto ws = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("fake");
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(), 3);
+    TS_ASSERT_EQUALS(ws->y(1).rawData(), (std::vector<double>{1, 1}));
+  }
+
   //--------------------------------------------------------------------------------------------
   /** Handle WorkspaceGroups returned by the listener */
   void test_WorkspaceGroup_Replace_None_None() {
@@ -491,4 +639,21 @@ public:
     TS_ASSERT_EQUALS(std::accumulate(mws->readY(1).begin(), mws->readY(1).end(), 0.0, std::plus<double>()), 16.0);
     AnalysisDataService::Instance().clear();
   }
+
+private:
+  /// Run LoadLiveData into "fake", returning whether it executed
+  bool runLoadLiveData(const std::string &accumulationMethod, const ILiveListener_sptr &listener,
+                       const std::string &processingAlgorithm = "", const std::string &processingProperties = "") {
+    FacilityHelper::ScopedFacilities loadTESTFacility("unit_testing/UnitTestFacilities.xml", "TEST");
+    LoadLiveData alg;
+    alg.initialize();
+    alg.setPropertyValue("Instrument", "TestDataListener");
+    alg.setPropertyValue("AccumulationMethod", accumulationMethod);
+    alg.setPropertyValue("ProcessingAlgorithm", processingAlgorithm);
+    alg.setPropertyValue("ProcessingProperties", processingProperties);
+    alg.setPropertyValue("OutputWorkspace", "fake");
+    alg.setLiveListener(listener);
+    alg.execute();
+    return alg.isExecuted();
+  }
 };
@@ -0,0 +1,146 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidLiveData/LiveStreamRecording.h"
+#include "MantidLiveData/RecordLiveStream.h"
+#include "MantidLiveData/ReplayLiveStream.h"
+
+#include <Poco/ActiveResult.h>
+#include <Poco/Exception.h>
+#include <Poco/Net/StreamSocket.h>
+#include <Poco/TemporaryFile.h>
+#include <Poco/Thread.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Mantid::LiveData;
+
+namespace {
+constexpr int REPLAY_PORT = 59886;
+constexpr int RECORD_PORT = 59887;
+} // namespace
+
+class ReplayLiveStreamTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ReplayLiveStreamTest *createSuite() { return new ReplayLiveStreamTest(); }
+  static void destroySuite(ReplayLiveStreamTest *suite) { delete suite; }
+
+  ReplayLiveStreamTest() { Mantid::API::FrameworkManager::Instance(); }
+
+  void test_replay_sends_recorded_stream() {
+    ReplayLiveStream replay;
+    initReplay(replay, writeRecording({{0, "ADARA"}, {1000, " packets"}}), 0.0);
+    auto result = replay.executeAsync();
+
+    auto socket = connectTo(REPLAY_PORT);
+    TS_ASSERT_EQUALS(readAll(socket), "ADARA packets");
+    result.wait();
+    TS_ASSERT(replay.isExecuted());
+    const int numberOfRecords = replay.getProperty("NumberOfRecords");
+    const int64_t numberOfBytes = replay.getProperty("NumberOfBytes");
+    TS_ASSERT_EQUALS(numberOfRecords, 2);
+    TS_ASSERT_EQUALS(numberOfBytes, 13);
+  }
+
+  void test_speed_factor_scales_record_times() {
+    ReplayLiveStream replay;
+    initReplay(replay, writeRecording({{0, "first"}, {200000000, "second"}}), 2.0);
+    auto result = replay.executeAsync();
+
+    auto socket = connectTo(REPLAY_PORT);
+    TS_ASSERT_EQUALS(readAll(socket), "firstsecond");
+    result.wait();
+    TS_ASSERT(replay.isExecuted());
+    const double elapsed = replay.getProperty("ElapsedTime");
+    TS_ASSERT_LESS_THAN_EQUALS(0.09, elapsed);
+  }
+
+  void test_record_stream_through_proxy() {
+    const std::vector<std::pair<int64_t, std::string>> blocks{{0, "event "}, {1000, "stream "}, {2000, "bytes"}};
+    ReplayLiveStream replay;
+    initReplay(replay, writeRecording(blocks), 0.0);
+    const auto output = tempFilename();
+    RecordLiveStream record;
+    record.initialize();
+    record.setPropertyValue("Address", "127.0.0.1:" + std::to_string(REPLAY_PORT));
+    record.setProperty("Port", RECORD_PORT);
+    record.setPropertyValue("Filename", output);
+
+    auto replayResult = replay.executeAsync();
+    auto recordResult = record.executeAsync();
+    auto socket = connectTo(RECORD_PORT);
+    TS_ASSERT_EQUALS(readAll(socket), "event stream bytes");
+    recordResult.wait();
+    replayResult.wait();
+    TS_ASSERT(record.isExecuted());
+    TS_ASSERT(replay.isExecuted());
+    const int64_t numberOfBytes = record.getProperty("NumberOfBytes");
+    TS_ASSERT_EQUALS(numberOfBytes, 18);
+
+    // The stream may have been received in different blocks
+    std::string recorded;
+    LiveStreamRecordReader reader(output);
+    LiveStreamRecord block;
+    while (reader.next(block))
+      recorded.append(block.data.begin(), block.data.end());
+    TS_ASSERT_EQUALS(recorded, "event stream bytes");
+  }
+
+private:
+  std::string tempFilename() {
+    const auto filename = Poco::TemporaryFile::tempName() + ".livestream";
+    Poco::TemporaryFile::registerForDeletion(filename);
+    return filename;
+  }
+
+  std::string writeRecording(const std::vector<std::pair<int64_t, std::string>> &blocks) {
+    const auto filename = tempFilename();
+    LiveStreamRecordWriter writer(filename);
+    for (const auto &block : blocks)
+      writer.write(block.first, block.second.data(), block.second.size());
+    return filename;
+  }
+
+  void initReplay(ReplayLiveStream &replay, const std::string &filename, double speed) {
+    replay.initialize();
+    replay.setPropertyValue("Filename", filename);
+    replay.setProperty("Port", REPLAY_PORT);
+    replay.setProperty("SpeedFactor", speed);
+    replay.setProperty("Timeout", 10.0);
+  }
+
+  /// Connect to the port, the server may still be starting
+  Poco::Net::StreamSocket connectTo(int port) {
+    const Poco::Net::SocketAddress address("127.0.0.1:" + std::to_string(port));
+    for (int attempt = 1;; ++attempt) {
+      try {
+        return Poco::Net::StreamSocket(address);
+      } catch (Poco::Exception &) {
+        if (attempt == 50)
+          throw;
+      }
+      Poco::Thread::sleep(100);
+    }
+  }
+
+  std::string readAll(Poco::Net::StreamSocket &socket) {
+    std::string received;
+    char buffer[256];
+    int n;
+    while ((n = socket.receiveBytes(buffer, sizeof(buffer))) > 0)
+      received.append(buffer, n);
+    return received;
+  }
+};
@@ -0,0 +1,86 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidLiveData/Kafka/SPSCRingBuffer.h"
+
+#include <cxxtest/TestSuite.h>
+#include <string>
+#include <thread>
+
+using Mantid::LiveData::SPSCRingBuffer;
+
+class SPSCRingBufferTest : public CxxTest::TestSuite {
+public:
+  void test_Zero_Capacity_Throws() { TS_ASSERT_THROWS(SPSCRingBuffer<int>(0), const std::invalid_argument &); }
+
+  void test_Items_Are_Popped_In_Order() {
+    SPSCRingBuffer<int> buffer(3);
+    TS_ASSERT(buffer.empty());
+    TS_ASSERT(buffer.tryPush(1));
+    TS_ASSERT(buffer.tryPush(2));
+    TS_ASSERT_EQUALS(2, buffer.size());
+
+    int item(0);
+    TS_ASSERT(buffer.tryPop(item));
+    TS_ASSERT_EQUALS(1, item);
+    TS_ASSERT(buffer.tryPop(item));
+    TS_ASSERT_EQUALS(2, item);
+    TS_ASSERT(!buffer.tryPop(item));
+    TS_ASSERT(buffer.empty());
+  }
+
+  void test_Push_Fails_When_Full_And_Leaves_Item() {
+    SPSCRingBuffer<std::string> buffer(2);
+    TS_ASSERT(buffer.tryPush("a"));
+    TS_ASSERT(buffer.tryPush("b"));
+
+    std::string item("c");
+    TS_ASSERT(!buffer.tryPush(std::move(item)));
+    TS_ASSERT_EQUALS("c", item);
+    TS_ASSERT_EQUALS(2, buffer.size());
+
+    // Space is available again after a pop, wrapping around the slots
+    std::string popped;
+    TS_ASSERT(buffer.tryPop(popped));
+    TS_ASSERT_EQUALS("a", popped);
+    TS_ASSERT(buffer.tryPush(std::move(item)));
+    TS_ASSERT(buffer.tryPop(popped));
+    TS_ASSERT_EQUALS("b", popped);
+    TS_ASSERT(buffer.tryPop(popped));
+    TS_ASSERT_EQUALS("c", popped);
+  }
+
+  void test_Producer_And_Consumer_Threads() {
+    constexpr int nItems = 100000;
+    SPSCRingBuffer<int> buffer(16);
+
+    std::thread producer([&buffer] {
+      for (int i = 0; i < nItems; ++i) {
+        int item = i;
+        while (!buffer.tryPush(std::move(item))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    bool inOrder(true);
+    for (int expected = 0; expected < nItems;) {
+      int item(-1);
+      if (buffer.tryPop(item)) {
+        inOrder = inOrder && item == expected;
+        ++expected;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+
+    TS_ASSERT(inOrder);
+    TS_ASSERT(buffer.empty());
+  }
+};
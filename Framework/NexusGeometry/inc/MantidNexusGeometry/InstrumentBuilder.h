@@ -14,6 +14,7 @@
 #include <Eigen/Geometry>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Mantid {
 namespace Geometry {
@@ -23,6 +24,15 @@ class ICompAssembly;
 } // namespace Geometry
 namespace NexusGeometry {
 
+/// Description of a single detector pixel for bulk insertion into a bank
+struct DetectorDescription {
+  std::string name;
+  detid_t id;
+  /// Offset relative to the owning bank
+  Eigen::Vector3d relativeOffset;
+  std::shared_ptr<const Geometry::IObject> shape;
+};
+
 /** InstrumentBuilder : Builder for wrapping the creating of a Mantid
   Instrument. Provides some useful abstractions over the full-blown Instrument
   interface
@@ -44,6 +54,8 @@ public:
   /// Adds detector to the last registered bank
   void addDetectorToLastBank(const std::string &detName, detid_t detId, const Eigen::Vector3d &relativeOffset,
                              std::shared_ptr<const Mantid::Geometry::IObject> shape);
+  /// Adds many detectors to the last registered bank in one operation
+  void addDetectorsToLastBank(const std::vector<DetectorDescription> &detectors);
   /// Adds detector to instrument
   void addMonitor(const std::string &detName, detid_t detId, const Eigen::Vector3d &position,
                   std::shared_ptr<const Mantid::Geometry::IObject> &shape);
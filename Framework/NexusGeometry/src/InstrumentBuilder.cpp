@@ -11,6 +11,7 @@
 #include "MantidGeometry/Instrument/ObjCompAssembly.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidKernel/EigenConversionHelpers.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include "MantidNexusGeometry/NexusShapeFactory.h"
 #include <memory>
@@ -94,6 +95,32 @@ void InstrumentBuilder::addDetectorToLastBank(const std::string &detName, detid_
   m_instrument->markAsDetectorIncomplete(detector);
 }
 
+/** Add a batch of detectors to the last registered bank. The detector
+components are created concurrently and then attached to the bank and
+registered with the instrument in input order, so the result is identical to
+calling addDetectorToLastBank for each entry.
+@param detectors Descriptions of the detectors to add
+*/
+void InstrumentBuilder::addDetectorsToLastBank(const std::vector<DetectorDescription> &detectors) {
+  if (!m_lastBank)
+    throw std::runtime_error("No bank to add the detectors to");
+  auto *parent = const_cast<Geometry::IComponent *>(m_lastBank->getBaseComponent());
+  const auto nDetectors = static_cast<int64_t>(detectors.size());
+  std::vector<Geometry::Detector *> created(detectors.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < nDetectors; ++i) {
+    const auto &description = detectors[i];
+    auto *detector = new Geometry::Detector(description.name, description.id, parent);
+    detector->translate(Mantid::Kernel::toV3D(description.relativeOffset));
+    detector->setShape(description.shape);
+    created[i] = detector;
+  }
+  for (auto *detector : created) {
+    m_lastBank->add(detector);
+    m_instrument->markAsDetectorIncomplete(detector);
+  }
+}
+
 /// Adds detector to instrument
 void InstrumentBuilder::addDetectorToInstrument(const std::string &detName, detid_t detId,
                                                 const Eigen::Vector3d &position,
@@ -10,6 +10,7 @@
 #include "MantidGeometry/Rendering/GeometryHandler.h"
 #include "MantidGeometry/Rendering/ShapeInfo.h"
 #include "MantidKernel/ChecksumHelper.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidNexusGeometry/AbstractLogger.h"
 #include "MantidNexusGeometry/H5ForwardCompatibility.h"
 #include "MantidNexusGeometry/Hdf5Version.h"
@@ -22,6 +23,7 @@
 #include <Eigen/Geometry>
 #include <H5Cpp.h>
 #include <boost/regex.hpp>
+#include <exception>
 #include <numeric>
 #include <sstream>
 #include <tuple>
@@ -86,6 +88,51 @@ template <typename ValueType> std::vector<ValueType> extractVector(const DataSet
   return values;
 }
 
+/**
+ * Everything read from file for a single NXdetector. The HDF5 library is not
+ * thread safe, so banks are read one after another into these records and the
+ * expensive construction of shapes, tubes and detector descriptions then
+ * proceeds concurrently without touching the file.
+ */
+struct BankData {
+  enum class DetectorShapes { None, Cylinder, Mesh };
+  std::string name;
+  Eigen::Vector3d position;
+  Eigen::Quaterniond rotation;
+  std::vector<Mantid::detid_t> detectorIds;
+  Pixels pixelOffsets;
+  /// Shape shared by all pixels of the bank (when there are no detector_shape)
+  std::shared_ptr<const Geometry::IObject> pixelShape;
+  bool searchTubes = false;
+  /// Type of the per-detector shapes given in detector_shape
+  DetectorShapes detectorShapes = DetectorShapes::None;
+  /// detector_number dataset of a cylindrical detector_shape
+  std::vector<Mantid::detid_t> cylinderIndexToDetId;
+  std::vector<int64_t> cylinders;
+  std::vector<uint32_t> detectorFaces;
+  std::vector<uint32_t> faces;
+  std::vector<uint32_t> windingOrder;
+  std::vector<double> vertices;
+
+  /// Free the raw datasets once the bank has been built
+  void releaseDatasets() {
+    detectorIds = std::vector<Mantid::detid_t>();
+    pixelOffsets = Pixels();
+    cylinderIndexToDetId = std::vector<Mantid::detid_t>();
+    cylinders = std::vector<int64_t>();
+    detectorFaces = std::vector<uint32_t>();
+    faces = std::vector<uint32_t>();
+    windingOrder = std::vector<uint32_t>();
+    vertices = std::vector<double>();
+  }
+};
+
+/// The components built for a single bank, ready for insertion
+struct BankDetectors {
+  std::vector<detail::TubeBuilder> tubes;
+  std::vector<DetectorDescription> detectors;
+};
+
 /**
  * Parser as local class. Makes logging (side-effect) easier.
  */
@@ -467,22 +514,28 @@ private:
     return detIds;
   }
 
-  // Parse cylinder nexus geometry
-  void parseNexusCylinderDetector(const Group &shapeGroup, const std::string &name, InstrumentBuilder &builder,
-                                  const std::vector<Mantid::detid_t> &detectorIds) {
-
-    const auto cylinderIndexToDetId = getDetectorIds(shapeGroup); // 2x detids size
-    const auto cPoints = readNXInts(shapeGroup, "cylinders");
+  // Read cylinder nexus geometry describing each detector of a bank
+  void readCylinderDetectorShapes(const Group &shapeGroup, BankData &bank) {
+    bank.cylinderIndexToDetId = getDetectorIds(shapeGroup); // 2x detids size
+    bank.cylinders = readNXInts(shapeGroup, "cylinders");
     // 1D reads row first, then columns
-    auto vPoints = readNXFloats(shapeGroup, "vertices");
-    if (cylinderIndexToDetId.size() != 2 * detectorIds.size())
+    bank.vertices = readNXFloats(shapeGroup, "vertices");
+    if (bank.cylinderIndexToDetId.size() != 2 * bank.detectorIds.size())
       throw std::runtime_error("numbers of detector with shape cylinder does "
                                "not match number of detectors");
-    if (cPoints.size() % 3 != 0)
+    if (bank.cylinders.size() % 3 != 0)
       throw std::runtime_error("cylinders not divisible by 3. Bad input.");
-    if (vPoints.size() % 3 != 0)
+    if (bank.vertices.size() % 3 != 0)
       throw std::runtime_error("vertices not divisible by 3. Bad input.");
+    bank.detectorShapes = BankData::DetectorShapes::Cylinder;
+  }
 
+  // Create the detectors of a bank with one cylinder per detector
+  void prepareCylinderDetectors(const BankData &bank, BankDetectors &prepared) {
+    const auto &cylinderIndexToDetId = bank.cylinderIndexToDetId;
+    const auto &cPoints = bank.cylinders;
+    const auto &vPoints = bank.vertices;
+    prepared.detectors.reserve(cylinderIndexToDetId.size() / 2);
     for (size_t i = 0; i < cylinderIndexToDetId.size(); i += 2) {
       auto cylinderIndex = cylinderIndexToDetId[i];
       auto detId = cylinderIndexToDetId[i + 1];
@@ -499,8 +552,9 @@ private:
 
       // Note that tube optimisation is not used here. That should be applied as
       // future optimisation.
-      builder.addDetectorToLastBank(name + "_" + std::to_string(cylinderIndex), detId, (centre + other) / 2,
-                                    NexusShapeFactory::createCylinder(vSorted));
+      prepared.detectors.emplace_back(DetectorDescription{bank.name + "_" + std::to_string(cylinderIndex), detId,
+                                                          (centre + other) / 2,
+                                                          NexusShapeFactory::createCylinder(vSorted)});
     }
   }
 
@@ -559,32 +613,30 @@ private:
     }
   }
 
-  void extractNexusMeshAndAddDetectors(const std::vector<uint32_t> &detFaces, const std::vector<uint32_t> &faceIndices,
-                                       const std::vector<uint32_t> &windingOrder, const std::vector<double> &vertices,
-                                       const size_t numDets, const std::unordered_map<int, uint32_t> &detIdToIndex,
-                                       const std::string &name, InstrumentBuilder &builder,
-                                       const Group &detectorGroup) {
+  // Create the detectors of a bank with a mesh (OFF) shape per detector
+  void prepareMeshDetectors(const BankData &bank, BankDetectors &prepared) {
+    const auto &detFaces = bank.detectorFaces;
+    const auto numDets = bank.detectorIds.size();
+    // Build a map of detector IDs to the index of occurrence in the
+    // "detector_number" dataset
+    std::unordered_map<int, uint32_t> detIdToIndex;
+    for (uint32_t i = 0; i < numDets; ++i) {
+      detIdToIndex.emplace(bank.detectorIds[i], i);
+    }
+
     std::vector<std::vector<Eigen::Vector3d>> detFaceVerts(numDets);
     std::vector<std::vector<uint32_t>> detFaceIndices(numDets);
     std::vector<std::vector<uint32_t>> detWindingOrder(numDets);
     std::vector<int> detIds(numDets);
 
-    extractFacesAndIDs(detFaces, windingOrder, vertices, detIdToIndex, faceIndices, detFaceVerts, detFaceIndices,
-                       detWindingOrder, detIds);
-
-    Pixels detectorPixels;
-    bool calculatePixelCentre = true;
-    if (detFaces.size() != 2 * numDets) {
-      // At least one pixel is 3D (comprises multiple faces)
-      // We need pixel offsets from the NXdetector in this case, as
-      // calculating centre of mass for a general polyhedron is fairly
-      // complex and computationally expensive
-      Pixels pixelOffsets = getPixelOffsets(detectorGroup);
-      // Calculate pixel relative positions
-      detectorPixels = Eigen::Affine3d::Identity() * pixelOffsets;
-      calculatePixelCentre = false;
-    }
+    extractFacesAndIDs(detFaces, bank.windingOrder, bank.vertices, detIdToIndex, bank.faces, detFaceVerts,
+                       detFaceIndices, detWindingOrder, detIds);
 
+    // If at least one pixel is 3D (comprises multiple faces) the pixel offsets
+    // recorded in the NXdetector are used, as calculating centre of mass for a
+    // general polyhedron is fairly complex and computationally expensive
+    const bool calculatePixelCentre = detFaces.size() == 2 * numDets;
+    prepared.detectors.reserve(numDets);
     for (size_t i = 0; i < numDets; ++i) {
       auto &detVerts = detFaceVerts[i];
       const auto &singleDetIndices = detFaceIndices[i];
@@ -598,57 +650,51 @@ private:
       } else {
         // Our detector is 3D (described by multiple faces in the mesh)
         // Use pixel offset which was recorded in the NXdetector
-        centre = detectorPixels.col(i);
+        centre = bank.pixelOffsets.col(i);
       }
 
       // translate shape to origin for shape coordinates
       std::for_each(detVerts.begin(), detVerts.end(), [&centre](Eigen::Vector3d &val) { val -= centre; });
 
       auto shape = NexusShapeFactory::createFromOFFMesh(singleDetIndices, detWinding, detVerts);
-      builder.addDetectorToLastBank(name + "_" + std::to_string(i), detIds[i], centre, std::move(shape));
+      prepared.detectors.emplace_back(
+          DetectorDescription{bank.name + "_" + std::to_string(i), detIds[i], centre, std::move(shape)});
     }
   }
 
-  void parseMeshAndAddDetectors(InstrumentBuilder &builder, const Group &shapeGroup,
-                                const std::vector<Mantid::detid_t> &detectorIds, const std::string &bankName,
-                                const Group &detectorGroup) {
+  // Read mesh (OFF) nexus geometry describing each detector of a bank
+  void readMeshDetectorShapes(const Group &shapeGroup, BankData &bank, const Group &detectorGroup) {
     // Load mapping between detector IDs and faces, winding order of vertices
     // for faces, and face corner vertices
-    const auto detFaces = readNXUInts32(shapeGroup, "detector_faces");
-    const auto faceIndices = readNXUInts32(shapeGroup, "faces");
-    const auto windingOrder = readNXUInts32(shapeGroup, "winding_order");
-    const auto vertices = readNXFloats(shapeGroup, "vertices");
+    bank.detectorFaces = readNXUInts32(shapeGroup, "detector_faces");
+    bank.faces = readNXUInts32(shapeGroup, "faces");
+    bank.windingOrder = readNXUInts32(shapeGroup, "winding_order");
+    bank.vertices = readNXFloats(shapeGroup, "vertices");
+    const auto &detFaces = bank.detectorFaces;
 
     // Sanity check entries
-    if (detFaces.size() < 2 * detectorIds.size())
+    if (detFaces.size() < 2 * bank.detectorIds.size())
       throw std::runtime_error("Expect to have at least as many detector_face "
                                "entries as detector_number entries");
     if (detFaces.size() % 2 != 0)
       throw std::runtime_error("Unequal pairs of face indices to detector "
                                "indices in detector_faces");
-    if (detFaces.size() / 2 > faceIndices.size())
+    if (detFaces.size() / 2 > bank.faces.size())
       throw std::runtime_error("Cannot have more detector_faces entries than faces entries");
-    if (vertices.size() % 3 != 0)
+    if (bank.vertices.size() % 3 != 0)
       throw std::runtime_error("Unequal triple entries for vertices. Must be 3 * n entries");
 
-    // Build a map of detector IDs to the index of occurrence in the
-    // "detector_number" dataset
-    std::unordered_map<int, uint32_t> detIdToIndex;
-    for (uint32_t i = 0; i < detectorIds.size(); ++i) {
-      detIdToIndex.emplace(detectorIds[i], i);
-    }
-
-    extractNexusMeshAndAddDetectors(detFaces, faceIndices, windingOrder, vertices, detectorIds.size(), detIdToIndex,
-                                    bankName, builder, detectorGroup);
+    // Pixel offsets are only needed if pixels are 3D
+    if (detFaces.size() != 2 * bank.detectorIds.size())
+      bank.pixelOffsets = getPixelOffsets(detectorGroup);
+    bank.detectorShapes = BankData::DetectorShapes::Mesh;
   }
 
-  void parseAndAddBank(const Group &shapeGroup, InstrumentBuilder &builder,
-                       const std::vector<Mantid::detid_t> &detectorIds, const std::string &bankName,
-                       const Group &detectorGroup) {
+  void readDetectorShapes(const Group &shapeGroup, BankData &bank, const Group &detectorGroup) {
     if (utilities::hasNXAttribute(shapeGroup, NX_OFF)) {
-      parseMeshAndAddDetectors(builder, shapeGroup, detectorIds, bankName, detectorGroup);
+      readMeshDetectorShapes(shapeGroup, bank, detectorGroup);
     } else if (utilities::hasNXAttribute(shapeGroup, NX_CYLINDER)) {
-      parseNexusCylinderDetector(shapeGroup, bankName, builder, detectorIds);
+      readCylinderDetectorShapes(shapeGroup, bank);
     } else {
       std::stringstream ss;
       ss << "Shape group " << H5_OBJ_NAME(shapeGroup) << " has unknown geometry type specified via " << NX_CLASS;
@@ -656,6 +702,72 @@ private:
     }
   }
 
+  // Create the detectors of a bank where all pixels share a single shape
+  void preparePixelDetectors(const BankData &bank, BankDetectors &prepared) {
+    auto detectorIds = bank.detectorIds;
+    if (bank.searchTubes) {
+      prepared.tubes = TubeHelpers::findAndSortTubes(*bank.pixelShape, bank.pixelOffsets, detectorIds);
+      // Even if tubes are searched, we do NOT guarantee all detectors will be
+      // in tube formation, so must continue to process non-tube detectors
+      detectorIds = TubeHelpers::notInTubes(prepared.tubes, detectorIds);
+    }
+    prepared.detectors.reserve(detectorIds.size());
+    for (size_t i = 0; i < detectorIds.size(); ++i) {
+      auto index = static_cast<int>(i);
+      prepared.detectors.emplace_back(DetectorDescription{bank.name + "_" + std::to_string(index), detectorIds[index],
+                                                          bank.pixelOffsets.col(index), bank.pixelShape});
+    }
+  }
+
+  // Read the datasets of an NXdetector needed to build its bank
+  BankData readBank(const H5File &file, const Group &detectorGroup) {
+    BankData bank;
+    // Transform in homogenous coordinates. Offsets will be rotated then bank
+    // translation applied.
+    Eigen::Transform<double, 3, 2> transforms = getTransformations(file, detectorGroup);
+    // Absolute bank position
+    bank.position = transforms * Eigen::Vector3d{0, 0, 0};
+    // Absolute bank rotation
+    bank.rotation = Eigen::Quaterniond(transforms.rotation());
+    if (utilities::findDataset(detectorGroup, BANK_NAME))
+      bank.name = get1DStringDataset(BANK_NAME,
+                                     detectorGroup); // local_name is optional
+    // Get the pixel detIds
+    bank.detectorIds = getDetectorIds(detectorGroup);
+
+    // We preferentially deal with DETECTOR_SHAPE type shapes. Pixel offsets
+    // only needed if pixels are 3D for this processing
+    auto detector_shape = utilities::findGroupByName(detectorGroup, DETECTOR_SHAPE);
+    if (detector_shape) {
+      readDetectorShapes(*detector_shape, bank, detectorGroup);
+      return bank;
+    }
+
+    // Get the pixel offsets
+    bank.pixelOffsets = getPixelOffsets(detectorGroup);
+    // Extract shape
+    bank.pixelShape = parseNexusShape(detectorGroup, bank.searchTubes);
+    return bank;
+  }
+
+  // Build the components of a bank. Safe to call concurrently for different
+  // banks.
+  BankDetectors prepareBank(const BankData &bank) {
+    BankDetectors prepared;
+    switch (bank.detectorShapes) {
+    case BankData::DetectorShapes::Cylinder:
+      prepareCylinderDetectors(bank, prepared);
+      break;
+    case BankData::DetectorShapes::Mesh:
+      prepareMeshDetectors(bank, prepared);
+      break;
+    case BankData::DetectorShapes::None:
+      preparePixelDetectors(bank, prepared);
+      break;
+    }
+    return prepared;
+  }
+
   /**
    * Parse and return any sub-group providing shape information as Geometry
    * IObject.
@@ -742,55 +854,40 @@ public:
     InstrumentBuilder builder(instrumentName(root));
     // Get path to all detector groups
     const std::vector<Group> detectorGroups = openDetectorGroups(root);
+    std::vector<BankData> banks;
+    banks.reserve(detectorGroups.size());
     for (auto &detectorGroup : detectorGroups) {
-      // Transform in homogenous coordinates. Offsets will be rotated then bank
-      // translation applied.
-      auto debug = H5_OBJ_NAME(detectorGroup);
-      Eigen::Transform<double, 3, 2> transforms = getTransformations(file, detectorGroup);
-      // Absolute bank position
-      Eigen::Vector3d bankPos = transforms * Eigen::Vector3d{0, 0, 0};
-      // Absolute bank rotation
-      auto bankRotation = Eigen::Quaterniond(transforms.rotation());
-      std::string bankName;
-      if (utilities::findDataset(detectorGroup, BANK_NAME))
-        bankName = get1DStringDataset(BANK_NAME,
-                                      detectorGroup); // local_name is optional
-      builder.addBank(bankName, bankPos, bankRotation);
-      // Get the pixel detIds
-      auto detectorIds = getDetectorIds(detectorGroup);
-
-      // We preferentially deal with DETECTOR_SHAPE type shapes. Pixel offsets
-      // only needed if pixels are 3D for this processing
-      auto detector_shape = utilities::findGroupByName(detectorGroup, DETECTOR_SHAPE);
-      if (detector_shape) {
-        parseAndAddBank(*detector_shape, builder, detectorIds, bankName, detectorGroup);
-        continue;
-      }
-
-      // Get the pixel offsets
-      Pixels pixelOffsets = getPixelOffsets(detectorGroup);
-      // Calculate pixel relative positions
-      Pixels detectorPixels = Eigen::Affine3d::Identity() * pixelOffsets;
-      bool searchTubes = false;
-      // Extract shape
-      auto detShape = parseNexusShape(detectorGroup, searchTubes);
-
-      if (searchTubes) {
-        auto tubes = TubeHelpers::findAndSortTubes(*detShape, detectorPixels, detectorIds);
-        builder.addTubes(bankName, tubes, detShape);
-
-        // Even if tubes are searched, we do NOT guarantee all detectors will be
-        // in tube formation, so must continue to process non-tube detectors
-        detectorIds = TubeHelpers::notInTubes(tubes, detectorIds);
-      }
-      for (size_t i = 0; i < detectorIds.size(); ++i) {
-        auto index = static_cast<int>(i);
-        std::string name = bankName + "_" + std::to_string(index);
+      banks.emplace_back(readBank(file, detectorGroup));
+    }
 
-        const Eigen::Vector3d &relativePos = detectorPixels.col(index);
-        builder.addDetectorToLastBank(name, detectorIds[index], relativePos, detShape);
+    // Construct the components of each bank concurrently
+    const auto nBanks = static_cast<int64_t>(banks.size());
+    std::vector<BankDetectors> prepared(banks.size());
+    std::exception_ptr error;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < nBanks; ++i) {
+      try {
+        prepared[i] = prepareBank(banks[i]);
+        // Raw datasets are no longer needed
+        banks[i].releaseDatasets();
+      } catch (...) {
+        PARALLEL_CRITICAL(NexusGeometryParser_prepareBank) {
+          if (!error)
+            error = std::current_exception();
+        }
       }
     }
+    if (error)
+      std::rethrow_exception(error);
+
+    // Insert in file order so that the component tree is deterministic
+    for (size_t i = 0; i < banks.size(); ++i) {
+      builder.addBank(banks[i].name, banks[i].position, banks[i].rotation);
+      if (!prepared[i].tubes.empty())
+        builder.addTubes(banks[i].name, prepared[i].tubes, banks[i].pixelShape);
+      builder.addDetectorsToLastBank(prepared[i].detectors);
+      prepared[i] = BankDetectors();
+    }
     // Sort the detectors
     // Parse source and sample and add to instrument
     parseAndAddSample(file, root, builder);
@@ -54,6 +54,32 @@ public:
     TS_ASSERT_EQUALS(iDetInfo->position(1), this->testPos1);
   }
 
+  void testAddDetectorsToLastBank_requires_bank() {
+    InstrumentBuilder builder(this->iTestName);
+    std::vector<DetectorDescription> detectors{{this->dTestName, 1, this->testPos1, this->shape}};
+    TS_ASSERT_THROWS(builder.addDetectorsToLastBank(detectors), const std::runtime_error &);
+  }
+
+  void testAddDetectorsToLastBank() {
+    InstrumentBuilder builder(this->iTestName);
+    builder.addSample("sample", {0, 0, 0});
+    builder.addSource("source", {-10, 0, 0});
+    const Eigen::Vector3d bankPos(0, 0, 5);
+    builder.addBank("bank", bankPos, Eigen::Quaterniond::Identity());
+    std::vector<DetectorDescription> detectors;
+    for (detid_t id = 10; id > 0; --id)
+      detectors.emplace_back(DetectorDescription{"pixel_" + std::to_string(id), id,
+                                                 Eigen::Vector3d(static_cast<double>(id), 0, 0), this->shape});
+    builder.addDetectorsToLastBank(detectors);
+    auto iVisitor = Geometry::InstrumentVisitor(builder.createInstrument());
+    iVisitor.walkInstrument();
+    auto iDetInfo = iVisitor.detectorInfo();
+    TS_ASSERT_EQUALS(iDetInfo->size(), 10);
+    // Detectors are sorted by id, positions are relative to the bank
+    for (size_t i = 0; i < iDetInfo->size(); ++i)
+      TS_ASSERT_EQUALS(iDetInfo->position(i), bankPos + Eigen::Vector3d(static_cast<double>(i + 1), 0, 0));
+  }
+
   void testAddSample_and_testAddSource() {
     InstrumentBuilder builder(this->iTestName);
     TS_ASSERT_THROWS_NOTHING(builder.addSample(this->sampleName, this->testPos1));
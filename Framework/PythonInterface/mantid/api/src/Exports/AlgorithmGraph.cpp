@@ -0,0 +1,154 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/AlgorithmGraph.h"
+#include "MantidAPI/IAlgorithm.h"
+#include "MantidAPI/Workspace.h"
+#include "MantidKernel/Property.h"
+#include "MantidKernel/WarningSuppressions.h"
+#include "MantidPythonInterface/core/ExtractSharedPtr.h"
+#include "MantidPythonInterface/core/ReleaseGlobalInterpreterLock.h"
+#include "MantidPythonInterface/kernel/Registry/PropertyValueHandler.h"
+#include "MantidPythonInterface/kernel/Registry/TypeRegistry.h"
+
+#include <boost/python/class.hpp>
+#include <boost/python/dict.hpp>
+#include <boost/python/enum.hpp>
+#include <boost/python/extract.hpp>
+#include <boost/python/list.hpp>
+#include <boost/python/overloads.hpp>
+#include <boost/python/scope.hpp>
+#include <boost/python/str.hpp>
+
+using namespace Mantid::API;
+using Mantid::PythonInterface::ExtractSharedPtr;
+using Mantid::PythonInterface::ReleaseGlobalInterpreterLock;
+using namespace boost::python;
+namespace Registry = Mantid::PythonInterface::Registry;
+
+namespace {
+
+/**
+ * Convert a Python value to the string the graph sets on the algorithm. Like
+ * setProperty, the value is converted to the type of the property, so that
+ * e.g. lists and numpy arrays give comma separated values.
+ * @param algorithm :: The algorithm, which must be initialized
+ * @param name :: The name of the property
+ * @param value :: The value
+ * @return :: The value as a string
+ */
+std::string toPropertyString(const IAlgorithm &algorithm, const std::string &name, const object &value) {
+  if (extract<std::string> asString(value); asString.check())
+    return asString();
+  // Workspaces are passed on by name, which also orders the graph
+  if (ExtractSharedPtr<Workspace> workspace(value); workspace.check())
+    return workspace()->getName();
+  if (!algorithm.existsProperty(name))
+    return extract<std::string>(str(value))();
+  const auto *property = algorithm.getPointerToProperty(name);
+  try {
+    const auto &handler = Registry::TypeRegistry::retrieve(*(property->type_info()));
+    return handler.create(name, value, object(), property->direction())->value();
+  } catch (std::invalid_argument &e) {
+    throw std::invalid_argument("When converting parameter \"" + name + "\": " + e.what());
+  }
+}
+
+/**
+ * Add an algorithm to the graph
+ * @param self :: A reference to the calling object
+ * @param algorithm :: The algorithm
+ * @param properties :: A dictionary of property values, converted to strings
+ * as setProperty would convert them
+ * @param cores :: The number of cores the algorithm may use
+ * @return :: The node of the algorithm
+ */
+AlgorithmGraph::Node addAlgorithm(AlgorithmGraph &self, const IAlgorithm_sptr &algorithm,
+                                  const dict &properties = dict(), const int cores = 1) {
+  if (!algorithm)
+    return self.addAlgorithm(algorithm, {}, cores);
+  if (!algorithm->isInitialized())
+    algorithm->initialize();
+  std::map<std::string, std::string> values;
+  const list items = properties.items();
+  for (ssize_t i = 0; i < len(items); ++i) {
+    const auto name = extract<std::string>(items[i][0])();
+    values.emplace(name, toPropertyString(*algorithm, name, items[i][1]));
+  }
+  return self.addAlgorithm(algorithm, values, cores);
+}
+
+/**
+ * @param self :: A reference to the calling object
+ * @param node :: The node
+ * @return :: A python list of the nodes the node waits for
+ */
+list dependencies(const AlgorithmGraph &self, const AlgorithmGraph::Node node) {
+  list nodes;
+  for (const auto dependency : self.dependencies(node)) {
+    nodes.append(dependency);
+  }
+  return nodes;
+}
+
+bool execute(AlgorithmGraph &self, const int cores = 0) {
+  // The algorithms run on other threads, Python algorithms need the lock
+  ReleaseGlobalInterpreterLock releaseGIL;
+  return self.execute(cores);
+}
+
+void cancel(AlgorithmGraph &self) {
+  ReleaseGlobalInterpreterLock releaseGIL;
+  self.cancel();
+}
+
+///@cond
+//------------------------------------------------------------------------------------------------------
+GNU_DIAG_OFF("unused-local-typedef")
+// Ignore -Wconversion warnings coming from boost::python
+// Seen with GCC 7.1.1 and Boost 1.63.0
+GNU_DIAG_OFF("conversion")
+/// Define overload generators
+BOOST_PYTHON_FUNCTION_OVERLOADS(addAlgorithm_overloads, addAlgorithm, 2, 4)
+BOOST_PYTHON_FUNCTION_OVERLOADS(execute_overloads, execute, 1, 2)
+GNU_DIAG_ON("conversion")
+GNU_DIAG_ON("unused-local-typedef")
+///@endcond
+} // namespace
+
+void export_AlgorithmGraph() {
+  scope graphScope =
+      class_<AlgorithmGraph, boost::noncopyable>("AlgorithmGraph", "Runs algorithms concurrently, in an order that "
+                                                                   "respects the workspaces they read and write.")
+          .def("addAlgorithm", &addAlgorithm,
+               addAlgorithm_overloads((arg("self"), arg("algorithm"), arg("properties"), arg("cores")),
+                                      "Adds an algorithm, with property values to set before it is run and the "
+                                      "number of cores it may use. Returns the node of the algorithm."))
+          .def("addDependency", &AlgorithmGraph::addDependency, (arg("self"), arg("before"), arg("after")),
+               "Makes an algorithm wait for one added before it.")
+          .def("size", &AlgorithmGraph::size, arg("self"), "Returns the number of algorithms in the graph.")
+          .def("__len__", &AlgorithmGraph::size, arg("self"))
+          .def("algorithm", &AlgorithmGraph::algorithm, (arg("self"), arg("node")),
+               "Returns the algorithm of a node.")
+          .def("dependencies", &dependencies, (arg("self"), arg("node")),
+               "Returns the nodes a node waits for.")
+          .def("state", &AlgorithmGraph::state, (arg("self"), arg("node")),
+               "Returns the execution state of a node.")
+          .def("execute", &execute,
+               execute_overloads((arg("self"), arg("cores")),
+                                 "Runs the algorithms using at most the given number of cores, by default all "
+                                 "of them. Returns False if the graph was cancelled, and raises if algorithms "
+                                 "failed."))
+          .def("cancel", &cancel, arg("self"),
+               "Cancels the running algorithms, the algorithms that have not started are not run.");
+
+  enum_<AlgorithmGraph::NodeState>("NodeState")
+      .value("Waiting", AlgorithmGraph::NodeState::Waiting)
+      .value("Running", AlgorithmGraph::NodeState::Running)
+      .value("Finished", AlgorithmGraph::NodeState::Finished)
+      .value("Failed", AlgorithmGraph::NodeState::Failed)
+      .value("Cancelled", AlgorithmGraph::NodeState::Cancelled);
+}
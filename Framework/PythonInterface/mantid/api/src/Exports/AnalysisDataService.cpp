@@ -5,6 +5,7 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/WorkspaceMemoryManager.h"
 #include "MantidKernel/WarningSuppressions.h"
 #include "MantidPythonInterface/core/Converters/PySequenceToVector.h"
 #include "MantidPythonInterface/core/Converters/ToPyList.h"
@@ -49,6 +50,29 @@ AnalysisDataServiceImpl &instance() {
   return ads;
 }
 
+/**
+ * Retrieve a workspace, raising a KeyError if it does not exist. Python
+ * handles do not own their workspaces, so the workspace is kept in memory
+ * rather than saved to free memory while a script may hold it.
+ * @param self A reference to the AnalysisDataServiceImpl
+ * @param name The name of the workspace
+ * @return A weak pointer to the workspace
+ */
+std::weak_ptr<Workspace> retrieveOrKeyError(AnalysisDataServiceImpl &self, const std::string &name) {
+  Workspace_sptr workspace;
+  try {
+    workspace = self.retrieve(name);
+  } catch (Exception::NotFoundError &) {
+    // Translate into a Python KeyError
+    std::string err = "'" + name + "' does not exist.";
+    PyErr_SetString(PyExc_KeyError, err.c_str());
+    throw boost::python::error_already_set();
+  }
+  // The workspace is held here so it cannot be saved before it is marked
+  self.memoryManager().keepInMemory(name);
+  return workspace;
+}
+
 /**
  * @param self A reference to the AnalysisDataServiceImpl
  * @param names The list of names to extract
@@ -56,10 +80,14 @@ AnalysisDataServiceImpl &instance() {
  * @return a python list of the workspaces in the ADS
  */
 
-list retrieveWorkspaces(AnalysisDataServiceImpl const *const self, const list &names, bool unrollGroups = false) {
+list retrieveWorkspaces(AnalysisDataServiceImpl *const self, const list &names, bool unrollGroups = false) {
   using WeakPtr = std::weak_ptr<Workspace>;
-  const auto wsSharedPtrs =
-      self->retrieveWorkspaces(Converters::PySequenceToVector<std::string>(names)(), unrollGroups);
+  const auto wsNames = Converters::PySequenceToVector<std::string>(names)();
+  const auto wsSharedPtrs = self->retrieveWorkspaces(wsNames, unrollGroups);
+  // See retrieveOrKeyError
+  for (const auto &name : wsNames) {
+    self->memoryManager().keepInMemory(name);
+  }
   std::vector<WeakPtr> wsWeakPtrs;
   wsWeakPtrs.reserve(wsSharedPtrs.size());
   std::transform(wsSharedPtrs.cbegin(), wsSharedPtrs.cend(), std::back_inserter(wsWeakPtrs),
@@ -83,6 +111,11 @@ void export_AnalysisDataService() {
       .def("Instance", instance, return_value_policy<reference_existing_object>(),
            "Return a reference to the singleton instance")
       .staticmethod("Instance")
+      // Take precedence over the generic definitions, which are tried last
+      .def("retrieve", retrieveOrKeyError, (arg("self"), arg("name")),
+           "Retrieve the named object. Raises an exception if the name "
+           "does not exist")
+      .def("__getitem__", retrieveOrKeyError, (arg("self"), arg("name")))
       .def("retrieveWorkspaces", retrieveWorkspaces,
            AdsRetrieveWorkspacesOverloads("Retrieve a list of workspaces by name",
                                           (arg("self"), arg("names"), arg("unrollGroups") = false)))
@@ -100,5 +133,12 @@ void export_AnalysisDataService() {
            ":return: prefix + n*random characters + suffix\n"
            ":rtype: str\n")
       .def("unique_hidden_name", &AnalysisDataServiceImpl::uniqueHiddenName, arg("self"),
-           "Return a randomly generated unique hidden workspace name.");
+           "Return a randomly generated unique hidden workspace name.")
+      .def("setMemoryBudget", &AnalysisDataServiceImpl::setMemoryBudget, (arg("self"), arg("bytes")),
+           "Set the memory in bytes the workspaces may use, 0 for no limit. Beyond it the least recently used "
+           "workspaces are saved to scratch files, and loaded back when they are retrieved.")
+      .def("memoryBudget", &AnalysisDataServiceImpl::memoryBudget, arg("self"),
+           "Return the memory in bytes the workspaces may use, 0 if there is no limit.")
+      .def("memoryUsage", &AnalysisDataServiceImpl::memoryUsage, arg("self"),
+           "Return the memory in bytes used by the workspaces.");
 }
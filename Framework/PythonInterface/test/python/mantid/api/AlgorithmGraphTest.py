@@ -0,0 +1,93 @@
+# Mantid Repository : https://github.com/mantidproject/mantid
+#
+# Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+#   NScD Oak Ridge National Laboratory, European Spallation Source,
+#   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+# SPDX - License - Identifier: GPL - 3.0 +
+import unittest
+from mantid.api import AlgorithmFactory, AlgorithmGraph, AlgorithmManager, AnalysisDataService, FrameworkManagerImpl, PythonAlgorithm
+
+
+class AlgorithmGraphTestFail(PythonAlgorithm):
+    def PyInit(self):
+        pass
+
+    def PyExec(self):
+        raise RuntimeError("failed on purpose")
+
+
+AlgorithmFactory.subscribe(AlgorithmGraphTestFail)
+
+
+class AlgorithmGraphTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        FrameworkManagerImpl.Instance()
+
+    def tearDown(self):
+        AnalysisDataService.clear()
+
+    def test_algorithms_run_after_the_workspaces_they_read(self):
+        graph = AlgorithmGraph()
+        create = graph.addAlgorithm(
+            AlgorithmManager.create("CreateWorkspace"), {"DataX": "1,2", "DataY": "3", "OutputWorkspace": "graph_in"}
+        )
+        scale = graph.addAlgorithm(
+            AlgorithmManager.create("Scale"), {"InputWorkspace": "graph_in", "OutputWorkspace": "graph_out", "Factor": 2}, cores=2
+        )
+        self.assertEqual(len(graph), 2)
+        self.assertEqual(graph.dependencies(create), [])
+        self.assertEqual(graph.dependencies(scale), [create])
+
+        self.assertTrue(graph.execute())
+        self.assertEqual(graph.state(scale), AlgorithmGraph.NodeState.Finished)
+        self.assertEqual(AnalysisDataService.retrieve("graph_out").readY(0)[0], 6)
+
+    def test_list_and_array_values_are_converted_like_setProperty(self):
+        import numpy as np
+
+        graph = AlgorithmGraph()
+        graph.addAlgorithm(
+            AlgorithmManager.create("CreateWorkspace"),
+            {"DataX": [0.0, 1.0, 2.0, 3.0, 4.0], "DataY": np.array([1.0, 2.0, 3.0, 4.0]), "OutputWorkspace": "graph_in"},
+        )
+        rebin = graph.addAlgorithm(
+            AlgorithmManager.create("Rebin"),
+            {"InputWorkspace": "graph_in", "OutputWorkspace": "graph_out", "Params": [0, 2, 4], "PreserveEvents": False},
+        )
+        self.assertTrue(graph.execute())
+        self.assertEqual(graph.state(rebin), AlgorithmGraph.NodeState.Finished)
+        self.assertEqual(list(AnalysisDataService.retrieve("graph_out").readX(0)), [0.0, 2.0, 4.0])
+        self.assertEqual(list(AnalysisDataService.retrieve("graph_out").readY(0)), [3.0, 7.0])
+
+    def test_workspace_values_are_passed_by_name(self):
+        graph = AlgorithmGraph()
+        graph.addAlgorithm(AlgorithmManager.create("CreateWorkspace"), {"DataX": "1,2", "DataY": "3", "OutputWorkspace": "graph_in"})
+        self.assertTrue(graph.execute())
+        graph = AlgorithmGraph()
+        scale = graph.addAlgorithm(
+            AlgorithmManager.create("Scale"),
+            {"InputWorkspace": AnalysisDataService.retrieve("graph_in"), "OutputWorkspace": "graph_out", "Factor": 2},
+        )
+        self.assertTrue(graph.execute())
+        self.assertEqual(graph.state(scale), AlgorithmGraph.NodeState.Finished)
+        self.assertEqual(AnalysisDataService.retrieve("graph_out").readY(0)[0], 6)
+
+    def test_python_algorithm_failure_raises(self):
+        graph = AlgorithmGraph()
+        fail = graph.addAlgorithm(AlgorithmManager.create("AlgorithmGraphTestFail"))
+        create = graph.addAlgorithm(AlgorithmManager.create("CreateWorkspace"), {"DataX": "1", "DataY": "1", "OutputWorkspace": "graph_ws"})
+        graph.addDependency(fail, create)
+
+        self.assertRaises(RuntimeError, graph.execute, 2)
+        self.assertEqual(graph.state(fail), AlgorithmGraph.NodeState.Failed)
+        self.assertEqual(graph.state(create), AlgorithmGraph.NodeState.Cancelled)
+        self.assertFalse(AnalysisDataService.doesExist("graph_ws"))
+
+    def test_unknown_property_raises(self):
+        graph = AlgorithmGraph()
+        self.assertRaises(ValueError, graph.addAlgorithm, AlgorithmManager.create("CreateWorkspace"), {"NotAProperty": "1"})
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -218,6 +218,28 @@ class AnalysisDataServiceTest(unittest.TestCase):
         with self.assertRaises(RuntimeError):
             str(workspaces[0])
 
+    def test_workspaces_over_the_memory_budget_are_loaded_back_when_retrieved(self):
+        self._run_createws("ADSTest_budget_a")
+        self._run_createws("ADSTest_budget_b")
+        self.assertGreater(AnalysisDataService.memoryUsage(), 0)
+        AnalysisDataService.setMemoryBudget(1)
+        try:
+            self.assertEqual(AnalysisDataService.memoryBudget(), 1)
+            self.assertEqual(AnalysisDataService["ADSTest_budget_a"].readY(0)[2], 3.0)
+            self.assertEqual(AnalysisDataService["ADSTest_budget_b"].readY(0)[2], 3.0)
+        finally:
+            AnalysisDataService.setMemoryBudget(0)
+
+    def test_workspaces_retrieved_from_python_stay_in_memory(self):
+        self._run_createws("ADSTest_budget_held")
+        held = AnalysisDataService["ADSTest_budget_held"]
+        AnalysisDataService.setMemoryBudget(1)
+        try:
+            self._run_createws("ADSTest_budget_other")
+            self.assertEqual(held.readY(0)[2], 3.0)
+        finally:
+            AnalysisDataService.setMemoryBudget(0)
+
     def test_unique_name(self):
         ws_name = mtd.unique_name()
         self.assertEqual(5, len(ws_name))
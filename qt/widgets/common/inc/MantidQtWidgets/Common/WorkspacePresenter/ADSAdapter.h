@@ -63,6 +63,12 @@ private:
 
   void handleWorkspaceGroupUpdate(Mantid::API::GroupUpdatedNotification_ptr pNf);
   Poco::NObserver<ADSAdapter, Mantid::API::GroupUpdatedNotification> m_workspaceGroupUpdateObserver;
+
+  void handleEvictWorkspace(Mantid::API::WorkspaceEvictedNotification_ptr pNf);
+  Poco::NObserver<ADSAdapter, Mantid::API::WorkspaceEvictedNotification> m_evictObserver;
+
+  void handleRestoreWorkspace(Mantid::API::WorkspaceRestoredNotification_ptr pNf);
+  Poco::NObserver<ADSAdapter, Mantid::API::WorkspaceRestoredNotification> m_restoreObserver;
 };
 } // namespace MantidWidgets
 } // namespace MantidQt
@@ -71,5 +71,8 @@ void WorkspaceIcons::initInternalLookup() {
   // MD
   m_idToPixmapName["MDHistoWorkspace"] = "mantid_mdws_xpm";
   m_idToPixmapName["MDEventWorkspace"] = "mantid_mdws_xpm";
+
+  // Saved to a scratch file to free memory
+  m_idToPixmapName["SavedWorkspace"] = "folder_closed_xpm";
 }
 } // namespace MantidQt::API
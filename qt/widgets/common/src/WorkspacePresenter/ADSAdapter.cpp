@@ -21,7 +21,9 @@ ADSAdapter::ADSAdapter()
       m_renameObserver(*this, &ADSAdapter::handleRenameWorkspace),
       m_groupworkspacesObserver(*this, &ADSAdapter::handleGroupWorkspaces),
       m_ungroupworkspaceObserver(*this, &ADSAdapter::handleUnGroupWorkspace),
-      m_workspaceGroupUpdateObserver(*this, &ADSAdapter::handleWorkspaceGroupUpdate) {
+      m_workspaceGroupUpdateObserver(*this, &ADSAdapter::handleWorkspaceGroupUpdate),
+      m_evictObserver(*this, &ADSAdapter::handleEvictWorkspace),
+      m_restoreObserver(*this, &ADSAdapter::handleRestoreWorkspace) {
   // Register all observers.
   auto &nc = AnalysisDataService::Instance().notificationCenter;
   nc.addObserver(m_addObserver);
@@ -32,6 +34,8 @@ ADSAdapter::ADSAdapter()
   nc.addObserver(m_groupworkspacesObserver);
   nc.addObserver(m_ungroupworkspaceObserver);
   nc.addObserver(m_workspaceGroupUpdateObserver);
+  nc.addObserver(m_evictObserver);
+  nc.addObserver(m_restoreObserver);
 }
 
 ADSAdapter::~ADSAdapter() {
@@ -45,6 +49,8 @@ ADSAdapter::~ADSAdapter() {
   nc.removeObserver(m_groupworkspacesObserver);
   nc.removeObserver(m_ungroupworkspaceObserver);
   nc.removeObserver(m_workspaceGroupUpdateObserver);
+  nc.removeObserver(m_evictObserver);
+  nc.removeObserver(m_restoreObserver);
 }
 
 void ADSAdapter::registerPresenter(Presenter_wptr presenter) { m_presenter = std::move(presenter); }
@@ -114,4 +120,16 @@ void ADSAdapter::handleWorkspaceGroupUpdate(Mantid::API::GroupUpdatedNotificatio
   presenter->notifyFromWorkspaceProvider(WorkspaceProviderNotifiable::Flag::WorkspaceGroupUpdated);
 }
 
+// Saving workspaces to free memory, or loading them back, changes their
+// entries in the tree but not the names
+void ADSAdapter::handleEvictWorkspace(Mantid::API::WorkspaceEvictedNotification_ptr /*unused*/) {
+  auto presenter = lockPresenter();
+  presenter->notifyFromWorkspaceProvider(WorkspaceProviderNotifiable::Flag::GenericUpdateNotification);
+}
+
+void ADSAdapter::handleRestoreWorkspace(Mantid::API::WorkspaceRestoredNotification_ptr /*unused*/) {
+  auto presenter = lockPresenter();
+  presenter->notifyFromWorkspaceProvider(WorkspaceProviderNotifiable::Flag::GenericUpdateNotification);
+}
+
 } // namespace MantidQt::MantidWidgets
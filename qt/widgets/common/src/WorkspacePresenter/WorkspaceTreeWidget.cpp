@@ -27,6 +27,7 @@
 #include "MantidAPI/IPeaksWorkspace.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/WorkspaceGroup.h"
+#include "MantidAPI/WorkspaceMemoryManager.h"
 
 #include <Poco/Path.h>
 
@@ -1174,6 +1175,15 @@ void WorkspaceTreeWidget::popupContextMenu() {
     menu->setObjectName("WorkspaceContextMenu");
     auto mantidTreeItem = dynamic_cast<MantidTreeWidgetItem *>(treeItem);
     auto ws = mantidTreeItem->data(0, Qt::UserRole).value<Mantid::API::Workspace_sptr>();
+    if (Mantid::API::WorkspaceMemoryManager::isSaved(*ws)) {
+      // Load it back to offer the actions for its type
+      try {
+        ws = AnalysisDataService::Instance().retrieve(selectedWsName.toStdString());
+      } catch (std::exception &ex) {
+        docklog.warning() << ex.what() << '\n';
+        return;
+      }
+    }
 
     // Add the items that are appropriate for the type
     if (auto matrixWS = std::dynamic_pointer_cast<const Mantid::API::MatrixWorkspace>(ws)) {